@@ -0,0 +1,345 @@
+#include "OPC_Benchmark.hpp"
+
+namespace TwilightDreamOfMagical::Benchmark_OaldresPuzzle_Cryptic
+{
+	namespace
+	{
+		//最近秩百分位数，Samples 已经排好序
+		//Nearest-rank percentile, Samples is already sorted
+		double NearestRankPercentile( const std::vector<double>& Samples, double Percentile )
+		{
+			const std::size_t Rank = static_cast<std::size_t>( std::ceil( Percentile * static_cast<double>( Samples.size() ) ) );
+			return Samples[ std::clamp<std::size_t>( Rank, 1, Samples.size() ) - 1 ];
+		}
+
+		//"64", "16K", "1M", "1G" (二进制单位)
+		//"64", "16K", "1M", "1G" (binary units)
+		std::optional<std::size_t> ParseByteSize( std::string_view Text )
+		{
+			std::size_t Multiplier = 1;
+			if ( !Text.empty() )
+			{
+				switch ( Text.back() )
+				{
+					case 'K':
+					case 'k':
+						Multiplier = std::size_t( 1 ) << 10;
+						break;
+					case 'M':
+					case 'm':
+						Multiplier = std::size_t( 1 ) << 20;
+						break;
+					case 'G':
+					case 'g':
+						Multiplier = std::size_t( 1 ) << 30;
+						break;
+					default:
+						break;
+				}
+				if ( Multiplier != 1 )
+					Text.remove_suffix( 1 );
+			}
+
+			std::size_t Value = 0;
+			const auto [ EndPointer, ErrorCode ] = std::from_chars( Text.data(), Text.data() + Text.size(), Value );
+			if ( Text.empty() || ErrorCode != std::errc() || EndPointer != Text.data() + Text.size() || Value == 0 || Value > std::numeric_limits<std::size_t>::max() / Multiplier )
+				return std::nullopt;
+			return Value * Multiplier;
+		}
+
+		std::optional<std::vector<std::size_t>> ParseList( std::string_view Text, bool AllowByteSuffix )
+		{
+			std::vector<std::size_t> Values;
+			while ( !Text.empty() )
+			{
+				const std::size_t CommaPosition = Text.find( ',' );
+				const std::string_view Item = Text.substr( 0, CommaPosition );
+
+				std::optional<std::size_t> Value;
+				if ( AllowByteSuffix )
+					Value = ParseByteSize( Item );
+				else
+				{
+					std::size_t Number = 0;
+					const auto [ EndPointer, ErrorCode ] = std::from_chars( Item.data(), Item.data() + Item.size(), Number );
+					if ( !Item.empty() && ErrorCode == std::errc() && EndPointer == Item.data() + Item.size() && Number != 0 )
+						Value = Number;
+				}
+
+				if ( !Value.has_value() )
+					return std::nullopt;
+				Values.push_back( *Value );
+
+				if ( CommaPosition == std::string_view::npos )
+					break;
+				Text.remove_prefix( CommaPosition + 1 );
+			}
+
+			if ( Values.empty() )
+				return std::nullopt;
+			return Values;
+		}
+
+		std::optional<double> ParseNumber( std::string_view Text )
+		{
+			const std::string TextCopy( Text );
+			char* EndPointer = nullptr;
+			const double Value = std::strtod( TextCopy.c_str(), &EndPointer );
+			if ( TextCopy.empty() || EndPointer != TextCopy.c_str() + TextCopy.size() || !( Value >= 0.0 ) )
+				return std::nullopt;
+			return Value;
+		}
+
+		std::string EscapeJsonString( std::string_view Text )
+		{
+			std::string Escaped;
+			Escaped.reserve( Text.size() );
+			for ( char Character : Text )
+			{
+				if ( Character == '"' || Character == '\\' )
+					Escaped.push_back( '\\' );
+				Escaped.push_back( Character );
+			}
+			return Escaped;
+		}
+	}  // namespace
+
+	void BenchmarkRunner::RecordResult( const std::string& Name, std::size_t Bytes, std::size_t Threads, std::size_t Iterations, std::vector<double> Samples )
+	{
+		std::ranges::sort( Samples );
+
+		BenchmarkResult Result;
+		Result.Name = Name;
+		Result.Bytes = Bytes;
+		Result.Threads = Threads;
+		Result.IterationsPerSample = Iterations;
+		Result.SampleCount = Samples.size();
+		Result.MinimumNanoseconds = Samples.front();
+		Result.MedianNanoseconds = NearestRankPercentile( Samples, 0.50 );
+		Result.Percentile90Nanoseconds = NearestRankPercentile( Samples, 0.90 );
+		Result.Percentile99Nanoseconds = NearestRankPercentile( Samples, 0.99 );
+		Result.MeanNanoseconds = std::accumulate( Samples.begin(), Samples.end(), 0.0 ) / static_cast<double>( Samples.size() );
+
+		std::cout << std::left << std::setw( 48 ) << Result.Identifier() << std::right
+				  << " median " << std::setw( 14 ) << std::fixed << std::setprecision( 1 ) << Result.MedianNanoseconds << " ns"
+				  << "  p90 " << std::setw( 14 ) << Result.Percentile90Nanoseconds << " ns"
+				  << "  " << std::setw( 10 ) << std::setprecision( 3 ) << Result.MebibytesPerSecond() << " MiB/s"
+				  << "  (" << Result.SampleCount << " x " << Result.IterationsPerSample << ")" << std::endl;
+		std::cout.unsetf( std::ios::floatfield );
+
+		ResultVector.push_back( std::move( Result ) );
+	}
+
+	void BenchmarkRunner::WriteJson( std::ostream& OutputStream ) const
+	{
+		const auto& Features = BaseOperation::CurrentProcessorFeatures();
+
+		//没有打开优化时测出来的数字没有参考价值，所以把这一点写进结果里
+		//Numbers measured without optimization are meaningless, so this is recorded in the results
+		#if defined( __OPTIMIZE__ ) || defined( NDEBUG )
+		constexpr bool IsOptimizedBuild = true;
+		#else
+		constexpr bool IsOptimizedBuild = false;
+		#endif
+
+		OutputStream << std::setprecision( 17 );
+		OutputStream << "{\n";
+		OutputStream << "  \"schema\": \"opc_bench/1\",\n";
+		OutputStream << "  \"environment\": {\n";
+		OutputStream << "    \"optimized_build\": " << ( IsOptimizedBuild ? "true" : "false" ) << ",\n";
+		OutputStream << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+		OutputStream << "    \"avx2\": " << ( Features.AVX2 ? "true" : "false" ) << ",\n";
+		OutputStream << "    \"avx512bw\": " << ( Features.AVX512BW ? "true" : "false" ) << "\n";
+		OutputStream << "  },\n";
+		OutputStream << "  \"settings\": {\n";
+		OutputStream << "    \"warmup\": " << Options.WarmupCount << ",\n";
+		OutputStream << "    \"samples\": " << Options.SampleCount << ",\n";
+		OutputStream << "    \"minimum_sample_ns\": " << Options.MinimumSampleTime.count() << "\n";
+		OutputStream << "  },\n";
+		OutputStream << "  \"results\": [";
+		for ( std::size_t Index = 0; Index < ResultVector.size(); ++Index )
+		{
+			const BenchmarkResult& Result = ResultVector[ Index ];
+			OutputStream << ( Index == 0 ? "\n" : ",\n" );
+			OutputStream << "    {\n";
+			OutputStream << "      \"id\": \"" << EscapeJsonString( Result.Identifier() ) << "\",\n";
+			OutputStream << "      \"name\": \"" << EscapeJsonString( Result.Name ) << "\",\n";
+			OutputStream << "      \"bytes\": " << Result.Bytes << ",\n";
+			OutputStream << "      \"threads\": " << Result.Threads << ",\n";
+			OutputStream << "      \"iterations_per_sample\": " << Result.IterationsPerSample << ",\n";
+			OutputStream << "      \"samples\": " << Result.SampleCount << ",\n";
+			OutputStream << "      \"min_ns\": " << Result.MinimumNanoseconds << ",\n";
+			OutputStream << "      \"median_ns\": " << Result.MedianNanoseconds << ",\n";
+			OutputStream << "      \"p90_ns\": " << Result.Percentile90Nanoseconds << ",\n";
+			OutputStream << "      \"p99_ns\": " << Result.Percentile99Nanoseconds << ",\n";
+			OutputStream << "      \"mean_ns\": " << Result.MeanNanoseconds << ",\n";
+			OutputStream << "      \"mib_per_second\": " << Result.MebibytesPerSecond() << "\n";
+			OutputStream << "    }";
+		}
+		OutputStream << "\n  ]\n";
+		OutputStream << "}\n";
+	}
+
+	void PrintBenchmarkUsage( std::ostream& OutputStream )
+	{
+		OutputStream << "Usage: opc_bench [options]\n"
+					 << "  --filter <text>          Only run the cases whose name contains <text>\n"
+					 << "  --sizes <list>           End-to-end message sizes, e.g. 64,4K,1M,1G\n"
+					 << "  --max-size <size>        End-to-end message sizes 64, 256, 1K, ... up to <size>\n"
+					 << "  --threads <list>         Thread counts of the end-to-end cases, e.g. 1,2,4\n"
+					 << "  --warmup <count>         Warm-up samples per case (default 3)\n"
+					 << "  --samples <count>        Measured samples per case (default 15)\n"
+					 << "  --min-sample-ms <ms>     Minimum duration of one sample (default 2)\n"
+					 << "  --max-case-seconds <s>   Stop sampling a case after this long, keeping at least 3 samples (default 10)\n"
+					 << "  --output <path>          Where to write the JSON results (default opc_bench.json)\n"
+					 << "  --baseline <path>        Compare the medians with a previously written JSON file\n"
+					 << "  --tolerance <percent>    Slowdown over the baseline that counts as a regression (default 10)\n"
+					 << "Every thread of an end-to-end case holds its own copy of the message, its ciphertext and its decrypted text.\n"
+					 << "Exit status: 0 on success, 1 on invalid arguments or a failed self check, 2 when a regression was found.\n";
+	}
+
+	std::optional<BenchmarkOptions> ParseBenchmarkOptions( int ArgumentCount, char* Arguments[], std::ostream& ErrorStream )
+	{
+		BenchmarkOptions Options;
+
+		for ( int ArgumentIndex = 1; ArgumentIndex < ArgumentCount; ++ArgumentIndex )
+		{
+			const std::string_view Argument = Arguments[ ArgumentIndex ];
+			if ( ArgumentIndex + 1 >= ArgumentCount )
+			{
+				ErrorStream << "opc_bench: Missing value after " << Argument << std::endl;
+				return std::nullopt;
+			}
+			const std::string_view Value = Arguments[ ++ArgumentIndex ];
+
+			bool IsValidValue = true;
+			if ( Argument == "--filter" )
+				Options.Filter = Value;
+			else if ( Argument == "--sizes" )
+			{
+				auto Sizes = ParseList( Value, true );
+				IsValidValue = Sizes.has_value();
+				if ( IsValidValue )
+					Options.MessageSizes = std::move( *Sizes );
+			}
+			else if ( Argument == "--max-size" )
+			{
+				auto MaximumSize = ParseByteSize( Value );
+				IsValidValue = MaximumSize.has_value() && *MaximumSize >= 64;
+				if ( IsValidValue )
+				{
+					Options.MessageSizes.clear();
+					for ( std::size_t Size = 64; Size <= *MaximumSize; Size *= 4 )
+					{
+						Options.MessageSizes.push_back( Size );
+						if ( Size > std::numeric_limits<std::size_t>::max() / 4 )
+							break;
+					}
+				}
+			}
+			else if ( Argument == "--threads" )
+			{
+				auto Threads = ParseList( Value, false );
+				IsValidValue = Threads.has_value();
+				if ( IsValidValue )
+					Options.ThreadCounts = std::move( *Threads );
+			}
+			else if ( Argument == "--warmup" || Argument == "--samples" )
+			{
+				std::size_t Count = 0;
+				const auto [ EndPointer, ErrorCode ] = std::from_chars( Value.data(), Value.data() + Value.size(), Count );
+				IsValidValue = ErrorCode == std::errc() && EndPointer == Value.data() + Value.size() && ( Argument == "--warmup" || Count != 0 );
+				if ( IsValidValue )
+					( Argument == "--warmup" ? Options.WarmupCount : Options.SampleCount ) = Count;
+			}
+			else if ( Argument == "--min-sample-ms" || Argument == "--max-case-seconds" )
+			{
+				auto Number = ParseNumber( Value );
+				IsValidValue = Number.has_value();
+				if ( IsValidValue )
+				{
+					const double Nanoseconds = *Number * ( Argument == "--min-sample-ms" ? 1e6 : 1e9 );
+					( Argument == "--min-sample-ms" ? Options.MinimumSampleTime : Options.MaximumCaseTime ) = std::chrono::nanoseconds( static_cast<std::int64_t>( Nanoseconds ) );
+				}
+			}
+			else if ( Argument == "--output" )
+				Options.OutputPath = Value;
+			else if ( Argument == "--baseline" )
+				Options.BaselinePath = Value;
+			else if ( Argument == "--tolerance" )
+			{
+				auto Percent = ParseNumber( Value );
+				IsValidValue = Percent.has_value();
+				if ( IsValidValue )
+					Options.RegressionTolerance = *Percent / 100.0;
+			}
+			else
+			{
+				ErrorStream << "opc_bench: Unknown option " << Argument << std::endl;
+				PrintBenchmarkUsage( ErrorStream );
+				return std::nullopt;
+			}
+
+			if ( !IsValidValue )
+			{
+				ErrorStream << "opc_bench: Invalid value \"" << Value << "\" for " << Argument << std::endl;
+				return std::nullopt;
+			}
+		}
+
+		return Options;
+	}
+
+	std::optional<std::map<std::string, double>> LoadBaseline( const std::string& Path )
+	{
+		std::ifstream BaselineFile( Path, std::ios::binary );
+		if ( !BaselineFile )
+			return std::nullopt;
+
+		const std::string Text( ( std::istreambuf_iterator<char>( BaselineFile ) ), std::istreambuf_iterator<char>() );
+
+		//只需要读回 WriteJson 自己写出的格式: 每个结果里 "id" 在 "median_ns" 之前
+		//Only the format written by WriteJson itself needs to be read back: in every result "id" comes before "median_ns"
+		std::map<std::string, double> Baseline;
+		constexpr std::string_view IdentifierKey = "\"id\": \"";
+		constexpr std::string_view MedianKey = "\"median_ns\": ";
+		for ( std::size_t Position = Text.find( IdentifierKey ); Position != std::string::npos; Position = Text.find( IdentifierKey, Position ) )
+		{
+			const std::size_t IdentifierBegin = Position + IdentifierKey.size();
+			const std::size_t IdentifierEnd = Text.find( '"', IdentifierBegin );
+			const std::size_t MedianPosition = Text.find( MedianKey, IdentifierBegin );
+			if ( IdentifierEnd == std::string::npos || MedianPosition == std::string::npos )
+				break;
+
+			Baseline[ Text.substr( IdentifierBegin, IdentifierEnd - IdentifierBegin ) ] = std::strtod( Text.c_str() + MedianPosition + MedianKey.size(), nullptr );
+			Position = MedianPosition;
+		}
+
+		return Baseline;
+	}
+
+	std::size_t CompareWithBaseline( const std::vector<BenchmarkResult>& Results, const std::map<std::string, double>& Baseline, double RegressionTolerance, std::ostream& OutputStream )
+	{
+		std::size_t RegressionCount = 0;
+
+		OutputStream << "Comparison with the baseline (median, tolerance " << RegressionTolerance * 100.0 << "%):" << std::endl;
+		for ( const BenchmarkResult& Result : Results )
+		{
+			const auto BaselineIterator = Baseline.find( Result.Identifier() );
+			if ( BaselineIterator == Baseline.end() || BaselineIterator->second <= 0.0 )
+			{
+				OutputStream << "  " << Result.Identifier() << ": not in the baseline" << std::endl;
+				continue;
+			}
+
+			const double Ratio = Result.MedianNanoseconds / BaselineIterator->second;
+			const bool IsRegression = Ratio > 1.0 + RegressionTolerance;
+			RegressionCount += IsRegression ? 1 : 0;
+
+			OutputStream << "  " << Result.Identifier() << ": " << std::fixed << std::setprecision( 3 ) << Ratio << "x of baseline" << ( IsRegression ? "  <-- REGRESSION" : "" ) << std::endl;
+			OutputStream.unsetf( std::ios::floatfield );
+		}
+
+		return RegressionCount;
+	}
+}  // namespace TwilightDreamOfMagical::Benchmark_OaldresPuzzle_Cryptic
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * 本文件是 Algorithm_OaldresPuzzleCryptic 的一部分。
+ *
+ * Algorithm_OaldresPuzzleCryptic 是自由软件：你可以再分发之和/或依照由自由软件基金会发布的 GNU 通用公共许可证修改之，无论是版本 3 许可证，还是（按你的决定）任何以后版都可以。
+ *
+ * 发布 Algorithm_OaldresPuzzleCryptic 是希望它能有用，但是并无保障;甚至连可销售和符合某个特定的目的都不保证。请参看 GNU 通用公共许可证，了解详情。
+ * 你应该随程序获得一份 GNU 通用公共许可证的复本。如果没有，请看 <https://www.gnu.org/licenses/>。
+ */
+
+ /*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * This file is part of Algorithm_OaldresPuzzleCryptic.
+ *
+ * Algorithm_OaldresPuzzleCryptic is free software: you may redistribute it and/or modify it under the GNU General Public License as published by the Free Software Foundation, either under the Version 3 license, or (at your discretion) any later version.
+ *
+ * TDOM-EncryptOrDecryptFile-Reborn is released in the hope that it will be useful, but there are no guarantees; not even that it will be marketable and fit a particular purpose. Please see the GNU General Public License for details.
+ * You should get a copy of the GNU General Public License with your program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALGORITHM_OALDRESPUZZLECRYPTIC_OPC_BENCHMARK_HPP
+#define ALGORITHM_OALDRESPUZZLECRYPTIC_OPC_BENCHMARK_HPP
+
+#include <iostream>
+#include <chrono>
+
+#include "../SupportBaseFunctions.hpp" //C++ STL Wrapper and Custom Utils
+#include "../ProcessorFeatureDetection.hpp"
+
+/*
+	OaldresPuzzle-Cryptic 的基准测试工具 (opc_bench)
+	每个用例先校准每个样本的迭代次数 (使一个样本至少持续 MinimumSampleTime)，再预热，然后采集多个样本；
+	结果按每次操作的纳秒数给出最小值、中位数、P90、P99 和平均值，写成 JSON，并且可以和之前保存的 JSON (基线) 比较中位数。
+
+	Benchmark tool of OaldresPuzzle-Cryptic (opc_bench)
+	Every case first calibrates the iterations per sample (so that one sample lasts at least MinimumSampleTime), then warms up, then collects several samples;
+	the results give the minimum, median, P90, P99 and mean in nanoseconds per operation, are written as JSON, and their medians can be compared with a previously saved JSON (the baseline).
+*/
+
+namespace TwilightDreamOfMagical::Benchmark_OaldresPuzzle_Cryptic
+{
+	struct BenchmarkOptions
+	{
+		//只运行名字里包含这个子串的用例 (空表示全部)
+		//Only run the cases whose name contains this substring (empty means all)
+		std::string Filter;
+
+		//端到端用例的消息大小和线程数
+		//Message sizes and thread counts of the end-to-end cases
+		std::vector<std::size_t> MessageSizes { 64, 256, 1024, 4096, 16384 };
+		std::vector<std::size_t> ThreadCounts { 1 };
+
+		std::size_t WarmupCount = 3;
+		std::size_t SampleCount = 15;
+		std::chrono::nanoseconds MinimumSampleTime = std::chrono::milliseconds( 2 );
+
+		//一个用例已经用了这么长时间时，采集到最少的样本数就停止 (大消息用)
+		//Once a case has used this much time it stops as soon as it has the minimum number of samples (for large messages)
+		std::chrono::nanoseconds MaximumCaseTime = std::chrono::seconds( 10 );
+
+		std::string OutputPath = "opc_bench.json";
+		std::string BaselinePath;
+
+		//中位数比基线慢超过这个比例就算性能回退
+		//A median slower than the baseline by more than this fraction counts as a regression
+		double RegressionTolerance = 0.10;
+	};
+
+	struct BenchmarkResult
+	{
+		std::string Name;
+		std::size_t Bytes = 0;
+		std::size_t Threads = 1;
+		std::size_t IterationsPerSample = 0;
+		std::size_t SampleCount = 0;
+
+		//每次操作的纳秒数 (多线程用例是所有线程各完成一次操作的墙上时间)
+		//Nanoseconds per operation (for multi-threaded cases, the wall time until every thread has finished one operation)
+		double MinimumNanoseconds = 0.0;
+		double MedianNanoseconds = 0.0;
+		double Percentile90Nanoseconds = 0.0;
+		double Percentile99Nanoseconds = 0.0;
+		double MeanNanoseconds = 0.0;
+
+		//基线文件里用来匹配用例的键: 名字/字节数/线程数
+		//The key used to match cases in the baseline file: name/bytes/threads
+		std::string Identifier() const
+		{
+			return Name + "/" + std::to_string( Bytes ) + "/" + std::to_string( Threads );
+		}
+
+		double MebibytesPerSecond() const
+		{
+			if ( MedianNanoseconds <= 0.0 )
+				return 0.0;
+			return static_cast<double>( Bytes * Threads ) / ( MedianNanoseconds * 1e-9 ) / 1048576.0;
+		}
+	};
+
+	class BenchmarkRunner
+	{
+
+	public:
+		explicit BenchmarkRunner( const BenchmarkOptions& Options )
+			:
+			Options( Options )
+		{
+
+		}
+
+		bool IsSelected( std::string_view Name ) const
+		{
+			return Options.Filter.empty() || Name.find( Options.Filter ) != std::string_view::npos;
+		}
+
+		/*
+			运行一个用例: Operation( ThreadIndex ) 执行一次操作，多线程时每个线程用自己的 ThreadIndex (各自的上下文) 同时执行
+			Run one case: Operation( ThreadIndex ) executes one operation; with several threads every thread runs at the same time with its own ThreadIndex (its own context)
+		*/
+		template <typename OperationType>
+		void Run( const std::string& Name, std::size_t Bytes, std::size_t Threads, OperationType&& Operation )
+		{
+			if ( !IsSelected( Name ) )
+				return;
+
+			using Clock = std::chrono::steady_clock;
+
+			auto RunBatch = [ &Operation, Threads ]( std::size_t Iterations ) -> std::chrono::nanoseconds
+			{
+				const Clock::time_point StartTime = Clock::now();
+				if ( Threads <= 1 )
+				{
+					for ( std::size_t Iteration = 0; Iteration < Iterations; ++Iteration )
+						Operation( std::size_t( 0 ) );
+				}
+				else
+				{
+					std::vector<std::jthread> WorkerThreads;
+					WorkerThreads.reserve( Threads );
+					for ( std::size_t ThreadIndex = 0; ThreadIndex < Threads; ++ThreadIndex )
+					{
+						WorkerThreads.emplace_back
+						(
+							[ &Operation, Iterations, ThreadIndex ]()
+							{
+								for ( std::size_t Iteration = 0; Iteration < Iterations; ++Iteration )
+									Operation( ThreadIndex );
+							}
+						);
+					}
+					WorkerThreads.clear();
+				}
+				return std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - StartTime );
+			};
+
+			const Clock::time_point CaseStartTime = Clock::now();
+
+			//校准 (同时也是第一次预热): 每个样本的迭代次数加倍，直到一个样本至少持续 MinimumSampleTime
+			//Calibration (which is also the first warm-up): double the iterations per sample until one sample lasts at least MinimumSampleTime
+			std::size_t Iterations = 1;
+			while ( RunBatch( Iterations ) < Options.MinimumSampleTime && Iterations < MaximumIterationsPerSample )
+				Iterations *= 2;
+
+			for ( std::size_t WarmupIndex = 0; WarmupIndex < Options.WarmupCount && Clock::now() - CaseStartTime < Options.MaximumCaseTime / 4; ++WarmupIndex )
+				RunBatch( Iterations );
+
+			const std::size_t MinimumSampleCount = std::min<std::size_t>( 3, std::max<std::size_t>( Options.SampleCount, 1 ) );
+			std::vector<double> Samples;
+			Samples.reserve( Options.SampleCount );
+			while ( Samples.size() < std::max<std::size_t>( Options.SampleCount, 1 ) )
+			{
+				Samples.push_back( static_cast<double>( RunBatch( Iterations ).count() ) / static_cast<double>( Iterations ) );
+				if ( Samples.size() >= MinimumSampleCount && Clock::now() - CaseStartTime > Options.MaximumCaseTime )
+					break;
+			}
+
+			this->RecordResult( Name, Bytes, Threads, Iterations, std::move( Samples ) );
+		}
+
+		const std::vector<BenchmarkResult>& Results() const
+		{
+			return ResultVector;
+		}
+
+		void WriteJson( std::ostream& OutputStream ) const;
+
+	private:
+		static constexpr std::size_t MaximumIterationsPerSample = std::size_t( 1 ) << 30;
+
+		const BenchmarkOptions& Options;
+		std::vector<BenchmarkResult> ResultVector;
+
+		void RecordResult( const std::string& Name, std::size_t Bytes, std::size_t Threads, std::size_t Iterations, std::vector<double> Samples );
+	};
+
+	//解析命令行，出错时把原因写到 ErrorStream 并返回空
+	//Parse the command line; on error the reason is written to ErrorStream and nothing is returned
+	std::optional<BenchmarkOptions> ParseBenchmarkOptions( int ArgumentCount, char* Arguments[], std::ostream& ErrorStream );
+
+	void PrintBenchmarkUsage( std::ostream& OutputStream );
+
+	//读取之前用 WriteJson 保存的结果，得到 用例键 -> 中位数纳秒数
+	//Read results previously saved by WriteJson, giving case key -> median nanoseconds
+	std::optional<std::map<std::string, double>> LoadBaseline( const std::string& Path );
+
+	//逐个用例比较中位数并打印，返回性能回退的用例数量 (基线里没有的用例不参与比较)
+	//Compare the medians case by case and print them, returning the number of regressed cases (cases missing from the baseline are not compared)
+	std::size_t CompareWithBaseline( const std::vector<BenchmarkResult>& Results, const std::map<std::string, double>& Baseline, double RegressionTolerance, std::ostream& OutputStream );
+}  // namespace TwilightDreamOfMagical::Benchmark_OaldresPuzzle_Cryptic
+
+#endif	//ALGORITHM_OALDRESPUZZLECRYPTIC_OPC_BENCHMARK_HPP
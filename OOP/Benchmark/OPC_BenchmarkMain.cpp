@@ -0,0 +1,346 @@
+#include "OPC_Benchmark.hpp"
+
+#include "../BlockCipher/OPC_MainAlgorithm_Worker.hpp"
+#include "../BlockCipher/OPC_SegmentedWorker.hpp"
+#include "../BlockCipher/Includes/KeyDerivationFunction/Scrypt.hpp"
+#include "../BlockCipher/Includes/SecureHashProvider/SHA2_512.hpp"
+
+namespace TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher
+{
+	/*
+		给基准测试单独调用算法内部阶段的入口 (各个类把它声明为友元)，使用常用配置 (16, 32)，构造时先生成一次子密钥和轮子密钥
+		Entry point for the benchmark to call the internal stages of the algorithm on their own (the classes declare it as a friend); it uses the common configuration (16, 32) and generates the subkeys and round subkeys once at construction
+	*/
+	class OPC_BenchmarkProbe
+	{
+
+	public:
+		OPC_BenchmarkProbe( const std::vector<std::uint8_t>& InitialVector, std::span<const std::uint64_t> MasterKeyWords )
+			:
+			StateData( 16, 32, InitialVector, 1, 1, 0xB7E151628AED2A6AULL ),
+			AlgorithmCore( StateData )
+		{
+			this->GenerationSubkeys( MasterKeyWords );
+			this->GenerationRoundSubkeys();
+		}
+
+		std::size_t DataBlockByteSize() const
+		{
+			return StateData.OPC_QuadWord_DataBlockSize * sizeof( std::uint64_t );
+		}
+
+		std::size_t KeyBlockByteSize() const
+		{
+			return StateData.OPC_QuadWord_KeyBlockSize * sizeof( std::uint64_t );
+		}
+
+		std::size_t KeyMatrixByteSize() const
+		{
+			return StateData.OPC_KeyMatrix_Rows * StateData.OPC_KeyMatrix_Columns * sizeof( std::uint64_t );
+		}
+
+		void ByteSubstitution( std::span<std::uint64_t> EachRoundDatas, CryptionMode2MCAC4_FDW ThisExecuteMode )
+		{
+			AlgorithmCore.QuadWordByteSubstitution( EachRoundDatas, ThisExecuteMode );
+		}
+
+		//一遍 Lai-Massey 结构，使用轮子密钥的第一段
+		//One pass of the Lai-Massey structure, using the first segment of the round subkeys
+		void LaiMasseyFramework( std::span<std::uint64_t> EachRoundDatas, CryptionMode2MCAC4_FDW ThisExecuteMode )
+		{
+			const auto& RoundSubkeys = AlgorithmCore.SecureRoundSubkeyGeneratationModuleObject.GeneratedRoundSubkeyVector;
+			AlgorithmCore.LaiMasseyFrameworkBatch( EachRoundDatas, std::span<const std::uint64_t>( RoundSubkeys.data(), EachRoundDatas.size() ), ThisExecuteMode );
+		}
+
+		void RoundFunction( std::span<std::uint64_t> EachRoundDatas, CryptionMode2MCAC4_FDW ThisExecuteMode )
+		{
+			AlgorithmCore.RoundFunction( EachRoundDatas, ThisExecuteMode );
+		}
+
+		std::uint32_t CrazyTransformAssociatedWord( std::uint32_t AssociatedWordData, std::uint64_t WordKeyMaterial )
+		{
+			return AlgorithmCore.SecureRoundSubkeyGeneratationModuleObject.CrazyTransformAssociatedWord( AssociatedWordData, WordKeyMaterial );
+		}
+
+		void GenerationSubkeys( std::span<const std::uint64_t> MasterKeyWords )
+		{
+			AlgorithmCore.SecureSubkeyGeneratationModuleObject.GenerationSubkeys( MasterKeyWords );
+		}
+
+		void UpdateState()
+		{
+			AlgorithmCore.SecureSubkeyGeneratationModuleObject.SubkeyMatrixOperationObject.UpdateState();
+		}
+
+		void MatrixTransformation()
+		{
+			AlgorithmCore.SecureRoundSubkeyGeneratationModuleObject.OPC_MatrixTransformation();
+		}
+
+		void GenerationRoundSubkeys()
+		{
+			AlgorithmCore.SecureRoundSubkeyGeneratationModuleObject.GenerationRoundSubkeys();
+		}
+
+	private:
+		ImplementationDetails::CommonStateData StateData;
+		OaldresPuzzle_Cryptic AlgorithmCore;
+	};
+}  // namespace TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher
+
+namespace TwilightDreamOfMagical::Benchmark_OaldresPuzzle_Cryptic
+{
+	namespace
+	{
+		using TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW;
+		using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OaldresPuzzle_Cryptic;
+		using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_MainAlgorithm_Worker;
+		using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_BenchmarkProbe;
+		using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_SegmentedWorker;
+		using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::ImplementationDetails::CommonStateData;
+
+		//每个线程自己的完整上下文；每次操作之前恢复到同一个初始状态，所以每个样本做的是同样的工作
+		//A complete context owned by one thread; it is restored to the same initial state before every operation, so every sample does the same work
+		struct EndToEndContext
+		{
+			CommonStateData StateData;
+			OaldresPuzzle_Cryptic AlgorithmCore;
+			OPC_MainAlgorithm_Worker Worker;
+			const OaldresPuzzle_Cryptic::StateSnapshot InitialState;
+
+			const std::vector<std::uint8_t>& PlainText;
+			std::vector<std::uint8_t> CipherText;
+			std::vector<std::uint8_t> ProcessedText;
+
+			EndToEndContext( const std::vector<std::uint8_t>& InitialVector, const std::vector<std::uint8_t>& PlainText )
+				:
+				StateData( 16, 32, InitialVector, 1, 1, 0xB7E151628AED2A6AULL ),
+				AlgorithmCore( StateData ),
+				Worker( AlgorithmCore, false ),
+				InitialState( AlgorithmCore.TakeSnapshot() ),
+				PlainText( PlainText )
+			{
+
+			}
+
+			void Encrypt( const std::vector<std::uint8_t>& Keys )
+			{
+				AlgorithmCore.RestoreSnapshot( InitialState );
+				CipherText = Worker.EncrypterMain( PlainText, Keys );
+			}
+
+			void Decrypt( const std::vector<std::uint8_t>& Keys )
+			{
+				AlgorithmCore.RestoreSnapshot( InitialState );
+				ProcessedText = Worker.DecrypterMain( CipherText, Keys );
+			}
+		};
+
+		std::vector<std::uint8_t> GenerateBytes( std::mt19937_64& PRNG, std::size_t ByteSize )
+		{
+			std::vector<std::uint8_t> Bytes( ByteSize );
+			for ( auto& Byte : Bytes )
+				Byte = static_cast<std::uint8_t>( PRNG() );
+			return Bytes;
+		}
+
+		void RunStageBenchmarks( BenchmarkRunner& Runner, const std::vector<std::uint8_t>& InitialVector, std::mt19937_64& PRNG )
+		{
+			std::vector<std::uint64_t> MasterKeyWords( 32 );
+			std::ranges::generate( MasterKeyWords, PRNG );
+
+			OPC_BenchmarkProbe Probe( InitialVector, MasterKeyWords );
+
+			std::array<std::uint64_t, 16> DataBlock {};
+			std::ranges::generate( DataBlock, PRNG );
+
+			Runner.Run( "ByteSubstitution", Probe.DataBlockByteSize(), 1, [ & ]( std::size_t ) { Probe.ByteSubstitution( DataBlock, CryptionMode2MCAC4_FDW::MCA_ENCRYPTER ); } );
+			Runner.Run( "LaiMasseyFramework", Probe.DataBlockByteSize(), 1, [ & ]( std::size_t ) { Probe.LaiMasseyFramework( DataBlock, CryptionMode2MCAC4_FDW::MCA_ENCRYPTER ); } );
+			Runner.Run( "RoundFunction", Probe.DataBlockByteSize(), 1, [ & ]( std::size_t ) { Probe.RoundFunction( DataBlock, CryptionMode2MCAC4_FDW::MCA_ENCRYPTER ); } );
+
+			//每次的输出作为下一次的输入，这样调用不会被优化掉，测到的是延迟
+			//Each output is the next input, so the calls cannot be optimized away and the latency is measured
+			std::uint32_t AssociatedWord = 0x9E3779B9U;
+			Runner.Run
+			(
+				"CrazyTransformAssociatedWord", sizeof( std::uint32_t ), 1,
+				[ & ]( std::size_t ) { AssociatedWord = Probe.CrazyTransformAssociatedWord( AssociatedWord, DataBlock[ AssociatedWord % DataBlock.size() ] ); }
+			);
+			volatile std::uint32_t AssociatedWordSink = AssociatedWord;
+			static_cast<void>( AssociatedWordSink );
+
+			Runner.Run( "GenerationSubkeys", Probe.KeyBlockByteSize(), 1, [ & ]( std::size_t ) { Probe.GenerationSubkeys( MasterKeyWords ); } );
+			Runner.Run( "UpdateState", Probe.KeyMatrixByteSize(), 1, [ & ]( std::size_t ) { Probe.UpdateState(); } );
+			Runner.Run( "OPC_MatrixTransformation", Probe.KeyMatrixByteSize(), 1, [ & ]( std::size_t ) { Probe.MatrixTransformation(); } );
+			Runner.Run( "GenerationRoundSubkeys", Probe.KeyMatrixByteSize(), 1, [ & ]( std::size_t ) { Probe.GenerationRoundSubkeys(); } );
+		}
+
+		void RunPrimitiveBenchmarks( BenchmarkRunner& Runner, const BenchmarkOptions& Options, std::mt19937_64& PRNG )
+		{
+			//与周期性重新派生密钥相同的参数 (N = 1024, r = 8, p = 16)，输出一个密钥块
+			//The same parameters as the periodic rekey (N = 1024, r = 8, p = 16), producing one key block
+			if ( Runner.IsSelected( "Scrypt::GenerateKeys" ) )
+			{
+				using TwilightDreamOfMagical::CommonSecurity::KeyDerivationFunction::Scrypt;
+
+				std::vector<std::uint8_t> SecretBytes = GenerateBytes( PRNG, 256 );
+				std::vector<std::uint8_t> SaltBytes = GenerateBytes( PRNG, 128 );
+				Scrypt KDF_Object;
+				Runner.Run
+				(
+					"Scrypt::GenerateKeys", SecretBytes.size(), 1,
+					[ & ]( std::size_t ) { std::vector<std::uint8_t> GeneratedKeys = KDF_Object.GenerateKeys( SecretBytes, SaltBytes, SecretBytes.size(), 1024, 8, 16 ); }
+				);
+			}
+
+			if ( Runner.IsSelected( "SHA2_512::Hash" ) )
+			{
+				using TwilightDreamOfMagical::CommonSecurity::SHA::SHA2_512;
+
+				SHA2_512 HashObject;
+				std::array<std::uint8_t, 64> HashedMessage {};
+				for ( std::size_t MessageSize : Options.MessageSizes )
+				{
+					std::vector<std::uint8_t> Message = GenerateBytes( PRNG, MessageSize );
+					Runner.Run( "SHA2_512::Hash", MessageSize, 1, [ & ]( std::size_t ) { HashObject.Hash( Message, HashedMessage ); } );
+				}
+			}
+		}
+
+		//返回自检是否通过 (每个上下文的解密结果都必须等于明文)
+		//Returns whether the self check passed (the decryption of every context must equal the plaintext)
+		bool RunEndToEndBenchmarks( BenchmarkRunner& Runner, const BenchmarkOptions& Options, const std::vector<std::uint8_t>& InitialVector, std::mt19937_64& PRNG )
+		{
+			if ( !Runner.IsSelected( "EncrypterMain" ) && !Runner.IsSelected( "DecrypterMain" ) )
+				return true;
+
+			const std::vector<std::uint8_t> Keys = GenerateBytes( PRNG, 5120 );
+			bool IsSelfCheckPassed = true;
+
+			for ( std::size_t MessageSize : Options.MessageSizes )
+			{
+				const std::vector<std::uint8_t> PlainText = GenerateBytes( PRNG, MessageSize );
+
+				for ( std::size_t Threads : Options.ThreadCounts )
+				{
+					std::vector<std::unique_ptr<EndToEndContext>> Contexts;
+					for ( std::size_t ThreadIndex = 0; ThreadIndex < Threads; ++ThreadIndex )
+					{
+						Contexts.push_back( std::make_unique<EndToEndContext>( InitialVector, PlainText ) );
+
+						EndToEndContext& Context = *Contexts.back();
+						Context.Encrypt( Keys );
+						Context.Decrypt( Keys );
+						if ( Context.ProcessedText != PlainText )
+						{
+							std::cout << "Oh, no!\nThe self check of " << MessageSize << " bytes failed, the decrypted data is incorrect." << std::endl;
+							IsSelfCheckPassed = false;
+						}
+					}
+
+					Runner.Run( "EncrypterMain", MessageSize, Threads, [ & ]( std::size_t ThreadIndex ) { Contexts[ ThreadIndex ]->Encrypt( Keys ); } );
+					Runner.Run( "DecrypterMain", MessageSize, Threads, [ & ]( std::size_t ThreadIndex ) { Contexts[ ThreadIndex ]->Decrypt( Keys ); } );
+				}
+			}
+
+			return IsSelfCheckPassed;
+		}
+
+		/*
+			分段并行模式: 每条消息切成 4 段，在共享线程池上加密 (线程数由线程池决定，记录为 1)。
+			和同样大小的 EncrypterMain 比较就能看到各段状态派生的开销和多核上的扩展效果。
+
+			Segmented parallel mode: every message is cut into 4 segments and encrypted on the shared thread pool (the thread count is decided by the pool, recorded as 1).
+			Comparing it with EncrypterMain of the same size shows the cost of deriving the segment states and the scaling on several cores.
+		*/
+		bool RunSegmentedBenchmarks( BenchmarkRunner& Runner, const BenchmarkOptions& Options, const std::vector<std::uint8_t>& InitialVector, std::mt19937_64& PRNG )
+		{
+			if ( !Runner.IsSelected( "SegmentedEncrypterMain" ) )
+				return true;
+
+			constexpr std::size_t DataBlockByteSize = 16 * sizeof( std::uint64_t );
+
+			std::cout << "SegmentedEncrypterMain runs on " << CommonToolkit::WorkStealingThreadPool::Shared().WorkerThreadCount() + 1 << " executor(s) of the shared thread pool." << std::endl;
+
+			const std::vector<std::uint8_t> Keys = GenerateBytes( PRNG, 5120 );
+			bool IsSelfCheckPassed = true;
+
+			for ( std::size_t MessageSize : Options.MessageSizes )
+			{
+				const std::vector<std::uint8_t> PlainText = GenerateBytes( PRNG, MessageSize );
+				const std::size_t SegmentByteSize = std::max( DataBlockByteSize, MessageSize / 4 / DataBlockByteSize * DataBlockByteSize );
+
+				OPC_SegmentedWorker SegmentedWorker( 16, 32, InitialVector, 1, 1, 0xB7E151628AED2A6AULL, SegmentByteSize );
+				std::vector<std::uint8_t> CipherText = SegmentedWorker.EncrypterMain( PlainText, Keys );
+				if ( SegmentedWorker.DecrypterMain( CipherText, Keys ) != PlainText )
+				{
+					std::cout << "Oh, no!\nThe self check of the segmented mode with " << MessageSize << " bytes failed, the decrypted data is incorrect." << std::endl;
+					IsSelfCheckPassed = false;
+				}
+
+				Runner.Run( "SegmentedEncrypterMain", MessageSize, 1, [ & ]( std::size_t ) { CipherText = SegmentedWorker.EncrypterMain( PlainText, Keys ); } );
+			}
+
+			return IsSelfCheckPassed;
+		}
+	}  // namespace
+}  // namespace TwilightDreamOfMagical::Benchmark_OaldresPuzzle_Cryptic
+
+int main( int ArgumentCount, char* Arguments[] )
+{
+	using namespace TwilightDreamOfMagical::Benchmark_OaldresPuzzle_Cryptic;
+
+	for ( int ArgumentIndex = 1; ArgumentIndex < ArgumentCount; ++ArgumentIndex )
+	{
+		const std::string_view Argument = Arguments[ ArgumentIndex ];
+		if ( Argument == "--help" || Argument == "-h" )
+		{
+			PrintBenchmarkUsage( std::cout );
+			return 0;
+		}
+	}
+
+	const std::optional<BenchmarkOptions> ParsedOptions = ParseBenchmarkOptions( ArgumentCount, Arguments, std::cerr );
+	if ( !ParsedOptions.has_value() )
+		return 1;
+	const BenchmarkOptions& Options = *ParsedOptions;
+
+	#if !defined( __OPTIMIZE__ ) && !defined( NDEBUG )
+	std::cout << "Warning: opc_bench was built without optimization, the numbers below are not representative." << std::endl;
+	#endif
+
+	//固定的种子和初始向量，使每次运行处理相同的数据
+	//Fixed seed and initial vector, so every run processes the same data
+	std::mt19937_64 PRNG( 1 );
+	const std::vector<std::uint8_t> InitialVector( 8192, 0x00 );
+
+	BenchmarkRunner Runner( Options );
+	RunStageBenchmarks( Runner, InitialVector, PRNG );
+	RunPrimitiveBenchmarks( Runner, Options, PRNG );
+	bool IsSelfCheckPassed = RunEndToEndBenchmarks( Runner, Options, InitialVector, PRNG );
+	IsSelfCheckPassed = RunSegmentedBenchmarks( Runner, Options, InitialVector, PRNG ) && IsSelfCheckPassed;
+
+	std::ofstream OutputFile( Options.OutputPath, std::ios::binary | std::ios::trunc );
+	Runner.WriteJson( OutputFile );
+	if ( !OutputFile )
+	{
+		std::cerr << "opc_bench: Cannot write the results to " << Options.OutputPath << std::endl;
+		return 1;
+	}
+	std::cout << "Results written to " << Options.OutputPath << std::endl;
+
+	if ( !Options.BaselinePath.empty() )
+	{
+		const auto Baseline = LoadBaseline( Options.BaselinePath );
+		if ( !Baseline.has_value() )
+		{
+			std::cerr << "opc_bench: Cannot read the baseline " << Options.BaselinePath << std::endl;
+			return 1;
+		}
+
+		if ( CompareWithBaseline( Runner.Results(), *Baseline, Options.RegressionTolerance, std::cout ) != 0 )
+			return 2;
+	}
+
+	return IsSelfCheckPassed ? 0 : 1;
+}
@@ -0,0 +1,277 @@
+#include "ByteSubstitutionKernel.hpp"
+
+namespace TwilightDreamOfMagical::CustomSecurity
+{
+	//SymmetricEncryptionDecryption
+	namespace SED::BlockCipher
+	{
+		namespace ImplementationDetails::ByteSubstitutionKernel
+		{
+			namespace
+			{
+				constexpr std::size_t GroupBytes = 8;
+
+				void SubstituteGroupsScalar( std::uint8_t* Datas, std::size_t ByteCount, const std::array<SubstitutionBox, GroupBytes>& LaneBoxes )
+				{
+					for ( std::size_t Index = 0; Index < ByteCount; Index += GroupBytes )
+					{
+						for ( std::size_t Lane = 0; Lane < GroupBytes; ++Lane )
+							Datas[ Index + Lane ] = LaneBoxes[ Lane ][ Datas[ Index + Lane ] ];
+					}
+				}
+
+				#if defined( TDOM_PROCESSOR_X86 )
+
+				/*
+					AVX2: 一个块是 128 字节 (16 组，每组 8 个通道)。
+					先把块转置成 "通道主序"，让每个 128 位的半个 YMM 寄存器只包含同一个通道的 16 个字节，这样每半个寄存器只需要一个置换盒。
+					vpshufb 的表是按 128 位通道独立的，所以一个 YMM 寄存器可以同时查两个不同的置换盒。
+					AVX2: One block is 128 bytes (16 groups of 8 lanes).
+					The block is first transposed into "lane-major" order so that every 128-bit half of a YMM register only holds the 16 bytes of one lane, so each half needs only one substitution box.
+					The vpshufb table is independent per 128-bit lane, so one YMM register can look up two different substitution boxes at once.
+				*/
+				constexpr std::size_t BlockBytesAVX2 = 128;
+
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				TDOM_ALWAYS_INLINE void TransposeToLaneMajor( __m256i& Row0, __m256i& Row1, __m256i& Row2, __m256i& Row3 )
+				{
+					//每半个寄存器 (2 组) 变成 8 个 16 位字，第 j 个字是两组的第 j 个通道
+					//Each half register (2 groups) becomes 8 16-bit words, word j holds lane j of both groups
+					const __m256i InterleaveGroups = _mm256_setr_epi8
+					(
+						0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15,
+						0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15
+					);
+					Row0 = _mm256_shuffle_epi8( Row0, InterleaveGroups );
+					Row1 = _mm256_shuffle_epi8( Row1, InterleaveGroups );
+					Row2 = _mm256_shuffle_epi8( Row2, InterleaveGroups );
+					Row3 = _mm256_shuffle_epi8( Row3, InterleaveGroups );
+
+					//第 j 个 32 位字是 Row0/Row1 的第 j 个通道 (通道 0-3 与 4-7)
+					//Dword j holds lane j of Row0/Row1 (lanes 0-3 and 4-7)
+					const __m256i Lanes0To3Of01 = _mm256_unpacklo_epi16( Row0, Row1 );
+					const __m256i Lanes4To7Of01 = _mm256_unpackhi_epi16( Row0, Row1 );
+					const __m256i Lanes0To3Of23 = _mm256_unpacklo_epi16( Row2, Row3 );
+					const __m256i Lanes4To7Of23 = _mm256_unpackhi_epi16( Row2, Row3 );
+
+					//第 j 个 64 位字是 4 行的第 j 个通道
+					//Qword j holds lane j of all 4 rows
+					const __m256i Lanes01 = _mm256_unpacklo_epi32( Lanes0To3Of01, Lanes0To3Of23 );
+					const __m256i Lanes23 = _mm256_unpackhi_epi32( Lanes0To3Of01, Lanes0To3Of23 );
+					const __m256i Lanes45 = _mm256_unpacklo_epi32( Lanes4To7Of01, Lanes4To7Of23 );
+					const __m256i Lanes67 = _mm256_unpackhi_epi32( Lanes4To7Of01, Lanes4To7Of23 );
+
+					//低半个寄存器放通道 2p，高半个寄存器放通道 2p+1
+					//The low half register holds lane 2p, the high half register holds lane 2p+1
+					Row0 = _mm256_permute4x64_epi64( Lanes01, 0xD8 );
+					Row1 = _mm256_permute4x64_epi64( Lanes23, 0xD8 );
+					Row2 = _mm256_permute4x64_epi64( Lanes45, 0xD8 );
+					Row3 = _mm256_permute4x64_epi64( Lanes67, 0xD8 );
+				}
+
+				//TransposeToLaneMajor 的逆变换，每一步按相反的顺序撤销
+				//Inverse of TransposeToLaneMajor, undoing every step in reverse order
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				TDOM_ALWAYS_INLINE void TransposeToGroupMajor( __m256i& Row0, __m256i& Row1, __m256i& Row2, __m256i& Row3 )
+				{
+					const __m256i Lanes01 = _mm256_shuffle_epi32( _mm256_permute4x64_epi64( Row0, 0xD8 ), 0xD8 );
+					const __m256i Lanes23 = _mm256_shuffle_epi32( _mm256_permute4x64_epi64( Row1, 0xD8 ), 0xD8 );
+					const __m256i Lanes45 = _mm256_shuffle_epi32( _mm256_permute4x64_epi64( Row2, 0xD8 ), 0xD8 );
+					const __m256i Lanes67 = _mm256_shuffle_epi32( _mm256_permute4x64_epi64( Row3, 0xD8 ), 0xD8 );
+
+					const __m256i SplitWordPairs = _mm256_setr_epi8
+					(
+						0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15,
+						0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15
+					);
+					const __m256i Lanes0To3Of01 = _mm256_shuffle_epi8( _mm256_unpacklo_epi64( Lanes01, Lanes23 ), SplitWordPairs );
+					const __m256i Lanes0To3Of23 = _mm256_shuffle_epi8( _mm256_unpackhi_epi64( Lanes01, Lanes23 ), SplitWordPairs );
+					const __m256i Lanes4To7Of01 = _mm256_shuffle_epi8( _mm256_unpacklo_epi64( Lanes45, Lanes67 ), SplitWordPairs );
+					const __m256i Lanes4To7Of23 = _mm256_shuffle_epi8( _mm256_unpackhi_epi64( Lanes45, Lanes67 ), SplitWordPairs );
+
+					const __m256i DeinterleaveGroups = _mm256_setr_epi8
+					(
+						0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+						0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15
+					);
+					Row0 = _mm256_shuffle_epi8( _mm256_unpacklo_epi64( Lanes0To3Of01, Lanes4To7Of01 ), DeinterleaveGroups );
+					Row1 = _mm256_shuffle_epi8( _mm256_unpackhi_epi64( Lanes0To3Of01, Lanes4To7Of01 ), DeinterleaveGroups );
+					Row2 = _mm256_shuffle_epi8( _mm256_unpacklo_epi64( Lanes0To3Of23, Lanes4To7Of23 ), DeinterleaveGroups );
+					Row3 = _mm256_shuffle_epi8( _mm256_unpackhi_epi64( Lanes0To3Of23, Lanes4To7Of23 ), DeinterleaveGroups );
+				}
+
+				/*
+					256 项的查表被拆成 16 个 16 项的子表: 每个子表都用 vpshufb 查低半字节，再用高半字节的相等掩码只保留正确的那一个。
+					The 256-entry lookup is split into 16 sub-tables of 16 entries: every sub-table is looked up by the low nibble with vpshufb, and an equality mask on the high nibble keeps only the correct one.
+				*/
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				TDOM_ALWAYS_INLINE __m256i SubstituteNibbleSplit( __m256i Data, const __m256i* SubTables )
+				{
+					const __m256i NibbleMask = _mm256_set1_epi8( 0x0F );
+					const __m256i LowNibbles = _mm256_and_si256( Data, NibbleMask );
+					const __m256i HighNibbles = _mm256_and_si256( _mm256_srli_epi16( Data, 4 ), NibbleMask );
+
+					__m256i Result = _mm256_setzero_si256();
+					__m256i SubTableIndex = _mm256_setzero_si256();
+					const __m256i One = _mm256_set1_epi8( 1 );
+
+					for ( std::size_t HighNibble = 0; HighNibble < 16; ++HighNibble )
+					{
+						const __m256i Selected = _mm256_cmpeq_epi8( HighNibbles, SubTableIndex );
+						const __m256i Looked = _mm256_shuffle_epi8( _mm256_load_si256( SubTables + HighNibble ), LowNibbles );
+						Result = _mm256_or_si256( Result, _mm256_and_si256( Looked, Selected ) );
+						SubTableIndex = _mm256_add_epi8( SubTableIndex, One );
+					}
+
+					return Result;
+				}
+
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				void SubstituteBlocksAVX2( std::uint8_t* Datas, std::size_t BlockCount, const std::uint8_t* NibbleSubTables )
+				{
+					const __m256i* SubTables = reinterpret_cast<const __m256i*>( NibbleSubTables );
+
+					for ( std::size_t Block = 0; Block < BlockCount; ++Block )
+					{
+						__m256i* BlockPointer = reinterpret_cast<__m256i*>( Datas + Block * BlockBytesAVX2 );
+						__m256i Row0 = _mm256_loadu_si256( BlockPointer );
+						__m256i Row1 = _mm256_loadu_si256( BlockPointer + 1 );
+						__m256i Row2 = _mm256_loadu_si256( BlockPointer + 2 );
+						__m256i Row3 = _mm256_loadu_si256( BlockPointer + 3 );
+
+						TransposeToLaneMajor( Row0, Row1, Row2, Row3 );
+						Row0 = SubstituteNibbleSplit( Row0, SubTables );
+						Row1 = SubstituteNibbleSplit( Row1, SubTables + 16 );
+						Row2 = SubstituteNibbleSplit( Row2, SubTables + 32 );
+						Row3 = SubstituteNibbleSplit( Row3, SubTables + 48 );
+						TransposeToGroupMajor( Row0, Row1, Row2, Row3 );
+
+						_mm256_storeu_si256( BlockPointer, Row0 );
+						_mm256_storeu_si256( BlockPointer + 1, Row1 );
+						_mm256_storeu_si256( BlockPointer + 2, Row2 );
+						_mm256_storeu_si256( BlockPointer + 3, Row3 );
+					}
+				}
+
+				/*
+					AVX-512VBMI: 每个不同的置换盒占 4 个 ZMM 寄存器 (256 字节)，vpermi2b 用索引的低 7 位在 128 字节里查表，第 7 位选择上半或下半张表。
+					然后用固定的通道掩码把每个置换盒的结果合并到它负责的通道上。
+					AVX-512VBMI: Each distinct substitution box occupies 4 ZMM registers (256 bytes); vpermi2b looks up 128 bytes with the low 7 bits of the index, and bit 7 selects the lower or upper half of the table.
+					The result of each substitution box is then merged into the lanes it is responsible for with a fixed lane mask.
+				*/
+				constexpr std::size_t VectorBytesAVX512 = 64;
+
+				TDOM_TARGET_ATTRIBUTE( "avx512f,avx512bw,avx512vbmi" )
+				void SubstituteBytesAVX512VBMI( std::uint8_t* Datas, std::size_t ByteCount, const SubstitutionBox* DistinctBoxes, const std::uint64_t* DistinctBoxByteMasks, std::size_t DistinctBoxCount )
+				{
+					for ( std::size_t Offset = 0; Offset < ByteCount; Offset += VectorBytesAVX512 )
+					{
+						//最后不满 64 字节的部分用掩码加载和存储 (ByteCount 是 8 的倍数，所以通道对齐不变)
+						//The final partial vector uses masked loads and stores (ByteCount is a multiple of 8, so the lane alignment is unchanged)
+						const std::size_t RemainingBytes = ByteCount - Offset;
+						const __mmask64 ActiveBytes = RemainingBytes >= VectorBytesAVX512 ? _cvtu64_mask64( ~0ULL ) : _cvtu64_mask64( ( 1ULL << RemainingBytes ) - 1 );
+
+						const __m512i Data = _mm512_maskz_loadu_epi8( ActiveBytes, Datas + Offset );
+						const __mmask64 UpperHalf = _mm512_movepi8_mask( Data );
+						__m512i Result = _mm512_setzero_si512();
+
+						for ( std::size_t BoxIndex = 0; BoxIndex < DistinctBoxCount; ++BoxIndex )
+						{
+							const std::uint8_t* Box = DistinctBoxes[ BoxIndex ].data();
+							const __m512i LowerLooked = _mm512_permutex2var_epi8( _mm512_load_si512( Box ), Data, _mm512_load_si512( Box + 64 ) );
+							const __m512i UpperLooked = _mm512_permutex2var_epi8( _mm512_load_si512( Box + 128 ), Data, _mm512_load_si512( Box + 192 ) );
+							const __m512i Looked = _mm512_mask_blend_epi8( UpperHalf, LowerLooked, UpperLooked );
+							Result = _mm512_mask_blend_epi8( _cvtu64_mask64( DistinctBoxByteMasks[ BoxIndex ] ), Result, Looked );
+						}
+
+						_mm512_mask_storeu_epi8( Datas + Offset, ActiveBytes, Result );
+					}
+				}
+
+				#endif
+			}  // namespace
+
+			KernelKind SelectKernel()
+			{
+				static const KernelKind Selected = []()
+				{
+					const auto& Features = BaseOperation::CurrentProcessorFeatures();
+
+					if ( Features.AVX512F && Features.AVX512BW && Features.AVX512VBMI )
+						return KernelKind::AVX512VBMI;
+					if ( Features.AVX2 )
+						return KernelKind::AVX2;
+					return KernelKind::Scalar;
+				}();
+
+				return Selected;
+			}
+
+			SubstitutionLayer::SubstitutionLayer( const LaneSubstitutionBoxes& LaneBoxes )
+			{
+				for ( std::size_t Lane = 0; Lane < GroupBytes; ++Lane )
+				{
+					my_cpp2020_assert( LaneBoxes[ Lane ] != nullptr, "ByteSubstitutionKernel: The substitution box of a lane is null!", std::source_location::current() );
+					this->LaneBoxes[ Lane ] = *LaneBoxes[ Lane ];
+				}
+
+				for ( std::size_t Pair = 0; Pair < GroupBytes / 2; ++Pair )
+				{
+					for ( std::size_t HighNibble = 0; HighNibble < 16; ++HighNibble )
+					{
+						auto& Row = NibbleSubTables[ Pair * 16 + HighNibble ];
+						std::copy_n( this->LaneBoxes[ Pair * 2 ].begin() + HighNibble * 16, 16, Row.begin() );
+						std::copy_n( this->LaneBoxes[ Pair * 2 + 1 ].begin() + HighNibble * 16, 16, Row.begin() + 16 );
+					}
+				}
+
+				for ( std::size_t Lane = 0; Lane < GroupBytes; ++Lane )
+				{
+					std::size_t BoxIndex = 0;
+					while ( BoxIndex < DistinctBoxCount && DistinctBoxes[ BoxIndex ] != this->LaneBoxes[ Lane ] )
+						++BoxIndex;
+
+					if ( BoxIndex == DistinctBoxCount )
+					{
+						DistinctBoxes[ BoxIndex ] = this->LaneBoxes[ Lane ];
+						++DistinctBoxCount;
+					}
+					DistinctBoxByteMasks[ BoxIndex ] |= 0x0101010101010101ULL << Lane;
+				}
+			}
+
+			void SubstitutionLayer::Substitute( std::span<std::uint8_t> Datas, KernelKind Kernel ) const
+			{
+				my_cpp2020_assert( Datas.size() % GroupBytes == 0, "ByteSubstitutionKernel: The data size is not a multiple of 8 bytes!", std::source_location::current() );
+
+				std::uint8_t* DataPointer = Datas.data();
+				std::size_t	  ByteCount = Datas.size();
+
+				//不能使用当前处理器不支持的内核
+				//Never use a kernel that the current processor does not support
+				if ( Kernel == KernelKind::AVX512VBMI && SelectKernel() != KernelKind::AVX512VBMI )
+					Kernel = SelectKernel();
+				if ( Kernel == KernelKind::AVX2 && SelectKernel() == KernelKind::Scalar )
+					Kernel = KernelKind::Scalar;
+
+				#if defined( TDOM_PROCESSOR_X86 )
+				if ( Kernel == KernelKind::AVX512VBMI )
+				{
+					SubstituteBytesAVX512VBMI( DataPointer, ByteCount, DistinctBoxes.data(), DistinctBoxByteMasks.data(), DistinctBoxCount );
+					return;
+				}
+				else if ( Kernel == KernelKind::AVX2 && ByteCount >= BlockBytesAVX2 )
+				{
+					SubstituteBlocksAVX2( DataPointer, ByteCount / BlockBytesAVX2, NibbleSubTables.front().data() );
+
+					DataPointer += ( ByteCount / BlockBytesAVX2 ) * BlockBytesAVX2;
+					ByteCount %= BlockBytesAVX2;
+				}
+				#endif
+
+				if ( ByteCount != 0 )
+					SubstituteGroupsScalar( DataPointer, ByteCount, LaneBoxes );
+			}
+		}  // namespace ImplementationDetails::ByteSubstitutionKernel
+	}	   // namespace SED::BlockCipher
+}  // namespace TwilightDreamOfMagical::CustomSecurity
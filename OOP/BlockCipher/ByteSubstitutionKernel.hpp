@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * 本文件是 Algorithm_OaldresPuzzleCryptic 的一部分。
+ *
+ * Algorithm_OaldresPuzzleCryptic 是自由软件：你可以再分发之和/或依照由自由软件基金会发布的 GNU 通用公共许可证修改之，无论是版本 3 许可证，还是（按你的决定）任何以后版都可以。
+ *
+ * 发布 Algorithm_OaldresPuzzleCryptic 是希望它能有用，但是并无保障;甚至连可销售和符合某个特定的目的都不保证。请参看 GNU 通用公共许可证，了解详情。
+ * 你应该随程序获得一份 GNU 通用公共许可证的复本。如果没有，请看 <https://www.gnu.org/licenses/>。
+ */
+
+ /*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * This file is part of Algorithm_OaldresPuzzleCryptic.
+ *
+ * Algorithm_OaldresPuzzleCryptic is free software: you may redistribute it and/or modify it under the GNU General Public License as published by the Free Software Foundation, either under the Version 3 license, or (at your discretion) any later version.
+ *
+ * TDOM-EncryptOrDecryptFile-Reborn is released in the hope that it will be useful, but there are no guarantees; not even that it will be marketable and fit a particular purpose. Please see the GNU General Public License for details.
+ * You should get a copy of the GNU General Public License with your program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALGORITHM_OALDRESPUZZLECRYPTIC_BYTESUBSTITUTIONKERNEL_HPP
+#define ALGORITHM_OALDRESPUZZLECRYPTIC_BYTESUBSTITUTIONKERNEL_HPP
+
+#include "../SupportBaseFunctions.hpp"
+#include "../ProcessorFeatureDetection.hpp"
+
+namespace TwilightDreamOfMagical::CustomSecurity
+{
+	//SymmetricEncryptionDecryption
+	namespace SED::BlockCipher
+	{
+		namespace ImplementationDetails::ByteSubstitutionKernel
+		{
+			using SubstitutionBox = std::array<std::uint8_t, 256>;
+
+			//每 8 个字节为一组，组内第 Lane 个字节使用 LaneBoxes[ Lane ] 置换
+			//Every 8 bytes form a group, and byte Lane of each group is substituted through LaneBoxes[ Lane ]
+			using LaneSubstitutionBoxes = std::array<const SubstitutionBox*, 8>;
+
+			enum class KernelKind : std::uint8_t
+			{
+				//逐字节查表 (参考实现)
+				//Byte-by-byte table lookup (reference implementation)
+				Scalar,
+				//一次 32 字节，按高半字节在 16 个 16 字节子表之间选择，子表内用 vpshufb 查低半字节
+				//32 bytes at a time, selecting among 16 sub-tables of 16 bytes by the high nibble and looking up the low nibble inside each sub-table with vpshufb
+				AVX2,
+				//一次 64 字节，每个置换盒放在 4 个 ZMM 寄存器里，用 vpermi2b 查表
+				//64 bytes at a time, each substitution box lives in 4 ZMM registers and is looked up with vpermi2b
+				AVX512VBMI
+			};
+
+			//当前处理器可用的最快内核
+			//The fastest kernel available on the current processor
+			KernelKind SelectKernel();
+
+			/*
+				字节数据置换层
+				Byte Data Substitution Layer
+
+				构造时把置换盒整理成 SIMD 内核需要的布局 (只做一次)，之后每次调用都不再需要准备工作。
+				SIMD 内核每次都会完整读取所有置换盒，访问的地址与数据无关，因此不会通过缓存时序泄露被置换的字节。
+				The substitution boxes are rearranged into the layout needed by the SIMD kernels at construction (only once), so no preparation is needed on each call.
+				The SIMD kernels always read every substitution box in full, so the accessed addresses do not depend on the data and the substituted bytes are not leaked through cache timing.
+			*/
+			class SubstitutionLayer
+			{
+
+			public:
+				explicit SubstitutionLayer( const LaneSubstitutionBoxes& LaneBoxes );
+
+				//Datas.size() 必须是 8 的倍数
+				//Datas.size() must be a multiple of 8
+				void Substitute( std::span<std::uint8_t> Datas, KernelKind Kernel ) const;
+
+				void Substitute( std::span<std::uint8_t> Datas ) const
+				{
+					Substitute( Datas, SelectKernel() );
+				}
+
+			private:
+				std::array<SubstitutionBox, 8> LaneBoxes {};
+
+				//AVX2: 第 Pair*16+HighNibble 行的低 16 字节是通道 2*Pair 的置换盒的第 HighNibble 行，高 16 字节是通道 2*Pair+1 的
+				//AVX2: the low 16 bytes of row Pair*16+HighNibble are row HighNibble of lane 2*Pair's substitution box, the high 16 bytes are lane 2*Pair+1's
+				alignas( 64 ) std::array<std::array<std::uint8_t, 32>, 64> NibbleSubTables {};
+
+				//AVX-512VBMI: 不重复的置换盒，以及每个置换盒负责的字节掩码
+				//AVX-512VBMI: the distinct substitution boxes, and the byte mask each substitution box is responsible for
+				alignas( 64 ) std::array<SubstitutionBox, 8> DistinctBoxes {};
+				std::array<std::uint64_t, 8> DistinctBoxByteMasks {};
+				std::size_t DistinctBoxCount = 0;
+			};
+		}  // namespace ImplementationDetails::ByteSubstitutionKernel
+	}	   // namespace SED::BlockCipher
+}  // namespace TwilightDreamOfMagical::CustomSecurity
+
+#endif	//ALGORITHM_OALDRESPUZZLECRYPTIC_BYTESUBSTITUTIONKERNEL_HPP
@@ -180,19 +180,32 @@ namespace TwilightDreamOfMagical::CustomSecurity
 						return;
 					const std::size_t H = W / 2;                        // 半状态词数
 
-					std::vector<std::uint64_t> StateBuffer(W, 0);
-					std::vector<std::uint64_t> StateBuffer2(W, 0);
-					std::vector<std::uint64_t> StateBuffer3(W, 0);
+					// 三个状态缓冲区在构造时一次分配 (3 * W 个字)，每次调用开始时清零：
+					// 置换只写 StateBuffer3 的一部分槽位，没写到的槽位必须和原来新分配的缓冲区一样从 0 开始
+					// The three state buffers are allocated once at construction (3 * W words) and zeroed at the start of every call:
+					// the permutation writes only some slots of StateBuffer3, and the unwritten slots must start at 0 just like freshly allocated buffers did
+					std::uint64_t* const StateBuffer = this->TransformStateBuffers.data();
+					std::uint64_t* const StateBuffer2 = StateBuffer + W;
+					std::uint64_t* const StateBuffer3 = StateBuffer2 + W;
+					std::fill(this->TransformStateBuffers.begin(), this->TransformStateBuffers.end(), 0);
+
+					// 下标都小于 2 * W，用一次条件减法代替按运行时 W 取模 (除法是这个置换里最贵的操作)
+					// Every index is below 2 * W, so one conditional subtraction replaces the modulo by the runtime W (division was the most expensive operation in this permutation)
+					const auto WrapIndex = [W](std::size_t index) -> std::size_t
+					{
+						return (index >= W) ? (index - W) : index;
+					};
+					const std::size_t MoveBitCountsSize = this->MoveBitCounts.size();
 
 					for (std::size_t RoundIndex = 0; RoundIndex < Counter; ++RoundIndex)
 					{
 						// Step 1: 哈希状态混合
 						for (std::size_t i = 0; i < H; ++i)
 						{
-							const std::size_t a0 = (2*i)     % W;
-							const std::size_t a1 = (2*i + 1) % W;
-							const std::size_t a2 = (2*i + 2) % W;
-							const std::size_t a3 = (2*i + 3) % W;
+							const std::size_t a0 = WrapIndex(2*i);
+							const std::size_t a1 = WrapIndex(2*i + 1);
+							const std::size_t a2 = WrapIndex(2*i + 2);
+							const std::size_t a3 = WrapIndex(2*i + 3);
 
 							StateBuffer[i]     = this->BitsHashState[a0] ^ this->BitsHashState[a1];
 							StateBuffer[i + H] = this->BitsHashState[a2] ^ this->BitsHashState[a3];
@@ -211,24 +224,30 @@ namespace TwilightDreamOfMagical::CustomSecurity
 						// Step 3: 比特伪随机置换（P）
 						StateBuffer3[0] = this->BitsHashState[0] ^ StateBuffer2[0];
 
+						// i % H 和 StateCurrentCounter % MoveBitCounts.size() 都随 i 逐一递增，所以各用一个回绕的游标
+						// i % H and StateCurrentCounter % MoveBitCounts.size() both advance by one with i, so each uses a wrapping cursor
+						std::size_t source_cursor = (H == 1) ? 0 : 1;
+						std::size_t rotation_cursor = this->StateCurrentCounter % MoveBitCountsSize;
 						for (std::size_t i = 1; i < W; ++i)
 						{
-							const std::size_t source = static_cast<std::size_t>(this->HashStateIndices[i % H]);
+							const std::size_t source = static_cast<std::size_t>(this->HashStateIndices[source_cursor]);
 							const std::size_t target  = (i < H) ? source : (source + H);
 
-							const std::uint32_t rot =
-								this->MoveBitCounts[this->StateCurrentCounter % this->MoveBitCounts.size()];
+							const std::uint32_t rot = this->MoveBitCounts[rotation_cursor];
 
 							StateBuffer3[target] = rotate_right(this->BitsHashState[i] ^ StateBuffer2[i], rot);
-							++this->StateCurrentCounter;
+
+							source_cursor = (source_cursor + 1 == H) ? 0 : (source_cursor + 1);
+							rotation_cursor = (rotation_cursor + 1 == MoveBitCountsSize) ? 0 : (rotation_cursor + 1);
 						}
+						this->StateCurrentCounter += W - 1;
 
 						// Step 4: 非线性函数（χ 型）
 						for (std::size_t i = 0; i < W; ++i)
 						{
 							const std::uint64_t x = StateBuffer3[i];
-							const std::uint64_t y = StateBuffer3[(i + 1) % W];
-							const std::uint64_t z = StateBuffer3[(i + 2) % W];
+							const std::uint64_t y = StateBuffer3[WrapIndex(i + 1)];
+							const std::uint64_t z = StateBuffer3[WrapIndex(i + 2)];
 							this->BitsHashState[i] = x ^ ((~y) & z);
 						}
 
@@ -241,6 +260,16 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				// ---------- [private:] 复用缓冲（不在声明处用 BITWORDS_RATE/ BYTES_RATE 做 NSDMI，避免依赖顺序隐患） ----------
 				std::vector<std::uint64_t> io_words_;  // size = BITWORDS_RATE
 				std::vector<std::uint8_t>  io_bytes_;  // size = BYTES_RATE
+				std::vector<std::uint64_t> TransformStateBuffers;  // size = 3 * BitsHashState.size()
+
+				// ---------- 吸收一个整块（u64）：XOR 到 rate 槽，然后搅拌 ----------
+				void AbsorbBlock(const std::uint64_t* block_words)
+				{
+					for (std::size_t w = 0; w < static_cast<std::size_t>(this->BITWORDS_RATE); ++w)
+						this->BitsHashState[w] ^= block_words[w];
+
+					this->TransfromState(this->BitsHashState.size());
+				}
 
 				// ---------- [public:/private:] 吸收（字节版） ----------
 				void AbsorbInputData(std::span<const std::uint8_t> input_bytes)
@@ -261,12 +290,8 @@ namespace TwilightDreamOfMagical::CustomSecurity
 						// 当前块字节 → u64（写入类内 io_words_）
 						MessagePacking<std::uint64_t, std::uint8_t>(chunk, this->io_words_.data());
 
-						// XOR 到 rate 槽
-						for (std::size_t w = 0; w < static_cast<std::size_t>(this->BITWORDS_RATE); ++w)
-							this->BitsHashState[w] ^= this->io_words_[w];
-
-						// 块结束搅拌
-						this->TransfromState(this->BitsHashState.size());
+						// XOR 到 rate 槽，块结束搅拌
+						this->AbsorbBlock(this->io_words_.data());
 					}
 
 					// 擦缓冲
@@ -282,12 +307,7 @@ namespace TwilightDreamOfMagical::CustomSecurity
 						std::source_location::current());
 
 					for (std::size_t i = 0; i < input_words.size(); i += static_cast<std::size_t>(this->BITWORDS_RATE))
-					{
-						for (std::size_t w = 0; w < static_cast<std::size_t>(this->BITWORDS_RATE); ++w)
-							this->BitsHashState[w] ^= input_words[i + w];
-
-						this->TransfromState(this->BitsHashState.size());
-					}
+						this->AbsorbBlock(input_words.data() + i);
 				}
 
 				// ---------- 挤出（字节版） ----------
@@ -349,6 +369,30 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				{
 					this->StateCurrentCounter = 0;
 					memory_set_no_optimize_function<0x00>(BitsHashState.data(), BitsHashState.size() * sizeof(std::uint64_t));
+					memory_set_no_optimize_function<0x00>(TransformStateBuffers.data(), TransformStateBuffers.size() * sizeof(std::uint64_t));
+				}
+
+				//海绵状态的快照: 状态计数器和比特状态 (新建的对象计数器从 1 开始，Reset 之后从 0 开始，所以也要保存)
+				//Snapshot of the sponge state: the state counter and the bits state (a new object starts the counter at 1 and Reset starts it at 0, so it must be saved too)
+				std::size_t SnapshotByteSize() const
+				{
+					return sizeof(StateCurrentCounter) + BitsHashState.size() * sizeof(std::uint64_t);
+				}
+
+				void SaveSnapshot(std::span<std::uint8_t> SnapshotBytes) const
+				{
+					my_cpp2020_assert(SnapshotBytes.size() == this->SnapshotByteSize(), "CustomSecureHash: The snapshot size does not match this hash state!", std::source_location::current());
+
+					std::memcpy(SnapshotBytes.data(), &StateCurrentCounter, sizeof(StateCurrentCounter));
+					std::memcpy(SnapshotBytes.data() + sizeof(StateCurrentCounter), BitsHashState.data(), BitsHashState.size() * sizeof(std::uint64_t));
+				}
+
+				void RestoreSnapshot(std::span<const std::uint8_t> SnapshotBytes)
+				{
+					my_cpp2020_assert(SnapshotBytes.size() == this->SnapshotByteSize(), "CustomSecureHash: The snapshot size does not match this hash state!", std::source_location::current());
+
+					std::memcpy(&StateCurrentCounter, SnapshotBytes.data(), sizeof(StateCurrentCounter));
+					std::memcpy(BitsHashState.data(), SnapshotBytes.data() + sizeof(StateCurrentCounter), BitsHashState.size() * sizeof(std::uint64_t));
 				}
 
 				//不提供外部数据的测试
@@ -369,22 +413,28 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				}
 
 				// ---------- SpongeHash（字节版）：pad = 1 后补 0 到整块 ----------
+				// 整块直接从调用者的 span 吸收；只有最后不满一块的部分复制到类内的 io_bytes_ 里填充（输入正好是整块时不填充）
+				// Whole blocks are absorbed straight from the caller's span; only the final partial block is copied into the member io_bytes_ and padded (no padding when the input is already whole blocks)
 				void SpongeHash(std::span<const std::uint8_t> InputData,
 								std::span<std::uint8_t> OuputData)
 				{
-					std::vector<std::uint8_t> BlockDataBuffer(InputData.begin(), InputData.end());
+					const std::size_t rate_bytes = static_cast<std::size_t>(this->BYTES_RATE);
+					const std::size_t whole_bytes = InputData.size() - (InputData.size() % rate_bytes);
+
+					this->AbsorbInputData(InputData.first(whole_bytes));
 
-					if (BlockDataBuffer.size() % this->BYTES_RATE != 0)
+					if (whole_bytes != InputData.size())
 					{
-						const std::size_t need = static_cast<std::size_t>(this->BYTES_RATE) - (BlockDataBuffer.size() % this->BYTES_RATE);
-						BlockDataBuffer.push_back(this->PAD_BYTE_DATA);                // 1
-						BlockDataBuffer.resize(BlockDataBuffer.size() + need - 1, 0x00); //0*
+						const std::size_t tail = InputData.size() - whole_bytes;
+						std::memcpy(this->io_bytes_.data(), InputData.data() + whole_bytes, tail);
+						this->io_bytes_[tail] = this->PAD_BYTE_DATA;                                        // 1
+						std::fill(this->io_bytes_.begin() + tail + 1, this->io_bytes_.end(), std::uint8_t(0x00)); //0*
+
+						this->AbsorbInputData(std::span<const std::uint8_t>(this->io_bytes_.data(), rate_bytes));
+						memory_set_no_optimize_function<0x00>(this->io_bytes_.data(), this->io_bytes_.size());
 					}
 
-					this->AbsorbInputData(BlockDataBuffer);
 					this->SqueezeOutputData(OuputData);
-
-					memory_set_no_optimize_function<0x00>(BlockDataBuffer.data(), BlockDataBuffer.size());
 					this->Reset();
 				}
 
@@ -392,19 +442,23 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				void SpongeHash(std::span<const std::uint64_t> InputData,
 								std::span<std::uint64_t> OuputData)
 				{
-					std::vector<std::uint64_t> BlockDataBuffer(InputData.begin(), InputData.end());
+					const std::size_t rate_words = static_cast<std::size_t>(this->BITWORDS_RATE);
+					const std::size_t whole_words = InputData.size() - (InputData.size() % rate_words);
 
-					if (BlockDataBuffer.size() % this->BITWORDS_RATE != 0)
+					this->AbsorbInputData(InputData.first(whole_words));
+
+					if (whole_words != InputData.size())
 					{
-						const std::size_t need = static_cast<std::size_t>(this->BITWORDS_RATE) - (BlockDataBuffer.size() % this->BITWORDS_RATE);
-						BlockDataBuffer.push_back(this->PAD_BITSWORD_DATA);             // 1
-						BlockDataBuffer.resize(BlockDataBuffer.size() + need - 1, 0x00); //0*
+						const std::size_t tail = InputData.size() - whole_words;
+						std::copy_n(InputData.data() + whole_words, tail, this->io_words_.begin());
+						this->io_words_[tail] = this->PAD_BITSWORD_DATA;                                          // 1
+						std::fill(this->io_words_.begin() + tail + 1, this->io_words_.end(), std::uint64_t(0x00)); //0*
+
+						this->AbsorbBlock(this->io_words_.data());
+						memory_set_no_optimize_function<0x00>(this->io_words_.data(), this->io_words_.size() * sizeof(std::uint64_t));
 					}
 
-					this->AbsorbInputData(BlockDataBuffer);
 					this->SqueezeOutputData(OuputData);
-
-					memory_set_no_optimize_function<0x00>(BlockDataBuffer.data(), BlockDataBuffer.size() * sizeof(std::uint64_t));
 					this->Reset();
 				}
 
@@ -430,6 +484,7 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					// io 缓冲按当前 rate 分配一次，后续复用
 					this->io_words_.assign(static_cast<std::size_t>(this->BITWORDS_RATE), 0);
 					this->io_bytes_.assign(static_cast<std::size_t>(this->BYTES_RATE),   0);
+					this->TransformStateBuffers.assign(this->BitsHashState.size() * 3, 0);
 				}
 
 				~CustomSecureHash() = default;
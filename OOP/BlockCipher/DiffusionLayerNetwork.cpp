@@ -0,0 +1,453 @@
+#include "DiffusionLayerNetwork.hpp"
+
+namespace TwilightDreamOfMagical::CustomSecurity
+{
+	//SymmetricEncryptionDecryption
+	namespace SED::BlockCipher
+	{
+		namespace ImplementationDetails::DiffusionLayerNetwork
+		{
+			namespace
+			{
+				/*
+					每 32 个 QuadWord 为一片，输出的第 Row 个字是输入片中下面 16 个字的异或。
+					该排列的常数 Index 来源于 Module_SecureRoundSubkeyGeneratation.cpp 里注释掉的 GenerateDiffusionLayerPermuteIndices (函数/算法)。
+					Every 32 QuadWords form a slice, and output word Row is the XOR of the 16 input words of that slice listed below.
+					The constant indices come from the commented-out GenerateDiffusionLayerPermuteIndices (function/algorithm) in Module_SecureRoundSubkeyGeneratation.cpp.
+				*/
+				constexpr std::size_t SliceWords = 32;
+				constexpr std::size_t TermsPerRow = 16;
+
+				constexpr std::array<std::array<std::uint8_t, TermsPerRow>, SliceWords> DiffusionLayerMatrixIndices
+				{{
+					{ 24, 8, 6, 1, 9, 4, 10, 3, 26, 2, 5, 15, 17, 13, 23, 12 },
+					{ 19, 11, 22, 14, 25, 31, 7, 0, 30, 21, 28, 20, 18, 27, 29, 16 },
+					{ 4, 18, 10, 26, 1, 22, 30, 21, 20, 5, 23, 12, 17, 6, 3, 25 },
+					{ 11, 19, 24, 16, 0, 7, 28, 13, 29, 14, 2, 15, 27, 8, 31, 9 },
+					{ 21, 13, 28, 4, 7, 24, 25, 9, 16, 5, 6, 19, 23, 31, 27, 1 },
+					{ 15, 3, 11, 2, 12, 20, 17, 30, 10, 22, 8, 0, 18, 26, 29, 14 },
+					{ 16, 24, 21, 25, 18, 10, 30, 22, 0, 6, 27, 1, 23, 4, 28, 3 },
+					{ 12, 20, 14, 31, 15, 2, 9, 8, 29, 11, 5, 19, 26, 13, 17, 7 },
+					{ 7, 31, 8, 24, 2, 9, 3, 22, 14, 6, 4, 20, 27, 17, 26, 21 },
+					{ 19, 23, 15, 28, 5, 0, 1, 10, 25, 30, 13, 12, 18, 16, 29, 11 },
+					{ 25, 9, 30, 22, 14, 3, 10, 18, 12, 4, 26, 21, 27, 24, 8, 28 },
+					{ 0, 17, 1, 19, 11, 13, 5, 7, 29, 15, 6, 20, 16, 31, 23, 2 },
+					{ 9, 17, 13, 5, 7, 2, 28, 30, 11, 4, 24, 0, 26, 23, 16, 22 },
+					{ 12, 20, 27, 19, 8, 6, 21, 25, 3, 10, 31, 1, 18, 14, 29, 15 },
+					{ 7, 3, 11, 30, 28, 18, 10, 25, 1, 24, 16, 22, 26, 9, 13, 8 },
+					{ 20, 12, 21, 23, 31, 15, 6, 2, 29, 19, 4, 0, 14, 17, 27, 5 },
+					{ 7, 31, 8, 24, 2, 9, 3, 22, 14, 6, 4, 20, 27, 17, 26, 21 },
+					{ 19, 23, 15, 28, 5, 0, 1, 10, 25, 30, 13, 12, 18, 16, 29, 11 },
+					{ 25, 9, 30, 22, 14, 3, 10, 18, 12, 4, 26, 21, 27, 24, 8, 28 },
+					{ 0, 17, 1, 19, 11, 13, 5, 7, 29, 15, 6, 20, 16, 31, 23, 2 },
+					{ 9, 17, 13, 5, 7, 2, 28, 30, 11, 4, 24, 0, 26, 23, 16, 22 },
+					{ 12, 20, 27, 19, 8, 6, 21, 25, 3, 10, 31, 1, 18, 14, 29, 15 },
+					{ 7, 3, 11, 30, 28, 18, 10, 25, 1, 24, 16, 22, 26, 9, 13, 8 },
+					{ 20, 12, 21, 23, 31, 15, 6, 2, 29, 19, 4, 0, 14, 17, 27, 5 },
+					{ 31, 7, 23, 6, 10, 2, 5, 8, 15, 24, 9, 12, 16, 27, 14, 30 },
+					{ 0, 4, 20, 13, 1, 22, 26, 3, 28, 25, 17, 21, 18, 11, 29, 19 },
+					{ 18, 10, 2, 15, 8, 28, 25, 3, 21, 9, 14, 30, 16, 7, 31, 13 },
+					{ 17, 1, 22, 27, 19, 0, 4, 5, 29, 20, 24, 12, 11, 23, 26, 6 },
+					{ 27, 2, 4, 13, 5, 6, 17, 25, 19, 9, 7, 1, 14, 26, 11, 10 },
+					{ 28, 12, 16, 24, 0, 31, 21, 30, 8, 3, 23, 22, 18, 15, 29, 20 },
+					{ 13, 5, 3, 19, 25, 8, 18, 28, 22, 7, 11, 10, 14, 2, 17, 31 },
+					{ 21, 6, 30, 12, 20, 24, 23, 26, 29, 0, 9, 1, 15, 27, 16, 4 },
+				}};
+
+				struct XorOperation
+				{
+					std::uint16_t Target = 0;
+					std::uint16_t Left = 0;
+					std::uint16_t Right = 0;
+				};
+
+				/*
+					编译后的异或网络: 寄存器 0..31 是输入字，每个操作产生一个新寄存器，OutputRegisters[Row] 是输出第 Row 个字的寄存器
+					The compiled XOR network: registers 0..31 are the input words, every operation produces a new register, and OutputRegisters[Row] is the register of output word Row
+				*/
+				struct XorNetwork
+				{
+					//没有任何公共子表达式时的上限 (每行 15 次异或)
+					//Upper bound when there is no common subexpression at all (15 XORs per row)
+					static constexpr std::size_t MaximumOperations = SliceWords * ( TermsPerRow - 1 );
+
+					std::array<XorOperation, MaximumOperations> Operations {};
+					std::size_t OperationCount = 0;
+					std::size_t RegisterCount = SliceWords;
+					std::array<std::uint16_t, SliceWords> OutputRegisters {};
+				};
+
+				constexpr std::uint32_t RowMask( std::size_t Row )
+				{
+					std::uint32_t Mask = 0;
+					for ( const std::uint8_t Index : DiffusionLayerMatrixIndices[ Row ] )
+						Mask |= std::uint32_t { 1 } << Index;
+					return Mask;
+				}
+
+				/*
+					用 Paar 的贪心算法做公共子表达式消除:
+					反复找出在最多行里同时出现的一对寄存器，把它们的异或提取成新寄存器，直到没有任何一对被两行以上共享；然后把每行剩下的寄存器串起来。
+					完全相同的行 (第 8-15 行与第 16-23 行) 只计算一次。
+					Common subexpression elimination with Paar's greedy algorithm:
+					Repeatedly find the pair of registers that appears together in the most rows and extract their XOR as a new register, until no pair is shared by two or more rows; then chain the registers left in each row.
+					Identical rows (rows 8-15 and rows 16-23) are computed only once.
+				*/
+				constexpr XorNetwork CompileXorNetwork()
+				{
+					XorNetwork Network {};
+
+					//去掉重复的行
+					//Remove duplicate rows
+					std::array<std::uint32_t, SliceWords> UniqueRowMasks {};
+					std::array<std::size_t, SliceWords> UniqueRowOfRow {};
+					std::size_t UniqueRowCount = 0;
+					for ( std::size_t Row = 0; Row < SliceWords; ++Row )
+					{
+						const std::uint32_t Mask = RowMask( Row );
+						std::size_t UniqueRow = 0;
+						while ( UniqueRow < UniqueRowCount && UniqueRowMasks[ UniqueRow ] != Mask )
+							++UniqueRow;
+						if ( UniqueRow == UniqueRowCount )
+							UniqueRowMasks[ UniqueRowCount++ ] = Mask;
+						UniqueRowOfRow[ Row ] = UniqueRow;
+					}
+
+					//RowsOfRegister[Register] 的第 UniqueRow 位表示该寄存器仍是这一行的一个项
+					//Bit UniqueRow of RowsOfRegister[Register] means the register is still a term of that row
+					std::array<std::uint32_t, SliceWords + XorNetwork::MaximumOperations> RowsOfRegister {};
+					for ( std::size_t UniqueRow = 0; UniqueRow < UniqueRowCount; ++UniqueRow )
+						for ( std::size_t Register = 0; Register < SliceWords; ++Register )
+							if ( ( UniqueRowMasks[ UniqueRow ] >> Register ) & 1 )
+								RowsOfRegister[ Register ] |= std::uint32_t { 1 } << UniqueRow;
+
+					auto AppendOperation = [ &Network ]( std::size_t Left, std::size_t Right )
+					{
+						const std::size_t Target = Network.RegisterCount++;
+						Network.Operations[ Network.OperationCount++ ] = XorOperation { static_cast<std::uint16_t>( Target ), static_cast<std::uint16_t>( Left ), static_cast<std::uint16_t>( Right ) };
+						return Target;
+					};
+
+					std::array<std::uint16_t, SliceWords + XorNetwork::MaximumOperations> ActiveRegisters {};
+					while ( true )
+					{
+						std::size_t ActiveCount = 0;
+						for ( std::size_t Register = 0; Register < Network.RegisterCount; ++Register )
+							if ( RowsOfRegister[ Register ] != 0 )
+								ActiveRegisters[ ActiveCount++ ] = static_cast<std::uint16_t>( Register );
+
+						int BestCount = 1;
+						std::size_t BestLeft = 0, BestRight = 0;
+						for ( std::size_t Left = 0; Left < ActiveCount; ++Left )
+						{
+							for ( std::size_t Right = Left + 1; Right < ActiveCount; ++Right )
+							{
+								const int SharedCount = std::popcount( RowsOfRegister[ ActiveRegisters[ Left ] ] & RowsOfRegister[ ActiveRegisters[ Right ] ] );
+								if ( SharedCount > BestCount )
+								{
+									BestCount = SharedCount;
+									BestLeft = ActiveRegisters[ Left ];
+									BestRight = ActiveRegisters[ Right ];
+								}
+							}
+						}
+
+						if ( BestCount < 2 )
+							break;
+
+						const std::uint32_t SharedRows = RowsOfRegister[ BestLeft ] & RowsOfRegister[ BestRight ];
+						const std::size_t	Target = AppendOperation( BestLeft, BestRight );
+						RowsOfRegister[ BestLeft ] &= ~SharedRows;
+						RowsOfRegister[ BestRight ] &= ~SharedRows;
+						RowsOfRegister[ Target ] = SharedRows;
+					}
+
+					std::array<std::uint16_t, SliceWords> UniqueRowOutputs {};
+					for ( std::size_t UniqueRow = 0; UniqueRow < UniqueRowCount; ++UniqueRow )
+					{
+						std::size_t Accumulated = SliceWords + XorNetwork::MaximumOperations;
+						const std::size_t RegisterCount = Network.RegisterCount;
+						for ( std::size_t Register = 0; Register < RegisterCount; ++Register )
+						{
+							if ( ( ( RowsOfRegister[ Register ] >> UniqueRow ) & 1 ) == 0 )
+								continue;
+
+							if ( Accumulated == SliceWords + XorNetwork::MaximumOperations )
+								Accumulated = Register;
+							else
+								Accumulated = AppendOperation( Accumulated, Register );
+						}
+						UniqueRowOutputs[ UniqueRow ] = static_cast<std::uint16_t>( Accumulated );
+					}
+
+					for ( std::size_t Row = 0; Row < SliceWords; ++Row )
+						Network.OutputRegisters[ Row ] = UniqueRowOutputs[ UniqueRowOfRow[ Row ] ];
+
+					return Network;
+				}
+
+				/*
+					按活跃区间重新分配寄存器: 一个值在最后一次被使用之后，它的寄存器就可以给后面的操作复用。
+					这样寄存器文件会小很多 (更容易留在 L1 里，擦除的成本也更低)。输出值一直活到最后。
+					Reallocate registers by live range: once a value has been used for the last time, its register can be reused by a later operation.
+					This makes the register file much smaller (it stays in L1 more easily and is cheaper to wipe). Output values stay live until the end.
+				*/
+				constexpr XorNetwork AllocateRegisters( const XorNetwork& Network )
+				{
+					constexpr std::size_t MaximumRegisters = SliceWords + XorNetwork::MaximumOperations;
+					constexpr std::size_t LiveUntilEnd = XorNetwork::MaximumOperations;
+
+					std::array<std::size_t, MaximumRegisters> LastUse {};
+					for ( std::size_t Index = 0; Index < Network.OperationCount; ++Index )
+					{
+						LastUse[ Network.Operations[ Index ].Left ] = Index;
+						LastUse[ Network.Operations[ Index ].Right ] = Index;
+					}
+					for ( const std::uint16_t Output : Network.OutputRegisters )
+						LastUse[ Output ] = LiveUntilEnd;
+
+					XorNetwork Allocated {};
+					Allocated.OperationCount = Network.OperationCount;
+					Allocated.RegisterCount = SliceWords;
+
+					std::array<std::uint16_t, MaximumRegisters> PhysicalOf {};
+					std::array<bool, MaximumRegisters> PhysicalFree {};
+					for ( std::size_t Register = 0; Register < SliceWords; ++Register )
+						PhysicalOf[ Register ] = static_cast<std::uint16_t>( Register );
+
+					for ( std::size_t Index = 0; Index < Network.OperationCount; ++Index )
+					{
+						const XorOperation& Operation = Network.Operations[ Index ];
+						const std::uint16_t Left = PhysicalOf[ Operation.Left ];
+						const std::uint16_t Right = PhysicalOf[ Operation.Right ];
+
+						//操作数在这里最后一次使用，先释放，目标可以直接写回它们的寄存器
+						//The operands are used for the last time here, so free them first; the target may be written straight back into their registers
+						if ( LastUse[ Operation.Left ] == Index )
+							PhysicalFree[ Left ] = true;
+						if ( LastUse[ Operation.Right ] == Index )
+							PhysicalFree[ Right ] = true;
+
+						std::size_t Target = 0;
+						while ( Target < Allocated.RegisterCount && !PhysicalFree[ Target ] )
+							++Target;
+						if ( Target == Allocated.RegisterCount )
+							++Allocated.RegisterCount;
+						PhysicalFree[ Target ] = false;
+
+						PhysicalOf[ Operation.Target ] = static_cast<std::uint16_t>( Target );
+						Allocated.Operations[ Index ] = XorOperation { static_cast<std::uint16_t>( Target ), Left, Right };
+					}
+
+					for ( std::size_t Row = 0; Row < SliceWords; ++Row )
+						Allocated.OutputRegisters[ Row ] = PhysicalOf[ Network.OutputRegisters[ Row ] ];
+
+					return Allocated;
+				}
+
+				constexpr XorNetwork CompiledXorNetwork = AllocateRegisters( CompileXorNetwork() );
+
+				//在编译期用比特掩码符号执行整个网络，证明它与矩阵完全一致
+				//Symbolically execute the whole network with bit masks at compile time, proving it matches the matrix exactly
+				constexpr bool VerifyXorNetwork()
+				{
+					std::array<std::uint32_t, SliceWords + XorNetwork::MaximumOperations> RegisterMasks {};
+					for ( std::size_t Register = 0; Register < SliceWords; ++Register )
+						RegisterMasks[ Register ] = std::uint32_t { 1 } << Register;
+
+					for ( std::size_t Index = 0; Index < CompiledXorNetwork.OperationCount; ++Index )
+					{
+						const XorOperation& Operation = CompiledXorNetwork.Operations[ Index ];
+						RegisterMasks[ Operation.Target ] = RegisterMasks[ Operation.Left ] ^ RegisterMasks[ Operation.Right ];
+					}
+
+					for ( std::size_t Row = 0; Row < SliceWords; ++Row )
+						if ( RegisterMasks[ CompiledXorNetwork.OutputRegisters[ Row ] ] != RowMask( Row ) )
+							return false;
+
+					return true;
+				}
+
+				static_assert( VerifyXorNetwork(), "DiffusionLayerNetwork: The compiled XOR network does not match the diffusion layer matrix!" );
+
+				#if defined( _MSC_VER ) && !defined( __clang__ ) && defined( TDOM_PROCESSOR_X86 )
+				//GCC/Clang 的向量类型自带 ^ 运算符，MSVC 的需要补上
+				//GCC/Clang vector types come with the ^ operator, MSVC ones need it added
+				inline __m256i operator^( __m256i Left, __m256i Right )
+				{
+					return _mm256_xor_si256( Left, Right );
+				}
+
+				inline __m512i operator^( __m512i Left, __m512i Right )
+				{
+					return _mm512_xor_si512( Left, Right );
+				}
+				#endif
+
+				//把整个网络按常量下标展开，WordType 可以是一个 QuadWord，也可以是装着多片同一位置 QuadWord 的向量
+				//Unroll the whole network with constant indices; WordType may be one QuadWord or a vector holding the same-position QuadWord of several slices
+				template <typename WordType, std::size_t... OperationIndex>
+				TDOM_ALWAYS_INLINE void RunXorNetwork( WordType* Registers, std::index_sequence<OperationIndex...> )
+				{
+					( ( Registers[ CompiledXorNetwork.Operations[ OperationIndex ].Target ] =
+						Registers[ CompiledXorNetwork.Operations[ OperationIndex ].Left ] ^ Registers[ CompiledXorNetwork.Operations[ OperationIndex ].Right ] ), ... );
+				}
+
+				template <typename WordType>
+				TDOM_ALWAYS_INLINE void RunXorNetwork( WordType* Registers )
+				{
+					RunXorNetwork( Registers, std::make_index_sequence<CompiledXorNetwork.OperationCount> {} );
+				}
+
+				//网络需要的寄存器数量 (输入字 + 每个异或操作一个)
+				//Number of registers the network needs (input words + one per XOR operation)
+				constexpr std::size_t RegisterCount = CompiledXorNetwork.RegisterCount;
+
+				void DiffuseSlicesScalar( std::uint64_t* Slices, std::size_t SliceCount, std::uint64_t* Registers )
+				{
+					for ( std::size_t Slice = 0; Slice < SliceCount; ++Slice )
+					{
+						std::uint64_t* KeyState = Slices + Slice * SliceWords;
+
+						for ( std::size_t Word = 0; Word < SliceWords; ++Word )
+							Registers[ Word ] = KeyState[ Word ];
+
+						RunXorNetwork( Registers );
+
+						for ( std::size_t Row = 0; Row < SliceWords; ++Row )
+							KeyState[ Row ] = Registers[ CompiledXorNetwork.OutputRegisters[ Row ] ];
+					}
+				}
+
+				#if defined( TDOM_PROCESSOR_X86 )
+
+				//4x4 QuadWord 转置 (自逆): 把 4 片各自连续的 4 个字，变成 4 个 "同一位置、4 片" 的向量
+				//4x4 QuadWord transpose (self-inverse): turns 4 consecutive words of each of 4 slices into 4 "same position, 4 slices" vectors
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				TDOM_ALWAYS_INLINE void Transpose4x4( __m256i& Row0, __m256i& Row1, __m256i& Row2, __m256i& Row3 )
+				{
+					const __m256i Low01 = _mm256_unpacklo_epi64( Row0, Row1 );
+					const __m256i High01 = _mm256_unpackhi_epi64( Row0, Row1 );
+					const __m256i Low23 = _mm256_unpacklo_epi64( Row2, Row3 );
+					const __m256i High23 = _mm256_unpackhi_epi64( Row2, Row3 );
+					Row0 = _mm256_permute2x128_si256( Low01, Low23, 0x20 );
+					Row1 = _mm256_permute2x128_si256( High01, High23, 0x20 );
+					Row2 = _mm256_permute2x128_si256( Low01, Low23, 0x31 );
+					Row3 = _mm256_permute2x128_si256( High01, High23, 0x31 );
+				}
+
+				//一次处理 4 片，每个 YMM 寄存器的 4 个通道对应 4 片
+				//Process 4 slices at a time; the 4 lanes of each YMM register correspond to 4 slices
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				void DiffuseSlicesAVX2( std::uint64_t* Slices, std::size_t GroupCount, __m256i* Registers )
+				{
+					for ( std::size_t Group = 0; Group < GroupCount; ++Group )
+					{
+						std::uint64_t* KeyState = Slices + Group * SliceWords * 4;
+
+						for ( std::size_t Word = 0; Word < SliceWords; Word += 4 )
+						{
+							__m256i Row0 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( KeyState + Word ) );
+							__m256i Row1 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( KeyState + SliceWords + Word ) );
+							__m256i Row2 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( KeyState + SliceWords * 2 + Word ) );
+							__m256i Row3 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( KeyState + SliceWords * 3 + Word ) );
+							Transpose4x4( Row0, Row1, Row2, Row3 );
+							Registers[ Word ] = Row0;
+							Registers[ Word + 1 ] = Row1;
+							Registers[ Word + 2 ] = Row2;
+							Registers[ Word + 3 ] = Row3;
+						}
+
+						RunXorNetwork( Registers );
+
+						for ( std::size_t Row = 0; Row < SliceWords; Row += 4 )
+						{
+							__m256i Row0 = Registers[ CompiledXorNetwork.OutputRegisters[ Row ] ];
+							__m256i Row1 = Registers[ CompiledXorNetwork.OutputRegisters[ Row + 1 ] ];
+							__m256i Row2 = Registers[ CompiledXorNetwork.OutputRegisters[ Row + 2 ] ];
+							__m256i Row3 = Registers[ CompiledXorNetwork.OutputRegisters[ Row + 3 ] ];
+							Transpose4x4( Row0, Row1, Row2, Row3 );
+							_mm256_storeu_si256( reinterpret_cast<__m256i*>( KeyState + Row ), Row0 );
+							_mm256_storeu_si256( reinterpret_cast<__m256i*>( KeyState + SliceWords + Row ), Row1 );
+							_mm256_storeu_si256( reinterpret_cast<__m256i*>( KeyState + SliceWords * 2 + Row ), Row2 );
+							_mm256_storeu_si256( reinterpret_cast<__m256i*>( KeyState + SliceWords * 3 + Row ), Row3 );
+						}
+					}
+				}
+
+				//一次处理 8 片，用 gather/scatter 按 32 个字的步长收集同一位置的字
+				//Process 8 slices at a time, using gather/scatter with a 32-word stride to collect the same-position words
+				TDOM_TARGET_ATTRIBUTE( "avx512f" )
+				void DiffuseSlicesAVX512( std::uint64_t* Slices, std::size_t GroupCount, __m512i* Registers )
+				{
+					const __m512i SliceOffsets = _mm512_set_epi64( 7 * SliceWords, 6 * SliceWords, 5 * SliceWords, 4 * SliceWords, 3 * SliceWords, 2 * SliceWords, 1 * SliceWords, 0 );
+
+					for ( std::size_t Group = 0; Group < GroupCount; ++Group )
+					{
+						std::uint64_t* KeyState = Slices + Group * SliceWords * 8;
+
+						for ( std::size_t Word = 0; Word < SliceWords; ++Word )
+							Registers[ Word ] = _mm512_i64gather_epi64( SliceOffsets, KeyState + Word, sizeof( std::uint64_t ) );
+
+						RunXorNetwork( Registers );
+
+						for ( std::size_t Row = 0; Row < SliceWords; ++Row )
+							_mm512_i64scatter_epi64( KeyState + Row, SliceOffsets, Registers[ CompiledXorNetwork.OutputRegisters[ Row ] ], sizeof( std::uint64_t ) );
+					}
+				}
+
+				#endif
+			}  // namespace
+
+			void ApplyDiffusionLayerScalar( std::span<std::uint64_t> KeyState )
+			{
+				my_cpp2020_assert( KeyState.size() % SliceWords == 0, "DiffusionLayerNetwork: The key state size is not a multiple of 32 quad-words!", std::source_location::current() );
+
+				std::uint64_t Registers[ RegisterCount ] {};
+				DiffuseSlicesScalar( KeyState.data(), KeyState.size() / SliceWords, Registers );
+
+				volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( Registers, sizeof( Registers ) );
+				CheckPointer = nullptr;
+			}
+
+			void ApplyDiffusionLayer( std::span<std::uint64_t> KeyState )
+			{
+				my_cpp2020_assert( KeyState.size() % SliceWords == 0, "DiffusionLayerNetwork: The key state size is not a multiple of 32 quad-words!", std::source_location::current() );
+
+				std::uint64_t* Slices = KeyState.data();
+				std::size_t	   SliceCount = KeyState.size() / SliceWords;
+
+				#if defined( TDOM_PROCESSOR_X86 )
+				const auto& Features = BaseOperation::CurrentProcessorFeatures();
+				volatile void* CheckPointer = nullptr;
+
+				if ( Features.AVX512F && SliceCount >= 8 )
+				{
+					__m512i Registers[ RegisterCount ];
+					DiffuseSlicesAVX512( Slices, SliceCount / 8, Registers );
+
+					CheckPointer = memory_set_no_optimize_function<0x00>( Registers, sizeof( Registers ) );
+					CheckPointer = nullptr;
+
+					Slices += ( SliceCount / 8 ) * 8 * SliceWords;
+					SliceCount %= 8;
+				}
+				else if ( Features.AVX2 && SliceCount >= 4 )
+				{
+					__m256i Registers[ RegisterCount ];
+					DiffuseSlicesAVX2( Slices, SliceCount / 4, Registers );
+
+					CheckPointer = memory_set_no_optimize_function<0x00>( Registers, sizeof( Registers ) );
+					CheckPointer = nullptr;
+
+					Slices += ( SliceCount / 4 ) * 4 * SliceWords;
+					SliceCount %= 4;
+				}
+				#endif
+
+				if ( SliceCount != 0 )
+					ApplyDiffusionLayerScalar( std::span<std::uint64_t>( Slices, SliceCount * SliceWords ) );
+			}
+		}  // namespace ImplementationDetails::DiffusionLayerNetwork
+	}	   // namespace SED::BlockCipher
+}  // namespace TwilightDreamOfMagical::CustomSecurity
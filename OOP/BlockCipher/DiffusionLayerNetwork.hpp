@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * 本文件是 Algorithm_OaldresPuzzleCryptic 的一部分。
+ *
+ * Algorithm_OaldresPuzzleCryptic 是自由软件：你可以再分发之和/或依照由自由软件基金会发布的 GNU 通用公共许可证修改之，无论是版本 3 许可证，还是（按你的决定）任何以后版都可以。
+ *
+ * 发布 Algorithm_OaldresPuzzleCryptic 是希望它能有用，但是并无保障;甚至连可销售和符合某个特定的目的都不保证。请参看 GNU 通用公共许可证，了解详情。
+ * 你应该随程序获得一份 GNU 通用公共许可证的复本。如果没有，请看 <https://www.gnu.org/licenses/>。
+ */
+
+ /*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * This file is part of Algorithm_OaldresPuzzleCryptic.
+ *
+ * Algorithm_OaldresPuzzleCryptic is free software: you may redistribute it and/or modify it under the GNU General Public License as published by the Free Software Foundation, either under the Version 3 license, or (at your discretion) any later version.
+ *
+ * TDOM-EncryptOrDecryptFile-Reborn is released in the hope that it will be useful, but there are no guarantees; not even that it will be marketable and fit a particular purpose. Please see the GNU General Public License for details.
+ * You should get a copy of the GNU General Public License with your program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALGORITHM_OALDRESPUZZLECRYPTIC_DIFFUSIONLAYERNETWORK_HPP
+#define ALGORITHM_OALDRESPUZZLECRYPTIC_DIFFUSIONLAYERNETWORK_HPP
+
+#include "../SupportBaseFunctions.hpp"
+#include "../ProcessorFeatureDetection.hpp"
+
+namespace TwilightDreamOfMagical::CustomSecurity
+{
+	//SymmetricEncryptionDecryption
+	namespace SED::BlockCipher
+	{
+		namespace ImplementationDetails::DiffusionLayerNetwork
+		{
+			/*
+				比特数据扩散层 (GenerationRoundSubkeys 使用)
+				Bits data diffusion layer (used by GenerationRoundSubkeys)
+
+				这是 GF(2) 上固定的线性映射，矩阵常量和编译期生成的异或网络都在 DiffusionLayerNetwork.cpp 里。
+				This is a fixed linear map over GF(2); the matrix constants and the XOR network generated from them at compile time live in DiffusionLayerNetwork.cpp.
+
+				原地对 KeyState 的每一片 (32 个 QuadWord) 应用扩散层，KeyState.size() 必须是 32 的倍数。
+				自动选择 AVX-512 (一次 8 片)、AVX2 (一次 4 片) 或者标量路径。
+				Apply the diffusion layer in place to every slice (32 QuadWords) of KeyState; KeyState.size() must be a multiple of 32.
+				Automatically selects the AVX-512 (8 slices at a time), AVX2 (4 slices at a time) or scalar path.
+			*/
+			void ApplyDiffusionLayer( std::span<std::uint64_t> KeyState );
+
+			//只使用标量路径 (参考实现)
+			//Scalar path only (reference implementation)
+			void ApplyDiffusionLayerScalar( std::span<std::uint64_t> KeyState );
+		}  // namespace ImplementationDetails::DiffusionLayerNetwork
+	}	   // namespace SED::BlockCipher
+}  // namespace TwilightDreamOfMagical::CustomSecurity
+
+#endif	//ALGORITHM_OALDRESPUZZLECRYPTIC_DIFFUSIONLAYERNETWORK_HPP
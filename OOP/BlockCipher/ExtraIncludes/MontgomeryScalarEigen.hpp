@@ -236,6 +236,103 @@ namespace TwilightDreamOfMagical::PrimeField
 		}
 	};
 
+	// —— 融合的模矩阵-向量乘法：y = A x，与“Montgomery64 入域 + Eigen GEMV + 出域”的结果逐位相同 ——
+	// A 是列主序（Eigen 默认）的 rows x cols 矩阵，x 有 cols 个元素，y 有 rows 个普通余数。
+	// 上下文作为参数传入，不再经过线程局部作用域；A 的元素在用到时才入域，不生成域内矩阵。
+	//
+	// 注意：模数大于 2^63 时 ReduceFrom128 会丢掉最高位的进位，ComputeR2 的倍加也会回绕，
+	// 所以每个乘积的域内余数不是乘积的线性函数，几个乘积不能合并成一次规约（否则所有密文都会改变）。
+	// 因此每个乘积仍然各自做一次 REDC；惰性的是求和：规范余数先在两个 64 位字里累加，每行最后只规约一次。
+	//
+	// vector_in_field 是调用者提供的 cols 个字的临时空间，accumulator_words 是 2 * rows 个字的临时空间。
+	// MatrixInField 为 true 时，A 已经是域内表示（例如生成矩阵时已经用 ToMontgomery 映射过），不再逐元素入域。
+	template <bool MatrixInField = false>
+	inline void MultiplyMatrixVectorInField
+	(
+		const MontgomeryPrimeFieldContext& context,
+		const uint64_t* matrix, size_t rows, size_t cols,
+		const uint64_t* vector, uint64_t* output,
+		uint64_t* vector_in_field, uint64_t* accumulator_words
+	) noexcept
+	{
+		const uint64_t modulus = context.modulus;
+		// 模数大于 2^63 时，任何 64 位数对它取模最多只需要减一次
+		const bool single_subtraction = ( modulus >> 63 ) != 0;
+		const auto reduce_word = [ modulus, single_subtraction ]( uint64_t value ) noexcept
+		{
+			if ( single_subtraction )
+				return value - ( ( value >= modulus ) ? modulus : 0 );
+			return value % modulus;
+		};
+		// 2^64 mod n，用来把累加器的高位折叠回低位
+		const uint64_t wrap_value = ( 0 - modulus ) % modulus;
+		// 与 ReduceFrom128 逐位相同（包括丢掉的进位），u 只需要低 64 位，条件减法写成无分支的形式
+		const uint64_t montgomery_inverse = context.montgomery_inverse;
+		const auto reduce_product = [ modulus, montgomery_inverse ]( uint64_t low, uint64_t high ) noexcept
+		{
+			const uint64_t u_low = low * montgomery_inverse;
+			uint64_t m_low, m_high;
+			MultiplyUnsignedWide( u_low, modulus, m_low, m_high );
+			const uint64_t sum_low = low + m_low;
+			const uint64_t sum_high = high + m_high + ( ( sum_low < low ) ? 1 : 0 );
+			return sum_high - ( ( sum_high >= modulus ) ? modulus : 0 );
+		};
+
+		// 入域向量（与 Montgomery64::FromStandard 相同）
+		for ( size_t column = 0; column < cols; ++column )
+		{
+			uint64_t lo, hi;
+			MultiplyUnsignedWide( reduce_word( vector[ column ] ), context.r2_mod, lo, hi );
+			vector_in_field[ column ] = context.ReduceFrom128( lo, hi );
+		}
+
+		for ( size_t word_index = 0; word_index < 2 * rows; ++word_index )
+			accumulator_words[ word_index ] = 0;
+
+		// 列主序：按列遍历，矩阵连续读取
+		for ( size_t column = 0; column < cols; ++column )
+		{
+			const uint64_t  x_in_field = vector_in_field[ column ];
+			const uint64_t* matrix_column = matrix + column * rows;
+
+			for ( size_t row = 0; row < rows; ++row )
+			{
+				uint64_t lo, hi;
+				uint64_t a_in_field = matrix_column[ row ];
+				if constexpr ( !MatrixInField )
+				{
+					MultiplyUnsignedWide( reduce_word( a_in_field ), context.r2_mod, lo, hi );
+					a_in_field = reduce_product( lo, hi );
+				}
+
+				MultiplyUnsignedWide( a_in_field, x_in_field, lo, hi );
+				const uint64_t product_in_field = reduce_product( lo, hi );
+
+				uint64_t& sum_low = accumulator_words[ 2 * row ];
+				uint64_t& sum_high = accumulator_words[ 2 * row + 1 ];
+				sum_low += product_in_field;
+				sum_high += ( sum_low < product_in_field ) ? 1 : 0;
+			}
+		}
+
+		// 每行规约一次：把高位乘以 2^64 mod n 折叠回来，直到高位为 0，再取模得到规范余数，最后出域
+		for ( size_t row = 0; row < rows; ++row )
+		{
+			uint64_t sum_low = accumulator_words[ 2 * row ];
+			uint64_t sum_high = accumulator_words[ 2 * row + 1 ];
+
+			while ( sum_high != 0 )
+			{
+				uint64_t fold_low, fold_high;
+				MultiplyUnsignedWide( sum_high, wrap_value, fold_low, fold_high );
+				sum_low += fold_low;
+				sum_high = fold_high + ( ( sum_low < fold_low ) ? 1 : 0 );
+			}
+
+			output[ row ] = context.FromMontgomery( reduce_word( sum_low ) );
+		}
+	}
+
 }  // namespace TwilightDreamOfMagical::PrimeField
 
 // —— 告诉 Eigen：这个自定义标量能当 “数字” 用 ——
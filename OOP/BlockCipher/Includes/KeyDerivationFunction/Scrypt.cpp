@@ -4,6 +4,381 @@ namespace TwilightDreamOfMagical::CommonSecurity
 {
 	namespace KeyDerivationFunction
 	{
+		namespace
+		{
+			/*
+				Salsa20/8 的对角线字布局 (和 Colin Percival 的 SSE2 实现相同):
+				每 16 个字的子块里，第 Index 个位置存放原来的第 (Index * 5) mod 16 个字，四行分别是
+				(x0, x5, x10, x15), (x4, x9, x14, x3), (x8, x13, x2, x7), (x12, x1, x6, x11)。
+				列轮和行轮都变成整行的运算，两者之间只需要旋转行。Integerify 读取的 x0 和 x1 分别在第 0 和第 13 个位置。
+				BlockMix 的异或、复制和 Y 的重新排列都按 16 个字的子块进行，所以不受布局影响。
+
+				Diagonal word layout of Salsa20/8 (the same as Colin Percival's SSE2 implementation):
+				inside every 16-word sub-block, position Index holds the original word (Index * 5) mod 16, so the four rows are
+				(x0, x5, x10, x15), (x4, x9, x14, x3), (x8, x13, x2, x7), (x12, x1, x6, x11).
+				Column rounds and row rounds both become whole-row operations, with only row rotations between them. x0 and x1 read by Integerify live at positions 0 and 13.
+				The exclusive-or, the copies and the Y reordering of BlockMix all work on 16-word sub-blocks, so they are unaffected by the layout.
+			*/
+			constexpr std::size_t DiagonalHighWordPosition = 13;
+
+			void ToDiagonalLayout( std::span<std::uint32_t> words )
+			{
+				std::array<std::uint32_t, 16> sub_block {};
+
+				for ( std::size_t offset = 0; offset < words.size(); offset += 16 )
+				{
+					std::memcpy( sub_block.data(), &words[ offset ], sizeof( sub_block ) );
+					for ( std::size_t index = 0; index < 16; ++index )
+						words[ offset + index ] = sub_block[ ( index * 5 ) % 16 ];
+				}
+
+				volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( sub_block.data(), sub_block.size() * sizeof( std::uint32_t ) );
+				CheckPointer = nullptr;
+			}
+
+			void FromDiagonalLayout( std::span<std::uint32_t> words )
+			{
+				std::array<std::uint32_t, 16> sub_block {};
+
+				for ( std::size_t offset = 0; offset < words.size(); offset += 16 )
+				{
+					std::memcpy( sub_block.data(), &words[ offset ], sizeof( sub_block ) );
+					for ( std::size_t index = 0; index < 16; ++index )
+						words[ offset + ( index * 5 ) % 16 ] = sub_block[ index ];
+				}
+
+				volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( sub_block.data(), sub_block.size() * sizeof( std::uint32_t ) );
+				CheckPointer = nullptr;
+			}
+
+			std::uint64_t IntegerifyDiagonal( const std::uint32_t* block, const std::uint64_t block_size )
+			{
+				const std::uint64_t index = ( 2 * block_size - 1 ) * 16;
+				return static_cast<std::uint64_t>( block[ index ] ) | static_cast<std::uint64_t>( block[ index + DiagonalHighWordPosition ] ) << 32;
+			}
+
+			#if defined( TDOM_PROCESSOR_X86 )
+
+			/*
+				SSE2 (一个通道，一个 XMM 寄存器放一行)
+				SSE2 (one lane, one XMM register per row)
+			*/
+
+			template <int Count>
+			TDOM_TARGET_ATTRIBUTE( "sse2" )
+			TDOM_ALWAYS_INLINE __m128i RotateLeftSSE2( __m128i value )
+			{
+				return _mm_or_si128( _mm_slli_epi32( value, Count ), _mm_srli_epi32( value, 32 - Count ) );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "sse2" )
+			TDOM_ALWAYS_INLINE void Salsa20_8_SSE2( __m128i& row0, __m128i& row1, __m128i& row2, __m128i& row3 )
+			{
+				const __m128i input0 = row0, input1 = row1, input2 = row2, input3 = row3;
+
+				for ( std::int32_t round = 8; round > 0; round -= 2 )
+				{
+					//Odd round (columns)
+					row1 = _mm_xor_si128( row1, RotateLeftSSE2<7>( _mm_add_epi32( row0, row3 ) ) );
+					row2 = _mm_xor_si128( row2, RotateLeftSSE2<9>( _mm_add_epi32( row1, row0 ) ) );
+					row3 = _mm_xor_si128( row3, RotateLeftSSE2<13>( _mm_add_epi32( row2, row1 ) ) );
+					row0 = _mm_xor_si128( row0, RotateLeftSSE2<18>( _mm_add_epi32( row3, row2 ) ) );
+
+					row1 = _mm_shuffle_epi32( row1, 0x93 );
+					row2 = _mm_shuffle_epi32( row2, 0x4E );
+					row3 = _mm_shuffle_epi32( row3, 0x39 );
+
+					//Even round (rows)
+					row3 = _mm_xor_si128( row3, RotateLeftSSE2<7>( _mm_add_epi32( row0, row1 ) ) );
+					row2 = _mm_xor_si128( row2, RotateLeftSSE2<9>( _mm_add_epi32( row3, row0 ) ) );
+					row1 = _mm_xor_si128( row1, RotateLeftSSE2<13>( _mm_add_epi32( row2, row3 ) ) );
+					row0 = _mm_xor_si128( row0, RotateLeftSSE2<18>( _mm_add_epi32( row1, row2 ) ) );
+
+					row1 = _mm_shuffle_epi32( row1, 0x39 );
+					row2 = _mm_shuffle_epi32( row2, 0x4E );
+					row3 = _mm_shuffle_epi32( row3, 0x93 );
+				}
+
+				row0 = _mm_add_epi32( row0, input0 );
+				row1 = _mm_add_epi32( row1, input1 );
+				row2 = _mm_add_epi32( row2, input2 );
+				row3 = _mm_add_epi32( row3, input3 );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "sse2" )
+			void MixBlockSSE2( const std::uint32_t* in, std::uint32_t* out, const std::uint64_t block_size )
+			{
+				/* 1: X = Block[2 * block_size - 1] */
+				const std::uint32_t* last_sub_block = in + ( 2 * block_size - 1 ) * 16;
+				__m128i row0 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( last_sub_block ) );
+				__m128i row1 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( last_sub_block + 4 ) );
+				__m128i row2 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( last_sub_block + 8 ) );
+				__m128i row3 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( last_sub_block + 12 ) );
+
+				/* 2: for index = 0 to 2 * block_size - 1 do */
+				for ( std::size_t index = 0; index < 2 * block_size; ++index )
+				{
+					/* 3: X = Salsa20(X xor Block[index]) */
+					const std::uint32_t* sub_block = in + index * 16;
+					row0 = _mm_xor_si128( row0, _mm_loadu_si128( reinterpret_cast<const __m128i*>( sub_block ) ) );
+					row1 = _mm_xor_si128( row1, _mm_loadu_si128( reinterpret_cast<const __m128i*>( sub_block + 4 ) ) );
+					row2 = _mm_xor_si128( row2, _mm_loadu_si128( reinterpret_cast<const __m128i*>( sub_block + 8 ) ) );
+					row3 = _mm_xor_si128( row3, _mm_loadu_si128( reinterpret_cast<const __m128i*>( sub_block + 12 ) ) );
+
+					Salsa20_8_SSE2( row0, row1, row2, row3 );
+
+					/* 4: Block' = (Y[0], Y[2], ..., Y[2 * block_size - 2], Y[1], Y[3], ..., Y[2 * block_size - 1]) */
+					std::uint32_t* out_sub_block = out + ( index / 2 + ( index & 1 ) * block_size ) * 16;
+					_mm_storeu_si128( reinterpret_cast<__m128i*>( out_sub_block ), row0 );
+					_mm_storeu_si128( reinterpret_cast<__m128i*>( out_sub_block + 4 ), row1 );
+					_mm_storeu_si128( reinterpret_cast<__m128i*>( out_sub_block + 8 ), row2 );
+					_mm_storeu_si128( reinterpret_cast<__m128i*>( out_sub_block + 12 ), row3 );
+				}
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "sse2" )
+			void ExclusiveOrWordsSSE2( std::uint32_t* destination, const std::uint32_t* source, const std::size_t word_count )
+			{
+				for ( std::size_t index = 0; index < word_count; index += 4 )
+				{
+					const __m128i value = _mm_xor_si128( _mm_loadu_si128( reinterpret_cast<const __m128i*>( destination + index ) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>( source + index ) ) );
+					_mm_storeu_si128( reinterpret_cast<__m128i*>( destination + index ), value );
+				}
+			}
+
+			//block_x 是对角线布局的输入，也是输出
+			//block_x is the input in the diagonal layout, and also the output
+			TDOM_TARGET_ATTRIBUTE( "sse2" )
+			void ScryptMixFunctonSSE2( std::uint32_t* block_x, std::uint32_t* block_y, std::uint32_t* block_v, const std::uint64_t block_size, const std::uint64_t resource_cost )
+			{
+				const std::size_t word32_block_size = 32 * block_size;
+
+				for ( std::size_t index = 0; index < resource_cost; index += 2 )
+				{
+					std::memcpy( &block_v[ index * word32_block_size ], block_x, word32_block_size * sizeof( std::uint32_t ) );
+					MixBlockSSE2( block_x, block_y, block_size );
+					std::memcpy( &block_v[ ( index + 1 ) * word32_block_size ], block_y, word32_block_size * sizeof( std::uint32_t ) );
+					MixBlockSSE2( block_y, block_x, block_size );
+				}
+
+				for ( std::size_t index = 0; index < resource_cost; index += 2 )
+				{
+					std::uint64_t offset_index = IntegerifyDiagonal( block_x, block_size ) & ( resource_cost - 1 );
+					ExclusiveOrWordsSSE2( block_x, &block_v[ offset_index * word32_block_size ], word32_block_size );
+					MixBlockSSE2( block_x, block_y, block_size );
+
+					offset_index = IntegerifyDiagonal( block_y, block_size ) & ( resource_cost - 1 );
+					ExclusiveOrWordsSSE2( block_y, &block_v[ offset_index * word32_block_size ], word32_block_size );
+					MixBlockSSE2( block_y, block_x, block_size );
+				}
+			}
+
+			/*
+				AVX2 (两个互相独立的 ROMix 通道，通道 A 在每个 YMM 寄存器的低 128 位，通道 B 在高 128 位)
+				_mm256_shuffle_epi32 在每个 128 位半边里分别旋转，所以行的旋转和 SSE2 完全相同
+
+				AVX2 (two independent ROMix lanes, lane A in the low 128 bits of every YMM register and lane B in the high 128 bits)
+				_mm256_shuffle_epi32 rotates within each 128-bit half separately, so the row rotations are exactly the same as SSE2
+			*/
+
+			template <int Count>
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE __m256i RotateLeftAVX2( __m256i value )
+			{
+				return _mm256_or_si256( _mm256_slli_epi32( value, Count ), _mm256_srli_epi32( value, 32 - Count ) );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE __m256i LoadRowPairAVX2( const std::uint32_t* row_a, const std::uint32_t* row_b )
+			{
+				return _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( reinterpret_cast<const __m128i*>( row_a ) ) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>( row_b ) ), 1 );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE void StoreRowPairAVX2( std::uint32_t* row_a, std::uint32_t* row_b, __m256i value )
+			{
+				_mm_storeu_si128( reinterpret_cast<__m128i*>( row_a ), _mm256_castsi256_si128( value ) );
+				_mm_storeu_si128( reinterpret_cast<__m128i*>( row_b ), _mm256_extracti128_si256( value, 1 ) );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE void Salsa20_8_AVX2( __m256i& row0, __m256i& row1, __m256i& row2, __m256i& row3 )
+			{
+				const __m256i input0 = row0, input1 = row1, input2 = row2, input3 = row3;
+
+				for ( std::int32_t round = 8; round > 0; round -= 2 )
+				{
+					//Odd round (columns)
+					row1 = _mm256_xor_si256( row1, RotateLeftAVX2<7>( _mm256_add_epi32( row0, row3 ) ) );
+					row2 = _mm256_xor_si256( row2, RotateLeftAVX2<9>( _mm256_add_epi32( row1, row0 ) ) );
+					row3 = _mm256_xor_si256( row3, RotateLeftAVX2<13>( _mm256_add_epi32( row2, row1 ) ) );
+					row0 = _mm256_xor_si256( row0, RotateLeftAVX2<18>( _mm256_add_epi32( row3, row2 ) ) );
+
+					row1 = _mm256_shuffle_epi32( row1, 0x93 );
+					row2 = _mm256_shuffle_epi32( row2, 0x4E );
+					row3 = _mm256_shuffle_epi32( row3, 0x39 );
+
+					//Even round (rows)
+					row3 = _mm256_xor_si256( row3, RotateLeftAVX2<7>( _mm256_add_epi32( row0, row1 ) ) );
+					row2 = _mm256_xor_si256( row2, RotateLeftAVX2<9>( _mm256_add_epi32( row3, row0 ) ) );
+					row1 = _mm256_xor_si256( row1, RotateLeftAVX2<13>( _mm256_add_epi32( row2, row3 ) ) );
+					row0 = _mm256_xor_si256( row0, RotateLeftAVX2<18>( _mm256_add_epi32( row1, row2 ) ) );
+
+					row1 = _mm256_shuffle_epi32( row1, 0x39 );
+					row2 = _mm256_shuffle_epi32( row2, 0x4E );
+					row3 = _mm256_shuffle_epi32( row3, 0x93 );
+				}
+
+				row0 = _mm256_add_epi32( row0, input0 );
+				row1 = _mm256_add_epi32( row1, input1 );
+				row2 = _mm256_add_epi32( row2, input2 );
+				row3 = _mm256_add_epi32( row3, input3 );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			void MixBlockAVX2( const std::uint32_t* in_a, const std::uint32_t* in_b, std::uint32_t* out_a, std::uint32_t* out_b, const std::uint64_t block_size )
+			{
+				const std::size_t last_offset = ( 2 * block_size - 1 ) * 16;
+				__m256i row0 = LoadRowPairAVX2( in_a + last_offset, in_b + last_offset );
+				__m256i row1 = LoadRowPairAVX2( in_a + last_offset + 4, in_b + last_offset + 4 );
+				__m256i row2 = LoadRowPairAVX2( in_a + last_offset + 8, in_b + last_offset + 8 );
+				__m256i row3 = LoadRowPairAVX2( in_a + last_offset + 12, in_b + last_offset + 12 );
+
+				for ( std::size_t index = 0; index < 2 * block_size; ++index )
+				{
+					const std::size_t offset = index * 16;
+					row0 = _mm256_xor_si256( row0, LoadRowPairAVX2( in_a + offset, in_b + offset ) );
+					row1 = _mm256_xor_si256( row1, LoadRowPairAVX2( in_a + offset + 4, in_b + offset + 4 ) );
+					row2 = _mm256_xor_si256( row2, LoadRowPairAVX2( in_a + offset + 8, in_b + offset + 8 ) );
+					row3 = _mm256_xor_si256( row3, LoadRowPairAVX2( in_a + offset + 12, in_b + offset + 12 ) );
+
+					Salsa20_8_AVX2( row0, row1, row2, row3 );
+
+					const std::size_t out_offset = ( index / 2 + ( index & 1 ) * block_size ) * 16;
+					StoreRowPairAVX2( out_a + out_offset, out_b + out_offset, row0 );
+					StoreRowPairAVX2( out_a + out_offset + 4, out_b + out_offset + 4, row1 );
+					StoreRowPairAVX2( out_a + out_offset + 8, out_b + out_offset + 8, row2 );
+					StoreRowPairAVX2( out_a + out_offset + 12, out_b + out_offset + 12, row3 );
+				}
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			void ExclusiveOrWordsAVX2( std::uint32_t* destination, const std::uint32_t* source, const std::size_t word_count )
+			{
+				for ( std::size_t index = 0; index < word_count; index += 8 )
+				{
+					const __m256i value = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( destination + index ) ), _mm256_loadu_si256( reinterpret_cast<const __m256i*>( source + index ) ) );
+					_mm256_storeu_si256( reinterpret_cast<__m256i*>( destination + index ), value );
+				}
+			}
+
+			//两个通道的 block_x 都是对角线布局的输入，也是输出；两个通道的 Integerify 互相独立
+			//The block_x of both lanes is the input in the diagonal layout, and also the output; the Integerify of the two lanes is independent
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			void ScryptMixFunctonAVX2
+			(
+				std::uint32_t* block_x_a, std::uint32_t* block_y_a, std::uint32_t* block_v_a,
+				std::uint32_t* block_x_b, std::uint32_t* block_y_b, std::uint32_t* block_v_b,
+				const std::uint64_t block_size, const std::uint64_t resource_cost
+			)
+			{
+				const std::size_t word32_block_size = 32 * block_size;
+
+				for ( std::size_t index = 0; index < resource_cost; index += 2 )
+				{
+					std::memcpy( &block_v_a[ index * word32_block_size ], block_x_a, word32_block_size * sizeof( std::uint32_t ) );
+					std::memcpy( &block_v_b[ index * word32_block_size ], block_x_b, word32_block_size * sizeof( std::uint32_t ) );
+					MixBlockAVX2( block_x_a, block_x_b, block_y_a, block_y_b, block_size );
+					std::memcpy( &block_v_a[ ( index + 1 ) * word32_block_size ], block_y_a, word32_block_size * sizeof( std::uint32_t ) );
+					std::memcpy( &block_v_b[ ( index + 1 ) * word32_block_size ], block_y_b, word32_block_size * sizeof( std::uint32_t ) );
+					MixBlockAVX2( block_y_a, block_y_b, block_x_a, block_x_b, block_size );
+				}
+
+				for ( std::size_t index = 0; index < resource_cost; index += 2 )
+				{
+					std::uint64_t offset_index_a = IntegerifyDiagonal( block_x_a, block_size ) & ( resource_cost - 1 );
+					std::uint64_t offset_index_b = IntegerifyDiagonal( block_x_b, block_size ) & ( resource_cost - 1 );
+					ExclusiveOrWordsAVX2( block_x_a, &block_v_a[ offset_index_a * word32_block_size ], word32_block_size );
+					ExclusiveOrWordsAVX2( block_x_b, &block_v_b[ offset_index_b * word32_block_size ], word32_block_size );
+					MixBlockAVX2( block_x_a, block_x_b, block_y_a, block_y_b, block_size );
+
+					offset_index_a = IntegerifyDiagonal( block_y_a, block_size ) & ( resource_cost - 1 );
+					offset_index_b = IntegerifyDiagonal( block_y_b, block_size ) & ( resource_cost - 1 );
+					ExclusiveOrWordsAVX2( block_y_a, &block_v_a[ offset_index_a * word32_block_size ], word32_block_size );
+					ExclusiveOrWordsAVX2( block_y_b, &block_v_b[ offset_index_b * word32_block_size ], word32_block_size );
+					MixBlockAVX2( block_y_a, block_y_b, block_x_a, block_x_b, block_size );
+				}
+			}
+
+			#endif
+
+			/*
+				用对角线布局的 SIMD 内核处理一个通道 (block_b 为空，SSE2) 或者两个通道 (AVX2)
+				每个通道需要 block_xy 中的 64 * block_size 个字和 block_v 中的 32 * resource_cost * block_size 个字；
+				只有一个通道时 block_xy 和 block_v 只需要这么大，第二个通道的区域只在 block_b 不为空时才会被使用
+
+				Process one lane (block_b empty, SSE2) or two lanes (AVX2) with the SIMD kernels in the diagonal layout
+				Every lane needs 64 * block_size words of block_xy and 32 * resource_cost * block_size words of block_v;
+				With one lane block_xy and block_v only need to be that large, the region of the second lane is only used when block_b is not empty
+			*/
+			void ScryptMixFunctonDiagonal( std::span<std::uint8_t> block_a, std::span<std::uint8_t> block_b, const std::uint64_t block_size, const std::uint64_t resource_cost, std::span<std::uint32_t> block_v, std::span<std::uint32_t> block_xy )
+			{
+				using CommonToolkit::IntegerExchangeBytes::MessagePacking;
+				using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
+
+				const std::size_t		 word32_block_size = 32 * block_size;
+				std::span<std::uint32_t> block_x_a = block_xy.subspan( 0, word32_block_size );
+				std::span<std::uint32_t> block_y_a = block_xy.subspan( word32_block_size, word32_block_size );
+
+				MessagePacking<std::uint32_t, std::uint8_t>( block_a.first( word32_block_size * sizeof( std::uint32_t ) ), block_x_a.data() );
+				ToDiagonalLayout( block_x_a );
+
+				#if defined( TDOM_PROCESSOR_X86 )
+				if ( block_b.empty() )
+					ScryptMixFunctonSSE2( block_x_a.data(), block_y_a.data(), block_v.data(), block_size, resource_cost );
+				else
+				{
+					//第二个通道的区域只有在这里才存在 (SSE2 内核的临时空间只有一个通道大)
+					//The region of the second lane only exists here (the scratch space of the SSE2 kernel is one lane large)
+					std::span<std::uint32_t> block_x_b = block_xy.subspan( 2 * word32_block_size, word32_block_size );
+					std::span<std::uint32_t> block_y_b = block_xy.subspan( 3 * word32_block_size, word32_block_size );
+
+					MessagePacking<std::uint32_t, std::uint8_t>( block_b.first( word32_block_size * sizeof( std::uint32_t ) ), block_x_b.data() );
+					ToDiagonalLayout( block_x_b );
+
+					ScryptMixFunctonAVX2
+					(
+						block_x_a.data(), block_y_a.data(), block_v.data(),
+						block_x_b.data(), block_y_b.data(), block_v.data() + resource_cost * word32_block_size,
+						block_size, resource_cost
+					);
+
+					FromDiagonalLayout( block_x_b );
+					MessageUnpacking<std::uint32_t, std::uint8_t>( block_x_b, block_b.data() );
+				}
+				#endif
+
+				FromDiagonalLayout( block_x_a );
+				MessageUnpacking<std::uint32_t, std::uint8_t>( block_x_a, block_a.data() );
+			}
+		}  // namespace
+
+		Scrypt::SalsaKernelKind Scrypt::SelectSalsaKernel()
+		{
+			static const SalsaKernelKind Selected = []()
+			{
+				const auto& Features = BaseOperation::CurrentProcessorFeatures();
+
+				if ( Features.AVX2 )
+					return SalsaKernelKind::AVX2;
+				if ( Features.SSE2 )
+					return SalsaKernelKind::SSE2;
+				return SalsaKernelKind::Scalar;
+			}();
+
+			return Selected;
+		}
+
 		void Scrypt::Salsa20_WordSpecification( const std::array<std::uint32_t, 16>& in, std::array<std::uint32_t, 16>& out )
 		{
 			std::array<std::uint32_t, 16> words;
@@ -186,15 +561,66 @@ namespace TwilightDreamOfMagical::CommonSecurity
 			// 1: (Block[0] ... Block{ParallelizationCount-1}) = PBKDF2(Password, Salt, 1, ParallelizationCount * MixFunctionLength)
 			std::vector<std::uint8_t> block = pbkdf2.WithSHA2_512( secret_passsword_or_key_byte, salt_data, 1, parallelization_count * 128 * block_size );
 
-			std::vector<std::uint32_t> block_xy( 64 * block_size, 0 );
-			std::vector<std::uint32_t> block_v( 32 * resource_cost * block_size, 0 );
+			//不能使用当前处理器不支持的内核
+			//Never use a kernel that the current processor does not support
+			SalsaKernelKind kernel = this->SalsaKernel;
+			if ( static_cast<std::uint8_t>( kernel ) > static_cast<std::uint8_t>( SelectSalsaKernel() ) )
+				kernel = SelectSalsaKernel();
+
+			/*
+				各个通道互相独立。每个执行者 (线程池的工作线程和调用线程) 有自己的 block_xy 和 block_v，依次处理分给它的通道任务；
+				AVX2 内核一次处理两个通道，所以每份临时空间是两个通道的大小。
 
-			// 2: for index = 0 to ParallelizationCount - 1 do
-			for ( std::size_t index = 0; index < parallelization_count; index++ )
+				The lanes are independent of each other. Every executor (the worker threads of the thread pool and the calling thread) owns its own block_xy and block_v, and processes the lane tasks assigned to it one after another;
+				The AVX2 kernel processes two lanes at a time, so every scratch space is the size of two lanes.
+			*/
+			const std::size_t lanes_per_task = ( kernel == SalsaKernelKind::AVX2 ) ? 2 : 1;
+			const std::size_t lane_task_count = ( parallelization_count + lanes_per_task - 1 ) / lanes_per_task;
+			const std::size_t executor_count = ( LaneThreadPoolPointer != nullptr ) ? LaneThreadPoolPointer->WorkerThreadCount() + 1 : 1;
+			const std::size_t scratch_count = std::min( lane_task_count, executor_count );
+
+			std::vector<std::vector<std::uint32_t>> block_xy_list( scratch_count, std::vector<std::uint32_t>( lanes_per_task * 64 * block_size, 0 ) );
+			std::vector<std::vector<std::uint32_t>> block_v_list( scratch_count, std::vector<std::uint32_t>( lanes_per_task * 32 * resource_cost * block_size, 0 ) );
+
+			auto run_lane_tasks = [ this, &block, &block_xy_list, &block_v_list, kernel, lane_task_count, scratch_count, lanes_per_task, block_size, resource_cost, parallelization_count ]( std::size_t scratch_index )
+			{
+				std::span<std::uint32_t> block_xy { block_xy_list[ scratch_index ] };
+				std::span<std::uint32_t> block_v { block_v_list[ scratch_index ] };
+
+				// 2: for index = 0 to ParallelizationCount - 1 do
+				for ( std::size_t task_index = scratch_index; task_index < lane_task_count; task_index += scratch_count )
+				{
+					const std::size_t index = task_index * lanes_per_task;
+
+					// 3: Block[index] = MixFunction(Block[index], N)
+					std::span<std::uint8_t> slice_block { block.begin() + index * 128 * block_size, block.end() };
+
+					if ( kernel == SalsaKernelKind::Scalar )
+					{
+						this->ScryptMixFuncton( slice_block, block_size, resource_cost, block_v, block_xy );
+						continue;
+					}
+
+					//AVX2 内核剩下的最后一个单独的通道交给 SSE2
+					//The last lone lane of the AVX2 kernel is left to SSE2
+					std::span<std::uint8_t> slice_block_b {};
+					if ( kernel == SalsaKernelKind::AVX2 && index + 1 < parallelization_count )
+						slice_block_b = slice_block.subspan( 128 * block_size, 128 * block_size );
+
+					ScryptMixFunctonDiagonal( slice_block.first( 128 * block_size ), slice_block_b, block_size, resource_cost, block_v, block_xy );
+				}
+			};
+
+			if ( scratch_count == 1 )
+				run_lane_tasks( 0 );
+			else
 			{
-				// 3: Block[index] = MixFunction(Block[index], N)
-				std::span<std::uint8_t> slice_block { block.begin() + index * 128 * block_size, block.end() };
-				this->ScryptMixFuncton( slice_block, block_size, resource_cost, block_v, block_xy );
+				CommonToolkit::WorkStealingThreadPool::TaskGroup lane_tasks;
+
+				for ( std::size_t scratch_index = 0; scratch_index < scratch_count; ++scratch_index )
+					LaneThreadPoolPointer->Submit( lane_tasks, [ &run_lane_tasks, scratch_index ]() { run_lane_tasks( scratch_index ); } );
+
+				LaneThreadPoolPointer->Wait( lane_tasks );
 			}
 
 			// 4: DeriveKey = PBKDF2(Password, Block, 1, DeriveKeyLength)
@@ -202,10 +628,13 @@ namespace TwilightDreamOfMagical::CommonSecurity
 
 			volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( block.data(), block.size() );
 			CheckPointer = nullptr;
-			CheckPointer = memory_set_no_optimize_function<0x00>( block_xy.data(), block_xy.size() * sizeof( std::uint32_t ) );
-			CheckPointer = nullptr;
-			CheckPointer = memory_set_no_optimize_function<0x00>( block_v.data(), block_v.size() * sizeof( std::uint32_t ) );
-			CheckPointer = nullptr;
+			for ( std::size_t scratch_index = 0; scratch_index < scratch_count; ++scratch_index )
+			{
+				CheckPointer = memory_set_no_optimize_function<0x00>( block_xy_list[ scratch_index ].data(), block_xy_list[ scratch_index ].size() * sizeof( std::uint32_t ) );
+				CheckPointer = nullptr;
+				CheckPointer = memory_set_no_optimize_function<0x00>( block_v_list[ scratch_index ].data(), block_v_list[ scratch_index ].size() * sizeof( std::uint32_t ) );
+				CheckPointer = nullptr;
+			}
 
 			return generated_secure_keys;
 		}
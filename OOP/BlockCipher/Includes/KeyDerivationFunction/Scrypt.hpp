@@ -24,6 +24,8 @@
 #define ALGORITHM_OALDRESPUZZLECRYPTIC_SCRYPT_HPP
 
 #include "PBKDF2.hpp"
+#include "../../../ProcessorFeatureDetection.hpp"
+#include "../../../WorkStealingThreadPool.hpp"
 
 namespace TwilightDreamOfMagical::CommonSecurity
 {	namespace KeyDerivationFunction
@@ -33,7 +35,35 @@ namespace TwilightDreamOfMagical::CommonSecurity
 
 		public:
 
+			enum class SalsaKernelKind : std::uint8_t
+			{
+				//逐字的参考实现
+				//Word-by-word reference implementation
+				Scalar,
+				//对角线字布局，一个 XMM 寄存器放一行
+				//Diagonal word layout, one XMM register per row
+				SSE2,
+				//对角线字布局，两个 ROMix 通道共用 YMM 寄存器 (低 128 位和高 128 位各一个通道)
+				//Diagonal word layout, two ROMix lanes share the YMM registers (one lane in each of the low and high 128 bits)
+				AVX2
+			};
+
+			//当前处理器可用的最快 Salsa20/8 内核
+			//The fastest Salsa20/8 kernel available on the current processor
+			static SalsaKernelKind SelectSalsaKernel();
+
 			Scrypt() = default;
+
+			/*
+				指定 Salsa20/8 内核 (当前处理器不支持时会降级) 和执行并行通道的线程池 (空指针表示在调用线程上依次执行)
+				Specify the Salsa20/8 kernel (downgraded when the current processor does not support it) and the thread pool that executes the parallel lanes (null means one after another on the calling thread)
+			*/
+			Scrypt( SalsaKernelKind Kernel, CommonToolkit::WorkStealingThreadPool* LaneThreadPool )
+				:
+				SalsaKernel( Kernel ), LaneThreadPoolPointer( LaneThreadPool )
+			{
+			}
+
 			~Scrypt() = default;
 
 			std::vector<std::uint8_t> GenerateKeys
@@ -98,11 +128,15 @@ namespace TwilightDreamOfMagical::CommonSecurity
 			static constexpr std::size_t DefaultBlockSize = 8;
 			static constexpr std::size_t DefaultParallelizationCount = 1;
 
+			SalsaKernelKind SalsaKernel = SelectSalsaKernel();
+			CommonToolkit::WorkStealingThreadPool* LaneThreadPoolPointer = std::addressof( CommonToolkit::WorkStealingThreadPool::Shared() );
+
 			void Salsa20_WordSpecification( const std::array<std::uint32_t, 16>& in, std::array<std::uint32_t, 16>& out );
 			std::array<std::uint32_t, 16> ExclusiveOrBlock( std::span<const std::uint32_t> left, std::span<const std::uint32_t> right );
 			void MixBlock( std::array<std::uint32_t, 16>& word32_buffer, std::span<const std::uint32_t> in, std::span<std::uint32_t> out, const std::uint64_t block_size );
 			std::uint64_t Integerify( std::span<std::uint32_t> block, const std::uint64_t block_size );
 			void ScryptMixFuncton( std::span<std::uint8_t> block, const std::uint64_t& block_size, const std::uint64_t resource_cost, std::span<std::uint32_t> block_v, std::span<std::uint32_t> block_xy );
+
 			std::vector<std::uint8_t> DoGenerateKeys( std::span<std::uint8_t> secret_passsword_or_key_byte, std::span<std::uint8_t> salt_data, std::uint64_t& result_byte_size, std::uint64_t& resource_cost, std::uint64_t& block_size, std::uint64_t& parallelization_count );
 		};
 	}
@@ -1977,6 +1977,14 @@ namespace TwilightDreamOfMagical::CustomSecurity
 		//https://en.wikipedia.org/wiki/Chaos_theory
 		namespace ChaoticTheory
 		{
+			//快速模式的浮点代码不允许把乘法和加法合并成 FMA, 否则不同的目标 (例如 -march=native) 会得到不同的比特流
+			//The floating point code of the fast mode must not contract multiply and add into FMA, otherwise different targets (e.g. -march=native) produce different bit streams
+			#if defined(__GNUC__) && !defined(__clang__)
+			#define TDOM_STRICT_FLOATING_POINT __attribute__((optimize("fp-contract=off")))
+			#else
+			#define TDOM_STRICT_FLOATING_POINT
+			#endif
+
 			//模拟双段摆锤物理系统，根据二进制密钥生成伪随机数
 			//Simulate a two-segment pendulum physical system to generate pseudo-random numbers based on a binary key
 			//https://zh.wikipedia.org/wiki/%E5%8F%8C%E6%91%86
@@ -1986,6 +1994,27 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			class SimulateDoublePendulum
 			{
 
+			public:
+
+				/*
+					求值模式:
+					compatible_long_double 是默认模式, 每次输出都用 long double 积分一个摆锤, 保持现有的比特流。
+					fast_double_v1 是可选的快速模式: 同一个动力系统, 但用 double 精度同时积分几个独立的摆锤, 三角函数是固定的多项式, 只用 IEEE 的基本运算。
+					它的初始状态直接从种子的整数比特得到, 不经过 long double 和数学库的 sin/cos, 所以在 IEEE double 严格求值的平台上 (x86-64 的 GCC/Clang/MSVC, aarch64), 输出与 long double 的宽度和数学库无关。
+					它是另一条比特流, 以后如果改动, 要加新的版本号而不是修改 v1。
+
+					Evaluation mode:
+					compatible_long_double is the default mode, integrates one pendulum in long double for every output and keeps the current bit stream.
+					fast_double_v1 is the opt-in fast mode: the same dynamical system, but several independent pendulums integrated together in double precision, with fixed polynomial trigonometric functions using only IEEE basic operations.
+					Its initial state comes straight from the integer bits of the seed, without going through long double or the sin/cos of the math library, so on platforms with strict IEEE double evaluation (GCC/Clang/MSVC on x86-64, aarch64) the output does not depend on the width of long double or on the math library.
+					It is a different bit stream; any future change must add a new version instead of modifying v1.
+				*/
+				enum class evaluation_mode : std::uint32_t
+				{
+					compatible_long_double = 0,
+					fast_double_v1 = 1
+				};
+
 			private:
 
 				using result_type = std::uint64_t;
@@ -1997,6 +2026,203 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				static constexpr long double gravity_coefficient = 9.8;
 				static constexpr long double hight = 0.002;
 
+				//快速模式里同时积分的摆锤个数, 以及每个摆锤开始输出之前的预热步数
+				//Number of pendulums integrated together in fast mode, and the warm-up steps of each pendulum before it starts producing output
+				static constexpr std::size_t fast_lane_count = 4;
+				static constexpr std::size_t fast_warm_up_steps = 128;
+
+				//快速模式的状态 (结构数组布局, 每个数组一个摆锤一个元素), 可以直接按字节复制
+				//State of the fast mode (structure-of-arrays layout, one element per pendulum in each array), trivially copyable
+				struct fast_state_type
+				{
+					std::array<double, fast_lane_count> tension1{};
+					std::array<double, fast_lane_count> tension2{};
+					std::array<double, fast_lane_count> velocity1{};
+					std::array<double, fast_lane_count> velocity2{};
+					double length1 = 0.0;
+					double length2 = 0.0;
+					double mass1 = 0.0;
+					double mass2 = 0.0;
+					std::array<result_type, fast_lane_count> pending_numbers{};
+					std::uint64_t pending_index = fast_lane_count;
+				};
+
+				evaluation_mode current_evaluation_mode = evaluation_mode::compatible_long_double;
+				fast_state_type fast_state{};
+
+				//最近一次播种的 7 个参数的定点比特 (参数 j 的第 i 个比特表示 2^-i, 半径的表示 2^(4-i)) 和二进制密钥序列的长度, 快速模式只从它们开始
+				//Fixed-point bits of the 7 parameters of the most recent seeding (bit i of parameter j stands for 2^-i, of the radius for 2^(4-i)) and the length of the binary key sequence; the fast mode starts only from these
+				std::array<std::uint64_t, 7> seed_parameter_bits{};
+				std::uint64_t seed_sequence_size = 0;
+
+				//把 |x| < 2^51 的 double 舍入到最近的整数 (平局取偶): 加上再减去 1.5 * 2^52, 只用 IEEE 的加减法
+				//Round a double with |x| < 2^51 to the nearest integer (ties to even): add and subtract 1.5 * 2^52, using only IEEE addition and subtraction
+				static constexpr double fast_round_constant = 6755399441055744.0;
+
+				//同时求 sin(x) 和 cos(x): 按 pi/2 做 Cody-Waite 约化, 然后在 [-pi/4, pi/4] 上用 fdlibm 的多项式系数, 象限用选择而不是分支
+				//Compute sin(x) and cos(x) together: Cody-Waite reduction by pi/2, then the fdlibm polynomial coefficients on [-pi/4, pi/4], with the quadrant applied by selection rather than branches
+				TDOM_STRICT_FLOATING_POINT
+				static inline void fast_sin_cos(double x, double& sine, double& cosine)
+				{
+				#if defined(__clang__)
+					#pragma STDC FP_CONTRACT OFF
+				#endif
+
+					constexpr double two_over_pi = 6.36619772367581382433e-01;
+					constexpr double pi_over_two_high = 1.57079632673412561417e+00;
+					constexpr double pi_over_two_low = 6.07710050650619224932e-11;
+
+					const double shifted_quadrant = x * two_over_pi + fast_round_constant;
+					const double quadrant_number = shifted_quadrant - fast_round_constant;
+					const double reduced = (x - quadrant_number * pi_over_two_high) - quadrant_number * pi_over_two_low;
+					const double square = reduced * reduced;
+
+					const double sine_polynomial = -1.66666666666666324348e-01 + square * (8.33333333332248946124e-03 + square * (-1.98412698298579493134e-04 + square * (2.75573137070700676789e-06 + square * (-2.50507602534068634195e-08 + square * 1.58969099521155010221e-10))));
+					const double cosine_polynomial = 4.16666666666666019037e-02 + square * (-1.38888888888741095749e-03 + square * (2.48015872894767294178e-05 + square * (-2.75573143513906633035e-07 + square * (2.08757232129817482790e-09 + square * -1.13596475577881948265e-11))));
+
+					const double reduced_sine = reduced + reduced * square * sine_polynomial;
+					const double reduced_cosine = 1.0 - 0.5 * square + square * square * cosine_polynomial;
+
+					//象限就是移位后尾数的最低两位
+					//The quadrant is the lowest two bits of the shifted mantissa
+					const std::uint64_t quadrant = std::bit_cast<std::uint64_t>(shifted_quadrant) & 3;
+					const double swapped_sine = (quadrant & 1) ? reduced_cosine : reduced_sine;
+					const double swapped_cosine = (quadrant & 1) ? reduced_sine : reduced_cosine;
+					sine = (quadrant & 2) ? -swapped_sine : swapped_sine;
+					cosine = ((quadrant + 1) & 2) ? -swapped_cosine : swapped_cosine;
+				}
+
+				//floor(fmod(value, 1.0) * 2^32), 对 |value| < 2^52 逐位相同, 但只用截断转换和 IEEE 运算, 不调用数学库
+				//floor(fmod(value, 1.0) * 2^32), bit-identical for |value| < 2^52, but using only truncating conversion and IEEE arithmetic, without calling the math library
+				TDOM_STRICT_FLOATING_POINT
+				static inline std::int64_t fast_fraction_bits(double value)
+				{
+					const double fraction = value - static_cast<double>(static_cast<std::int64_t>(value));
+					const double scaled = fraction * 4294967296.0;
+					const std::int64_t truncated = static_cast<std::int64_t>(scaled);
+					return truncated - ((scaled < static_cast<double>(truncated)) ? 1 : 0);
+				}
+
+				//所有摆锤各积分一步, 与 run_system 的公式相同
+				//Advance every pendulum by one step, with the same formula as run_system
+				TDOM_STRICT_FLOATING_POINT
+				void run_fast_system()
+				{
+				#if defined(__clang__)
+					#pragma STDC FP_CONTRACT OFF
+				#endif
+
+					constexpr double gravity = static_cast<double>(gravity_coefficient);
+					constexpr double step = static_cast<double>(hight);
+					const double length1 = fast_state.length1;
+					const double length2 = fast_state.length2;
+					const double mass1 = fast_state.mass1;
+					const double mass2 = fast_state.mass2;
+
+					for (std::size_t lane = 0; lane < fast_lane_count; ++lane)
+					{
+						double& tension1 = fast_state.tension1[lane];
+						double& tension2 = fast_state.tension2[lane];
+						double& velocity1 = fast_state.velocity1[lane];
+						double& velocity2 = fast_state.velocity2[lane];
+
+						double sine1, cosine1, sine_difference, cosine_difference, sine_a, cosine_a, sine_b, cosine_b;
+						fast_sin_cos(tension1, sine1, cosine1);
+						fast_sin_cos(tension1 - tension2, sine_difference, cosine_difference);
+						fast_sin_cos(tension1 - 2 * tension2, sine_a, cosine_a);
+						fast_sin_cos(2 * tension1 - 2 * tension2, sine_b, cosine_b);
+
+						const double denominator = 2 * mass1 + mass2 - mass2 * cosine_b;
+
+						double alpha1 = -1 * gravity * (2 * mass1 + mass2) * sine1
+							- mass2 * gravity * sine_a
+							- 2 * sine_difference * mass2
+							* (velocity2 * velocity2 * length2 + velocity1 * velocity1 * length1 * cosine_difference);
+
+						alpha1 /= length1 * denominator;
+
+						double alpha2 = 2 * sine_difference
+							* (velocity1 * velocity1 * length1 * (mass1 + mass2) + gravity * (mass1 + mass2) * cosine1 + velocity2 * velocity2 * length2 * mass2 * cosine_difference);
+
+						alpha2 /= length2 * denominator;
+
+						velocity1 += step * alpha1;
+						velocity2 += step * alpha2;
+						tension1 += step * velocity1;
+						tension2 += step * velocity2;
+					}
+				}
+
+				//积分一步, 每个摆锤产生一个输出 (与 generate 的输出公式相同)
+				//Integrate one step and produce one output per pendulum (same output formula as generate)
+				TDOM_STRICT_FLOATING_POINT
+				void generate_fast_numbers(result_type* random_numbers)
+				{
+				#if defined(__clang__)
+					#pragma STDC FP_CONTRACT OFF
+				#endif
+
+					this->run_fast_system();
+
+					for (std::size_t lane = 0; lane < fast_lane_count; ++lane)
+					{
+						double sine1, cosine1, sine2, cosine2;
+						fast_sin_cos(fast_state.tension1[lane], sine1, cosine1);
+						fast_sin_cos(fast_state.tension2[lane], sine2, cosine2);
+
+						const double temporary_floating_a = fast_state.length1 * sine1 + fast_state.length2 * sine2;
+						const double temporary_floating_b = -(fast_state.length1) * sine1 - fast_state.length2 * sine2;
+
+						const std::int64_t left_number = fast_fraction_bits( temporary_floating_a * 1000 );
+						const std::int64_t right_number = fast_fraction_bits( temporary_floating_b * 1000 );
+
+						random_numbers[lane] = static_cast<result_type>(this->concat(static_cast<std::int32_t>(left_number), static_cast<std::int32_t>(right_number)));
+					}
+				}
+
+				/*
+					从种子的整数比特派生快速模式的摆锤: 长度、质量和角度是定点比特乘以 2^-63 (整数到 double 的转换和乘以 2 的幂都是 IEEE 确定的), 速度从 0 开始,
+					摆锤 i 的两个角度错开 i * 2^-20; 然后用 run_fast_system 积分 round(半径 * 序列长度) 步 (与 initialize 对应, 用整数计算, 半径取高 32 位), 再预热。
+					这里不读取 long double 状态, 所以结果只取决于种子。
+
+					Derive the fast-mode pendulums from the integer bits of the seed: the lengths, masses and angles are the fixed-point bits times 2^-63 (integer to double conversion and scaling by a power of 2 are exact IEEE operations), the velocities start from 0,
+					and the two angles of pendulum i are offset by i * 2^-20; then run_fast_system integrates round(radius * sequence length) steps (mirroring initialize, computed in integers from the top 32 bits of the radius), followed by the warm-up.
+					No long double state is read here, so the result only depends on the seed.
+				*/
+				TDOM_STRICT_FLOATING_POINT
+				void initialize_fast_state()
+				{
+					constexpr double fixed_point_scale = 0x1p-63;
+
+					fast_state.length1 = static_cast<double>(this->seed_parameter_bits[0]) * fixed_point_scale;
+					fast_state.length2 = static_cast<double>(this->seed_parameter_bits[1]) * fixed_point_scale;
+					fast_state.mass1 = static_cast<double>(this->seed_parameter_bits[2]) * fixed_point_scale;
+					fast_state.mass2 = static_cast<double>(this->seed_parameter_bits[3]) * fixed_point_scale;
+
+					const double tension1 = static_cast<double>(this->seed_parameter_bits[4]) * fixed_point_scale;
+					const double tension2 = static_cast<double>(this->seed_parameter_bits[5]) * fixed_point_scale;
+
+					for (std::size_t lane = 0; lane < fast_lane_count; ++lane)
+					{
+						const double offset = static_cast<double>(lane) * 9.5367431640625e-07;
+						fast_state.tension1[lane] = tension1 + offset;
+						fast_state.tension2[lane] = tension2 - offset;
+						fast_state.velocity1[lane] = 0.0;
+						fast_state.velocity2[lane] = 0.0;
+					}
+
+					//半径 = 比特 * 2^-59, 高 32 位就是 半径 * 2^27
+					//radius = bits * 2^-59, so the top 32 bits are radius * 2^27
+					const std::uint64_t radius_high_bits = this->seed_parameter_bits[6] >> 32;
+					const std::uint64_t seeding_steps = (radius_high_bits * this->seed_sequence_size + (std::uint64_t(1) << 26)) >> 27;
+
+					for (std::uint64_t step = 0; step < seeding_steps + fast_warm_up_steps; ++step)
+						this->run_fast_system();
+
+					fast_state.pending_numbers.fill(0);
+					fast_state.pending_index = fast_lane_count;
+				}
+
 				void run_system(bool is_initialize_mode, std::uint64_t time)
 				{
 					const long double& length1 = this->SystemData[0];
@@ -2085,18 +2311,30 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					long double& radius = this->SystemData[6];
 					long double& current_binary_key_sequence_size = this->SystemData[7];
 
+					this->seed_parameter_bits.fill(0);
+
 					for (std::int32_t i = 0; i < 64; i++)
 					{
 						for (std::int32_t j = 0; j < 6; j++)
 						{
 							if (binary_key_sequence_2d_param[j][i] == 1)
+							{
 								this->SystemData[j] += 1 * ::powl(2.0, 0 - i);
+								this->seed_parameter_bits[j] |= std::uint64_t(1) << (63 - i);
+							}
 						}
 						if (binary_key_sequence_2d_param[6][i] == 1)
+						{
 							radius += 1 * ::powl(2.0, 4 - i);
+							this->seed_parameter_bits[6] |= std::uint64_t(1) << (63 - i);
+						}
 					}
 
 					current_binary_key_sequence_size = static_cast<long double>(binary_key_sequence_size);
+					this->seed_sequence_size = static_cast<std::uint64_t>(binary_key_sequence_size);
+
+					if (current_evaluation_mode == evaluation_mode::fast_double_v1)
+						this->initialize_fast_state();
 
 					//This is initialize mode
 					this->run_system(true, static_cast<std::uint64_t>(::round(radius * current_binary_key_sequence_size)));
@@ -2122,6 +2360,16 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 				std::int64_t generate()
 				{
+					if (current_evaluation_mode == evaluation_mode::fast_double_v1)
+					{
+						if (fast_state.pending_index >= fast_lane_count)
+						{
+							this->generate_fast_numbers(fast_state.pending_numbers.data());
+							fast_state.pending_index = 0;
+						}
+						return static_cast<std::int64_t>(fast_state.pending_numbers[fast_state.pending_index++]);
+					}
+
 					//This is generate mode
 					this->run_system(false, 1);
 
@@ -2172,6 +2420,27 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					return random_numbers;
 				}
 
+				//批量生成整个 64 位范围的伪随机数, 与逐个调用 operator()(min(), max()) 的结果和顺序相同
+				//Bulk generate pseudo-random numbers over the full 64-bit range, with the same values and order as calling operator()(min(), max()) one by one
+				void generate(std::span<result_type> random_numbers)
+				{
+					std::size_t index = 0;
+
+					if (current_evaluation_mode == evaluation_mode::fast_double_v1)
+					{
+						//先用完上一次剩下的输出, 然后整批直接写到调用者的缓冲区
+						//Use up the outputs left over from last time first, then write whole batches straight into the caller's buffer
+						while (index < random_numbers.size() && fast_state.pending_index < fast_lane_count)
+							random_numbers[index++] = fast_state.pending_numbers[fast_state.pending_index++];
+
+						for (; index + fast_lane_count <= random_numbers.size(); index += fast_lane_count)
+							this->generate_fast_numbers(random_numbers.data() + index);
+					}
+
+					for (; index < random_numbers.size(); ++index)
+						random_numbers[index] = static_cast<result_type>(this->generate());
+				}
+
 				result_type operator()(std::uint64_t min_number, std::uint64_t max_number)
 				{
 					std::int64_t modulus = static_cast<std::int64_t>(max_number) - static_cast<std::int64_t>(min_number) + 1;
@@ -2196,6 +2465,37 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					this->SystemData[5] = this->BackupTensions[1];
 					this->SystemData[8] = this->BackupVelocitys[0];
 					this->SystemData[9] = this->BackupVelocitys[1];
+
+					if (current_evaluation_mode == evaluation_mode::fast_double_v1)
+						this->initialize_fast_state();
+				}
+
+				/*
+					切换求值模式。切换到快速模式时摆锤从种子重新开始 (与之前生成过多少输出无关); 在快速模式下 long double 状态保持不变, 切换回兼容模式后从原处继续。
+					Switch the evaluation mode. Switching to fast mode restarts the pendulums from the seed (regardless of how many outputs were generated before); the long double state is left untouched while in fast mode and continues from where it was after switching back to compatibility mode.
+				*/
+				void set_evaluation_mode(evaluation_mode mode)
+				{
+					if (mode == current_evaluation_mode)
+						return;
+
+					my_cpp2020_assert
+					(
+						mode == evaluation_mode::compatible_long_double || mode == evaluation_mode::fast_double_v1,
+						"RNG_ChaoticTheory::SimulateDoublePendulum: Unknown evaluation mode!",
+						std::source_location::current()
+					);
+
+					current_evaluation_mode = mode;
+					if (mode == evaluation_mode::fast_double_v1)
+						this->initialize_fast_state();
+					else
+						fast_state = fast_state_type{};
+				}
+
+				evaluation_mode get_evaluation_mode() const
+				{
+					return current_evaluation_mode;
 				}
 
 				void seed_with_binary_string(std::string binary_key_sequence_string)
@@ -2235,6 +2535,48 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 				}
 
+				//内部状态的扁平字节表示，给状态快照和恢复使用
+				//Flat byte image of the internal state, used by state snapshot and restore
+				static constexpr std::size_t state_byte_size = sizeof(std::array<long double, 2>) * 2 + sizeof(std::array<long double, 10>) + sizeof(evaluation_mode) + sizeof(fast_state_type) + sizeof(std::array<std::uint64_t, 7>) + sizeof(std::uint64_t);
+
+				void save_state(std::span<std::uint8_t> state_bytes) const
+				{
+					my_cpp2020_assert(state_bytes.size() >= state_byte_size, "The state snapshot buffer is too small!", std::source_location::current());
+					std::size_t byte_offset = 0;
+					std::memcpy(state_bytes.data() + byte_offset, this->BackupTensions.data(), sizeof(this->BackupTensions));
+					byte_offset += sizeof(this->BackupTensions);
+					std::memcpy(state_bytes.data() + byte_offset, this->BackupVelocitys.data(), sizeof(this->BackupVelocitys));
+					byte_offset += sizeof(this->BackupVelocitys);
+					std::memcpy(state_bytes.data() + byte_offset, this->SystemData.data(), sizeof(this->SystemData));
+					byte_offset += sizeof(this->SystemData);
+					std::memcpy(state_bytes.data() + byte_offset, &this->current_evaluation_mode, sizeof(this->current_evaluation_mode));
+					byte_offset += sizeof(this->current_evaluation_mode);
+					std::memcpy(state_bytes.data() + byte_offset, &this->fast_state, sizeof(this->fast_state));
+					byte_offset += sizeof(this->fast_state);
+					std::memcpy(state_bytes.data() + byte_offset, this->seed_parameter_bits.data(), sizeof(this->seed_parameter_bits));
+					byte_offset += sizeof(this->seed_parameter_bits);
+					std::memcpy(state_bytes.data() + byte_offset, &this->seed_sequence_size, sizeof(this->seed_sequence_size));
+				}
+
+				void load_state(std::span<const std::uint8_t> state_bytes)
+				{
+					my_cpp2020_assert(state_bytes.size() >= state_byte_size, "The state snapshot buffer is too small!", std::source_location::current());
+					std::size_t byte_offset = 0;
+					std::memcpy(this->BackupTensions.data(), state_bytes.data() + byte_offset, sizeof(this->BackupTensions));
+					byte_offset += sizeof(this->BackupTensions);
+					std::memcpy(this->BackupVelocitys.data(), state_bytes.data() + byte_offset, sizeof(this->BackupVelocitys));
+					byte_offset += sizeof(this->BackupVelocitys);
+					std::memcpy(this->SystemData.data(), state_bytes.data() + byte_offset, sizeof(this->SystemData));
+					byte_offset += sizeof(this->SystemData);
+					std::memcpy(&this->current_evaluation_mode, state_bytes.data() + byte_offset, sizeof(this->current_evaluation_mode));
+					byte_offset += sizeof(this->current_evaluation_mode);
+					std::memcpy(&this->fast_state, state_bytes.data() + byte_offset, sizeof(this->fast_state));
+					byte_offset += sizeof(this->fast_state);
+					std::memcpy(this->seed_parameter_bits.data(), state_bytes.data() + byte_offset, sizeof(this->seed_parameter_bits));
+					byte_offset += sizeof(this->seed_parameter_bits);
+					std::memcpy(&this->seed_sequence_size, state_bytes.data() + byte_offset, sizeof(this->seed_sequence_size));
+				}
+
 				explicit SimulateDoublePendulum(auto number)
 				{
 					using SeedNumberType = decltype(number);
@@ -2246,6 +2588,11 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					this->BackupVelocitys.fill(0.0);
 					this->BackupTensions.fill(0.0);
 					this->SystemData.fill(0.0);
+					volatile void* CheckPointer = memory_set_no_optimize_function<0x00>(&this->fast_state, sizeof(this->fast_state));
+					CheckPointer = nullptr;
+					CheckPointer = memory_set_no_optimize_function<0x00>(this->seed_parameter_bits.data(), sizeof(this->seed_parameter_bits));
+					CheckPointer = nullptr;
+					this->seed_sequence_size = 0;
 				}
 			};
 		}
@@ -2271,46 +2618,75 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				*/
 				std::array<result_type, 2> state{};
 
-			public:
+				//一次跳跃推进的最大步数
+				//Maximum number of steps advanced by one leap
+				static constexpr std::size_t leap_bits = 32;
 
-				result_type generate_bits(std::size_t bits_size)
+				static constexpr result_type reverse_bits(result_type value)
+				{
+					value = ((value >> 1) & 0x5555555555555555ULL) | ((value & 0x5555555555555555ULL) << 1);
+					value = ((value >> 2) & 0x3333333333333333ULL) | ((value & 0x3333333333333333ULL) << 2);
+					value = ((value >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((value & 0x0F0F0F0F0F0F0F0FULL) << 4);
+					value = ((value >> 8) & 0x00FF00FF00FF00FFULL) | ((value & 0x00FF00FF00FF00FFULL) << 8);
+					value = ((value >> 16) & 0x0000FFFF0000FFFFULL) | ((value & 0x0000FFFF0000FFFFULL) << 16);
+					return (value >> 32) | (value << 32);
+				}
+
+				/*
+					把 128 位寄存器 R = (NumberA : NumberB) 一次推进 step_count (1..32) 步，返回这些步的反馈位 (第 t 位是第 t 步的反馈位)。
+					每一步 R 右移一位，反馈位 fb 进入 R[127]，fb_t = R_t[0] ^ R_t[87] ^ R_t[89] ^ R_t[127]。
+					在 32 步之内前三个抽头都还是原来的比特 R[t]、R[87 + t]、R[89 + t]，而 R_t[127] 正是上一步的反馈位 fb_{t-1} (t = 0 时是 R[127])，
+					所以 fb_t = R[127] ^ X_0 ^ ... ^ X_t，其中 X = NumberB ^ (NumberA >> 23) ^ (NumberA >> 25)，也就是 X 的前缀异或。
+
+					Advance the 128-bit register R = (NumberA : NumberB) by step_count (1..32) steps at once, and return the feedback bits of those steps (bit t is the feedback bit of step t).
+					Every step shifts R right by one and the feedback bit fb enters R[127], with fb_t = R_t[0] ^ R_t[87] ^ R_t[89] ^ R_t[127].
+					Within 32 steps the first three taps are still the original bits R[t], R[87 + t], R[89 + t], and R_t[127] is exactly the previous feedback bit fb_{t-1} (R[127] for t = 0),
+					so fb_t = R[127] ^ X_0 ^ ... ^ X_t with X = NumberB ^ (NumberA >> 23) ^ (NumberA >> 25), i.e. the prefix XOR of X.
+				*/
+				result_type leap(std::size_t step_count)
 				{
 					result_type& NumberA = state[0];
 					result_type& NumberB = state[1];
 
-					result_type current_random_bit = 0;
+					result_type feedback_bits = NumberB ^ (NumberA >> 23) ^ (NumberA >> 25);
+					feedback_bits ^= feedback_bits << 1;
+					feedback_bits ^= feedback_bits << 2;
+					feedback_bits ^= feedback_bits << 4;
+					feedback_bits ^= feedback_bits << 8;
+					feedback_bits ^= feedback_bits << 16;
+					feedback_bits ^= 0ULL - (NumberA >> 63);
+					feedback_bits &= (result_type(1) << step_count) - 1;
+
+					NumberB = (NumberB >> step_count) | (NumberA << (64 - step_count));
+					NumberA = (NumberA >> step_count) | (feedback_bits << (64 - step_count));
+
+					return feedback_bits;
+				}
+
+			public:
+
+				result_type generate_bits(std::size_t bits_size)
+				{
+					//计算二进制的伪随机比特序列
+					//Compute pseudo-random bit sequences in binary
+					//这个多项式是 : x^128 + x^41 + x^39 + x + 1
+					//This polynomial is : x^128 + x^41 + x^39 + x + 1
+					//举一个例子，这个多项式的最高系数是128
+					//As an example, the highest coefficient of this polynomial is 128.
 
 					//多项式的初始值可以是：128,126,101,99
 					//The initial values of the polynomial can be: 128,126,101,99
 					result_type answer = 128;
-					for (std::size_t round_counter = 0; round_counter < bits_size; ++round_counter)
-					{
-						//计算二进制的伪随机比特序列
-						//Compute pseudo-random bit sequences in binary
-						//这个多项式是 : x^128 + x^41 + x^39 + x + 1
-						//This polynomial is : x^128 + x^41 + x^39 + x + 1
-						//举一个例子，这个多项式的最高系数是128
-						//As an example, the highest coefficient of this polynomial is 128.
-						std::uint64_t&& irreducible_primitive_polynomial = NumberB ^ (NumberA >> 23) ^ (NumberA >> 25) ^ (NumberA >> 63);
-
-						//只保留一个二进制的随机比特位
-						//Only one binary random bit is retained
-						current_random_bit = irreducible_primitive_polynomial & 0x01; //Feedback bit
-
-						//左移答案的比特位
-						//Shift the bits of the answer to the left
-						answer <<= 1;
 
-						//用当前随机位切换答案位
-						//Toggle the answer bit with the current random bit
-						answer ^= current_random_bit;
+					//逐步实现里，答案每步左移一位再异或上反馈位，所以最先产生的反馈位在最高位: 一次跳跃后把反馈位倒序接到答案后面
+					//In the step-by-step form the answer is shifted left by one and XORed with the feedback bit on every step, so the earliest feedback bit ends up highest: after each leap append the feedback bits in reverse order
+					while (bits_size > 0)
+					{
+						const std::size_t step_count = (bits_size < leap_bits) ? bits_size : leap_bits;
+						const result_type feedback_bits = this->leap(step_count);
 
-						//右移状态寄存器比特位
-						//Shift the bits of the status register to the right
-						NumberB >>= 1;
-						NumberB |= (NumberA & 0x01) << 63;
-						NumberA >>= 1;
-						NumberA |= current_random_bit << 63;
+						answer = (answer << step_count) ^ (reverse_bits(feedback_bits) >> (64 - step_count));
+						bits_size -= step_count;
 					}
 					return answer;
 				}
@@ -2320,6 +2696,26 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					return this->generate_bits(63);
 				}
 
+				//批量生成，与逐个调用 operator() 的结果和顺序相同
+				//Bulk generate, with the same values and order as calling operator() one by one
+				void generate(std::span<result_type> random_numbers)
+				{
+					for (auto& random_number : random_numbers)
+						random_number = this->generate_bits(63);
+				}
+
+				//向前跳过 bits_size 个比特 (等价于 generate_bits(bits_size) 但不组装答案)
+				//Leap forward by bits_size bits (equivalent to generate_bits(bits_size) without assembling the answer)
+				void discard_bits(std::size_t bits_size)
+				{
+					while (bits_size > 0)
+					{
+						const std::size_t step_count = (bits_size < leap_bits) ? bits_size : leap_bits;
+						(void)this->leap(step_count);
+						bits_size -= step_count;
+					}
+				}
+
 				static constexpr result_type min()
 				{
 					return 0ULL;
@@ -2335,10 +2731,25 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					*this = LinearFeedbackShiftRegister(seed);
 				}
 
+				//内部状态的扁平字节表示，给状态快照和恢复使用
+				//Flat byte image of the internal state, used by state snapshot and restore
+				static constexpr std::size_t state_byte_size = sizeof(std::array<result_type, 2>);
+
+				void save_state(std::span<std::uint8_t> state_bytes) const
+				{
+					my_cpp2020_assert(state_bytes.size() >= state_byte_size, "The state snapshot buffer is too small!", std::source_location::current());
+					std::memcpy(state_bytes.data(), state.data(), state_byte_size);
+				}
+
+				void load_state(std::span<const std::uint8_t> state_bytes)
+				{
+					my_cpp2020_assert(state_bytes.size() >= state_byte_size, "The state snapshot buffer is too small!", std::source_location::current());
+					std::memcpy(state.data(), state_bytes.data(), state_byte_size);
+				}
+
 				void discard(std::size_t round_number)
 				{
-					for (std::size_t round_counter = 0; round_counter < round_number; ++round_counter)
-						this->generate_bits(64);
+					this->discard_bits(round_number * 64);
 				}
 
 #ifndef BOOST_RANDOM_NO_STREAM_OPERATORS
@@ -2767,6 +3178,27 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					return answer;
 				}
 
+				/*
+					批量生成，与逐个调用 operator() 的结果和顺序相同。
+					门控每一步都由当前状态选出不同的反馈多项式，所以不存在固定的转移矩阵，不能像线性反馈移位寄存器那样一次跳跃多步；这里只省掉逐个调用的开销。
+
+					Bulk generate, with the same values and order as calling operator() one by one.
+					The gate picks different feedback polynomials from the current state on every step, so there is no fixed transition matrix and no multi-step leap as in the linear feedback shift register; this only saves the per-call overhead.
+				*/
+				void generate(std::span<result_type> random_numbers)
+				{
+					for (auto& random_number : random_numbers)
+					{
+						result_type answer = 0;
+						for (std::size_t i = 0; i < 64; ++i)
+						{
+							answer <<= 1;
+							answer |= static_cast<result_type>(this->next_nlfsr_bit());
+						}
+						random_number = answer;
+					}
+				}
+
 				static constexpr result_type min()
 				{
 					return 0;
@@ -2782,6 +3214,22 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					*this = NonlinearFeedbackShiftRegister(seed);
 				}
 
+				//内部状态的扁平字节表示，给状态快照和恢复使用
+				//Flat byte image of the internal state, used by state snapshot and restore
+				static constexpr std::size_t state_byte_size = sizeof(std::array<result_type, 4>);
+
+				void save_state(std::span<std::uint8_t> state_bytes) const
+				{
+					my_cpp2020_assert(state_bytes.size() >= state_byte_size, "The state snapshot buffer is too small!", std::source_location::current());
+					std::memcpy(state_bytes.data(), state.data(), state_byte_size);
+				}
+
+				void load_state(std::span<const std::uint8_t> state_bytes)
+				{
+					my_cpp2020_assert(state_bytes.size() >= state_byte_size, "The state snapshot buffer is too small!", std::source_location::current());
+					std::memcpy(state.data(), state_bytes.data(), state_byte_size);
+				}
+
 				void discard(std::size_t round_number)
 				{
 					if (round_number == 0)
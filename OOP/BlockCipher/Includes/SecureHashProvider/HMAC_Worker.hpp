@@ -58,16 +58,31 @@ namespace TwilightDreamOfMagical::CommonSecurity
 
 			~HMAC_Worker()
 			{
-				if(SHA2_512_Pointer != nullptr)
-					SHA2_512_Pointer.reset();
+				//填充过的密钥是密钥材料，离开时擦除
+				//The padded keys are key material, wipe them on the way out
+				volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( OuterPaddedKeys.data(), OuterPaddedKeys.size() );
+				CheckPointer = nullptr;
+				CheckPointer = memory_set_no_optimize_function<0x00>( InnerPaddedKeys.data(), InnerPaddedKeys.size() );
+				CheckPointer = nullptr;
+
+				//散列函数实例由调用者拥有，这里只解除借用
+				//The hash function instance is owned by the caller, only release the borrow here
+				SHA2_512_Pointer = nullptr;
 			}
 
 			void GivenKeyWith_SHA2_512(const std::string& Key)
+			{
+				this->GivenKeyWith_SHA2_512( std::span<const std::uint8_t>( reinterpret_cast<const std::uint8_t*>( Key.data() ), Key.size() ) );
+			}
+
+			//直接使用调用者的密钥字节，不复制一份字符串
+			//Uses the key bytes of the caller directly, without copying them into a string
+			void GivenKeyWith_SHA2_512(std::span<const std::uint8_t> Key)
 			{
 				static constexpr std::size_t BLOCK_SIZE = 64;
 
 				//Key after hashing and padding
-				std::string KeyPaddings( BLOCK_SIZE, 0x00 );
+				std::array<char, BLOCK_SIZE> KeyPaddings {};
 
 				//Keys are processed according to the block size of the hash function
 				if(Key.size() > BLOCK_SIZE)
@@ -75,32 +90,29 @@ namespace TwilightDreamOfMagical::CommonSecurity
 					// Keys longer than blockSize are shortened by hashing them
 					// 长于blockSize的密钥通过散列来缩短其长度
 
-					SHA2_512_Pointer->Hash(Key, KeyPaddings);
-				}
-				else if(Key.size() < BLOCK_SIZE)
-				{
-					// Keys shorter than blockSize are padded to blockSize by padding with zeros on the right
-					// 短于blockSize的键被填充到blockSize，在右边用0填充。
+					//和字符串版本的散列一样，使用的是摘要的十六进制文本的前 BLOCK_SIZE 个字符
+					//Like the hashing of the string version, the first BLOCK_SIZE characters of the hexadecimal text of the digest are used
+					static constexpr std::string_view HexadecimalDigits = "0123456789abcdef";
 
-					KeyPaddings = Key;
+					std::array<std::uint8_t, BLOCK_SIZE> KeyDigest {};
+					SHA2_512_Pointer->Hash(Key, KeyDigest);
 
-					for ( std::size_t index = 0; index < BLOCK_SIZE; ++index )
+					for ( std::size_t index = 0; index < BLOCK_SIZE / 2; ++index )
 					{
-						// Pad key with zeros to make it blockSize bytes long
-						if ( index < BLOCK_SIZE - Key.size() )
-						{
-							KeyPaddings[ index ] = 0x00;
-						}
-						else
-						{
-							KeyPaddings[ index ] = Key[ index - ( BLOCK_SIZE - Key.size() ) ];
-						}
+						KeyPaddings[ index * 2 ] = HexadecimalDigits[ KeyDigest[ index ] >> 4 ];
+						KeyPaddings[ index * 2 + 1 ] = HexadecimalDigits[ KeyDigest[ index ] & 0x0F ];
 					}
+
+					volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( KeyDigest.data(), KeyDigest.size() );
+					CheckPointer = nullptr;
 				}
 				else
 				{
-					// If the key is exactly equal to the block size, use it directly
-					KeyPaddings = Key;
+					// Keys shorter than blockSize are padded to blockSize by padding with zeros (on the left, the key ends at the last byte)
+					// 短于blockSize的键被填充到blockSize，用0填充 (在左边，密钥结束于最后一个字节)
+					// If the key is exactly equal to the block size, it is used directly
+
+					std::ranges::copy( Key, reinterpret_cast<std::uint8_t*>( KeyPaddings.data() ) + ( BLOCK_SIZE - Key.size() ) );
 				}
 
 				OuterPaddedKeys.resize( BLOCK_SIZE, 0x5C );
@@ -111,6 +123,9 @@ namespace TwilightDreamOfMagical::CommonSecurity
 					OuterPaddedKeys[ index ] ^= KeyPaddings[ index ];
 					InnerPaddedKeys[ index ] ^= KeyPaddings[ index ];
 				}
+
+				volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( KeyPaddings.data(), KeyPaddings.size() );
+				CheckPointer = nullptr;
 			}
 
 			void With_SHA2_512
@@ -120,7 +135,7 @@ namespace TwilightDreamOfMagical::CommonSecurity
 			);
 
 		private:
-			std::unique_ptr<SHA::SHA2_512> SHA2_512_Pointer = nullptr;
+			SHA::SHA2_512* SHA2_512_Pointer = nullptr;
 			std::string OuterPaddedKeys; // inner padding key
 			std::string InnerPaddedKeys; // Outer padding key
 		};
@@ -225,7 +225,7 @@ namespace TwilightDreamOfMagical::CommonSecurity
 			HashValues = hash_values;
 		}
 
-		void SHA2_512::Hash( std::span<uint8_t> message, std::span<uint8_t> hashed_message )
+		void SHA2_512::Hash( std::span<const uint8_t> message, std::span<uint8_t> hashed_message )
 		{
 			// Error checking
 			my_cpp2020_assert( !message.empty(), "Input invalid message size.", std::source_location::current() );
@@ -251,6 +251,12 @@ namespace TwilightDreamOfMagical::CommonSecurity
 				hashed_message[ i * 8 + 6 ] = ( hash_values[ i ] >> 8 ) & 0xFF;
 				hashed_message[ i * 8 + 7 ] = ( hash_values[ i ] >> 0 ) & 0xFF;
 			}
+
+			// The padded copy holds the whole message (HMAC keys, key setup fingerprints), wipe it with the hash state
+			volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( PaddedMessage.data(), PaddedMessage.size() );
+			CheckPointer = nullptr;
+			CheckPointer = memory_set_no_optimize_function<0x00>( hash_values.data(), sizeof( hash_values ) );
+			CheckPointer = nullptr;
 		}
 
 		void SHA2_512::Hash( std::string message, std::string& hashed_message )
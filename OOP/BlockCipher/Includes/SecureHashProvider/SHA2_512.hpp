@@ -36,7 +36,7 @@ namespace TwilightDreamOfMagical::CommonSecurity
 			SHA2_512() = default;
 			~SHA2_512() = default;
 
-			void Hash(std::span<uint8_t> message, std::span<uint8_t> hashed_message);
+			void Hash(std::span<const uint8_t> message, std::span<uint8_t> hashed_message);
 			void Hash(std::span<uint64_t> message, std::span<uint64_t> hashed_message);
 			void Hash(std::string message, std::string& hashed_message);
 
@@ -0,0 +1,535 @@
+#include "LaiMasseyBatchKernel.hpp"
+
+namespace TwilightDreamOfMagical::CustomSecurity
+{
+	//SymmetricEncryptionDecryption
+	namespace SED::BlockCipher
+	{
+		namespace ImplementationDetails::LaiMasseyBatchKernel
+		{
+			namespace
+			{
+				/*
+					每个 SIMD 通道对应一个 64 位数据字。
+					32 位的部分放在 V32 里 (AVX2: XMM, AVX-512: YMM)，64 位的部分放在同样通道数的 V64 里 (AVX2: YMM, AVX-512: ZMM)。
+					Every SIMD lane corresponds to one 64-bit data word.
+					The 32-bit parts live in a V32 (AVX2: XMM, AVX-512: YMM), the 64-bit parts live in a V64 with the same lane count (AVX2: YMM, AVX-512: ZMM).
+
+					WordA/WordB 对矩阵大小取模使用 Lemire 的快速取模 (对所有 32 位输入都精确):
+					Modulo of WordA/WordB by the matrix size uses Lemire's fast modulo (exact for every 32-bit input):
+					Remainder = ( ( ( Magic * Value ) mod 2^64 ) * Divisor ) >> 64, Magic = floor( (2^64 - 1) / Divisor ) + 1
+				*/
+				std::uint64_t ComputeModuloMagic( std::uint32_t Divisor )
+				{
+					return ~0ULL / Divisor + 1;
+				}
+
+				#if defined( TDOM_PROCESSOR_X86 )
+
+				/*
+					AVX2 (一次 4 个字)
+					AVX2 (4 words at a time)
+				*/
+
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				TDOM_ALWAYS_INLINE __m128i NarrowLowDoublewords( __m256i QuadWords )
+				{
+					return _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( QuadWords, _mm256_setr_epi32( 0, 2, 4, 6, 0, 2, 4, 6 ) ) );
+				}
+
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				TDOM_ALWAYS_INLINE __m128i NarrowHighDoublewords( __m256i QuadWords )
+				{
+					return _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( QuadWords, _mm256_setr_epi32( 1, 3, 5, 7, 1, 3, 5, 7 ) ) );
+				}
+
+				template <int Count>
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				TDOM_ALWAYS_INLINE __m128i RotateLeft32( __m128i Value )
+				{
+					return _mm_or_si128( _mm_slli_epi32( Value, Count ), _mm_srli_epi32( Value, 32 - Count ) );
+				}
+
+				//Count 的范围是 [0, 31]，右移 32 位在 AVX2 里得到 0，所以 Count 为 0 时结果正确
+				//Count is within [0, 31]; a right shift by 32 yields 0 in AVX2, so the result is correct when Count is 0
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				TDOM_ALWAYS_INLINE __m128i RotateLeftVariable32( __m128i Value, __m128i Count )
+				{
+					return _mm_or_si128( _mm_sllv_epi32( Value, Count ), _mm_srlv_epi32( Value, _mm_sub_epi32( _mm_set1_epi32( 32 ), Count ) ) );
+				}
+
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				TDOM_ALWAYS_INLINE __m128i RotateRightVariable32( __m128i Value, __m128i Count )
+				{
+					return _mm_or_si128( _mm_srlv_epi32( Value, Count ), _mm_sllv_epi32( Value, _mm_sub_epi32( _mm_set1_epi32( 32 ), Count ) ) );
+				}
+
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				TDOM_ALWAYS_INLINE __m256i ModuloAVX2( __m256i Value, __m256i MagicLow, __m256i MagicHigh, __m256i Divisor )
+				{
+					const __m256i LowBits = _mm256_add_epi64( _mm256_mul_epu32( Value, MagicLow ), _mm256_slli_epi64( _mm256_mul_epu32( Value, MagicHigh ), 32 ) );
+					const __m256i Product = _mm256_add_epi64( _mm256_mul_epu32( _mm256_srli_epi64( LowBits, 32 ), Divisor ), _mm256_srli_epi64( _mm256_mul_epu32( LowBits, Divisor ), 32 ) );
+					return _mm256_srli_epi64( Product, 32 );
+				}
+
+				//与 Module_SecureRoundSubkeyGeneratation::CrazyTransformAssociatedWord 逐步对应
+				//Corresponds step by step to Module_SecureRoundSubkeyGeneratation::CrazyTransformAssociatedWord
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				TDOM_ALWAYS_INLINE __m128i CrazyTransformAssociatedWordAVX2( __m128i AssociatedWordData, __m256i WordKeyMaterial, const AssociatedWordTables& Tables )
+				{
+					const __m128i AllOnes = _mm_set1_epi32( -1 );
+
+					const __m128i LeftWordKey = NarrowHighDoublewords( WordKeyMaterial );
+					const __m128i RightWordKey = NarrowLowDoublewords( WordKeyMaterial );
+
+					//PseudoRandomValue = ( ( RightWordKey ^ AssociatedWordData ) << 32 ) | ~LeftWordKey
+					const __m256i PseudoRandomValue = _mm256_or_si256
+					(
+						_mm256_slli_epi64( _mm256_cvtepu32_epi64( _mm_xor_si128( RightWordKey, AssociatedWordData ) ), 32 ),
+						_mm256_cvtepu32_epi64( _mm_xor_si128( LeftWordKey, AllOnes ) )
+					);
+
+					const __m256i ShiftBitCount = _mm256_and_si256( WordKeyMaterial, _mm256_set1_epi64x( 63 ) );
+					__m128i WordC = NarrowHighDoublewords( _mm256_sllv_epi64( PseudoRandomValue, ShiftBitCount ) );
+					__m128i WordD = NarrowLowDoublewords( _mm256_srlv_epi64( PseudoRandomValue, ShiftBitCount ) );
+
+					WordC = _mm_xor_si128( WordC, _mm_or_si128( AssociatedWordData, LeftWordKey ) );
+					WordD = _mm_xor_si128( WordD, _mm_or_si128( _mm_xor_si128( AssociatedWordData, AllOnes ), RightWordKey ) );
+
+					//PseudoRandomValue % 32 只取决于低 32 位，也就是 ~LeftWordKey
+					//PseudoRandomValue % 32 only depends on the low 32 bits, that is ~LeftWordKey
+					const __m128i RotateCount = _mm_andnot_si128( LeftWordKey, _mm_set1_epi32( 31 ) );
+					__m128i WordA = RotateLeftVariable32( _mm_xor_si128( WordC, _mm_or_si128( LeftWordKey, RightWordKey ) ), RotateCount );
+					__m128i WordB = RotateRightVariable32( _mm_xor_si128( WordD, _mm_and_si128( LeftWordKey, RightWordKey ) ), RotateCount );
+
+					WordD = _mm_xor_si128( WordD, _mm_andnot_si128( AssociatedWordData, LeftWordKey ) );
+					WordC = _mm_xor_si128( WordC, _mm_and_si128( AssociatedWordData, RightWordKey ) );
+
+					WordB = _mm_xor_si128( WordB, _mm_xor_si128( WordC, _mm_xor_si128( LeftWordKey, AllOnes ) ) );
+					WordA = _mm_xor_si128( WordA, _mm_xor_si128( WordD, _mm_xor_si128( RightWordKey, AllOnes ) ) );
+
+					const std::uint64_t Magic = ComputeModuloMagic( Tables.MatrixOffsetCount );
+					const __m256i		MagicLow = _mm256_set1_epi64x( static_cast<long long>( Magic & 0xFFFFFFFFULL ) );
+					const __m256i		MagicHigh = _mm256_set1_epi64x( static_cast<long long>( Magic >> 32 ) );
+					const __m256i		Divisor = _mm256_set1_epi64x( Tables.MatrixOffsetCount );
+					const int*			Indices = reinterpret_cast<const int*>( Tables.MatrixOffsetWithRandomIndices );
+
+					const __m128i Row = _mm256_i64gather_epi32( Indices, ModuloAVX2( _mm256_cvtepu32_epi64( WordA ), MagicLow, MagicHigh, Divisor ), 4 );
+					const __m128i Column = _mm256_i64gather_epi32( Indices, ModuloAVX2( _mm256_cvtepu32_epi64( WordB ), MagicLow, MagicHigh, Divisor ), 4 );
+
+					const __m128i Mask63 = _mm_set1_epi32( 63 );
+					const __m128i ShiftAmount = _mm_and_si128( _mm_add_epi32( WordA, WordB ), Mask63 );
+					const __m128i ShiftAmount2 = _mm_and_si128( _mm_add_epi32( WordA, _mm_slli_epi32( WordB, 1 ) ), Mask63 );
+					const __m128i RotateAmount = _mm_and_si128( _mm_sub_epi32( Column, Row ), Mask63 );
+					//rotr( Bit, N ) == Bit << ( ( 64 - N ) % 64 )，因为 Bit 只有最低位
+					//rotr( Bit, N ) == Bit << ( ( 64 - N ) % 64 ), because Bit only has the lowest bit
+					const __m128i RotateAmount2 = _mm_and_si128( _mm_sub_epi32( Column, _mm_slli_epi32( Row, 1 ) ), Mask63 );
+
+					const __m256i MatrixOffset = _mm256_add_epi64( _mm256_mul_epu32( _mm256_cvtepu32_epi64( Column ), _mm256_set1_epi64x( static_cast<long long>( Tables.RoundSubkeyMatrixRows ) ) ), _mm256_cvtepu32_epi64( Row ) );
+					const __m256i RoundSubkey = _mm256_i64gather_epi64( reinterpret_cast<const long long*>( Tables.RoundSubkeyMatrix ), MatrixOffset, 8 );
+
+					const __m256i One = _mm256_set1_epi64x( 1 );
+					const __m256i RoundSubkeyBit = _mm256_and_si256( _mm256_srlv_epi64( RoundSubkey, _mm256_cvtepu32_epi64( ShiftAmount ) ), One );
+					const __m256i RoundSubkeyBit2 = _mm256_and_si256( _mm256_srlv_epi64( RoundSubkey, _mm256_cvtepu32_epi64( ShiftAmount2 ) ), One );
+					const __m256i LeftRotatedMask = _mm256_sllv_epi64( RoundSubkeyBit, _mm256_cvtepu32_epi64( RotateAmount ) );
+					const __m256i RightRotatedMask = _mm256_sllv_epi64( RoundSubkeyBit2, _mm256_cvtepu32_epi64( RotateAmount2 ) );
+					const __m256i RoundSubkeyMasked = _mm256_andnot_si256( _mm256_xor_si256( LeftRotatedMask, RightRotatedMask ), RoundSubkey );
+
+					const __m128i FunctionResult = _mm_xor_si128
+					(
+						RotateLeft32<16>( _mm_xor_si128( WordA, NarrowLowDoublewords( RoundSubkeyMasked ) ) ),
+						RotateLeft32<16>( _mm_xor_si128( WordB, NarrowHighDoublewords( RoundSubkeyMasked ) ) )
+					);
+					const __m128i FunctionResult2 = _mm_xor_si128
+					(
+						_mm_sub_epi32( NarrowHighDoublewords( RoundSubkey ), RotateLeft32<8>( _mm_xor_si128( WordC, NarrowLowDoublewords( RoundSubkey ) ) ) ),
+						RotateLeft32<24>( WordD )
+					);
+
+					return _mm_add_epi32( AssociatedWordData, _mm_xor_si128( FunctionResult, FunctionResult2 ) );
+				}
+
+				//对 4 个字应用一次 Lai-Massey 结构
+				//Apply one Lai-Massey structure to 4 words
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				TDOM_ALWAYS_INLINE __m256i LaiMasseyFrameworkAVX2( __m256i WordData, __m256i WordKeyMaterial, const AssociatedWordTables& Tables, bool IsEncrypter )
+				{
+					__m128i LeftWordData = NarrowHighDoublewords( WordData );
+					__m128i RightWordData = NarrowLowDoublewords( WordData );
+					__m128i WordA, WordB;
+
+					if ( IsEncrypter )
+					{
+						const __m128i TransformKey = CrazyTransformAssociatedWordAVX2( _mm_xor_si128( LeftWordData, RightWordData ), WordKeyMaterial, Tables );
+						LeftWordData = _mm_xor_si128( LeftWordData, TransformKey );
+						RightWordData = _mm_xor_si128( RightWordData, TransformKey );
+
+						//ForwardTransform
+						WordA = _mm_add_epi32( LeftWordData, RightWordData );
+						WordB = _mm_add_epi32( LeftWordData, _mm_slli_epi32( RightWordData, 1 ) );
+						WordB = _mm_xor_si128( WordB, RotateLeft32<1>( WordA ) );
+						WordA = _mm_xor_si128( WordA, RotateLeft32<1>( WordB ) );
+					}
+					else
+					{
+						//BackwardTransform
+						LeftWordData = _mm_xor_si128( LeftWordData, RotateLeft32<1>( RightWordData ) );
+						RightWordData = _mm_xor_si128( RightWordData, RotateLeft32<1>( LeftWordData ) );
+						WordB = _mm_sub_epi32( RightWordData, LeftWordData );
+						WordA = _mm_sub_epi32( _mm_slli_epi32( LeftWordData, 1 ), RightWordData );
+
+						const __m128i TransformKey = CrazyTransformAssociatedWordAVX2( _mm_xor_si128( WordA, WordB ), WordKeyMaterial, Tables );
+						WordA = _mm_xor_si128( WordA, TransformKey );
+						WordB = _mm_xor_si128( WordB, TransformKey );
+					}
+
+					return _mm256_or_si256( _mm256_slli_epi64( _mm256_cvtepu32_epi64( WordA ), 32 ), _mm256_cvtepu32_epi64( WordB ) );
+				}
+
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				std::size_t ApplyLaiMasseyFrameworkAVX2( std::uint64_t* WordDatas, const std::uint64_t* WordKeyMaterials, std::size_t WordCount, const AssociatedWordTables& Tables, bool IsEncrypter )
+				{
+					constexpr std::size_t Lanes = 4;
+					const std::size_t	  BatchedWordCount = WordCount - WordCount % Lanes;
+
+					for ( std::size_t Index = 0; Index < BatchedWordCount; Index += Lanes )
+					{
+						const __m256i WordData = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( WordDatas + Index ) );
+						const __m256i WordKeyMaterial = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( WordKeyMaterials + Index ) );
+
+						_mm256_storeu_si256( reinterpret_cast<__m256i*>( WordDatas + Index ), LaiMasseyFrameworkAVX2( WordData, WordKeyMaterial, Tables, IsEncrypter ) );
+					}
+
+					return BatchedWordCount;
+				}
+
+				/*
+					AVX-512 (一次 8 个字)
+					AVX-512 (8 words at a time)
+				*/
+
+				#define TDOM_LAIMASSEY_AVX512_TARGET "avx512f,avx512vl"
+
+				TDOM_TARGET_ATTRIBUTE( TDOM_LAIMASSEY_AVX512_TARGET )
+				TDOM_ALWAYS_INLINE __m512i ModuloAVX512( __m512i Value, __m512i MagicLow, __m512i MagicHigh, __m512i Divisor )
+				{
+					const __m512i LowBits = _mm512_add_epi64( _mm512_mul_epu32( Value, MagicLow ), _mm512_slli_epi64( _mm512_mul_epu32( Value, MagicHigh ), 32 ) );
+					const __m512i Product = _mm512_add_epi64( _mm512_mul_epu32( _mm512_srli_epi64( LowBits, 32 ), Divisor ), _mm512_srli_epi64( _mm512_mul_epu32( LowBits, Divisor ), 32 ) );
+					return _mm512_srli_epi64( Product, 32 );
+				}
+
+				TDOM_TARGET_ATTRIBUTE( TDOM_LAIMASSEY_AVX512_TARGET )
+				TDOM_ALWAYS_INLINE __m256i CrazyTransformAssociatedWordAVX512( __m256i AssociatedWordData, __m512i WordKeyMaterial, const AssociatedWordTables& Tables )
+				{
+					const __m256i AllOnes = _mm256_set1_epi32( -1 );
+
+					const __m256i LeftWordKey = _mm512_cvtepi64_epi32( _mm512_srli_epi64( WordKeyMaterial, 32 ) );
+					const __m256i RightWordKey = _mm512_cvtepi64_epi32( WordKeyMaterial );
+
+					const __m512i PseudoRandomValue = _mm512_or_si512
+					(
+						_mm512_slli_epi64( _mm512_cvtepu32_epi64( _mm256_xor_si256( RightWordKey, AssociatedWordData ) ), 32 ),
+						_mm512_cvtepu32_epi64( _mm256_xor_si256( LeftWordKey, AllOnes ) )
+					);
+
+					const __m512i ShiftBitCount = _mm512_and_si512( WordKeyMaterial, _mm512_set1_epi64( 63 ) );
+					__m256i WordC = _mm512_cvtepi64_epi32( _mm512_srli_epi64( _mm512_sllv_epi64( PseudoRandomValue, ShiftBitCount ), 32 ) );
+					__m256i WordD = _mm512_cvtepi64_epi32( _mm512_srlv_epi64( PseudoRandomValue, ShiftBitCount ) );
+
+					WordC = _mm256_xor_si256( WordC, _mm256_or_si256( AssociatedWordData, LeftWordKey ) );
+					WordD = _mm256_xor_si256( WordD, _mm256_or_si256( _mm256_xor_si256( AssociatedWordData, AllOnes ), RightWordKey ) );
+
+					const __m256i RotateCount = _mm256_andnot_si256( LeftWordKey, _mm256_set1_epi32( 31 ) );
+					__m256i WordA = _mm256_rolv_epi32( _mm256_xor_si256( WordC, _mm256_or_si256( LeftWordKey, RightWordKey ) ), RotateCount );
+					__m256i WordB = _mm256_rorv_epi32( _mm256_xor_si256( WordD, _mm256_and_si256( LeftWordKey, RightWordKey ) ), RotateCount );
+
+					WordD = _mm256_xor_si256( WordD, _mm256_andnot_si256( AssociatedWordData, LeftWordKey ) );
+					WordC = _mm256_xor_si256( WordC, _mm256_and_si256( AssociatedWordData, RightWordKey ) );
+
+					WordB = _mm256_ternarylogic_epi32( WordB, WordC, LeftWordKey, 0x69 );	 //B ^ C ^ ~LK
+					WordA = _mm256_ternarylogic_epi32( WordA, WordD, RightWordKey, 0x69 );	 //A ^ D ^ ~RK
+
+					const std::uint64_t Magic = ComputeModuloMagic( Tables.MatrixOffsetCount );
+					const __m512i		MagicLow = _mm512_set1_epi64( static_cast<long long>( Magic & 0xFFFFFFFFULL ) );
+					const __m512i		MagicHigh = _mm512_set1_epi64( static_cast<long long>( Magic >> 32 ) );
+					const __m512i		Divisor = _mm512_set1_epi64( Tables.MatrixOffsetCount );
+
+					const __m256i Row = _mm512_i64gather_epi32( ModuloAVX512( _mm512_cvtepu32_epi64( WordA ), MagicLow, MagicHigh, Divisor ), Tables.MatrixOffsetWithRandomIndices, 4 );
+					const __m256i Column = _mm512_i64gather_epi32( ModuloAVX512( _mm512_cvtepu32_epi64( WordB ), MagicLow, MagicHigh, Divisor ), Tables.MatrixOffsetWithRandomIndices, 4 );
+
+					const __m256i Mask63 = _mm256_set1_epi32( 63 );
+					const __m256i ShiftAmount = _mm256_and_si256( _mm256_add_epi32( WordA, WordB ), Mask63 );
+					const __m256i ShiftAmount2 = _mm256_and_si256( _mm256_add_epi32( WordA, _mm256_slli_epi32( WordB, 1 ) ), Mask63 );
+					const __m256i RotateAmount = _mm256_and_si256( _mm256_sub_epi32( Column, Row ), Mask63 );
+					const __m256i RotateAmount2 = _mm256_and_si256( _mm256_sub_epi32( _mm256_slli_epi32( Row, 1 ), Column ), Mask63 );
+
+					const __m512i MatrixOffset = _mm512_add_epi64( _mm512_mul_epu32( _mm512_cvtepu32_epi64( Column ), _mm512_set1_epi64( static_cast<long long>( Tables.RoundSubkeyMatrixRows ) ) ), _mm512_cvtepu32_epi64( Row ) );
+					const __m512i RoundSubkey = _mm512_i64gather_epi64( MatrixOffset, Tables.RoundSubkeyMatrix, 8 );
+
+					const __m512i One = _mm512_set1_epi64( 1 );
+					const __m512i RoundSubkeyBit = _mm512_and_si512( _mm512_srlv_epi64( RoundSubkey, _mm512_cvtepu32_epi64( ShiftAmount ) ), One );
+					const __m512i RoundSubkeyBit2 = _mm512_and_si512( _mm512_srlv_epi64( RoundSubkey, _mm512_cvtepu32_epi64( ShiftAmount2 ) ), One );
+					const __m512i LeftRotatedMask = _mm512_rolv_epi64( RoundSubkeyBit, _mm512_cvtepu32_epi64( RotateAmount ) );
+					const __m512i RightRotatedMask = _mm512_rorv_epi64( RoundSubkeyBit2, _mm512_cvtepu32_epi64( RotateAmount2 ) );
+					const __m512i RoundSubkeyMasked = _mm512_andnot_si512( _mm512_xor_si512( LeftRotatedMask, RightRotatedMask ), RoundSubkey );
+
+					const __m256i FunctionResult = _mm256_xor_si256
+					(
+						_mm256_rol_epi32( _mm256_xor_si256( WordA, _mm512_cvtepi64_epi32( RoundSubkeyMasked ) ), 16 ),
+						_mm256_ror_epi32( _mm256_xor_si256( WordB, _mm512_cvtepi64_epi32( _mm512_srli_epi64( RoundSubkeyMasked, 32 ) ) ), 16 )
+					);
+					const __m256i FunctionResult2 = _mm256_xor_si256
+					(
+						_mm256_sub_epi32( _mm512_cvtepi64_epi32( _mm512_srli_epi64( RoundSubkey, 32 ) ), _mm256_rol_epi32( _mm256_xor_si256( WordC, _mm512_cvtepi64_epi32( RoundSubkey ) ), 8 ) ),
+						_mm256_ror_epi32( WordD, 8 )
+					);
+
+					return _mm256_add_epi32( AssociatedWordData, _mm256_xor_si256( FunctionResult, FunctionResult2 ) );
+				}
+
+				//对 8 个字应用一次 Lai-Massey 结构
+				//Apply one Lai-Massey structure to 8 words
+				TDOM_TARGET_ATTRIBUTE( TDOM_LAIMASSEY_AVX512_TARGET )
+				TDOM_ALWAYS_INLINE __m512i LaiMasseyFrameworkAVX512( __m512i WordData, __m512i WordKeyMaterial, const AssociatedWordTables& Tables, bool IsEncrypter )
+				{
+					__m256i LeftWordData = _mm512_cvtepi64_epi32( _mm512_srli_epi64( WordData, 32 ) );
+					__m256i RightWordData = _mm512_cvtepi64_epi32( WordData );
+					__m256i WordA, WordB;
+
+					if ( IsEncrypter )
+					{
+						const __m256i TransformKey = CrazyTransformAssociatedWordAVX512( _mm256_xor_si256( LeftWordData, RightWordData ), WordKeyMaterial, Tables );
+						LeftWordData = _mm256_xor_si256( LeftWordData, TransformKey );
+						RightWordData = _mm256_xor_si256( RightWordData, TransformKey );
+
+						//ForwardTransform
+						WordA = _mm256_add_epi32( LeftWordData, RightWordData );
+						WordB = _mm256_add_epi32( LeftWordData, _mm256_slli_epi32( RightWordData, 1 ) );
+						WordB = _mm256_xor_si256( WordB, _mm256_rol_epi32( WordA, 1 ) );
+						WordA = _mm256_xor_si256( WordA, _mm256_rol_epi32( WordB, 1 ) );
+					}
+					else
+					{
+						//BackwardTransform
+						LeftWordData = _mm256_xor_si256( LeftWordData, _mm256_rol_epi32( RightWordData, 1 ) );
+						RightWordData = _mm256_xor_si256( RightWordData, _mm256_rol_epi32( LeftWordData, 1 ) );
+						WordB = _mm256_sub_epi32( RightWordData, LeftWordData );
+						WordA = _mm256_sub_epi32( _mm256_slli_epi32( LeftWordData, 1 ), RightWordData );
+
+						const __m256i TransformKey = CrazyTransformAssociatedWordAVX512( _mm256_xor_si256( WordA, WordB ), WordKeyMaterial, Tables );
+						WordA = _mm256_xor_si256( WordA, TransformKey );
+						WordB = _mm256_xor_si256( WordB, TransformKey );
+					}
+
+					return _mm512_or_si512( _mm512_slli_epi64( _mm512_cvtepu32_epi64( WordA ), 32 ), _mm512_cvtepu32_epi64( WordB ) );
+				}
+
+				TDOM_TARGET_ATTRIBUTE( TDOM_LAIMASSEY_AVX512_TARGET )
+				std::size_t ApplyLaiMasseyFrameworkAVX512( std::uint64_t* WordDatas, const std::uint64_t* WordKeyMaterials, std::size_t WordCount, const AssociatedWordTables& Tables, bool IsEncrypter )
+				{
+					constexpr std::size_t Lanes = 8;
+					const std::size_t	  BatchedWordCount = WordCount - WordCount % Lanes;
+
+					for ( std::size_t Index = 0; Index < BatchedWordCount; Index += Lanes )
+					{
+						const __m512i WordData = _mm512_loadu_si512( WordDatas + Index );
+						const __m512i WordKeyMaterial = _mm512_loadu_si512( WordKeyMaterials + Index );
+
+						_mm512_storeu_si512( WordDatas + Index, LaiMasseyFrameworkAVX512( WordData, WordKeyMaterial, Tables, IsEncrypter ) );
+					}
+
+					return BatchedWordCount;
+				}
+
+				/*
+					固定大小数据块的整轮路径: 数据块在所有段之间一直留在寄存器里。
+					向量个数在编译期已知，用递归模板把每一段里的向量完全展开，各个向量的依赖链互相独立，可以交错执行。
+					Whole-round path for a fixed-size data block: the block stays in registers across all segments.
+					The vector count is known at compile time, so a recursive template fully unrolls the vectors of each segment; their dependency chains are independent and can interleave.
+				*/
+				template <std::size_t Vector, std::size_t VectorCount, bool IsEncrypter>
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				TDOM_ALWAYS_INLINE void LaiMasseyFrameworkSegmentAVX2( __m256i* WordData, const std::uint64_t* WordKeyMaterials, const AssociatedWordTables& Tables )
+				{
+					if constexpr ( Vector < VectorCount )
+					{
+						WordData[ Vector ] = LaiMasseyFrameworkAVX2( WordData[ Vector ], _mm256_loadu_si256( reinterpret_cast<const __m256i*>( WordKeyMaterials + Vector * 4 ) ), Tables, IsEncrypter );
+						LaiMasseyFrameworkSegmentAVX2<Vector + 1, VectorCount, IsEncrypter>( WordData, WordKeyMaterials, Tables );
+					}
+				}
+
+				template <std::size_t VectorCount, std::size_t PassCount, bool IsEncrypter>
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				void ApplyLaiMasseyFrameworkPassesAVX2( std::uint64_t* WordDatas, const std::uint64_t* RoundSubkeys, const AssociatedWordTables& Tables )
+				{
+					constexpr std::size_t Lanes = 4;
+					constexpr std::size_t BlockWordCount = VectorCount * Lanes;
+
+					__m256i WordData[ VectorCount ];
+					for ( std::size_t Vector = 0; Vector < VectorCount; ++Vector )
+						WordData[ Vector ] = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( WordDatas + Vector * Lanes ) );
+
+					for ( std::size_t Pass = 0; Pass < PassCount; ++Pass )
+					{
+						//解密时倒序使用子密钥段
+						//Decryption uses the subkey segments in reverse order
+						const std::size_t Segment = IsEncrypter ? Pass : PassCount - 1 - Pass;
+						LaiMasseyFrameworkSegmentAVX2<0, VectorCount, IsEncrypter>( WordData, RoundSubkeys + Segment * BlockWordCount, Tables );
+					}
+
+					for ( std::size_t Vector = 0; Vector < VectorCount; ++Vector )
+						_mm256_storeu_si256( reinterpret_cast<__m256i*>( WordDatas + Vector * Lanes ), WordData[ Vector ] );
+				}
+
+				template <std::size_t Vector, std::size_t VectorCount, bool IsEncrypter>
+				TDOM_TARGET_ATTRIBUTE( TDOM_LAIMASSEY_AVX512_TARGET )
+				TDOM_ALWAYS_INLINE void LaiMasseyFrameworkSegmentAVX512( __m512i* WordData, const std::uint64_t* WordKeyMaterials, const AssociatedWordTables& Tables )
+				{
+					if constexpr ( Vector < VectorCount )
+					{
+						WordData[ Vector ] = LaiMasseyFrameworkAVX512( WordData[ Vector ], _mm512_loadu_si512( WordKeyMaterials + Vector * 8 ), Tables, IsEncrypter );
+						LaiMasseyFrameworkSegmentAVX512<Vector + 1, VectorCount, IsEncrypter>( WordData, WordKeyMaterials, Tables );
+					}
+				}
+
+				template <std::size_t VectorCount, std::size_t PassCount, bool IsEncrypter>
+				TDOM_TARGET_ATTRIBUTE( TDOM_LAIMASSEY_AVX512_TARGET )
+				void ApplyLaiMasseyFrameworkPassesAVX512( std::uint64_t* WordDatas, const std::uint64_t* RoundSubkeys, const AssociatedWordTables& Tables )
+				{
+					constexpr std::size_t Lanes = 8;
+					constexpr std::size_t BlockWordCount = VectorCount * Lanes;
+
+					__m512i WordData[ VectorCount ];
+					for ( std::size_t Vector = 0; Vector < VectorCount; ++Vector )
+						WordData[ Vector ] = _mm512_loadu_si512( WordDatas + Vector * Lanes );
+
+					for ( std::size_t Pass = 0; Pass < PassCount; ++Pass )
+					{
+						const std::size_t Segment = IsEncrypter ? Pass : PassCount - 1 - Pass;
+						LaiMasseyFrameworkSegmentAVX512<0, VectorCount, IsEncrypter>( WordData, RoundSubkeys + Segment * BlockWordCount, Tables );
+					}
+
+					for ( std::size_t Vector = 0; Vector < VectorCount; ++Vector )
+						_mm512_storeu_si512( WordDatas + Vector * Lanes, WordData[ Vector ] );
+				}
+
+				#undef TDOM_LAIMASSEY_AVX512_TARGET
+
+				#endif
+			}  // namespace
+
+			KernelKind SelectKernel()
+			{
+				static const KernelKind Selected = []()
+				{
+					const auto& Features = BaseOperation::CurrentProcessorFeatures();
+
+					if ( Features.AVX512F && Features.AVX512VL )
+						return KernelKind::AVX512;
+					if ( Features.AVX2 )
+						return KernelKind::AVX2;
+					return KernelKind::Scalar;
+				}();
+
+				return Selected;
+			}
+
+			std::size_t ApplyLaiMasseyFramework
+			(
+				std::span<std::uint64_t> WordDatas,
+				std::span<const std::uint64_t> WordKeyMaterials,
+				const AssociatedWordTables& Tables,
+				TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode,
+				KernelKind Kernel
+			)
+			{
+				using TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW;
+
+				my_cpp2020_assert( WordDatas.size() == WordKeyMaterials.size(), "LaiMasseyBatchKernel: The number of data words and key material words are not equal!", std::source_location::current() );
+				my_cpp2020_assert( ThisExecuteMode == CryptionMode2MCAC4_FDW::MCA_ENCRYPTER || ThisExecuteMode == CryptionMode2MCAC4_FDW::MCA_DECRYPTER, "Invalid cipher base work mode !", std::source_location::current() );
+
+				//不能使用当前处理器不支持的内核
+				//Never use a kernel that the current processor does not support
+				if ( Kernel == KernelKind::AVX512 && SelectKernel() != KernelKind::AVX512 )
+					Kernel = SelectKernel();
+				if ( Kernel == KernelKind::AVX2 && SelectKernel() == KernelKind::Scalar )
+					Kernel = KernelKind::Scalar;
+
+				//SIMD 内核按小端序拆分左右两半，大端机器全部交给逐字实现
+				//The SIMD kernels split the left and right halves in little-endian order; big-endian machines leave everything to the word-by-word implementation
+				if constexpr ( std::endian::native != std::endian::little )
+					return 0;
+
+				#if defined( TDOM_PROCESSOR_X86 )
+				const bool IsEncrypter = ThisExecuteMode == CryptionMode2MCAC4_FDW::MCA_ENCRYPTER;
+
+				if ( Kernel == KernelKind::AVX512 )
+					return ApplyLaiMasseyFrameworkAVX512( WordDatas.data(), WordKeyMaterials.data(), WordDatas.size(), Tables, IsEncrypter );
+				else if ( Kernel == KernelKind::AVX2 )
+					return ApplyLaiMasseyFrameworkAVX2( WordDatas.data(), WordKeyMaterials.data(), WordDatas.size(), Tables, IsEncrypter );
+				#endif
+
+				static_cast<void>( Tables );
+				return 0;
+			}
+
+			template <std::size_t DataBlockSize, std::size_t RoundSubkeyCount>
+			bool ApplyLaiMasseyFrameworkPasses
+			(
+				std::span<std::uint64_t, DataBlockSize> WordDatas,
+				std::span<const std::uint64_t, RoundSubkeyCount> RoundSubkeys,
+				const AssociatedWordTables& Tables,
+				TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode
+			)
+			{
+				static_assert( DataBlockSize % 8 == 0 && RoundSubkeyCount % DataBlockSize == 0, "LaiMasseyBatchKernel: The fixed data block must fill whole SIMD vectors and evenly divide the round subkeys!" );
+
+				using TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW;
+
+				constexpr std::size_t PassCount = RoundSubkeyCount / DataBlockSize;
+
+				if constexpr ( std::endian::native != std::endian::little )
+					return false;
+
+				#if defined( TDOM_PROCESSOR_X86 )
+				const bool IsEncrypter = ThisExecuteMode == CryptionMode2MCAC4_FDW::MCA_ENCRYPTER;
+
+				//加密或解密在编译期确定，所以内层循环里没有分支
+				//Encryption or decryption is decided at compile time, so there is no branch inside the inner loop
+				if ( SelectKernel() == KernelKind::AVX512 )
+				{
+					if ( IsEncrypter )
+						ApplyLaiMasseyFrameworkPassesAVX512<DataBlockSize / 8, PassCount, true>( WordDatas.data(), RoundSubkeys.data(), Tables );
+					else
+						ApplyLaiMasseyFrameworkPassesAVX512<DataBlockSize / 8, PassCount, false>( WordDatas.data(), RoundSubkeys.data(), Tables );
+					return true;
+				}
+				else if ( SelectKernel() == KernelKind::AVX2 )
+				{
+					if ( IsEncrypter )
+						ApplyLaiMasseyFrameworkPassesAVX2<DataBlockSize / 4, PassCount, true>( WordDatas.data(), RoundSubkeys.data(), Tables );
+					else
+						ApplyLaiMasseyFrameworkPassesAVX2<DataBlockSize / 4, PassCount, false>( WordDatas.data(), RoundSubkeys.data(), Tables );
+					return true;
+				}
+				#endif
+
+				static_cast<void>( WordDatas );
+				static_cast<void>( RoundSubkeys );
+				static_cast<void>( Tables );
+				static_cast<void>( ThisExecuteMode );
+				return false;
+			}
+
+			//常用配置 (16, 32): 数据块 16 个字，轮子密钥 (32 * 2) * (32 * 2) 个字
+			//The common configuration (16, 32): 16 words of data block, (32 * 2) * (32 * 2) words of round subkeys
+			template bool ApplyLaiMasseyFrameworkPasses<16, 4096>
+			(
+				std::span<std::uint64_t, 16>,
+				std::span<const std::uint64_t, 4096>,
+				const AssociatedWordTables&,
+				TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW
+			);
+		}  // namespace ImplementationDetails::LaiMasseyBatchKernel
+	}	   // namespace SED::BlockCipher
+}  // namespace TwilightDreamOfMagical::CustomSecurity
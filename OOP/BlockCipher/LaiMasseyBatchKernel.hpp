@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * 本文件是 Algorithm_OaldresPuzzleCryptic 的一部分。
+ *
+ * Algorithm_OaldresPuzzleCryptic 是自由软件：你可以再分发之和/或依照由自由软件基金会发布的 GNU 通用公共许可证修改之，无论是版本 3 许可证，还是（按你的决定）任何以后版都可以。
+ *
+ * 发布 Algorithm_OaldresPuzzleCryptic 是希望它能有用，但是并无保障;甚至连可销售和符合某个特定的目的都不保证。请参看 GNU 通用公共许可证，了解详情。
+ * 你应该随程序获得一份 GNU 通用公共许可证的复本。如果没有，请看 <https://www.gnu.org/licenses/>。
+ */
+
+ /*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * This file is part of Algorithm_OaldresPuzzleCryptic.
+ *
+ * Algorithm_OaldresPuzzleCryptic is free software: you may redistribute it and/or modify it under the GNU General Public License as published by the Free Software Foundation, either under the Version 3 license, or (at your discretion) any later version.
+ *
+ * TDOM-EncryptOrDecryptFile-Reborn is released in the hope that it will be useful, but there are no guarantees; not even that it will be marketable and fit a particular purpose. Please see the GNU General Public License for details.
+ * You should get a copy of the GNU General Public License with your program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALGORITHM_OALDRESPUZZLECRYPTIC_LAIMASSEYBATCHKERNEL_HPP
+#define ALGORITHM_OALDRESPUZZLECRYPTIC_LAIMASSEYBATCHKERNEL_HPP
+
+#include "../SupportBaseFunctions.hpp"
+#include "../CommonSecurity.hpp"
+#include "../ProcessorFeatureDetection.hpp"
+
+namespace TwilightDreamOfMagical::CustomSecurity
+{
+	//SymmetricEncryptionDecryption
+	namespace SED::BlockCipher
+	{
+		namespace ImplementationDetails::LaiMasseyBatchKernel
+		{
+			/*
+				CrazyTransformAssociatedWord 需要读取的状态 (只读视图，不拥有内存)
+				The state read by CrazyTransformAssociatedWord (read-only view, does not own the memory)
+			*/
+			struct AssociatedWordTables
+			{
+				//被洗牌的行列索引数组 (CommonStateData::MatrixOffsetWithRandomIndices)
+				//The shuffled row/column index array (CommonStateData::MatrixOffsetWithRandomIndices)
+				const std::uint32_t* MatrixOffsetWithRandomIndices = nullptr;
+				std::uint32_t		 MatrixOffsetCount = 0;
+
+				//列主序的轮子密钥矩阵 (Module_SecureRoundSubkeyGeneratation::GeneratedRoundSubkeyMatrix)
+				//The column-major round subkey matrix (Module_SecureRoundSubkeyGeneratation::GeneratedRoundSubkeyMatrix)
+				const std::uint64_t* RoundSubkeyMatrix = nullptr;
+				std::size_t			 RoundSubkeyMatrixRows = 0;
+			};
+
+			enum class KernelKind : std::uint8_t
+			{
+				//不做任何处理，全部交给调用方的逐字参考实现
+				//Processes nothing, everything is left to the caller's word-by-word reference implementation
+				Scalar,
+				//一次 4 个字
+				//4 words at a time
+				AVX2,
+				//一次 8 个字，使用 AVX-512VL 的可变循环移位
+				//8 words at a time, using the AVX-512VL variable rotates
+				AVX512
+			};
+
+			//当前处理器可用的最快内核
+			//The fastest kernel available on the current processor
+			KernelKind SelectKernel();
+
+			/*
+				对 WordDatas[ Index ] 使用 WordKeyMaterials[ Index ] 应用一次 Lai-Massey 结构 (与 OaldresPuzzle_Cryptic::LaiMasseyFramework 逐位相同)。
+				各个字之间互相独立，所以可以按 SIMD 通道并行。
+				只处理能凑满 SIMD 宽度的前缀，返回已经处理的字数，剩下的字由调用方用逐字实现处理。
+				Apply one Lai-Massey structure to WordDatas[ Index ] with WordKeyMaterials[ Index ] (bit-identical to OaldresPuzzle_Cryptic::LaiMasseyFramework).
+				The words are independent of each other, so they can run in parallel across SIMD lanes.
+				Only the prefix that fills whole SIMD vectors is processed; the number of processed words is returned and the rest is left to the caller's word-by-word implementation.
+			*/
+			std::size_t ApplyLaiMasseyFramework
+			(
+				std::span<std::uint64_t> WordDatas,
+				std::span<const std::uint64_t> WordKeyMaterials,
+				const AssociatedWordTables& Tables,
+				TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode,
+				KernelKind Kernel
+			);
+
+			/*
+				固定大小数据块的整轮快速路径: 依次使用 RoundSubkeys 的每一段 DataBlockSize 个字对整个数据块应用 Lai-Massey 结构 (解密时倒序使用各段)。
+				与对每一段调用 ApplyLaiMasseyFramework 逐位相同，但数据块在所有段之间一直留在寄存器里，大小在编译期固定，所以没有运行时的大小检查。
+				没有可用的 SIMD 内核时返回 false 并且不做任何处理，调用方改用逐段的实现。
+				Whole-round fast path for a fixed-size data block: apply the Lai-Massey structure to the whole block with each DataBlockSize-word segment of RoundSubkeys in turn (decryption uses the segments in reverse order).
+				Bit-identical to calling ApplyLaiMasseyFramework once per segment, but the block stays in registers across all segments and the sizes are fixed at compile time, so there are no runtime size checks.
+				Returns false and processes nothing when no SIMD kernel is available; the caller then falls back to the per-segment implementation.
+
+				只对常用配置 (16, 32) 显式实例化
+				Explicitly instantiated only for the common configuration (16, 32)
+			*/
+			template <std::size_t DataBlockSize, std::size_t RoundSubkeyCount>
+			bool ApplyLaiMasseyFrameworkPasses
+			(
+				std::span<std::uint64_t, DataBlockSize> WordDatas,
+				std::span<const std::uint64_t, RoundSubkeyCount> RoundSubkeys,
+				const AssociatedWordTables& Tables,
+				TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode
+			);
+
+			extern template bool ApplyLaiMasseyFrameworkPasses<16, 4096>
+			(
+				std::span<std::uint64_t, 16>,
+				std::span<const std::uint64_t, 4096>,
+				const AssociatedWordTables&,
+				TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW
+			);
+		}  // namespace ImplementationDetails::LaiMasseyBatchKernel
+	}	   // namespace SED::BlockCipher
+}  // namespace TwilightDreamOfMagical::CustomSecurity
+
+#endif	//ALGORITHM_OALDRESPUZZLECRYPTIC_LAIMASSEYBATCHKERNEL_HPP
@@ -103,10 +103,21 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			// 步骤：重组→分割→χ‑like 非线性→PHT 扩散→直接写出 12 子键。
 			// Steps: reorganize → split → χ‑like NL → PHT diffusion → emit 12 subkeys.
 			std::vector<std::uint32_t> Module_MixTransformationUtil::Word32Bit_ExpandKey( std::span<const std::uint32_t> NeedHashDataWords )
+			{
+				std::vector<std::uint32_t> ProcessedWordKeys( NeedHashDataWords.size() * 12, 0 );
+				this->Word32Bit_ExpandKey( NeedHashDataWords, ProcessedWordKeys );
+				return ProcessedWordKeys;
+			}
+
+			void Module_MixTransformationUtil::Word32Bit_ExpandKey( std::span<const std::uint32_t> NeedHashDataWords, std::span<std::uint32_t> ProcessedWordKeys )
 			{
 				using CommonToolkit::IntegerExchangeBytes::ByteSwap::byteswap;
 
-				std::vector<std::uint32_t> ProcessedWordKeys( NeedHashDataWords.size() * 12, 0 );
+				my_cpp2020_assert( ProcessedWordKeys.size() == NeedHashDataWords.size() * 12, "Module_MixTransformationUtil: The expanded key buffer must hold 12 words per input word!", std::source_location::current() );
+
+				//扩展字是异或写出的，所以先清零调用者的缓冲区
+				//The expanded words are written with exclusive-or, so clear the caller's buffer first
+				std::ranges::fill( ProcessedWordKeys, 0U );
 
 				std::size_t NeedHashDataIndex = 0;
 				while ( NeedHashDataIndex < NeedHashDataWords.size() )
@@ -200,8 +211,6 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					++NeedHashDataIndex;
 
 				}
-
-				return ProcessedWordKeys;
 			}  // namespace ImplementationDetails
 
 			static constexpr std::array<std::uint8_t, 32> SwapBitPairs { 0x00, 0x09, 0x01, 0x12, 0x02, 0x1B, 0x03, 0x14, 0x04, 0x13, 0x05, 0x1C, 0x06, 0x15, 0x07, 0x0E, 0x08, 0x17, 0x0A, 0x18, 0x0B, 0x19, 0x0C, 0x1E, 0x0D, 0x1F, 0x0F, 0x10, 0x11, 0x1D, 0x16, 0x1A };
@@ -72,6 +72,10 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				*/
 				std::vector<std::uint32_t> Word32Bit_ExpandKey( std::span<const std::uint32_t> NeedHashDataWords );
 
+				//同上，但写到调用者提供的缓冲区里 (大小必须是输入的 12 倍)，不分配内存
+				//Same as above, but writes into a caller-provided buffer (which must be 12 times the input size) without allocating
+				void Word32Bit_ExpandKey( std::span<const std::uint32_t> NeedHashDataWords, std::span<std::uint32_t> ProcessedWordKeys );
+
 			private:
 				CommonStateData* StateDataPointer = nullptr;
 
@@ -8,6 +8,17 @@ namespace TwilightDreamOfMagical::CustomSecurity
 		namespace ImplementationDetails
 		{
 			void Module_SecureRoundSubkeyGeneratation::OPC_MatrixTransformation()
+			{
+				constexpr std::size_t FixedMatrixSize = CommonStateData::FixedConfiguration_KeyMatrixSize;
+
+				if ( StateDataPointer->IsFixedConfiguration() )
+					this->OPC_MatrixTransformationSized<FixedMatrixSize, FixedMatrixSize>();
+				else
+					this->OPC_MatrixTransformationSized<0, 0>();
+			}
+
+			template <std::size_t FixedRows, std::size_t FixedColumns>
+			void Module_SecureRoundSubkeyGeneratation::OPC_MatrixTransformationSized()
 			{
 				//https://eigen.tuxfamily.org/dox/group__TutorialSTL.html
 
@@ -15,6 +26,45 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				auto& TransformedSubkeyMatrix = StateDataPointer->TransformedSubkeyMatrix;
 
 				#if 1
+				/*
+					使用专用的模 2^64 矩阵乘法引擎，结果与下面的 Eigen 版本逐位相同
+					Use the dedicated modulo 2^64 matrix multiplication engine; the result is bit-identical to the Eigen version below
+
+					Temporary = RHS^T * LHS^T, 其中 RHS^T = T^T - R, LHS^T = R^T + T
+					Temporary = RHS^T * LHS^T, where RHS^T = T^T - R, LHS^T = R^T + T
+					GeneratedRoundSubkeyMatrix += Temporary * (R * T)
+				*/
+				namespace GEMM = WrappingIntegerMatrixMultiply;
+
+				const std::size_t Rows = FixedRows != 0 ? FixedRows : StateDataPointer->OPC_KeyMatrix_Rows;
+				const std::size_t Columns = FixedColumns != 0 ? FixedColumns : StateDataPointer->OPC_KeyMatrix_Columns;
+				const std::size_t MatrixSize = Rows * Columns;
+
+				const std::uint64_t* R = RandomQuadWordMatrix.data();
+				const std::uint64_t* T = TransformedSubkeyMatrix.data();
+
+				std::uint64_t* RHS_Transpose = MatrixTransformationWorkspace.data();
+				std::uint64_t* LHS_Transpose = RHS_Transpose + MatrixSize;
+				std::uint64_t* TemporaryIntegerMartix = LHS_Transpose + MatrixSize;
+				std::uint64_t* RightOnce = TemporaryIntegerMartix + MatrixSize;
+
+				//先把“和/差”的转置直接 materialize，乘法内核只需要处理普通的列主序矩阵
+				//Materialize the transposed "sum/difference" directly, so the multiply kernel only handles plain column-major matrices
+				for ( std::size_t Column = 0; Column < Columns; ++Column )
+				{
+					for ( std::size_t Row = 0; Row < Rows; ++Row )
+					{
+						const std::size_t Index = Row + Column * Rows;
+						const std::size_t TransposeIndex = Column + Row * Rows;
+						RHS_Transpose[ Index ] = T[ TransposeIndex ] - R[ Index ];
+						LHS_Transpose[ Index ] = R[ TransposeIndex ] + T[ Index ];
+					}
+				}
+
+				GEMM::MultiplyMatrix( Rows, Columns, Columns, RHS_Transpose, Rows, LHS_Transpose, Rows, TemporaryIntegerMartix, Rows, false );
+				GEMM::MultiplyMatrix( Rows, Columns, Columns, R, Rows, T, Rows, RightOnce, Rows, false );
+				GEMM::MultiplyMatrix( Rows, Columns, Columns, TemporaryIntegerMartix, Rows, RightOnce, Rows, this->GeneratedRoundSubkeyMatrix.data(), Rows, true );
+				#else
 				//先把“和/差”各自 materialize，避免在乘法里重复遍历/转置
 				const auto TransformedSubkeyMatrixTranspose = TransformedSubkeyMatrix.transpose();
 				const auto RandomQuadWordMatrixTranspose    = RandomQuadWordMatrix.transpose();
@@ -32,12 +82,6 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				// 链式乘：把更可复用的右侧先做出来，再一次性与 Temporary 相乘并累加
 				const auto RightOnce = (RandomQuadWordMatrix * TransformedSubkeyMatrix).eval();
 				this->GeneratedRoundSubkeyMatrix.noalias() += TemporaryIntegerMartix * RightOnce;
-				#else
-				Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic> TemporaryIntegerMartix = Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic>::Zero( StateDataPointer->OPC_KeyMatrix_Rows, StateDataPointer->OPC_KeyMatrix_Columns );
-
-				//TemporaryIntegerMartix = ( RandomQuadWordMatrix + transpose(TransformedSubkeyMatrix) ) * ( TransformedSubkeyMatrix - transpose(RandomQuadWordMatrix) ) -> adjoint()
-				TemporaryIntegerMartix.noalias() = ( ( RandomQuadWordMatrix + TransformedSubkeyMatrix.transpose() ) * ( TransformedSubkeyMatrix - RandomQuadWordMatrix.transpose() ) ).adjoint();
-				this->GeneratedRoundSubkeyMatrix.noalias() += TemporaryIntegerMartix * RandomQuadWordMatrix * TransformedSubkeyMatrix;
 				#endif
 				/*
 					注意，如果这段代码被注释掉，虽然可以显著提高OaldresPuzzle-Cryptic算法的运行速度。
@@ -47,7 +91,12 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				*/
 				//确保状态矩阵被安全的清理
 				//Ensure that the status matrix is securely cleaned
+				#if 1
+				volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( MatrixTransformationWorkspace.data(), MatrixTransformationWorkspace.size() * sizeof( std::uint64_t ) );
+				CheckPointer = nullptr;
+				#else
 				TemporaryIntegerMartix.setZero();
+				#endif
 			}
 
 			#if 0
@@ -171,11 +220,11 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 			void Module_SecureRoundSubkeyGeneratation::GenerationRoundSubkeys()
 			{
-				volatile void* CheckPointer = nullptr;
+				TDOM_OPC_PROFILE_STAGE( StateDataPointer->StageProfiler, GenerationRoundSubkeys, GeneratedRoundSubkeyVector.size() * sizeof( std::uint64_t ) );
 
 				if ( this->MatrixTransformationCounter == 0 )
 				{
-					CheckPointer = memory_set_no_optimize_function<0x00>( GeneratedRoundSubkeyVector.data(), GeneratedRoundSubkeyVector.size() * sizeof( std::uint64_t ) );
+					volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( GeneratedRoundSubkeyVector.data(), GeneratedRoundSubkeyVector.size() * sizeof( std::uint64_t ) );
 					CheckPointer = nullptr;
 
 					GeneratedRoundSubkeyMatrix.setZero();
@@ -194,90 +243,44 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					++KeyVectorIndex;
 				}
 
-				std::vector<std::uint64_t> TransformedRoundSubkeyVector( StateDataPointer->OPC_KeyMatrix_Rows * StateDataPointer->OPC_KeyMatrix_Columns, 0 );
-
-				std::span<std::uint64_t>	   NewRoundSubkeyVectorSpan( TransformedRoundSubkeyVector.begin(), TransformedRoundSubkeyVector.end() );
-				std::span<const std::uint64_t> RoundSubkeyVectorSpan( GeneratedRoundSubkeyVector.begin(), GeneratedRoundSubkeyVector.end() );
-
 				/*
-						比特数据扩散层
-						Bits data diffusion layer
+					比特数据扩散层
+					Bits data diffusion layer
+
+					数据雪崩效应进行扩散
+					Data avalanche effect for diffusion
+
+				该排列的常数Index来源于,上面注释的GenerateDiffusionLayerPermuteIndices(函数/算法)，
+				现在作为 constexpr 矩阵放在 DiffusionLayerNetwork.cpp 里，并在编译期被消除公共子表达式，编译成最小的异或网络。
+				The constant Index of this alignment comes from, the (function/algorithm) annotated above,
+				and now lives as a constexpr matrix in DiffusionLayerNetwork.cpp, compiled into a minimal XOR network through common subexpression elimination at compile time.
+
+				伪代码:
+				Pseudocode:
+
+				MatrixA, MatrixB from KeyStateX
+				VectorA, VectorB from KeyStateY
+				VectorA is KeyStateY[0] ... KeyStateY[15]
+				VectorB is KeyStateY[16] ... KeyStateY[31]
+
+				//把长向量当成一个矩阵的视图来看
+				//View the long vector as a matrix
+				KeyStateMatrixX = ViewRangeMatrix(KeyStateX)
+				KeyStateMatrixY = ViewRangeMatrix(KeyStateY)
+
+				VectorA, VectorB = Split(KeyStateMatrixY)
+				MatrixA, MatrixB = Split(KeyStateMatrixX)
+				StateMatrixY[Index] = BinaryDiffusion(MatrixA, MatrixB, VectorA, VectorB)
+					Vectorα = BinaryMultiplicationWithGaloisFiniteField(VectorA, MatrixA)
+					Vectorβ = BinaryMultiplicationWithGaloisFiniteField(VectorB, MatrixB)
+					Vectorα, Vectorβ ∈ GaloisFiniteField(power(2, 64))
+					return Concat(Vectorα, Vectorβ)
 
-						数据雪崩效应进行扩散
-						Data avalanche effect for diffusion
-					*/
-				for ( std::size_t Index = 0; Index < RoundSubkeyVectorSpan.size(); Index += 32 )
-				{
-					std::span<const std::uint64_t> KeyStateX = RoundSubkeyVectorSpan.subspan( Index, 32 );
-					std::span<std::uint64_t>	   KeyStateY = NewRoundSubkeyVectorSpan.subspan( Index, 32 );
-
-					/*
-
-					该排列的常数Index来源于,上面注释的GenerateDiffusionLayerPermuteIndices(函数/算法).
-					The constant Index of this alignment comes from, the (function/algorithm) annotated above.
-
-					伪代码:
-					Pseudocode:
-
-					MatrixA, MatrixB from KeyStateX
-					VectorA, VectorB from KeyStateY
-					VectorA is KeyStateY[0] ... KeyStateY[15]
-					VectorB is KeyStateY[16] ... KeyStateY[31]
-
-					//把长向量当成一个矩阵的视图来看
-					//View the long vector as a matrix
-					KeyStateMatrixX = ViewRangeMatrix(KeyStateX)
-					KeyStateMatrixY = ViewRangeMatrix(KeyStateY)
-
-					VectorA, VectorB = Split(KeyStateMatrixY)
-					MatrixA, MatrixB = Split(KeyStateMatrixX)
-					StateMatrixY[Index] = BinaryDiffusion(MatrixA, MatrixB, VectorA, VectorB)
-						Vectorα = BinaryMultiplicationWithGaloisFiniteField(VectorA, MatrixA)
-						Vectorβ = BinaryMultiplicationWithGaloisFiniteField(VectorB, MatrixB)
-						Vectorα, Vectorβ ∈ GaloisFiniteField(power(2, 64))
-						return Concat(Vectorα, Vectorβ)
-
-					*/
-
-					KeyStateY[ 0 ] = KeyStateX[ 24 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 9 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 15 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 12 ];
-					KeyStateY[ 1 ] = KeyStateX[ 19 ] ^ KeyStateX[ 11 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 25 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 7 ] ^ KeyStateX[ 0 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 21 ] ^ KeyStateX[ 28 ] ^ KeyStateX[ 20 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 16 ];
-					KeyStateY[ 2 ] = KeyStateX[ 4 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 21 ] ^ KeyStateX[ 20 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 12 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 25 ];
-					KeyStateY[ 3 ] = KeyStateX[ 11 ] ^ KeyStateX[ 19 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 0 ] ^ KeyStateX[ 7 ] ^ KeyStateX[ 28 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 15 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 9 ];
-					KeyStateY[ 4 ] = KeyStateX[ 21 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 28 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 7 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 25 ] ^ KeyStateX[ 9 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 19 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 1 ];
-					KeyStateY[ 5 ] = KeyStateX[ 15 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 11 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 12 ] ^ KeyStateX[ 20 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 0 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 14 ];
-					KeyStateY[ 6 ] = KeyStateX[ 16 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 21 ] ^ KeyStateX[ 25 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 0 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 28 ] ^ KeyStateX[ 3 ];
-					KeyStateY[ 7 ] = KeyStateX[ 12 ] ^ KeyStateX[ 20 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 15 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 9 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 11 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 19 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 7 ];
-					KeyStateY[ 8 ] = KeyStateX[ 7 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 9 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 20 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 21 ];
-					KeyStateY[ 9 ] = KeyStateX[ 19 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 15 ] ^ KeyStateX[ 28 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 0 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 25 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 12 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 11 ];
-					KeyStateY[ 10 ] = KeyStateX[ 25 ] ^ KeyStateX[ 9 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 12 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 21 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 28 ];
-					KeyStateY[ 11 ] = KeyStateX[ 0 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 19 ] ^ KeyStateX[ 11 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 7 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 15 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 20 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 2 ];
-					KeyStateY[ 12 ] = KeyStateX[ 9 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 7 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 28 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 11 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 0 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 22 ];
-					KeyStateY[ 13 ] = KeyStateX[ 12 ] ^ KeyStateX[ 20 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 19 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 21 ] ^ KeyStateX[ 25 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 15 ];
-					KeyStateY[ 14 ] = KeyStateX[ 7 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 11 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 28 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 25 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 9 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 8 ];
-					KeyStateY[ 15 ] = KeyStateX[ 20 ] ^ KeyStateX[ 12 ] ^ KeyStateX[ 21 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 15 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 19 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 0 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 5 ];
-
-					KeyStateY[ 16 ] = KeyStateX[ 7 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 9 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 20 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 21 ];
-					KeyStateY[ 17 ] = KeyStateX[ 19 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 15 ] ^ KeyStateX[ 28 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 0 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 25 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 12 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 11 ];
-					KeyStateY[ 18 ] = KeyStateX[ 25 ] ^ KeyStateX[ 9 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 12 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 21 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 28 ];
-					KeyStateY[ 19 ] = KeyStateX[ 0 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 19 ] ^ KeyStateX[ 11 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 7 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 15 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 20 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 2 ];
-					KeyStateY[ 20 ] = KeyStateX[ 9 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 7 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 28 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 11 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 0 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 22 ];
-					KeyStateY[ 21 ] = KeyStateX[ 12 ] ^ KeyStateX[ 20 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 19 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 21 ] ^ KeyStateX[ 25 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 15 ];
-					KeyStateY[ 22 ] = KeyStateX[ 7 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 11 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 28 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 25 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 9 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 8 ];
-					KeyStateY[ 23 ] = KeyStateX[ 20 ] ^ KeyStateX[ 12 ] ^ KeyStateX[ 21 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 15 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 19 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 0 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 5 ];
-					KeyStateY[ 24 ] = KeyStateX[ 31 ] ^ KeyStateX[ 7 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 15 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 9 ] ^ KeyStateX[ 12 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 30 ];
-					KeyStateY[ 25 ] = KeyStateX[ 0 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 20 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 28 ] ^ KeyStateX[ 25 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 21 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 11 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 19 ];
-					KeyStateY[ 26 ] = KeyStateX[ 18 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 15 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 28 ] ^ KeyStateX[ 25 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 21 ] ^ KeyStateX[ 9 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 7 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 13 ];
-					KeyStateY[ 27 ] = KeyStateX[ 17 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 19 ] ^ KeyStateX[ 0 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 20 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 12 ] ^ KeyStateX[ 11 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 6 ];
-					KeyStateY[ 28 ] = KeyStateX[ 27 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 4 ] ^ KeyStateX[ 13 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 25 ] ^ KeyStateX[ 19 ] ^ KeyStateX[ 9 ] ^ KeyStateX[ 7 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 11 ] ^ KeyStateX[ 10 ];
-					KeyStateY[ 29 ] = KeyStateX[ 28 ] ^ KeyStateX[ 12 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 0 ] ^ KeyStateX[ 31 ] ^ KeyStateX[ 21 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 15 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 20 ];
-					KeyStateY[ 30 ] = KeyStateX[ 13 ] ^ KeyStateX[ 5 ] ^ KeyStateX[ 3 ] ^ KeyStateX[ 19 ] ^ KeyStateX[ 25 ] ^ KeyStateX[ 8 ] ^ KeyStateX[ 18 ] ^ KeyStateX[ 28 ] ^ KeyStateX[ 22 ] ^ KeyStateX[ 7 ] ^ KeyStateX[ 11 ] ^ KeyStateX[ 10 ] ^ KeyStateX[ 14 ] ^ KeyStateX[ 2 ] ^ KeyStateX[ 17 ] ^ KeyStateX[ 31 ];
-					KeyStateY[ 31 ] = KeyStateX[ 21 ] ^ KeyStateX[ 6 ] ^ KeyStateX[ 30 ] ^ KeyStateX[ 12 ] ^ KeyStateX[ 20 ] ^ KeyStateX[ 24 ] ^ KeyStateX[ 23 ] ^ KeyStateX[ 26 ] ^ KeyStateX[ 29 ] ^ KeyStateX[ 0 ] ^ KeyStateX[ 9 ] ^ KeyStateX[ 1 ] ^ KeyStateX[ 15 ] ^ KeyStateX[ 27 ] ^ KeyStateX[ 16 ] ^ KeyStateX[ 4 ];
-				}
-
-				GeneratedRoundSubkeyVector = TransformedRoundSubkeyVector;
+				*/
 
-				CheckPointer = memory_set_no_optimize_function<0x00>( TransformedRoundSubkeyVector.data(), TransformedRoundSubkeyVector.size() * sizeof( std::uint64_t ) );
-				CheckPointer = nullptr;
+				//原地变换，每次处理多片 KeyStateX，不再需要 TransformedRoundSubkeyVector 这个临时堆内存
+				//Transform in place, several KeyStateX slices at a time, so the TransformedRoundSubkeyVector heap temporary is no longer needed
+				DiffusionLayerNetwork::ApplyDiffusionLayer( GeneratedRoundSubkeyVector );
 
 				++( this->MatrixTransformationCounter );
 			}
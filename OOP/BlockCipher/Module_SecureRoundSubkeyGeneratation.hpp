@@ -24,6 +24,9 @@
 #define ALGORITHM_OALDRESPUZZLECRYPTIC_MODULE_SECUREROUNDSUBKEYGENERATATION_HPP
 
 #include "Modules_OaldresPuzzle_Cryptic.hpp"
+#include "WrappingIntegerMatrixMultiply.hpp"
+#include "DiffusionLayerNetwork.hpp"
+#include "LaiMasseyBatchKernel.hpp"
 
 namespace TwilightDreamOfMagical::CustomSecurity
 {
@@ -37,6 +40,8 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			class Module_SecureRoundSubkeyGeneratation
 			{
 
+				friend class TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_BenchmarkProbe;
+
 			public:
 				explicit Module_SecureRoundSubkeyGeneratation( CommonStateData& CommonStateDataObject )
 					:
@@ -44,6 +49,7 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				{
 					GeneratedRoundSubkeyMatrix = Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic>::Zero( StateDataPointer->OPC_KeyMatrix_Rows, StateDataPointer->OPC_KeyMatrix_Columns );
 					GeneratedRoundSubkeyVector = std::vector<std::uint64_t>( StateDataPointer->OPC_KeyMatrix_Rows * StateDataPointer->OPC_KeyMatrix_Columns, 0 );
+					MatrixTransformationWorkspace = std::vector<std::uint64_t>( StateDataPointer->OPC_KeyMatrix_Rows * StateDataPointer->OPC_KeyMatrix_Columns * 4, 0 );
 				}
 
 				~Module_SecureRoundSubkeyGeneratation()
@@ -53,6 +59,9 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					CheckPointer = memory_set_no_optimize_function<0x00>( GeneratedRoundSubkeyVector.data(), GeneratedRoundSubkeyVector.size() * sizeof( std::uint64_t ) );
 					CheckPointer = nullptr;
 
+					CheckPointer = memory_set_no_optimize_function<0x00>( MatrixTransformationWorkspace.data(), MatrixTransformationWorkspace.size() * sizeof( std::uint64_t ) );
+					CheckPointer = nullptr;
+
 					GeneratedRoundSubkeyMatrix.setZero();
 				}
 
@@ -82,6 +91,48 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					return this->GeneratedRoundSubkeyVector;
 				}
 
+				//给批量 Lai-Massey 内核使用的只读视图，与 CrazyTransformAssociatedWord 读取的状态相同
+				//Read-only view for the batched Lai-Massey kernel, the same state that CrazyTransformAssociatedWord reads
+				LaiMasseyBatchKernel::AssociatedWordTables UseAssociatedWordTables() const
+				{
+					return LaiMasseyBatchKernel::AssociatedWordTables
+					{
+						StateDataPointer->MatrixOffsetWithRandomIndices.data(),
+						static_cast<std::uint32_t>( StateDataPointer->MatrixOffsetWithRandomIndices.size() ),
+						GeneratedRoundSubkeyMatrix.data(),
+						static_cast<std::size_t>( GeneratedRoundSubkeyMatrix.rows() )
+					};
+				}
+
+				//轮子密钥模块的状态快照: 矩阵变换计数器、子密钥矩阵和子密钥向量
+				//State snapshot of the round subkey module: the matrix transformation counter, the subkey matrix and the subkey vector
+				std::size_t SnapshotByteSize() const
+				{
+					return sizeof( MatrixTransformationCounter )
+						+ static_cast<std::size_t>( GeneratedRoundSubkeyMatrix.size() ) * sizeof( std::uint64_t )
+						+ GeneratedRoundSubkeyVector.size() * sizeof( std::uint64_t );
+				}
+
+				void SaveSnapshot( std::span<std::uint8_t> SnapshotBytes ) const
+				{
+					my_cpp2020_assert( SnapshotBytes.size() == this->SnapshotByteSize(), "Module_SecureRoundSubkeyGeneratation: The snapshot size does not match this module!", std::source_location::current() );
+
+					const std::size_t MatrixByteSize = static_cast<std::size_t>( GeneratedRoundSubkeyMatrix.size() ) * sizeof( std::uint64_t );
+					std::memcpy( SnapshotBytes.data(), &MatrixTransformationCounter, sizeof( MatrixTransformationCounter ) );
+					std::memcpy( SnapshotBytes.data() + sizeof( MatrixTransformationCounter ), GeneratedRoundSubkeyMatrix.data(), MatrixByteSize );
+					std::memcpy( SnapshotBytes.data() + sizeof( MatrixTransformationCounter ) + MatrixByteSize, GeneratedRoundSubkeyVector.data(), GeneratedRoundSubkeyVector.size() * sizeof( std::uint64_t ) );
+				}
+
+				void RestoreSnapshot( std::span<const std::uint8_t> SnapshotBytes )
+				{
+					my_cpp2020_assert( SnapshotBytes.size() == this->SnapshotByteSize(), "Module_SecureRoundSubkeyGeneratation: The snapshot size does not match this module!", std::source_location::current() );
+
+					const std::size_t MatrixByteSize = static_cast<std::size_t>( GeneratedRoundSubkeyMatrix.size() ) * sizeof( std::uint64_t );
+					std::memcpy( &MatrixTransformationCounter, SnapshotBytes.data(), sizeof( MatrixTransformationCounter ) );
+					std::memcpy( GeneratedRoundSubkeyMatrix.data(), SnapshotBytes.data() + sizeof( MatrixTransformationCounter ), MatrixByteSize );
+					std::memcpy( GeneratedRoundSubkeyVector.data(), SnapshotBytes.data() + sizeof( MatrixTransformationCounter ) + MatrixByteSize, GeneratedRoundSubkeyVector.size() * sizeof( std::uint64_t ) );
+				}
+
 			private:
 				CommonStateData* StateDataPointer = nullptr;
 
@@ -97,9 +148,18 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 				std::uint64_t MatrixTransformationCounter = 0;
 
+				//矩阵变换的中间矩阵 (列主序，依次为 RHS^T, LHS^T, Temporary, RightOnce)，只分配一次
+				//Intermediate matrices of the matrix transformation (column-major: RHS^T, LHS^T, Temporary, RightOnce), allocated only once
+				std::vector<std::uint64_t> MatrixTransformationWorkspace;
+
 				//奥尔德雷斯之谜 - 不可预测的矩阵变换
 				//OaldresPuzzle-Cryptic - Unpredictable matrix transformation
 				void OPC_MatrixTransformation();
+
+				//FixedRows/FixedColumns 为 0 时使用运行时的矩阵大小，否则在编译期固定 (循环边界是常量，可以完全展开)
+				//When FixedRows/FixedColumns are 0 the runtime matrix size is used, otherwise it is fixed at compile time (constant loop bounds that can be fully unrolled)
+				template <std::size_t FixedRows, std::size_t FixedColumns>
+				void OPC_MatrixTransformationSized();
 			};
 		}  // namespace ImplementationDetails
 	}	   // namespace SED::BlockCipher
@@ -8,93 +8,98 @@ namespace TwilightDreamOfMagical::CustomSecurity
 	{
 		namespace ImplementationDetails
 		{
-			Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1> 
-			TDOM_HashModule::SecureHash
-			(
-				const Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic>& RandomQuadWordMatrix,
-				const Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1>&              IntegerVector
-			)
+			namespace
 			{
-				using TwilightDreamOfMagical::PrimeField::Montgomery64;
-				using TwilightDreamOfMagical::PrimeField::MontgomeryComputationScope;
-				using TwilightDreamOfMagical::PrimeField::MontgomeryPrimeFieldContext;
-
-				// 1) 建立 64 位蒙哥马利域上下文（模数为 LargePrimeNumber）。
-				//    Create 64-bit Montgomery field context (modulus = LargePrimeNumber).
-				MontgomeryPrimeFieldContext prime_field_context(TDOM_HashModule::LargePrimeNumber);
-
-				// 2) 开启作用域：将上下文注入到自定义标量的线程局部环境。
-				//    Enter scope: inject the context into the custom scalar's thread-local environment.
-				MontgomeryComputationScope scope(prime_field_context);
-
-				// 3) 将普通矩阵/向量映射为“蒙哥马利域内部表示”。入域只做一次，后续全在域内完成。
-				//    Map plain matrix/vector to Montgomery representation. Enter the field once; stay inside for the whole product.
-				Eigen::Matrix<Montgomery64, Eigen::Dynamic, Eigen::Dynamic> matrix_in_field(RandomQuadWordMatrix.rows(),
-																							RandomQuadWordMatrix.cols());
-				Eigen::Matrix<Montgomery64, Eigen::Dynamic, 1>              vector_in_field(IntegerVector.rows());
-
-				// 入域矩阵（每个元素先取模再转为域内表示）。
-				// Map matrix to field (reduce then convert to Montgomery form).
-				for (ptrdiff_t row = 0; row < matrix_in_field.rows(); ++row)
-					for (ptrdiff_t col = 0; col < matrix_in_field.cols(); ++col)
-						matrix_in_field(row, col) = Montgomery64::FromStandard(RandomQuadWordMatrix(row, col));
-
-				// 入域向量。
-				// Map vector to field.
-				for (ptrdiff_t index = 0; index < vector_in_field.rows(); ++index)
-					vector_in_field(index) = Montgomery64::FromStandard(IntegerVector(index));
-
-				// 4) 直接调用 Eigen 乘法核：此时 “*” 与 “+” 均为蒙哥马利域操作（无除法）。
-				//    Call Eigen's GEMV: now '*' and '+' are Montgomery ops (division-free modular arithmetic).
-				//    y_m = A_m * x_m  (all in Montgomery domain)
-				Eigen::Matrix<Montgomery64, Eigen::Dynamic, 1> vector_product_in_field = (matrix_in_field * vector_in_field).eval();
-
-				// 5) 出域：把域内结果转换为普通余数 [0, p)。
-				//    Leave the field: convert back to standard residues in [0, p).
-				Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1> product_vector(vector_product_in_field.rows());
-				for (ptrdiff_t row = 0; row < vector_product_in_field.rows(); ++row)
-					product_vector(row) = vector_product_in_field(row).ToStandard();
-
-				// 6) 将 y 作为输入喂给海绵函数，得到等长的杂合向量 h。
-				//    Feed y into the sponge to get an equal-length mixed vector h.
-				std::span<std::uint64_t> span_product(product_vector.data(), static_cast<size_t>(product_vector.size()));
+				//模数为 LargePrimeNumber 的 64 位蒙哥马利域上下文, 只建立一次
+				//64-bit Montgomery field context with modulus LargePrimeNumber, built only once
+				const TwilightDreamOfMagical::PrimeField::MontgomeryPrimeFieldContext& LargePrimeFieldContext()
+				{
+					static const TwilightDreamOfMagical::PrimeField::MontgomeryPrimeFieldContext prime_field_context(TDOM_HashModule::LargePrimeNumber);
+					return prime_field_context;
+				}
+			}
 
-				std::vector<std::uint64_t> sponge_hashed(static_cast<size_t>(IntegerVector.rows()));
-				std::span<std::uint64_t>   span_sponge_hashed(sponge_hashed.data(), sponge_hashed.size());
+			void TDOM_HashModule::SecureHashWorkspace::Wipe()
+			{
+				const auto WipeWords = [](std::vector<std::uint64_t>& Words)
+				{
+					volatile void* CheckPointer = memory_set_no_optimize_function<0x00>(Words.data(), Words.size() * sizeof(std::uint64_t));
+					CheckPointer = nullptr;
+				};
+
+				WipeWords(MatrixInField);
+				WipeWords(IntegerVector);
+				WipeWords(VectorInField);
+				WipeWords(AccumulatorWords);
+				WipeWords(ProductVector);
+				WipeWords(SpongeHashed);
+				WipeWords(HashedResult);
+			}
 
+			std::uint64_t TDOM_HashModule::MapToField(std::uint64_t Value)
+			{
+				return LargePrimeFieldContext().ToMontgomery(Value);
+			}
+
+			void TDOM_HashModule::SecureHash(SecureHashWorkspace& Workspace)
+			{
+				using TwilightDreamOfMagical::PrimeField::MultiplyMatrixVectorInField;
+
+				// 1) 融合的模 GEMV：矩阵已经是域内表示，乘积的和惰性累加，每行只规约一次，最后出域为普通余数 [0, p)。
+				//    Fused modular GEMV: the matrix is already in Montgomery form, the sum of products is accumulated lazily and reduced once per row, then leaves the field as standard residues [0, p).
+				//    y = A * x  (residues identical to the Montgomery64 + Eigen GEMV path)
+				MultiplyMatrixVectorInField<true>
+				(
+					LargePrimeFieldContext(),
+					Workspace.MatrixInField.data(), Workspace.Rows, Workspace.Columns,
+					Workspace.IntegerVector.data(), Workspace.ProductVector.data(),
+					Workspace.VectorInField.data(), Workspace.AccumulatorWords.data()
+				);
+
+				// 2) 将 y 作为输入喂给海绵函数，得到等长的杂合向量 h。
+				//    Feed y into the sponge to get an equal-length mixed vector h.
 				// 约定：海绵的 rate 为 64 比特；每吸收/挤压一个 64 位字后立刻搅拌（实现已在自定义哈希内部保证）。
 				// Convention: sponge rate is 64 bits; each 64-bit word absorbed/squeezed is followed by a state permutation (guaranteed inside your hash).
-				CustomSecureHashObject.SpongeHash(span_product, span_sponge_hashed);
+				CustomSecureHashObject.SpongeHash(Workspace.ProductVector, Workspace.SpongeHashed);
 
-				// 7) 逐元素做 y + h (mod p)；使用“条件减法”实现常时间模加。
+				// 3) 逐元素做 y + h (mod p)；使用“条件减法”实现常时间模加。
 				//    Compute y + h (mod p) element-wise; use conditional subtraction (branchless-friendly) for constant-time style add.
-				Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1> hashed_result(IntegerVector.rows());
-				for (ptrdiff_t row = 0; row < hashed_result.rows(); ++row)
+				for (std::size_t row = 0; row < Workspace.Rows; ++row)
 				{
-					const std::uint64_t a = product_vector(row);
-					const std::uint64_t b = sponge_hashed[static_cast<size_t>(row)];
+					const std::uint64_t a = Workspace.ProductVector[row];
+					const std::uint64_t b = Workspace.SpongeHashed[row];
 					const std::uint64_t sum = a + b;
-					hashed_result(row) = (sum >= TDOM_HashModule::LargePrimeNumber || sum < a)
-										 ? (sum - TDOM_HashModule::LargePrimeNumber)
-										 : sum;
+					Workspace.HashedResult[row] = (sum >= TDOM_HashModule::LargePrimeNumber || sum < a)
+												  ? (sum - TDOM_HashModule::LargePrimeNumber)
+												  : sum;
 				}
+			}
 
-				// 8) 清理局部敏感状态。注意：形参是 const，不能也不需要清空外部传入对象。
-				//    Wipe local sensitive state. Note: parameters are const; do NOT zero external inputs.
-				
-				// 域内矩阵/向量（Montgomery64 按字节清零）
-				memory_set_no_optimize_function<0x00>( matrix_in_field.data(), static_cast<size_t>( matrix_in_field.size() ) * sizeof( Montgomery64 ) );
-				memory_set_no_optimize_function<0x00>( vector_in_field.data(), static_cast<size_t>( vector_in_field.size() ) * sizeof( Montgomery64 ) );
-
-				// 乘积（域内）也顺手抹掉（如果还在作用域内）
-				memory_set_no_optimize_function<0x00>( vector_product_in_field.data(), static_cast<size_t>(vector_product_in_field.size()) * sizeof(Montgomery64) );
-
-				// 海绵输出与标准余数向量
-				memory_set_no_optimize_function<0x00>( sponge_hashed.data(), sponge_hashed.size() * sizeof( std::uint64_t ) );
-				memory_set_no_optimize_function<0x00>( product_vector.data(), static_cast<size_t>( product_vector.size() ) * sizeof( std::uint64_t ) );
-
-				// 9) 返回哈希混合后的向量。
-				//    Return the hash-mixed vector.
+			Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1> 
+			TDOM_HashModule::SecureHash
+			(
+				const Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic>& RandomQuadWordMatrix,
+				const Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1>&              IntegerVector
+			)
+			{
+				const std::size_t row_count = static_cast<std::size_t>(RandomQuadWordMatrix.rows());
+				const std::size_t column_count = static_cast<std::size_t>(RandomQuadWordMatrix.cols());
+				my_cpp2020_assert(static_cast<std::size_t>(IntegerVector.rows()) == column_count, "TDOM_HashModule: The number of matrix columns and the size of the vector do not match!", std::source_location::current());
+
+				// 1) 临时工作区；矩阵元素映射到域内表示（列主序，与 Eigen 默认一致）。
+				//    Temporary workspace; map the matrix elements to Montgomery form (column-major, same as the Eigen default).
+				SecureHashWorkspace Workspace(row_count, column_count);
+				for (std::size_t index = 0; index < row_count * column_count; ++index)
+					Workspace.MatrixInField[index] = MapToField(RandomQuadWordMatrix.data()[index]);
+				::memcpy(Workspace.IntegerVector.data(), IntegerVector.data(), column_count * sizeof(std::uint64_t));
+
+				// 2) y = A * x, h = SpongeHash(y), y + h (mod p)
+				this->SecureHash(Workspace);
+
+				// 3) 返回哈希混合后的向量；工作区在析构时清零。注意：形参是 const，不能也不需要清空外部传入对象。
+				//    Return the hash-mixed vector; the workspace is wiped on destruction. Note: parameters are const; do NOT zero external inputs.
+				Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1> hashed_result(IntegerVector.rows());
+				::memcpy(hashed_result.data(), Workspace.HashedResult.data(), row_count * sizeof(std::uint64_t));
 				return hashed_result;
 			}
 
@@ -105,44 +110,43 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			)
 			{
 				auto& SDP_Object = *(StateDataPointer->SDP_ClassicPointer);
-				auto& Rows = StateDataPointer->OPC_KeyMatrix_Rows;
-				auto& Columns = StateDataPointer->OPC_KeyMatrix_Columns;
 				auto& HashObject = *(this->HashObjectPointer);
-
-				//被哈希过的向量
-				//A vector hashed with the result of the hash function
-				Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1>
-				HashMixedIntegerVector = Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1>::Zero(Rows, 1);
+				auto& Workspace = this->LatticeWorkspace;
 
 				//InputX = Input
-				::memcpy(HashMixedIntegerVector.data(), Input.data(), Input.size() * sizeof(std::uint64_t));
-
-				Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic>
-				PseudoRandomNumberMatrix = Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic>::Zero(Rows, Columns);
+				::memcpy(Workspace.IntegerVector.data(), Input.data(), Input.size() * sizeof(std::uint64_t));
 
 				//计算哈希过的向量数据替换原向量数据
 				//Compute hashed vector data to replace original vector data
 				//The pseudo-random matrix elements are generated by a double-pendulum simulation random number generator, which maps to the prime field Z_p.
-				for ( std::size_t ElementIndex = 0; ElementIndex < Rows * Columns; ++ElementIndex )
+				//批量生成后在原处做拒绝采样: 被拒绝的数不占位置, 缺的部分再从伪随机数流里补, 所以接受的数和顺序与逐个拒绝采样完全相同
+				//生成时直接映射到蒙哥马利域内表示, 矩阵只写一次
+				//Generate in bulk, then do rejection sampling in place: rejected numbers take no slot and the missing tail is refilled from the stream, so the accepted numbers and their order are exactly those of one-by-one rejection sampling
+				//Each element is mapped to Montgomery form as it is generated, so the matrix is written only once
+				std::size_t AcceptedCount = 0;
+				while ( AcceptedCount < Workspace.MatrixInField.size() )
 				{
-					std::uint64_t Raw64 = 0;
-					do
+					std::span<std::uint64_t> RefillSpan( Workspace.MatrixInField.data() + AcceptedCount, Workspace.MatrixInField.size() - AcceptedCount );
+					SDP_Object.generate( RefillSpan );
+
+					for ( const std::uint64_t Raw64 : RefillSpan )
 					{
-						Raw64 = SDP_Object( std::numeric_limits<std::uint64_t>::min(), std::numeric_limits<std::uint64_t>::max() );
-					} while ( Raw64 >= TDOM_HashModule::UnbiasedThreshold );
-					PseudoRandomNumberMatrix.data()[ ElementIndex ] = Raw64 % TDOM_HashModule::LargePrimeNumber;  // Z_p [0, p-1]
+						if ( Raw64 >= TDOM_HashModule::UnbiasedThreshold )
+							continue;
+						Workspace.MatrixInField[ AcceptedCount++ ] = TDOM_HashModule::MapToField( Raw64 % TDOM_HashModule::LargePrimeNumber );  // Z_p [0, p-1]
+					}
 				}
 
 				//OutputY = SecureHash(A, InputX)
-				HashMixedIntegerVector.noalias() = HashObject.SecureHash( PseudoRandomNumberMatrix, HashMixedIntegerVector ).eval();
+				HashObject.SecureHash( Workspace );
 
 				//Mixed = InputX + OutputY (mod LargePrimeNumber)
 				//原向量数据和哈希过的向量数据做具有大模数的大整数的加法，然后变成一个被哈希混合过的向量
 				//The original vector data and the hashed vector data are added with a large integer with a large modulus, and then become a hash-mixed vector
-				for ( std::size_t index = 0; index < (size_t)HashMixedIntegerVector.size(); index++ )
+				for ( std::size_t index = 0; index < Workspace.HashedResult.size(); index++ )
 				{
 					const std::uint64_t& a = Input[index % Input.size()];
-					const std::uint64_t& b = HashMixedIntegerVector( index );
+					const std::uint64_t& b = Workspace.HashedResult[ index ];
 					std::uint64_t& c = Output[index];
 
 					if ( c == 0 )
@@ -154,13 +158,15 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					}
 				}
 
-				//确保状态向量被安全的清理
-				//Ensure that the status vector is securely cleaned
-				HashMixedIntegerVector.setZero();
+				//确保工作区被安全的清理
+				//Ensure that the workspace is securely cleaned
+				Workspace.Wipe();
 			}
 
 			void Module_SecureSubkeyGeneratation::GenerationSubkeys(std::span<const std::uint64_t> WordKeyDataVector)
 			{
+				TDOM_OPC_PROFILE_STAGE(StateDataPointer->StageProfiler, GenerationSubkeys, WordKeyDataVector.size_bytes());
+
 				auto& KeyBlockSize = StateDataPointer->OPC_QuadWord_KeyBlockSize;
 				auto& Rows = StateDataPointer->OPC_KeyMatrix_Rows;
 
@@ -171,12 +177,15 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				if(!WordKeyDataVector.empty())
 				{
 					my_cpp2020_assert(WordKeyDataVector.size() % KeyBlockSize == 0, "", std::source_location::current());
-					std::vector<std::uint64_t> WordKeyResistQC(Rows, 0);
+					CommonToolkit::SecureArenaVector<std::uint64_t> WordKeyResistQC(Rows, 0, CommonToolkit::SecureArenaAllocator<std::uint64_t>(StateDataPointer->TransientKeyArena));
 					this->LatticeCryptographyAndHash(WordKeyDataVector, WordKeyResistQC);
 					this->SubkeyMatrixOperationObject.InitializationState(WordKeyResistQC);
-					memory_set_no_optimize_function<0x00>(WordKeyResistQC.data(), WordKeyResistQC.size() * sizeof(std::uint64_t));
 				}
 
+				//这一轮所有临时密钥材料都已经释放，一次性擦除整个安全内存区
+				//All transient key material of this round has been released, wipe the whole secure arena in one pass
+				StateDataPointer->TransientKeyArena.Reset();
+
 				this->SubkeyMatrixOperationObject.UpdateState();
 			}
 
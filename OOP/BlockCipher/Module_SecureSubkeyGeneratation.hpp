@@ -46,6 +46,44 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 				static constexpr std::uint64_t UnbiasedThreshold = std::numeric_limits<std::uint64_t>::max() - ( std::numeric_limits<std::uint64_t>::max() % LargePrimeNumber );
 
+				//SecureHash 的工作区: 所有临时量按固定大小只分配一次, 每次使用后原地清零, 不再每次刷新子密钥都重新分配
+				//Workspace of SecureHash: every temporary is allocated once at a fixed size and wiped in place after each use, instead of being reallocated on every subkey refresh
+				struct SecureHashWorkspace
+				{
+					//列主序的 Rows x Columns 伪随机矩阵, 已经是蒙哥马利域内表示
+					//Column-major Rows x Columns pseudo-random matrix, already in Montgomery form
+					std::vector<std::uint64_t> MatrixInField;
+					//输入向量 x (Columns 个字)
+					//Input vector x (Columns words)
+					std::vector<std::uint64_t> IntegerVector;
+					std::vector<std::uint64_t> VectorInField;
+					std::vector<std::uint64_t> AccumulatorWords;
+					std::vector<std::uint64_t> ProductVector;
+					std::vector<std::uint64_t> SpongeHashed;
+					//哈希混合后的向量 (Rows 个字)
+					//Hash-mixed vector (Rows words)
+					std::vector<std::uint64_t> HashedResult;
+
+					std::size_t Rows = 0;
+					std::size_t Columns = 0;
+
+					SecureHashWorkspace(std::size_t Rows, std::size_t Columns)
+						:
+						MatrixInField(Rows * Columns, 0), IntegerVector(Columns, 0), VectorInField(Columns, 0), AccumulatorWords(Rows * 2, 0),
+						ProductVector(Rows, 0), SpongeHashed(Rows, 0), HashedResult(Rows, 0),
+						Rows(Rows), Columns(Columns)
+					{
+
+					}
+
+					void Wipe();
+
+					~SecureHashWorkspace()
+					{
+						this->Wipe();
+					}
+				};
+
 				/*
 					@details
 					https://en.wikipedia.org/wiki/Short_integer_solution_problem
@@ -92,6 +130,21 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					const Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1>& IntegerVector
 				);
 
+				/*
+					与上面相同的哈希, 但全部在调用者的工作区里完成, 不分配内存:
+					Workspace.MatrixInField 必须已经是蒙哥马利域内表示, 输入是 Workspace.IntegerVector, 输出写到 Workspace.HashedResult。
+					工作区的清理由调用者负责。
+
+					The same hash as above, but done entirely inside the caller's workspace without allocating:
+					Workspace.MatrixInField must already be in Montgomery form, the input is Workspace.IntegerVector, and the output is written to Workspace.HashedResult.
+					Wiping the workspace is the caller's responsibility.
+				*/
+				void SecureHash(SecureHashWorkspace& Workspace);
+
+				//把 Z_p 中的元素映射到蒙哥马利域内表示 (与 SecureHash 内部的映射逐位相同)
+				//Map an element of Z_p to Montgomery form (bit-identical to the mapping inside SecureHash)
+				static std::uint64_t MapToField(std::uint64_t Value);
+
 				explicit TDOM_HashModule(std::uint32_t HashBitSize)
 					:
 					CustomSecureHashObject(HashBitSize)
@@ -106,12 +159,16 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			//Module A: Secure generation of subkeys
 			class Module_SecureSubkeyGeneratation
 			{
+
+				friend class TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_BenchmarkProbe;
+
 			public:
 
 				explicit Module_SecureSubkeyGeneratation(CommonStateData& CommonStateDataObject)
 					:
 					StateDataPointer(std::addressof(CommonStateDataObject)),
-					SubkeyMatrixOperationObject(CommonStateDataObject)
+					SubkeyMatrixOperationObject(CommonStateDataObject),
+					LatticeWorkspace(CommonStateDataObject.OPC_KeyMatrix_Rows, CommonStateDataObject.OPC_KeyMatrix_Columns)
 				{
 					std::uint32_t HashBitSize = static_cast<uint32_t>((StateDataPointer->OPC_KeyMatrix_Rows) * 64) / 2;
 					HashObjectPointer = std::unique_ptr<TDOM_HashModule>(new TDOM_HashModule(HashBitSize));
@@ -158,9 +215,27 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				*/
 				void GenerationSubkeys(std::span<const std::uint64_t> WordKeyDataVector);
 
+				//子密钥模块的状态快照: 只有海绵哈希的状态 (混合变换的寄存器在每次初始化时都会重新播种)
+				//State snapshot of the subkey module: only the sponge hash state (the mix transformation registers are reseeded on every initialization)
+				std::size_t SnapshotByteSize() const
+				{
+					return HashObjectPointer->CustomSecureHashObject.SnapshotByteSize();
+				}
+
+				void SaveSnapshot(std::span<std::uint8_t> SnapshotBytes) const
+				{
+					HashObjectPointer->CustomSecureHashObject.SaveSnapshot(SnapshotBytes);
+				}
+
+				void RestoreSnapshot(std::span<const std::uint8_t> SnapshotBytes)
+				{
+					HashObjectPointer->CustomSecureHashObject.RestoreSnapshot(SnapshotBytes);
+				}
+
 			private:
 				std::unique_ptr<TDOM_HashModule> HashObjectPointer = nullptr;
 				Module_SubkeyMatrixOperation SubkeyMatrixOperationObject;
+				TDOM_HashModule::SecureHashWorkspace LatticeWorkspace;
 
 				CommonStateData* StateDataPointer = nullptr;
 
@@ -76,23 +76,31 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				auto& RandomQuadWordMatrix = StateDataPointer->RandomQuadWordMatrix;
 				auto& LFSR_Object = *( StateDataPointer->LFSR_ClassicPointer );
 
-				std::vector<std::uint8_t> ByteKeys = CommonToolkit::IntegerExchangeBytes::MessageUnpacking<std::uint64_t, std::uint8_t>( Key.data(), Key.size() );
+				using CommonToolkit::SecureArenaAllocator;
+				using CommonToolkit::SecureArenaVector;
+				using CommonToolkit::IntegerExchangeBytes::MessagePacking;
+				using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
 
-				std::vector<std::uint32_t> Word32Bit_Key = CommonToolkit::IntegerExchangeBytes::MessagePacking<std::uint32_t, std::uint8_t>( ByteKeys.data(), ByteKeys.size() );
+				//所有临时密钥材料都放在安全内存区里，由 GenerationSubkeys 结束时一次性擦除，这里不再逐个擦除
+				//All transient key material lives in the secure arena and is wiped in one pass at the end of GenerationSubkeys, so it is no longer wiped one by one here
+				auto& TransientKeyArena = StateDataPointer->TransientKeyArena;
 
-				CheckPointer = memory_set_no_optimize_function<0x00>( ByteKeys.data(), ByteKeys.size() );
-				CheckPointer = nullptr;
-				ByteKeys.resize( 0 );
+				SecureArenaVector<std::uint8_t> ByteKeys( Key.size() * sizeof( std::uint64_t ), 0, SecureArenaAllocator<std::uint8_t>( TransientKeyArena ) );
+				MessageUnpacking<std::uint64_t, std::uint8_t>( Key, ByteKeys.data() );
+
+				SecureArenaVector<std::uint32_t> Word32Bit_Key( ByteKeys.size() / sizeof( std::uint32_t ), 0, SecureArenaAllocator<std::uint32_t>( TransientKeyArena ) );
+				MessagePacking<std::uint32_t, std::uint8_t>( ByteKeys, Word32Bit_Key.data() );
 
 				MixTransformationUtilObject.Word32Bit_Initialize();
 
 				//初始采样Word数据 (使用32Bit字 - 密钥向量)
 				//Initial sampling of Word data (Use 32Bit Word - Key Vector)
-				std::vector<std::uint32_t> Word32Bit_ExpandedKey = MixTransformationUtilObject.Word32Bit_ExpandKey( Word32Bit_Key );
+				SecureArenaVector<std::uint32_t> Word32Bit_ExpandedKey( Word32Bit_Key.size() * 12, 0, SecureArenaAllocator<std::uint32_t>( TransientKeyArena ) );
+				MixTransformationUtilObject.Word32Bit_ExpandKey( Word32Bit_Key, Word32Bit_ExpandedKey );
 
 				std::span<std::uint32_t> Word32Bit_ExpandedKeySpan( Word32Bit_ExpandedKey.begin(), Word32Bit_ExpandedKey.end() );
 
-				std::vector<std::uint32_t> Word32Bit_Random( Word32Bit_ExpandedKey.size() / 4, 0 );
+				SecureArenaVector<std::uint32_t> Word32Bit_Random( Word32Bit_ExpandedKey.size() / 4, 0, SecureArenaAllocator<std::uint32_t>( TransientKeyArena ) );
 
 				//处理采样Word数据
 				//Processing Sampled Word Data
@@ -104,26 +112,14 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					RandomWord = 0;
 				}
 
-				ByteKeys = CommonToolkit::IntegerExchangeBytes::MessageUnpacking<std::uint32_t, std::uint8_t>( Word32Bit_Random.data(), Word32Bit_Random.size() );
-
-				CheckPointer = memory_set_no_optimize_function<0x00>( Word32Bit_ExpandedKey.data(), Word32Bit_ExpandedKey.size() * sizeof( std::uint32_t ) );
-				CheckPointer = nullptr;
-				Word32Bit_ExpandedKey.resize( 0 );
-				CheckPointer = memory_set_no_optimize_function<0x00>( Word32Bit_Random.data(), Word32Bit_Random.size() * sizeof( std::uint32_t ) );
-				CheckPointer = nullptr;
-				Word32Bit_Random.resize( 0 );
-				CheckPointer = memory_set_no_optimize_function<0x00>( Word32Bit_Key.data(), Word32Bit_Key.size() * sizeof( std::uint32_t ) );
-				CheckPointer = nullptr;
-				Word32Bit_Key.resize( 0 );
+				SecureArenaVector<std::uint8_t> RandomByteKeys( Word32Bit_Random.size() * sizeof( std::uint32_t ), 0, SecureArenaAllocator<std::uint8_t>( TransientKeyArena ) );
+				MessageUnpacking<std::uint32_t, std::uint8_t>( Word32Bit_Random, RandomByteKeys.data() );
 
-				std::vector<std::uint64_t> Word64Bit_ProcessedKey = CommonToolkit::IntegerExchangeBytes::MessagePacking<std::uint64_t, std::uint8_t>( ByteKeys.data(), ByteKeys.size() );
+				SecureArenaVector<std::uint64_t> Word64Bit_ProcessedKey( RandomByteKeys.size() / sizeof( std::uint64_t ), 0, SecureArenaAllocator<std::uint64_t>( TransientKeyArena ) );
+				MessagePacking<std::uint64_t, std::uint8_t>( RandomByteKeys, Word64Bit_ProcessedKey.data() );
 
-				CheckPointer = memory_set_no_optimize_function<0x00>( ByteKeys.data(), ByteKeys.size() );
-				CheckPointer = nullptr;
-				ByteKeys.resize( 0 );
-
-				volatile bool												 Word64Bit_KeyUsed = false;
-				std::array<bool, std::numeric_limits<std::uint64_t>::digits> RandomBitsArray {};
+				volatile bool Word64Bit_KeyUsed = false;
+				std::uint64_t RandomBits = 0;
 				for ( std::size_t row = 0; row < (size_t)RandomQuadWordMatrix.rows(); ++row )
 				{
 					for ( std::size_t column = 0; column < (size_t)RandomQuadWordMatrix.cols(); ++column )
@@ -139,18 +135,22 @@ namespace TwilightDreamOfMagical::CustomSecurity
 							{
 								volatile std::uint64_t RandomNumber = 0;
 
-								for ( auto& RandomBit : RandomBitsArray )
+								//64 个随机比特直接收集到一个字里 (线性反馈移位寄存器每次调用都是按字跳跃推进的)
+								//Collect the 64 random bits straight into one word (each call of the linear feedback shift register advances by word-sized leaps)
+								RandomBits = 0;
+								for ( std::size_t BitIndex = 0; BitIndex < std::numeric_limits<std::uint64_t>::digits; ++BitIndex )
 								{
 									RandomNumber = static_cast<std::uint64_t>( BernoulliDistribution( LFSR_Object ) ) ^ LFSR_Object();
-									RandomBit = static_cast<bool>( RandomNumber & 1 );
+									RandomBits |= ( RandomNumber & 1 ) << BitIndex;
 								}
 
-								for ( std::size_t BitIndex = 0; BitIndex < std::numeric_limits<std::uint64_t>::digits; BitIndex++ )
+								//合并比特：置位的比特并入随机数；未置位的比特会连同下一位一起跳过
+								//Merge bits: a set bit is merged into the random number; a clear bit skips the following bit as well
+								for ( std::size_t BitIndex = 0; BitIndex < std::numeric_limits<std::uint64_t>::digits; )
 								{
-									if ( RandomBitsArray[ BitIndex ] )
-										RandomNumber |= ( static_cast<std::uint64_t>( RandomBitsArray[ BitIndex ] ) << BitIndex );
-									else
-										BitIndex++;
+									const std::uint64_t Bit = ( RandomBits >> BitIndex ) & 1;
+									RandomNumber |= Bit << BitIndex;
+									BitIndex += 2 - Bit;
 								}
 
 								RandomQuadWordMatrix( row, column ) += RandomNumber;
@@ -168,7 +168,7 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					}
 				}
 
-				CheckPointer = memory_set_no_optimize_function<0x00>( RandomBitsArray.data(), RandomBitsArray.size() );
+				CheckPointer = memory_set_no_optimize_function<0x00>( &RandomBits, sizeof( RandomBits ) );
 				CheckPointer = nullptr;
 
 				//Simplify the “Big / Heavy” OaldresPuzzle algorithm.
@@ -255,21 +255,10 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				LeftMatrix.setZero();
 				RightMatrix.setZero();
 
-				for ( auto Rows : RandomWordVector.rowwise() )
-				{
-					for ( auto& RoundSubkeyMatrixValue : Rows )
-					{
-						RoundSubkeyMatrixValue = SDP_Object( std::numeric_limits<std::uint64_t>::min(), std::numeric_limits<std::uint64_t>::max() );
-					}
-				}
-
-				for ( auto Columns : RandomWordVector2.colwise() )
-				{
-					for ( auto& RoundSubkeyMatrixValue : Columns )
-					{
-						RoundSubkeyMatrixValue = SDP_Object( std::numeric_limits<std::uint64_t>::min(), std::numeric_limits<std::uint64_t>::max() );
-					}
-				}
+				//两个向量都是连续存储的, 直接批量生成 (顺序与逐个调用 SDP_Object(min, max) 相同)
+				//Both vectors are stored contiguously, so generate them in bulk (same order as calling SDP_Object(min, max) one by one)
+				SDP_Object.generate( std::span<std::uint64_t>( RandomWordVector.data(), static_cast<std::size_t>( RandomWordVector.size() ) ) );
+				SDP_Object.generate( std::span<std::uint64_t>( RandomWordVector2.data(), static_cast<std::size_t>( RandomWordVector2.size() ) ) );
 
 				//Tensor product
 				//https://en.wikipedia.org/wiki/Tensor_product
@@ -283,12 +272,35 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				//https://zh.wikipedia.org/wiki/%E5%85%8B%E7%BD%97%E5%86%85%E5%85%8B%E7%A7%AF
 				//Kronecker product
 				//https://en.wikipedia.org/wiki/Kronecker_product
+				//Kronecker(RandomWordVector[1 x N], RandomWordVector2[N x 1]) 就是外积 RandomWordVector2 * RandomWordVector，它的秩为 1。
+				//所以 RandomQuadWordMatrix * (KroneckerProductMatrix * DotProduct) == (RandomQuadWordMatrix * RandomWordVector2) * (RandomWordVector * DotProduct)，只需要 O(N^2)。
+				//Kronecker(RandomWordVector[1 x N], RandomWordVector2[N x 1]) is the outer product RandomWordVector2 * RandomWordVector, which has rank 1.
+				//So RandomQuadWordMatrix * (KroneckerProductMatrix * DotProduct) == (RandomQuadWordMatrix * RandomWordVector2) * (RandomWordVector * DotProduct), which only needs O(N^2).
+				#if 1
+				std::uint64_t DotProduct = RandomWordVector2.dot( RandomWordVector );
+
+				Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1> MatrixVectorProduct = Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1>::Zero( RandomQuadWordMatrix.rows(), 1 );
+
+				WrappingIntegerMatrixMultiply::MultiplyMatrixByRankOne
+				(
+					RandomQuadWordMatrix.rows(), RandomWordVector.cols(), RandomQuadWordMatrix.cols(),
+					RandomQuadWordMatrix.data(), RandomQuadWordMatrix.rows(),
+					RandomWordVector2.data(),
+					RandomWordVector.data(),
+					DotProduct,
+					MatrixVectorProduct.data(),
+					TransformedSubkeyMatrix.data(), TransformedSubkeyMatrix.rows()
+				);
+
+				MatrixVectorProduct.setZero();
+				#else
 				Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic> KroneckerProductMatrix = Eigen::kroneckerProduct( RandomWordVector, RandomWordVector2 ).eval();
 				std::uint64_t												 DotProduct = RandomWordVector2.dot( RandomWordVector );
 
 				TransformedSubkeyMatrix = RandomQuadWordMatrix * ( KroneckerProductMatrix * DotProduct );
 
 				KroneckerProductMatrix.setZero();
+				#endif
 				DotProduct = 0;
 				RandomWordVector.setZero();
 				RandomWordVector2.setZero();
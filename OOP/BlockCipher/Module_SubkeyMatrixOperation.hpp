@@ -24,6 +24,7 @@
 #define ALGORITHM_OALDRESPUZZLECRYPTIC_MODULE_SUBKEYMATRIXOPERATION_HPP
 
 #include "Module_MixTransformationUtil.hpp"
+#include "WrappingIntegerMatrixMultiply.hpp"
 
 namespace TwilightDreamOfMagical::CustomSecurity
 {
@@ -7,6 +7,8 @@
 
 #include "../../BitRotation.hpp"
 #include "../../RandomNumberDistribution.hpp"
+#include "../SecureArena.hpp"
+#include "OPC_StageProfiler.hpp"
 #include "Includes/PRNGs.hpp"
 
 namespace TwilightDreamOfMagical::CustomSecurity
@@ -28,6 +30,10 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 		//Give the class type forward declaration
 		class OPC_MainAlgorithm_Worker;
+		class OaldresPuzzle_Cryptic;
+		//基准测试 (opc_bench) 用来单独计时内部阶段
+		//Used by the benchmark suite (opc_bench) to time internal stages on their own
+		class OPC_BenchmarkProbe;
 
 		namespace ImplementationDetails
 		{
@@ -51,6 +57,7 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				friend class Module_SecureRoundSubkeyGeneratation;
 
 				friend class TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_MainAlgorithm_Worker;
+				friend class TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OaldresPuzzle_Cryptic;
 
 				//自定义的随机数生成器
 				//Customized random number generator
@@ -86,12 +93,77 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				//Generated subkey (from the transformed key matrix)
 				Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic> TransformedSubkeyMatrix;
 
+				//按缓存行对齐的字节暂存区 (大端机器上给字节置换层做按小端序展开的副本)
+				//Cache-line aligned byte scratch region (holds the little-endian unpacked copy for the byte substitution layer on big-endian machines)
+				struct alignas(64) ScratchCacheLine
+				{
+					std::uint8_t Bytes[64];
+				};
+
+				//只在构造时分配一次，按 OPC_KeyBlockSize 计算大小，所以数据块和密钥块都放得下
+				//Allocated only once at construction and sized by OPC_KeyBlockSize, so both a data block and a key block fit
+				std::vector<ScratchCacheLine> ScratchCacheLines;
+
+				std::span<std::uint8_t> UseScratchBytes(std::size_t ByteCount)
+				{
+					my_cpp2020_assert(ByteCount <= ScratchCacheLines.size() * sizeof(ScratchCacheLine), "CommonStateData: The requested scratch bytes exceed the preallocated scratch region!", std::source_location::current());
+					return std::span<std::uint8_t>(ScratchCacheLines.front().Bytes, ByteCount);
+				}
+
+				//每条消息结束时擦除一次，而不是每个数据块擦除一次
+				//Wiped once at the end of each message instead of once per data block
+				void WipeScratchBytes()
+				{
+					volatile void* CheckPointer = memory_set_no_optimize_function<0x00>(this->ScratchCacheLines.data(), this->ScratchCacheLines.size() * sizeof(ScratchCacheLine));
+					CheckPointer = nullptr;
+				}
+
+				//生成子密钥时临时密钥材料用的安全内存区，每次 GenerationSubkeys 结束时整体擦除并重置
+				//Secure arena for the transient key material of subkey generation, wiped and reset as a whole at the end of every GenerationSubkeys
+				CommonToolkit::SecureArena TransientKeyArena;
+
+				//一次子密钥生成里所有临时向量的总大小 (字节): 格哈希的输出、状态初始化的 12 倍扩展密钥以及它前后的打包副本
+				//Total size (in bytes) of all transient vectors of one subkey generation: the lattice hash output, the 12x expanded key of state initialization and the packed copies around it
+				static std::size_t TransientKeyArenaByteSize(std::size_t OPC_QuadWord_KeyBlockSize)
+				{
+					return OPC_QuadWord_KeyBlockSize * sizeof(std::uint64_t) * 64;
+				}
+
+				//各阶段的性能计数器 (只有定义了 TDOM_OPC_STAGE_PROFILING 才会被更新)，不属于状态快照，Clone 出来的实例从 0 开始
+				//Per-stage performance counters (only updated when TDOM_OPC_STAGE_PROFILING is defined); not part of the state snapshot, and a cloned instance starts from 0
+				OPC_StageProfiler StageProfiler;
+
 				void ShuffleMatrixOffsetWithRandomIndices()
 				{
 					auto& NLFSR_Object = *(NLFSR_ClassicPointer);
 					CommonSecurity::ShuffleRangeData(MatrixOffsetWithRandomIndices.begin(), MatrixOffsetWithRandomIndices.end(), NLFSR_Object);
 				}
 
+				//只给 Clone 使用，复制生成器的状态而不是重新播种
+				//Only used by Clone, copies the generator states instead of reseeding
+				CommonStateData(const CommonStateData& Other)
+					:
+					LFSR_Pointer(std::make_unique<LinearFeedbackShiftRegister>(*Other.LFSR_ClassicPointer)),
+					NLFSR_Pointer(std::make_unique<NonlinearFeedbackShiftRegister>(*Other.NLFSR_ClassicPointer)),
+					SDP_Pointer(std::make_unique<SimulateDoublePendulum>(*Other.SDP_ClassicPointer)),
+					BernoulliDistributionObject(Other.BernoulliDistributionObject),
+					MatrixOffsetWithRandomIndices(Other.MatrixOffsetWithRandomIndices),
+					WordDataInitialVector(Other.WordDataInitialVector),
+					WordKeyDataVector(Other.WordKeyDataVector),
+					RandomQuadWordMatrix(Other.RandomQuadWordMatrix),
+					TransformedSubkeyMatrix(Other.TransformedSubkeyMatrix),
+					ScratchCacheLines(Other.ScratchCacheLines.size(), ScratchCacheLine {}),
+					TransientKeyArena(Other.TransientKeyArena.Capacity()),
+					OPC_QuadWord_DataBlockSize(Other.OPC_QuadWord_DataBlockSize), OPC_QuadWord_KeyBlockSize(Other.OPC_QuadWord_KeyBlockSize),
+					OPC_KeyMatrix_Rows(Other.OPC_KeyMatrix_Rows), OPC_KeyMatrix_Columns(Other.OPC_KeyMatrix_Columns)
+				{
+					this->LFSR_ClassicPointer = this->LFSR_Pointer.get();
+					this->NLFSR_ClassicPointer = this->NLFSR_Pointer.get();
+					this->SDP_ClassicPointer = this->SDP_Pointer.get();
+				}
+
+				CommonStateData& operator=(const CommonStateData&) = delete;
+
 			public:
 
 				const std::size_t OPC_QuadWord_DataBlockSize;
@@ -100,6 +172,19 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				const std::size_t OPC_KeyMatrix_Rows;
 				const std::size_t OPC_KeyMatrix_Columns;
 
+				//最常用的配置 (数据块 16 个 QuadWord，密钥块 32 个 QuadWord)，编译期固定大小的快速路径只为它实例化
+				//The most common configuration (16 QuadWords of data block, 32 QuadWords of key block); the compile-time sized fast path is instantiated only for it
+				static constexpr std::size_t FixedConfiguration_DataBlockSize = 16;
+				static constexpr std::size_t FixedConfiguration_KeyBlockSize = 32;
+				static constexpr std::size_t FixedConfiguration_KeyMatrixSize = FixedConfiguration_KeyBlockSize * 2;
+
+				//运行时的大小与固定配置相同时，各个模块分派到编译期固定大小的实现
+				//When the runtime sizes match the fixed configuration, every module dispatches to the compile-time sized implementation
+				bool IsFixedConfiguration() const
+				{
+					return OPC_QuadWord_DataBlockSize == FixedConfiguration_DataBlockSize && OPC_QuadWord_KeyBlockSize == FixedConfiguration_KeyBlockSize;
+				}
+
 				void LFSR_Seed(std::uint64_t LFSR_SeedNumber)
 				{
 					if(LFSR_SeedNumber == 0)
@@ -121,6 +206,81 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					this->SDP_ClassicPointer->seed(SDP_SeedNumber);
 				}
 
+				/*
+					状态快照: 三个伪随机数生成器、索引向量、初始向量、密钥向量和两个矩阵，按这个顺序平铺成一段字节
+					所有存储在构造时就分配好了，所以保存和恢复都只是 memcpy，不会重新播种也不会重新分配
+
+					State snapshot: the three pseudo-random number generators, the index vector, the initial vector, the key vector and both matrices, laid out flat in this order
+					All storage is allocated at construction, so saving and restoring are only memcpy, with no reseeding and no reallocation
+				*/
+				std::size_t SnapshotByteSize() const
+				{
+					return LinearFeedbackShiftRegister::state_byte_size
+						+ NonlinearFeedbackShiftRegister::state_byte_size
+						+ SimulateDoublePendulum::state_byte_size
+						+ MatrixOffsetWithRandomIndices.size() * sizeof(std::uint32_t)
+						+ WordDataInitialVector.size() * sizeof(std::uint32_t)
+						+ WordKeyDataVector.size() * sizeof(std::uint64_t)
+						+ static_cast<std::size_t>(RandomQuadWordMatrix.size() + TransformedSubkeyMatrix.size()) * sizeof(std::uint64_t);
+				}
+
+				void SaveSnapshot(std::span<std::uint8_t> SnapshotBytes) const
+				{
+					my_cpp2020_assert(SnapshotBytes.size() == this->SnapshotByteSize(), "CommonStateData: The snapshot size does not match this state!", std::source_location::current());
+
+					std::size_t ByteOffset = 0;
+					auto SaveRegion = [&SnapshotBytes, &ByteOffset](const void* RegionPointer, std::size_t RegionByteSize)
+					{
+						std::memcpy(SnapshotBytes.data() + ByteOffset, RegionPointer, RegionByteSize);
+						ByteOffset += RegionByteSize;
+					};
+
+					this->LFSR_ClassicPointer->save_state(SnapshotBytes.subspan(ByteOffset, LinearFeedbackShiftRegister::state_byte_size));
+					ByteOffset += LinearFeedbackShiftRegister::state_byte_size;
+					this->NLFSR_ClassicPointer->save_state(SnapshotBytes.subspan(ByteOffset, NonlinearFeedbackShiftRegister::state_byte_size));
+					ByteOffset += NonlinearFeedbackShiftRegister::state_byte_size;
+					this->SDP_ClassicPointer->save_state(SnapshotBytes.subspan(ByteOffset, SimulateDoublePendulum::state_byte_size));
+					ByteOffset += SimulateDoublePendulum::state_byte_size;
+
+					SaveRegion(MatrixOffsetWithRandomIndices.data(), MatrixOffsetWithRandomIndices.size() * sizeof(std::uint32_t));
+					SaveRegion(WordDataInitialVector.data(), WordDataInitialVector.size() * sizeof(std::uint32_t));
+					SaveRegion(WordKeyDataVector.data(), WordKeyDataVector.size() * sizeof(std::uint64_t));
+					SaveRegion(RandomQuadWordMatrix.data(), static_cast<std::size_t>(RandomQuadWordMatrix.size()) * sizeof(std::uint64_t));
+					SaveRegion(TransformedSubkeyMatrix.data(), static_cast<std::size_t>(TransformedSubkeyMatrix.size()) * sizeof(std::uint64_t));
+				}
+
+				void RestoreSnapshot(std::span<const std::uint8_t> SnapshotBytes)
+				{
+					my_cpp2020_assert(SnapshotBytes.size() == this->SnapshotByteSize(), "CommonStateData: The snapshot size does not match this state!", std::source_location::current());
+
+					std::size_t ByteOffset = 0;
+					auto RestoreRegion = [&SnapshotBytes, &ByteOffset](void* RegionPointer, std::size_t RegionByteSize)
+					{
+						std::memcpy(RegionPointer, SnapshotBytes.data() + ByteOffset, RegionByteSize);
+						ByteOffset += RegionByteSize;
+					};
+
+					this->LFSR_ClassicPointer->load_state(SnapshotBytes.subspan(ByteOffset, LinearFeedbackShiftRegister::state_byte_size));
+					ByteOffset += LinearFeedbackShiftRegister::state_byte_size;
+					this->NLFSR_ClassicPointer->load_state(SnapshotBytes.subspan(ByteOffset, NonlinearFeedbackShiftRegister::state_byte_size));
+					ByteOffset += NonlinearFeedbackShiftRegister::state_byte_size;
+					this->SDP_ClassicPointer->load_state(SnapshotBytes.subspan(ByteOffset, SimulateDoublePendulum::state_byte_size));
+					ByteOffset += SimulateDoublePendulum::state_byte_size;
+
+					RestoreRegion(MatrixOffsetWithRandomIndices.data(), MatrixOffsetWithRandomIndices.size() * sizeof(std::uint32_t));
+					RestoreRegion(WordDataInitialVector.data(), WordDataInitialVector.size() * sizeof(std::uint32_t));
+					RestoreRegion(WordKeyDataVector.data(), WordKeyDataVector.size() * sizeof(std::uint64_t));
+					RestoreRegion(RandomQuadWordMatrix.data(), static_cast<std::size_t>(RandomQuadWordMatrix.size()) * sizeof(std::uint64_t));
+					RestoreRegion(TransformedSubkeyMatrix.data(), static_cast<std::size_t>(TransformedSubkeyMatrix.size()) * sizeof(std::uint64_t));
+				}
+
+				//复制出一个状态完全相同的独立实例 (不重新播种)，给分发到工作线程使用
+				//Copy out an independent instance with exactly the same state (without reseeding), for fan-out to worker threads
+				std::unique_ptr<CommonStateData> Clone() const
+				{
+					return std::unique_ptr<CommonStateData>(new CommonStateData(*this));
+				}
+
 				CommonStateData
 				(
 					std::size_t OPC_QuadWord_DataBlockSize,
@@ -135,7 +295,8 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					OPC_KeyMatrix_Rows(OPC_QuadWord_KeyBlockSize * 2), OPC_KeyMatrix_Columns(OPC_QuadWord_KeyBlockSize * 2),
 					LFSR_Pointer(std::make_unique<LinearFeedbackShiftRegister>(LFSR_SeedNumber)),
 					NLFSR_Pointer(std::make_unique<NonlinearFeedbackShiftRegister>(NLFSR_SeedNumber)),
-					SDP_Pointer(std::make_unique<SimulateDoublePendulum>(SDP_SeedNumber))
+					SDP_Pointer(std::make_unique<SimulateDoublePendulum>(SDP_SeedNumber)),
+					TransientKeyArena(TransientKeyArenaByteSize(OPC_QuadWord_KeyBlockSize))
 				{
 					//OPC_DataBlockSize必须是16的倍数，而且必须不能小于2（128 Bit / 8 Bit(1 Byte) == 16 Byte = 16 Byte / 8 Byte(1 QuadWords) == 2 QuadWords）
 					my_cpp2020_assert
@@ -192,6 +353,8 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 					RandomQuadWordMatrix = Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic>::Zero(OPC_KeyMatrix_Rows, OPC_KeyMatrix_Columns);
 					TransformedSubkeyMatrix = Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic>::Zero(OPC_KeyMatrix_Rows, OPC_KeyMatrix_Columns);
+
+					ScratchCacheLines = std::vector<ScratchCacheLine>((OPC_QuadWord_KeyBlockSize * sizeof(std::uint64_t) + sizeof(ScratchCacheLine) - 1) / sizeof(ScratchCacheLine), ScratchCacheLine {});
 				}
 
 				~CommonStateData()
@@ -214,6 +377,8 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					my_cpp2020_assert(CheckPointer == this->WordKeyDataVector.data(), "Force Memory Fill Has Been \"Optimization\" !", std::source_location::current());
 					CheckPointer = nullptr;
 
+					this->WipeScratchBytes();
+
 					this->TransformedSubkeyMatrix.setZero();
 				}
 			};
@@ -0,0 +1,360 @@
+#include "OPC_KeySetupCache.hpp"
+#include "./Includes/SecureHashProvider/SHA2_512.hpp"
+
+namespace TwilightDreamOfMagical::CustomSecurity
+{
+	namespace SED::BlockCipher
+	{
+		/*
+			一个缓存条目: 准备完成之后的算法状态、同一时刻的密钥编排状态、主密钥和指纹
+			条目本身就构造在它自己的 SecureArena 里，所以这些字节 (包括密钥编排里的梅森旋转状态) 都不会被换出，也不会进入核心转储
+
+			One cache entry: the algorithm state after the setup, the key schedule state at the same moment, the master key and the fingerprint
+			The entry itself is constructed inside its own SecureArena, so none of these bytes (including the Mersenne Twister state of the key schedule) are swapped out or written to a core dump
+		*/
+		struct OPC_PreparedContext::CachedSetup
+		{
+			CommonToolkit::SecureArena& EntryArena;
+
+			//只用来复制出同样大小的 CommonStateData，不会直接用来加密；准备完成后它的状态被清零，每次使用前都从快照恢复
+			//Only used to copy out a CommonStateData of the same size, never used to encrypt directly; its state is zeroed after the setup and restored from the snapshot before every use
+			std::unique_ptr<ImplementationDetails::CommonStateData> StateDataPointer = nullptr;
+
+			std::span<std::uint8_t> FingerprintBytes;
+			std::span<std::uint8_t> KeyBytes;
+			std::span<std::uint8_t> SnapshotBytes;
+			OPC_MainAlgorithm_Worker::PreparedKeySchedule KeySchedule;
+
+			CachedSetup( CommonToolkit::SecureArena& EntryArena, std::size_t FingerprintByteSize, std::size_t KeyByteSize, std::size_t SnapshotByteSize )
+				:
+				EntryArena( EntryArena ),
+				FingerprintBytes( AllocateBytes( EntryArena, FingerprintByteSize ) ),
+				KeyBytes( AllocateBytes( EntryArena, KeyByteSize ) ),
+				SnapshotBytes( AllocateBytes( EntryArena, SnapshotByteSize ) ),
+				KeySchedule( EntryArena )
+			{
+
+			}
+
+			CachedSetup( const CachedSetup& ) = delete;
+			CachedSetup& operator=( const CachedSetup& ) = delete;
+
+			~CachedSetup()
+			{
+				volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( KeyBytes.data(), KeyBytes.size() );
+				CheckPointer = nullptr;
+				CheckPointer = memory_set_no_optimize_function<0x00>( SnapshotBytes.data(), SnapshotBytes.size() );
+				CheckPointer = nullptr;
+
+				EntryArena.Deallocate( SnapshotBytes.data(), SnapshotBytes.size() );
+				EntryArena.Deallocate( KeyBytes.data(), KeyBytes.size() );
+				EntryArena.Deallocate( FingerprintBytes.data(), FingerprintBytes.size() );
+			}
+
+			std::string_view FingerprintView() const
+			{
+				return std::string_view( reinterpret_cast<const char*>( FingerprintBytes.data() ), FingerprintBytes.size() );
+			}
+
+			static std::span<std::uint8_t> AllocateBytes( CommonToolkit::SecureArena& Arena, std::size_t ByteCount )
+			{
+				if ( ByteCount == 0 )
+					return {};
+
+				return std::span<std::uint8_t>( static_cast<std::uint8_t*>( Arena.Allocate( ByteCount, alignof( std::uint64_t ) ) ), ByteCount );
+			}
+		};
+
+		OPC_PreparedContext::OPC_PreparedContext( std::shared_ptr<const CachedSetup> SetupPointer )
+			:
+			SetupPointer( std::move( SetupPointer ) )
+		{
+			this->StateDataPointer = this->SetupPointer->StateDataPointer->Clone();
+			this->AlgorithmCorePointer = std::make_unique<OaldresPuzzle_Cryptic>( *( this->StateDataPointer ) );
+			this->WorkerPointer = std::make_unique<OPC_MainAlgorithm_Worker>( *( this->AlgorithmCorePointer ), false );
+		}
+
+		void OPC_PreparedContext::Rearm()
+		{
+			this->AlgorithmCorePointer->RestoreSnapshot( std::span<const std::uint8_t>( SetupPointer->SnapshotBytes ) );
+			this->WorkerPointer->NextPreparedKeySchedule = std::addressof( SetupPointer->KeySchedule );
+		}
+
+		std::vector<std::uint8_t> OPC_PreparedContext::EncrypterMain( const std::vector<std::uint8_t>& PlainText )
+		{
+			this->Rearm();
+			return this->WorkerPointer->EncrypterMain( PlainText, SetupPointer->KeyBytes );
+		}
+
+		std::vector<std::uint8_t> OPC_PreparedContext::DecrypterMain( const std::vector<std::uint8_t>& CipherText )
+		{
+			this->Rearm();
+			return this->WorkerPointer->DecrypterMain( CipherText, SetupPointer->KeyBytes );
+		}
+
+		std::vector<std::uint8_t> OPC_PreparedContext::EncrypterMainWithoutPadding( const std::vector<std::uint8_t>& PlainText )
+		{
+			this->Rearm();
+			return this->WorkerPointer->EncrypterMainWithoutPadding( PlainText, SetupPointer->KeyBytes );
+		}
+
+		std::vector<std::uint8_t> OPC_PreparedContext::DecrypterMainWithoutUnpadding( const std::vector<std::uint8_t>& CipherText )
+		{
+			this->Rearm();
+			return this->WorkerPointer->DecrypterMainWithoutUnpadding( CipherText, SetupPointer->KeyBytes );
+		}
+
+		void OPC_PreparedContext::EncrypterMainInPlace( std::span<std::uint8_t> Data )
+		{
+			this->Rearm();
+			this->WorkerPointer->EncrypterMainInPlace( Data, SetupPointer->KeyBytes );
+		}
+
+		void OPC_PreparedContext::DecrypterMainInPlace( std::span<std::uint8_t> Data )
+		{
+			this->Rearm();
+			this->WorkerPointer->DecrypterMainInPlace( Data, SetupPointer->KeyBytes );
+		}
+
+		OPC_KeySetupCache::OPC_KeySetupCache( std::size_t Capacity )
+			:
+			Capacity( Capacity ), FingerprintKeyArena( FingerprintBlockSize * 2 )
+		{
+			this->FingerprintPaddedKeys = std::span<std::uint8_t>( static_cast<std::uint8_t*>( FingerprintKeyArena.Allocate( FingerprintBlockSize * 2, alignof( std::uint64_t ) ) ), FingerprintBlockSize * 2 );
+
+			//密钥是 FingerprintByteSize 个随机字节，用 0 补齐到块大小，然后分别和内填充 (0x36) 与外填充 (0x5C) 异或
+			//The key is FingerprintByteSize random bytes, padded with 0 up to the block size and then XORed with the inner (0x36) and the outer (0x5C) padding
+			std::random_device HardwareRandomDevice;
+			for ( std::size_t index = 0; index < FingerprintBlockSize; ++index )
+			{
+				const std::uint8_t KeyByte = index < FingerprintByteSize ? static_cast<std::uint8_t>( HardwareRandomDevice() & 0xFF ) : 0x00;
+				FingerprintPaddedKeys[ index ] = KeyByte ^ 0x36;
+				FingerprintPaddedKeys[ FingerprintBlockSize + index ] = KeyByte ^ 0x5C;
+			}
+		}
+
+		OPC_KeySetupCache::~OPC_KeySetupCache()
+		{
+			this->Purge();
+
+			volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( FingerprintPaddedKeys.data(), FingerprintPaddedKeys.size() );
+			CheckPointer = nullptr;
+			FingerprintKeyArena.Deallocate( FingerprintPaddedKeys.data(), FingerprintPaddedKeys.size() );
+		}
+
+		void OPC_KeySetupCache::Fingerprint
+		(
+			std::size_t OPC_QuadWord_DataBlockSize,
+			std::size_t OPC_QuadWord_KeyBlockSize,
+			std::span<const std::uint8_t> InitialBytes_MemorySpan,
+			std::span<const std::uint8_t> Keys,
+			std::uint64_t LFSR_SeedNumber,
+			std::uint64_t NLFSR_SeedNumber,
+			std::uint64_t SDP_SeedNumber,
+			std::span<std::uint8_t, FingerprintByteSize> Digest
+		) const
+		{
+			using CommonSecurity::SHA::SHA2_512;
+			using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
+
+			//长度也放进指纹，所以 (初始向量, 主密钥) 的不同切分不会得到相同的消息
+			//The lengths are part of the fingerprint too, so different splits of (initial vector, master key) cannot give the same message
+			const std::array<std::uint64_t, 7> ParameterWords
+			{
+				OPC_QuadWord_DataBlockSize, OPC_QuadWord_KeyBlockSize, LFSR_SeedNumber, NLFSR_SeedNumber, SDP_SeedNumber,
+				InitialBytes_MemorySpan.size(), Keys.size()
+			};
+
+			const std::size_t ParameterByteSize = ParameterWords.size() * sizeof( std::uint64_t );
+
+			//HMAC: 内层散列 (内填充的密钥 || 参数 || 初始向量 || 主密钥)，外层散列 (外填充的密钥 || 内层摘要)
+			//HMAC: inner hash of (inner padded key || parameters || initial vector || master key), outer hash of (outer padded key || inner digest)
+			std::vector<std::uint8_t> InnerMessage( FingerprintBlockSize + ParameterByteSize + InitialBytes_MemorySpan.size() + Keys.size(), 0x00 );
+			std::array<std::uint8_t, FingerprintBlockSize + FingerprintByteSize> OuterMessage {};
+
+			std::ranges::copy( FingerprintPaddedKeys.first( FingerprintBlockSize ), InnerMessage.begin() );
+			MessageUnpacking<std::uint64_t, std::uint8_t>( ParameterWords, InnerMessage.data() + FingerprintBlockSize );
+			std::ranges::copy( InitialBytes_MemorySpan, InnerMessage.begin() + FingerprintBlockSize + ParameterByteSize );
+			std::ranges::copy( Keys, InnerMessage.begin() + FingerprintBlockSize + ParameterByteSize + InitialBytes_MemorySpan.size() );
+
+			std::ranges::copy( FingerprintPaddedKeys.subspan( FingerprintBlockSize ), OuterMessage.begin() );
+
+			SHA2_512 HashFunctionObject;
+			HashFunctionObject.Hash( InnerMessage, std::span<std::uint8_t>( OuterMessage ).subspan( FingerprintBlockSize ) );
+			HashFunctionObject.Hash( OuterMessage, Digest );
+
+			volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( InnerMessage.data(), InnerMessage.size() );
+			CheckPointer = nullptr;
+			CheckPointer = memory_set_no_optimize_function<0x00>( OuterMessage.data(), OuterMessage.size() );
+			CheckPointer = nullptr;
+		}
+
+		std::shared_ptr<const OPC_KeySetupCache::CachedSetup> OPC_KeySetupCache::BuildSetup
+		(
+			std::span<const std::uint8_t> EntryFingerprint,
+			std::size_t OPC_QuadWord_DataBlockSize,
+			std::size_t OPC_QuadWord_KeyBlockSize,
+			std::span<const std::uint8_t> InitialBytes_MemorySpan,
+			std::span<const std::uint8_t> Keys,
+			std::uint64_t LFSR_SeedNumber,
+			std::uint64_t NLFSR_SeedNumber,
+			std::uint64_t SDP_SeedNumber
+		)
+		{
+			using CommonToolkit::IntegerExchangeBytes::MessagePacking;
+			using CommonToolkit::SecureArena;
+			using ImplementationDetails::CommonStateData;
+
+			std::unique_ptr<CommonStateData> StateDataPointer = std::make_unique<CommonStateData>( OPC_QuadWord_DataBlockSize, OPC_QuadWord_KeyBlockSize, InitialBytes_MemorySpan, LFSR_SeedNumber, NLFSR_SeedNumber, SDP_SeedNumber );
+			std::shared_ptr<CachedSetup> SetupPointer = nullptr;
+
+			std::vector<std::uint64_t> Word64Bit_MasterKey( Keys.size() / sizeof( std::uint64_t ), 0 );
+			MessagePacking<std::uint64_t, std::uint8_t>( Keys, Word64Bit_MasterKey.data() );
+
+			{
+				OaldresPuzzle_Cryptic	 AlgorithmCore( *StateDataPointer );
+				OPC_MainAlgorithm_Worker Worker( AlgorithmCore, false );
+
+				//条目本身、指纹、主密钥、快照和密钥编排的随机密钥向量 (OPC_QuadWord_KeyBlockSize * 2 个 QuadWord)，每一块都留出对齐的余量
+				//The entry itself, the fingerprint, the master key, the snapshot and the random key vector of the key schedule (OPC_QuadWord_KeyBlockSize * 2 QuadWords), each with room for alignment
+				const std::size_t SnapshotByteSize = AlgorithmCore.SnapshotByteSize();
+				const std::size_t EntryArenaByteSize = sizeof( CachedSetup ) + EntryFingerprint.size() + Keys.size() + SnapshotByteSize + OPC_QuadWord_KeyBlockSize * 2 * sizeof( std::uint64_t ) + SecureArena::MaximumAlignment * 5;
+
+				std::unique_ptr<SecureArena> EntryArenaPointer = std::make_unique<SecureArena>( EntryArenaByteSize );
+				SecureArena& EntryArena = *EntryArenaPointer;
+
+				CachedSetup* EntryPointer = new ( EntryArena.Allocate( sizeof( CachedSetup ), alignof( CachedSetup ) ) ) CachedSetup( EntryArena, EntryFingerprint.size(), Keys.size(), SnapshotByteSize );
+
+				//先析构条目，再销毁它所在的安全内存区 (整块擦除并解除锁定)
+				//Destroy the entry first, then the secure arena it lives in (wiped as a whole and unlocked)
+				SetupPointer = std::shared_ptr<CachedSetup>
+				(
+					EntryPointer,
+					[ EntryArenaPointer = std::move( EntryArenaPointer ) ]( CachedSetup* Pointer )
+					{
+						Pointer->~CachedSetup();
+						EntryArenaPointer->Deallocate( Pointer, sizeof( CachedSetup ) );
+					}
+				);
+
+				std::ranges::copy( EntryFingerprint, SetupPointer->FingerprintBytes.begin() );
+				std::ranges::copy( Keys, SetupPointer->KeyBytes.begin() );
+
+				Worker.PrepareKeySchedule( Word64Bit_MasterKey, SetupPointer->KeySchedule );
+				AlgorithmCore.SaveSnapshot( SetupPointer->SnapshotBytes );
+			}
+
+			volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( Word64Bit_MasterKey.data(), Word64Bit_MasterKey.size() * sizeof( std::uint64_t ) );
+			CheckPointer = nullptr;
+
+			//状态已经在快照里了，留在堆上的这一份清零
+			//The state is in the snapshot now, so the copy left on the heap is zeroed
+			std::vector<std::uint8_t> ZeroStateBytes( StateDataPointer->SnapshotByteSize(), 0x00 );
+			StateDataPointer->RestoreSnapshot( ZeroStateBytes );
+			SetupPointer->StateDataPointer = std::move( StateDataPointer );
+
+			return SetupPointer;
+		}
+
+		std::unique_ptr<OPC_PreparedContext> OPC_KeySetupCache::Acquire
+		(
+			std::size_t OPC_QuadWord_DataBlockSize,
+			std::size_t OPC_QuadWord_KeyBlockSize,
+			std::span<const std::uint8_t> InitialBytes_MemorySpan,
+			std::span<const std::uint8_t> Keys,
+			std::uint64_t LFSR_SeedNumber,
+			std::uint64_t NLFSR_SeedNumber,
+			std::uint64_t SDP_SeedNumber
+		)
+		{
+			const std::size_t KeyBlockByteSize = OPC_QuadWord_KeyBlockSize * sizeof( std::uint64_t );
+
+			my_cpp2020_assert
+			(
+				KeyBlockByteSize != 0 && !Keys.empty() && ( Keys.size() % KeyBlockByteSize ) == 0,
+				"OPC_KeySetupCache: The size of Keys must be a non-zero multiple of (OPC_KeyBlockSize * sizeof(std::uint64_t)) byte!",
+				std::source_location::current()
+			);
+
+			if ( Capacity == 0 )
+			{
+				{
+					std::scoped_lock Lock( CacheMutex );
+					++MissCount;
+				}
+
+				return std::unique_ptr<OPC_PreparedContext>( new OPC_PreparedContext( BuildSetup( {}, OPC_QuadWord_DataBlockSize, OPC_QuadWord_KeyBlockSize, InitialBytes_MemorySpan, Keys, LFSR_SeedNumber, NLFSR_SeedNumber, SDP_SeedNumber ) ) );
+			}
+
+			std::array<std::uint8_t, FingerprintByteSize> EntryFingerprint {};
+			this->Fingerprint( OPC_QuadWord_DataBlockSize, OPC_QuadWord_KeyBlockSize, InitialBytes_MemorySpan, Keys, LFSR_SeedNumber, NLFSR_SeedNumber, SDP_SeedNumber, EntryFingerprint );
+			const std::string_view EntryFingerprintView( reinterpret_cast<const char*>( EntryFingerprint.data() ), EntryFingerprint.size() );
+
+			std::shared_ptr<const CachedSetup> SetupPointer = nullptr;
+
+			{
+				std::scoped_lock Lock( CacheMutex );
+
+				auto EntryIterator = EntryIndex.find( EntryFingerprintView );
+				if ( EntryIterator != EntryIndex.end() )
+				{
+					RecentlyUsedEntries.splice( RecentlyUsedEntries.begin(), RecentlyUsedEntries, EntryIterator->second );
+					SetupPointer = *( EntryIterator->second );
+					++HitCount;
+				}
+				else
+				{
+					++MissCount;
+				}
+			}
+
+			if ( SetupPointer == nullptr )
+			{
+				//在锁外面准备，其他线程的命中不会被这次准备阻塞；两个线程同时准备同一组参数时，只保留先放入的那一份
+				//The setup runs outside the lock so hits from other threads are not blocked by it; when two threads set up the same parameters at once, only the one inserted first is kept
+				std::shared_ptr<const CachedSetup> BuiltSetupPointer = BuildSetup( EntryFingerprint, OPC_QuadWord_DataBlockSize, OPC_QuadWord_KeyBlockSize, InitialBytes_MemorySpan, Keys, LFSR_SeedNumber, NLFSR_SeedNumber, SDP_SeedNumber );
+
+				std::scoped_lock Lock( CacheMutex );
+
+				auto EntryIterator = EntryIndex.find( EntryFingerprintView );
+				if ( EntryIterator != EntryIndex.end() )
+				{
+					SetupPointer = *( EntryIterator->second );
+				}
+				else
+				{
+					RecentlyUsedEntries.emplace_front( BuiltSetupPointer );
+					EntryIndex.emplace( BuiltSetupPointer->FingerprintView(), RecentlyUsedEntries.begin() );
+					SetupPointer = std::move( BuiltSetupPointer );
+
+					while ( RecentlyUsedEntries.size() > Capacity )
+					{
+						EntryIndex.erase( RecentlyUsedEntries.back()->FingerprintView() );
+						RecentlyUsedEntries.pop_back();
+						++EvictionCount;
+					}
+				}
+			}
+
+			volatile void* CheckPointer = memory_set_no_optimize_function<0x00>( EntryFingerprint.data(), EntryFingerprint.size() );
+			CheckPointer = nullptr;
+
+			return std::unique_ptr<OPC_PreparedContext>( new OPC_PreparedContext( std::move( SetupPointer ) ) );
+		}
+
+		void OPC_KeySetupCache::Purge()
+		{
+			std::scoped_lock Lock( CacheMutex );
+
+			EntryIndex.clear();
+			RecentlyUsedEntries.clear();
+		}
+
+		OPC_KeySetupCache::Statistics OPC_KeySetupCache::GetStatistics() const
+		{
+			std::scoped_lock Lock( CacheMutex );
+
+			return Statistics { HitCount, MissCount, EvictionCount, RecentlyUsedEntries.size(), Capacity };
+		}
+	}  // namespace SED::BlockCipher
+}  // namespace TwilightDreamOfMagical::CustomSecurity
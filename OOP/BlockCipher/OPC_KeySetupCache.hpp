@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * 本文件是 Algorithm_OaldresPuzzleCryptic 的一部分。
+ *
+ * Algorithm_OaldresPuzzleCryptic 是自由软件：你可以再分发之和/或依照由自由软件基金会发布的 GNU 通用公共许可证修改之，无论是版本 3 许可证，还是（按你的决定）任何以后版都可以。
+ *
+ * 发布 Algorithm_OaldresPuzzleCryptic 是希望它能有用，但是并无保障;甚至连可销售和符合某个特定的目的都不保证。请参看 GNU 通用公共许可证，了解详情。
+ * 你应该随程序获得一份 GNU 通用公共许可证的复本。如果没有，请看 <https://www.gnu.org/licenses/>。
+ */
+
+ /*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * This file is part of Algorithm_OaldresPuzzleCryptic.
+ *
+ * Algorithm_OaldresPuzzleCryptic is free software: you may redistribute it and/or modify it under the GNU General Public License as published by the Free Software Foundation, either under the Version 3 license, or (at your discretion) any later version.
+ *
+ * TDOM-EncryptOrDecryptFile-Reborn is released in the hope that it will be useful, but there are no guarantees; not even that it will be marketable and fit a particular purpose. Please see the GNU General Public License for details.
+ * You should get a copy of the GNU General Public License with your program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALGORITHM_OALDRESPUZZLECRYPTIC_OPC_KEYSETUPCACHE_HPP
+#define ALGORITHM_OALDRESPUZZLECRYPTIC_OPC_KEYSETUPCACHE_HPP
+
+#include "OPC_MainAlgorithm_Worker.hpp"
+
+#include <list>
+#include <string_view>
+#include <unordered_map>
+
+namespace TwilightDreamOfMagical::CustomSecurity
+{
+	//SymmetricEncryptionDecryption
+	namespace SED::BlockCipher
+	{
+		/*
+			密钥准备缓存
+			同一组 (主密钥, 初始向量, 三个种子, 数据块和密钥块大小) 下，每条消息开始时的准备工作都是一样的:
+			给 CommonStateData 的伪随机数生成器播种、打包初始向量，以及第一个数据块的子密钥生成。
+			这个缓存把准备完成之后的状态保存下来，之后同样的参数只需要复制这个状态，不需要重新计算。
+
+			缓存的键是上面这些参数的带密钥指纹 (HMAC-SHA2-512，密钥是每个缓存实例随机生成的)，所以指纹离开这个实例就没有意义。
+			缓存按最近最少使用的顺序淘汰，容量固定；所有公开函数都是线程安全的。
+			被淘汰或被清除的条目，在最后一个使用它的 OPC_PreparedContext 销毁时擦除。
+			每个条目 (主密钥、状态快照、密钥编排状态和指纹) 都构造在它自己的 SecureArena 里，锁定在物理内存中并排除在核心转储之外。
+
+			Key setup cache
+			Under the same (master key, initial vector, three seeds, data block and key block sizes), the setup at the start of every message is identical:
+			seeding the pseudo-random number generators of CommonStateData, packing the initial vector, and the subkey generation of the first data block.
+			This cache keeps the state after that setup, so later messages with the same parameters only copy this state instead of recomputing it.
+
+			The cache key is a keyed fingerprint of the parameters above (HMAC-SHA2-512, keyed with a random key generated per cache instance), so a fingerprint means nothing outside this instance.
+			Entries are evicted in least recently used order with a fixed capacity; every public function is thread safe.
+			An evicted or purged entry is wiped when the last OPC_PreparedContext using it is destroyed.
+			Every entry (master key, state snapshot, key schedule state and fingerprint) is constructed inside its own SecureArena, locked into physical memory and excluded from core dumps.
+		*/
+		class OPC_KeySetupCache;
+
+		//准备完成的加密上下文，每条消息开始前都会回到缓存的准备状态，所以可以重复使用；一个上下文只能同时被一个线程使用
+		//A prepared encryption context, it returns to the cached setup state before every message so it can be reused; one context may only be used by one thread at a time
+		class OPC_PreparedContext
+		{
+			friend class OPC_KeySetupCache;
+
+		public:
+			OPC_PreparedContext(const OPC_PreparedContext&) = delete;
+			OPC_PreparedContext& operator=(const OPC_PreparedContext&) = delete;
+
+			~OPC_PreparedContext() = default;
+
+			std::vector<std::uint8_t> EncrypterMain(const std::vector<std::uint8_t>& PlainText);
+			std::vector<std::uint8_t> DecrypterMain(const std::vector<std::uint8_t>& CipherText);
+			std::vector<std::uint8_t> EncrypterMainWithoutPadding(const std::vector<std::uint8_t>& PlainText);
+			std::vector<std::uint8_t> DecrypterMainWithoutUnpadding(const std::vector<std::uint8_t>& CipherText);
+			void EncrypterMainInPlace(std::span<std::uint8_t> Data);
+			void DecrypterMainInPlace(std::span<std::uint8_t> Data);
+
+		private:
+			struct CachedSetup;
+
+			std::shared_ptr<const CachedSetup> SetupPointer = nullptr;
+			std::unique_ptr<ImplementationDetails::CommonStateData> StateDataPointer = nullptr;
+			std::unique_ptr<OaldresPuzzle_Cryptic> AlgorithmCorePointer = nullptr;
+			std::unique_ptr<OPC_MainAlgorithm_Worker> WorkerPointer = nullptr;
+
+			explicit OPC_PreparedContext(std::shared_ptr<const CachedSetup> SetupPointer);
+
+			//回到缓存的准备状态，并让工作器跳过下一条消息的第一次密钥编排
+			//Return to the cached setup state and let the worker skip the first key schedule step of the next message
+			void Rearm();
+		};
+
+		class OPC_KeySetupCache
+		{
+		public:
+			struct Statistics
+			{
+				std::uint64_t Hits = 0;
+				std::uint64_t Misses = 0;
+				std::uint64_t Evictions = 0;
+				std::size_t EntryCount = 0;
+				std::size_t Capacity = 0;
+			};
+
+			//容量为 0 时不缓存，每次都完整地准备
+			//With a capacity of 0 nothing is cached and every call does the full setup
+			explicit OPC_KeySetupCache(std::size_t Capacity);
+
+			~OPC_KeySetupCache();
+
+			OPC_KeySetupCache(const OPC_KeySetupCache&) = delete;
+			OPC_KeySetupCache& operator=(const OPC_KeySetupCache&) = delete;
+
+			/*
+				取得这组参数的准备完成的上下文: 命中时只复制缓存的状态，未命中时完整地准备一次并放入缓存
+				Keys 的大小必须是 OPC_QuadWord_KeyBlockSize * 8 字节的整数倍，其余参数的要求和 CommonStateData 相同
+
+				Get a prepared context for these parameters: a hit only copies the cached state, a miss does the full setup once and puts it into the cache
+				The size of Keys must be a multiple of OPC_QuadWord_KeyBlockSize * 8 bytes, the other parameters have the same requirements as CommonStateData
+			*/
+			std::unique_ptr<OPC_PreparedContext> Acquire
+			(
+				std::size_t OPC_QuadWord_DataBlockSize,
+				std::size_t OPC_QuadWord_KeyBlockSize,
+				std::span<const std::uint8_t> InitialBytes_MemorySpan,
+				std::span<const std::uint8_t> Keys,
+				std::uint64_t LFSR_SeedNumber = 1,
+				std::uint64_t NLFSR_SeedNumber = 1,
+				std::uint64_t SDP_SeedNumber = 0xB7E151628AED2A6AULL
+			);
+
+			//清除所有条目 (统计数字保留)
+			//Remove all entries (the statistics are kept)
+			void Purge();
+
+			Statistics GetStatistics() const;
+
+		private:
+			using CachedSetup = OPC_PreparedContext::CachedSetup;
+
+			//指纹是 HMAC-SHA2-512 的原始摘要
+			//A fingerprint is the raw HMAC-SHA2-512 digest
+			static constexpr std::size_t FingerprintByteSize = 64;
+			static constexpr std::size_t FingerprintBlockSize = 128;
+
+			const std::size_t Capacity;
+
+			//放指纹密钥的安全内存区
+			//Secure arena holding the fingerprint key
+			CommonToolkit::SecureArena FingerprintKeyArena;
+
+			//计算指纹用的随机密钥，预先和内外填充异或好: 前 128 字节是内填充的密钥，后 128 字节是外填充的密钥
+			//Random key used to compute fingerprints, XORed with the inner and outer paddings in advance: the first 128 bytes are the inner padded key, the last 128 bytes the outer padded key
+			std::span<std::uint8_t> FingerprintPaddedKeys;
+
+			//最前面的是最近使用的条目；索引的键指向条目自己保存的指纹，不另外复制一份
+			//The most recently used entry is at the front; the keys of the index point at the fingerprint stored by the entry itself instead of a separate copy
+			std::list<std::shared_ptr<const CachedSetup>> RecentlyUsedEntries;
+			std::unordered_map<std::string_view, std::list<std::shared_ptr<const CachedSetup>>::iterator> EntryIndex;
+
+			std::uint64_t HitCount = 0;
+			std::uint64_t MissCount = 0;
+			std::uint64_t EvictionCount = 0;
+
+			mutable std::mutex CacheMutex;
+
+			void Fingerprint
+			(
+				std::size_t OPC_QuadWord_DataBlockSize,
+				std::size_t OPC_QuadWord_KeyBlockSize,
+				std::span<const std::uint8_t> InitialBytes_MemorySpan,
+				std::span<const std::uint8_t> Keys,
+				std::uint64_t LFSR_SeedNumber,
+				std::uint64_t NLFSR_SeedNumber,
+				std::uint64_t SDP_SeedNumber,
+				std::span<std::uint8_t, FingerprintByteSize> Digest
+			) const;
+
+			//EntryFingerprint 为空时 (容量为 0) 条目不保存指纹
+			//When EntryFingerprint is empty (a capacity of 0) the entry keeps no fingerprint
+			static std::shared_ptr<const CachedSetup> BuildSetup
+			(
+				std::span<const std::uint8_t> EntryFingerprint,
+				std::size_t OPC_QuadWord_DataBlockSize,
+				std::size_t OPC_QuadWord_KeyBlockSize,
+				std::span<const std::uint8_t> InitialBytes_MemorySpan,
+				std::span<const std::uint8_t> Keys,
+				std::uint64_t LFSR_SeedNumber,
+				std::uint64_t NLFSR_SeedNumber,
+				std::uint64_t SDP_SeedNumber
+			);
+		};
+	}  // namespace SED::BlockCipher
+}  // namespace TwilightDreamOfMagical::CustomSecurity
+
+#endif	//ALGORITHM_OALDRESPUZZLECRYPTIC_OPC_KEYSETUPCACHE_HPP
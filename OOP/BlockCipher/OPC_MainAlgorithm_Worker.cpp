@@ -5,389 +5,409 @@ namespace TwilightDreamOfMagical::CustomSecurity
 {
 	namespace SED::BlockCipher
 	{
-		void OPC_MainAlgorithm_Worker::SplitDataBlockToEncrypt(std::span<std::uint64_t> PlainText, std::span<const std::uint64_t> Keys)
+		void OPC_MainAlgorithm_Worker::BeginKeySchedule(std::span<const std::uint64_t> Keys)
 		{
-			using TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW;
-			auto& DataBlockSize = AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_DataBlockSize;
 			auto& KeyBlockSize = AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_KeyBlockSize;
+			auto& WordKeyDataVector = AlgorithmCorePointer->StateDataPointer->WordKeyDataVector;
 
-			/*
-				Tips 提示
-				对于二进制计算机来说，一个数字a是modulo b，这相当于用b减1然后和a做比特AND运算 (b 应该是2的幂)。
-				For a binary computer, a number a is modulo b, which is equivalent to subtracting 1 from b and then doing a bitwise AND operation with a (b should be a power of 2)
-			*/
-
-			if( ( PlainText.size() & (DataBlockSize - 1) ) != 0)
-				my_cpp2020_assert(false, "StateData_Worker: The size of PlainText is not a multiple of OPC_QuadWord_DataBlockSize!", std::source_location::current());
-			if( ( Keys.size() & (KeyBlockSize - 1) ) != 0)
-				my_cpp2020_assert(false, "StateData_Worker: The size of (Encryption)Keys is not a multiple of OPC_QuadWord_KeyBlockSize!", std::source_location::current());
-
-			volatile void* CheckPointer = nullptr;
+			if(this->NextPreparedKeySchedule != nullptr)
+			{
+				const PreparedKeySchedule& Prepared = *(this->NextPreparedKeySchedule);
+				this->NextPreparedKeySchedule = nullptr;
+
+				KeySchedule.MasterKeyWords = Keys;
+				KeySchedule.Word64Bit_Key_OffsetIndex = Prepared.Word64Bit_Key_OffsetIndex;
+				KeySchedule.RandomWordKeyDataVector.assign(Prepared.RandomWordKeyDataVector.begin(), Prepared.RandomWordKeyDataVector.end());
+				KeySchedule.ConditionControlFlag = Prepared.ConditionControlFlag;
+				KeySchedule.MersenneTwister64Bit = Prepared.MersenneTwister64Bit;
+				KeySchedule.FirstAdvancePrepared = true;
+				this->RoundSubkeysCounter = Prepared.RoundSubkeysCounter;
+
+				this->CancelRekeyPrecomputation();
+				return;
+			}
 
-			volatile std::size_t Word64Bit_Key_OffsetIndex = 0;
+			KeySchedule.MasterKeyWords = Keys;
+			KeySchedule.Word64Bit_Key_OffsetIndex = 0;
 
-			auto& WordKeyDataVector = AlgorithmCorePointer->StateDataPointer->WordKeyDataVector;
 			std::ranges::copy(Keys.begin(), Keys.begin() + WordKeyDataVector.size(), WordKeyDataVector.begin());
-			Word64Bit_Key_OffsetIndex += KeyBlockSize;
-
-			std::vector<std::uint64_t> RandomWordKeyDataVector(KeyBlockSize * 2, 0);
+			KeySchedule.Word64Bit_Key_OffsetIndex += KeyBlockSize;
 
-			volatile bool ConditionControlFlag = true;
+			KeySchedule.RandomWordKeyDataVector.assign(KeyBlockSize * 2, 0);
+			KeySchedule.ConditionControlFlag = true;
+			KeySchedule.MersenneTwister64Bit.seed();
 
-			//生成代表"盐渍"的伪随机数
-			//Generate a pseudo-random number representing "salted"
-			std::mt19937_64 MersenneTwister64Bit;
+			this->CancelRekeyPrecomputation();
+		}
 
-			const std::size_t PlainTextSize = PlainText.size();
-			for ( std::size_t DataBlockOffset = 0; DataBlockOffset < PlainTextSize; DataBlockOffset += DataBlockSize )
-			{
-				if(Word64Bit_Key_OffsetIndex < Keys.size())
-				{
-					std::span<const std::uint64_t> KeyByteSpan { Keys.begin() + Word64Bit_Key_OffsetIndex, Keys.begin() + Word64Bit_Key_OffsetIndex + KeyBlockSize };
-
-					//使用你的主密钥数据
-					//Use your master key data
-					std::ranges::transform
-						(
-							KeyByteSpan.begin(),
-							KeyByteSpan.end(),
-							WordKeyDataVector.begin(),
-							WordKeyDataVector.end(),
-							WordKeyDataVector.begin(),
-							[](const std::uint64_t& left, const std::uint64_t& right)
-							{
-								if(left == right)
-									return ~(left + right);
-								else
-									return left ^ right;
-							}
-						);
-
-					Word64Bit_Key_OffsetIndex += KeyBlockSize;
-
-					//主密钥未使用时，应该更新WordKeyDataVector
-					//The WordKeyDataVector should be updated when the master key is not used
-					this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys(WordKeyDataVector);
+		void OPC_MainAlgorithm_Worker::AdvanceKeySchedule()
+		{
+			using TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW;
+			auto& KeyBlockSize = AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_KeyBlockSize;
+			auto& WordKeyDataVector = AlgorithmCorePointer->StateDataPointer->WordKeyDataVector;
 
-					++(this->RoundSubkeysCounter);
-				}
-				else
-				{
-					using CommonSecurity::KeyDerivationFunction::Scrypt;
-					using CommonToolkit::IntegerExchangeBytes::MessagePacking;
-					using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
+			volatile void* CheckPointer = nullptr;
 
-					//主密钥使用完毕之后，无需更新WordKeyDataVector，直接使用这个函数
-					//After the used of the master key, no need to update the WordKeyDataVector, directly using this function
+			if(KeySchedule.FirstAdvancePrepared)
+			{
+				KeySchedule.FirstAdvancePrepared = false;
+				return;
+			}
 
-					if( ConditionControlFlag || ((this->RoundSubkeysCounter % (2048ULL * 4ULL)) == 0) )
-					{
-						for(std::size_t KeyRound = 0; KeyRound < 16; ++KeyRound)
+			if(KeySchedule.Word64Bit_Key_OffsetIndex < KeySchedule.MasterKeyWords.size())
+			{
+				std::span<const std::uint64_t> KeyByteSpan = KeySchedule.MasterKeyWords.subspan( KeySchedule.Word64Bit_Key_OffsetIndex, KeyBlockSize );
+
+				//使用你的主密钥数据
+				//Use your master key data
+				std::ranges::transform
+					(
+						KeyByteSpan.begin(),
+						KeyByteSpan.end(),
+						WordKeyDataVector.begin(),
+						WordKeyDataVector.end(),
+						WordKeyDataVector.begin(),
+						[](const std::uint64_t& left, const std::uint64_t& right)
 						{
-							//Bit-level data diffusion algorithm
-							for (size_t i = 0; i < WordKeyDataVector.size(); i++)
-							{
-								std::uint64_t a = WordKeyDataVector[i] >> 32;
-								std::uint64_t b = WordKeyDataVector[i] & 0xFFFFFFFF;
-
-								//Apply bitwise operations to diffuse bits
-								a ^= b;
-								a = ~a;
-								b ^= a;
-								b = std::rotl(b, 19);
-								a ^= b;
-								a = std::rotl(a, 13);
-								b ^= a;
-								b = ~b;
-								a ^= b;
-								a = std::rotl(a, 27);
-								b ^= a;
-								b = std::rotl(b, 23);
-
-								WordKeyDataVector[i] = (a << 32) | b;
-							}
-
-							std::vector<std::uint8_t> KeyBytes(KeyBlockSize * sizeof(std::uint64_t), 0);
-
-							//Call Byte-level data confusion algorithm
-							MessageUnpacking<std::uint64_t, std::uint8_t>( WordKeyDataVector, KeyBytes.data() );
-							this->AlgorithmCorePointer->ByteSubstitution(KeyBytes, CryptionMode2MCAC4_FDW::MCA_ENCRYPTER);
-							MessagePacking<std::uint64_t, std::uint8_t>( KeyBytes, WordKeyDataVector.data() );
+							if(left == right)
+								return ~(left + right);
+							else
+								return left ^ right;
 						}
+					);
 
-						this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys(WordKeyDataVector);
-						ConditionControlFlag = false;
+				KeySchedule.Word64Bit_Key_OffsetIndex += KeyBlockSize;
 
-						++(this->RoundSubkeysCounter);
-					}
+				//主密钥未使用时，应该更新WordKeyDataVector
+				//The WordKeyDataVector should be updated when the master key is not used
+				this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys(WordKeyDataVector);
 
-					if((this->RoundSubkeysCounter % 2048ULL) == 0)
+				++(this->RoundSubkeysCounter);
+			}
+			else
+			{
+				using CommonToolkit::IntegerExchangeBytes::MessagePacking;
+
+				//主密钥使用完毕之后，无需更新WordKeyDataVector，直接使用这个函数
+				//After the used of the master key, no need to update the WordKeyDataVector, directly using this function
+
+				if( KeySchedule.ConditionControlFlag || ((this->RoundSubkeysCounter % (2048ULL * 4ULL)) == 0) )
+				{
+					for(std::size_t KeyRound = 0; KeyRound < 16; ++KeyRound)
 					{
-						std::array<std::uint64_t, 16> SaltWordData {};
-						std::ranges::generate_n( SaltWordData.begin(), SaltWordData.size(), MersenneTwister64Bit );
+						//每一轮比特扩散和字节混淆算一次调用，后面的 GenerationSubkeys 单独统计
+						//Every round of bit diffusion and byte confusion counts as one call, the GenerationSubkeys after it is profiled on its own
+						TDOM_OPC_PROFILE_STAGE(AlgorithmCorePointer->StateDataPointer->StageProfiler, KeyWhitening, WordKeyDataVector.size() * sizeof(std::uint64_t));
 
-						if((this->RoundSubkeysCounter % (2048ULL * 3ULL)) == 0)
+						//Bit-level data diffusion algorithm
+						for (size_t i = 0; i < WordKeyDataVector.size(); i++)
 						{
-							std::array<std::uint8_t, 16 * sizeof( std::uint64_t )> SaltData {};
-							MessageUnpacking<std::uint64_t, std::uint8_t>( SaltWordData, SaltData.data() );
-
-							std::vector<std::uint8_t> MaterialKeys = MessageUnpacking<std::uint64_t, std::uint8_t>( RandomWordKeyDataVector.data(), RandomWordKeyDataVector.size() );
-							Scrypt					  KDF_Object;
-							std::vector<std::uint8_t> GeneratedSecureKeys = KDF_Object.GenerateKeys( MaterialKeys, SaltData, RandomWordKeyDataVector.size() * sizeof( std::uint64_t ), 1024, 8, 16 );
-							MessagePacking<std::uint64_t, std::uint8_t>( GeneratedSecureKeys, RandomWordKeyDataVector.data() );
-
-							//使用通过密钥派生函数的生成的数据，而不使用主密钥数据
-							//Use the data generated by the key derivation function without using the master key data
-							this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys( RandomWordKeyDataVector );
-
-							CheckPointer = memory_set_no_optimize_function<0x00>( SaltWordData.data(), SaltWordData.size() * sizeof( std::uint64_t ) );
-							CheckPointer = nullptr;
-							CheckPointer = memory_set_no_optimize_function<0x00>( SaltData.data(), SaltData.size() );
-							CheckPointer = nullptr;
-							CheckPointer = memory_set_no_optimize_function<0x00>( MaterialKeys.data(), MaterialKeys.size() );
-							CheckPointer = nullptr;
-							CheckPointer = memory_set_no_optimize_function<0x00>( GeneratedSecureKeys.data(), GeneratedSecureKeys.size() );
-							CheckPointer = nullptr;
-							GeneratedSecureKeys.clear();
-							GeneratedSecureKeys.shrink_to_fit();
-						}
-						else if((this->RoundSubkeysCounter % (2048ULL * 2ULL)) == 0)
-						{
-							std::array<std::uint8_t, 16 * sizeof( std::uint64_t )> SaltData {};
-							MessageUnpacking<std::uint64_t, std::uint8_t>( SaltWordData, SaltData.data() );
-
-							std::vector<std::uint8_t> MaterialKeys = MessageUnpacking<std::uint64_t, std::uint8_t>( RandomWordKeyDataVector.data(), RandomWordKeyDataVector.size() );
-							Scrypt					  KDF_Object;
-							std::vector<std::uint8_t> GeneratedSecureKeys = KDF_Object.GenerateKeys( MaterialKeys, SaltData, RandomWordKeyDataVector.size() * sizeof( std::uint64_t ), 1024, 8, 16 );
-							MessagePacking<std::uint64_t, std::uint8_t>( GeneratedSecureKeys, RandomWordKeyDataVector.data() );
-
-							//使用通过密钥派生函数的生成的数据，而不使用主密钥数据
-							//Use the data generated by the key derivation function without using the master key data
-							this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys( RandomWordKeyDataVector );
-							std::seed_seq Seeds = std::seed_seq( RandomWordKeyDataVector.begin(), RandomWordKeyDataVector.end() );
-							MersenneTwister64Bit.seed( Seeds );
-
-							CheckPointer = memory_set_no_optimize_function<0x00>( SaltWordData.data(), SaltWordData.size() * sizeof( std::uint64_t ) );
-							CheckPointer = nullptr;
-							CheckPointer = memory_set_no_optimize_function<0x00>( SaltData.data(), SaltData.size() );
-							CheckPointer = nullptr;
-							CheckPointer = memory_set_no_optimize_function<0x00>( MaterialKeys.data(), MaterialKeys.size() );
-							CheckPointer = nullptr;
-							CheckPointer = memory_set_no_optimize_function<0x00>( GeneratedSecureKeys.data(), GeneratedSecureKeys.size() );
-							CheckPointer = nullptr;
-							GeneratedSecureKeys.clear();
-							GeneratedSecureKeys.shrink_to_fit();
+							std::uint64_t a = WordKeyDataVector[i] >> 32;
+							std::uint64_t b = WordKeyDataVector[i] & 0xFFFFFFFF;
+
+							//Apply bitwise operations to diffuse bits
+							a ^= b;
+							a = ~a;
+							b ^= a;
+							b = std::rotl(b, 19);
+							a ^= b;
+							a = std::rotl(a, 13);
+							b ^= a;
+							b = ~b;
+							a ^= b;
+							a = std::rotl(a, 27);
+							b ^= a;
+							b = std::rotl(b, 23);
+
+							WordKeyDataVector[i] = (a << 32) | b;
 						}
 
-						const std::vector<std::uint64_t> EmptyData {};
-						this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys( EmptyData );
+						//Call Byte-level data confusion algorithm
+						this->AlgorithmCorePointer->QuadWordByteSubstitution(WordKeyDataVector, CryptionMode2MCAC4_FDW::MCA_ENCRYPTER);
 					}
 
+					this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys(WordKeyDataVector);
+					KeySchedule.ConditionControlFlag = false;
+
 					++(this->RoundSubkeysCounter);
 				}
 
-				std::span<std::uint64_t> DataByteSpan { PlainText.begin() + DataBlockOffset, PlainText.begin() + DataBlockOffset + DataBlockSize };
+				if((this->RoundSubkeysCounter % 2048ULL) == 0)
+				{
+					std::array<std::uint64_t, 16> SaltWordData {};
+					std::ranges::generate_n( SaltWordData.begin(), SaltWordData.size(), KeySchedule.MersenneTwister64Bit );
 
-				this->AlgorithmCorePointer->RoundFunction(DataByteSpan, CryptionMode2MCAC4_FDW::MCA_ENCRYPTER);
+					if((this->RoundSubkeysCounter % (2048ULL * 3ULL)) == 0)
+					{
+						std::vector<std::uint8_t> GeneratedSecureKeys = this->TakeRekeyMaterial( SaltWordData );
+						MessagePacking<std::uint64_t, std::uint8_t>( GeneratedSecureKeys, KeySchedule.RandomWordKeyDataVector.data() );
+
+						//使用通过密钥派生函数的生成的数据，而不使用主密钥数据
+						//Use the data generated by the key derivation function without using the master key data
+						this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys( KeySchedule.RandomWordKeyDataVector );
+
+						CheckPointer = memory_set_no_optimize_function<0x00>( SaltWordData.data(), SaltWordData.size() * sizeof( std::uint64_t ) );
+						CheckPointer = nullptr;
+						CheckPointer = memory_set_no_optimize_function<0x00>( GeneratedSecureKeys.data(), GeneratedSecureKeys.size() );
+						CheckPointer = nullptr;
+						GeneratedSecureKeys.clear();
+						GeneratedSecureKeys.shrink_to_fit();
+					}
+					else if((this->RoundSubkeysCounter % (2048ULL * 2ULL)) == 0)
+					{
+						std::vector<std::uint8_t> GeneratedSecureKeys = this->TakeRekeyMaterial( SaltWordData );
+						MessagePacking<std::uint64_t, std::uint8_t>( GeneratedSecureKeys, KeySchedule.RandomWordKeyDataVector.data() );
+
+						//使用通过密钥派生函数的生成的数据，而不使用主密钥数据
+						//Use the data generated by the key derivation function without using the master key data
+						this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys( KeySchedule.RandomWordKeyDataVector );
+						std::seed_seq Seeds = std::seed_seq( KeySchedule.RandomWordKeyDataVector.begin(), KeySchedule.RandomWordKeyDataVector.end() );
+						KeySchedule.MersenneTwister64Bit.seed( Seeds );
+
+						CheckPointer = memory_set_no_optimize_function<0x00>( SaltWordData.data(), SaltWordData.size() * sizeof( std::uint64_t ) );
+						CheckPointer = nullptr;
+						CheckPointer = memory_set_no_optimize_function<0x00>( GeneratedSecureKeys.data(), GeneratedSecureKeys.size() );
+						CheckPointer = nullptr;
+						GeneratedSecureKeys.clear();
+						GeneratedSecureKeys.shrink_to_fit();
+					}
+
+					const std::vector<std::uint64_t> EmptyData {};
+					this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys( EmptyData );
+
+					this->StartRekeyPrecomputation();
+				}
+
+				++(this->RoundSubkeysCounter);
 			}
+		}
+
+		void OPC_MainAlgorithm_Worker::EndKeySchedule()
+		{
+			volatile void* CheckPointer = nullptr;
+
+			this->CancelRekeyPrecomputation();
+
+			KeySchedule.FirstAdvancePrepared = false;
 
 			this->RoundSubkeysCounter = 0;
-			CheckPointer = memory_set_no_optimize_function<0x00>(RandomWordKeyDataVector.data(), RandomWordKeyDataVector.size() * sizeof(std::uint64_t));
+			CheckPointer = memory_set_no_optimize_function<0x00>(KeySchedule.RandomWordKeyDataVector.data(), KeySchedule.RandomWordKeyDataVector.size() * sizeof(std::uint64_t));
 			CheckPointer = nullptr;
+			KeySchedule.MasterKeyWords = {};
+
+			this->AlgorithmCorePointer->StateDataPointer->WipeScratchBytes();
 		}
 
-		void OPC_MainAlgorithm_Worker::SplitDataBlockToDecrypt( std::span<std::uint64_t> CipherText, std::span<const std::uint64_t> Keys )
+		void OPC_MainAlgorithm_Worker::PrepareKeySchedule(std::span<const std::uint64_t> Keys, PreparedKeySchedule& Prepared)
 		{
-			using TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW;
-			auto& DataBlockSize = AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_DataBlockSize;
 			auto& KeyBlockSize = AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_KeyBlockSize;
 
-			/*
-				Tips 提示
-				对于二进制计算机来说，一个数字a是modulo b，这相当于用b减1然后和a做比特AND运算 (b 应该是2的幂)。
-				For a binary computer, a number a is modulo b, which is equivalent to subtracting 1 from b and then doing a bitwise AND operation with a (b should be a power of 2)
-			*/
+			my_cpp2020_assert(!Keys.empty() && ( Keys.size() & (KeyBlockSize - 1) ) == 0, "StateData_Worker: The size of Keys is not a multiple of OPC_QuadWord_KeyBlockSize!", std::source_location::current());
 
-			if( ( CipherText.size() & (DataBlockSize - 1) ) != 0)
-				my_cpp2020_assert(false, "StateData_Worker: The size of CipherText is not a multiple of OPC_QuadWord_DataBlockSize!", std::source_location::current());
-			if( ( Keys.size() & (KeyBlockSize - 1) ) != 0)
-				my_cpp2020_assert(false, "StateData_Worker: The size of (Decryption)Keys is not a multiple of OPC_QuadWord_KeyBlockSize!", std::source_location::current());
+			this->BeginKeySchedule(Keys);
+			this->AdvanceKeySchedule();
+
+			Prepared.Word64Bit_Key_OffsetIndex = KeySchedule.Word64Bit_Key_OffsetIndex;
+			Prepared.RandomWordKeyDataVector.assign(KeySchedule.RandomWordKeyDataVector.begin(), KeySchedule.RandomWordKeyDataVector.end());
+			Prepared.ConditionControlFlag = KeySchedule.ConditionControlFlag;
+			Prepared.MersenneTwister64Bit = KeySchedule.MersenneTwister64Bit;
+			Prepared.RoundSubkeysCounter = this->RoundSubkeysCounter;
+
+			this->EndKeySchedule();
+		}
+
+		std::vector<std::uint8_t> OPC_MainAlgorithm_Worker::DeriveRekeyMaterial(std::span<const std::uint64_t> MaterialWords, std::span<const std::uint64_t> SaltWordData)
+		{
+			using CommonSecurity::KeyDerivationFunction::Scrypt;
+			using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
 
 			volatile void* CheckPointer = nullptr;
 
-			volatile std::size_t Word64Bit_Key_OffsetIndex = 0;
+			std::vector<std::uint8_t> SaltData = MessageUnpacking<std::uint64_t, std::uint8_t>( SaltWordData.data(), SaltWordData.size() );
+			std::vector<std::uint8_t> MaterialKeys = MessageUnpacking<std::uint64_t, std::uint8_t>( MaterialWords.data(), MaterialWords.size() );
+			Scrypt					  KDF_Object;
+			std::vector<std::uint8_t> GeneratedSecureKeys = KDF_Object.GenerateKeys( MaterialKeys, SaltData, MaterialWords.size() * sizeof( std::uint64_t ), 1024, 8, 16 );
 
-			auto& WordKeyDataVector = AlgorithmCorePointer->StateDataPointer->WordKeyDataVector;
-			std::ranges::copy(Keys.begin(), Keys.begin() + WordKeyDataVector.size(), WordKeyDataVector.begin());
-			Word64Bit_Key_OffsetIndex += KeyBlockSize;
+			CheckPointer = memory_set_no_optimize_function<0x00>( SaltData.data(), SaltData.size() );
+			CheckPointer = nullptr;
+			CheckPointer = memory_set_no_optimize_function<0x00>( MaterialKeys.data(), MaterialKeys.size() );
+			CheckPointer = nullptr;
 
-			std::vector<std::uint64_t> RandomWordKeyDataVector(KeyBlockSize * 2, 0);
+			return GeneratedSecureKeys;
+		}
 
-			volatile bool ConditionControlFlag = true;
+		std::vector<std::uint8_t> OPC_MainAlgorithm_Worker::TakeRekeyMaterial(std::span<const std::uint64_t> SaltWordData)
+		{
+			TDOM_OPC_PROFILE_STAGE(AlgorithmCorePointer->StateDataPointer->StageProfiler, ScryptRekey, KeySchedule.RandomWordKeyDataVector.size() * sizeof(std::uint64_t));
 
-			//生成代表"盐渍"的伪随机数
-			//Generate a pseudo-random number representing "salted"
-			std::mt19937_64 MersenneTwister64Bit;
+			auto& Precomputation = this->RekeyPrecomputation;
 
-			const std::size_t CipherTextSize = CipherText.size();
-			for ( std::size_t DataBlockOffset = 0; DataBlockOffset < CipherTextSize; DataBlockOffset += DataBlockSize )
+			if
+			(
+				Precomputation.Pending
+				&& Precomputation.RoundSubkeysCounter == this->RoundSubkeysCounter
+				&& std::ranges::equal( Precomputation.SaltWordData, SaltWordData )
+				&& std::ranges::equal( Precomputation.MaterialWords, KeySchedule.RandomWordKeyDataVector )
+			)
 			{
-				if(Word64Bit_Key_OffsetIndex < Keys.size())
-				{
-					std::span<const std::uint64_t> KeyByteSpan { Keys.begin() + Word64Bit_Key_OffsetIndex, Keys.begin() + Word64Bit_Key_OffsetIndex + KeyBlockSize };
-
-					//使用你的主密钥数据
-					//Use your master key data
-					std::ranges::transform
-						(
-							KeyByteSpan.begin(),
-							KeyByteSpan.end(),
-							WordKeyDataVector.begin(),
-							WordKeyDataVector.end(),
-							WordKeyDataVector.begin(),
-							[](const std::uint64_t& left, const std::uint64_t& right)
-							{
-								if(left == right)
-									return ~(left + right);
-								else
-									return left ^ right;
-							}
-						);
-
-					Word64Bit_Key_OffsetIndex += KeyBlockSize;
-
-					//主密钥未使用时，应该更新WordKeyDataVector
-					//The WordKeyDataVector should be updated when the master key is not used
-					this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys(WordKeyDataVector);
+				RekeyThreadPoolPointer->Wait( Precomputation.Group );
+				Precomputation.Pending = false;
 
-					++(this->RoundSubkeysCounter);
-				}
-				else
+				if( Precomputation.Exception != nullptr )
 				{
-					using CommonSecurity::KeyDerivationFunction::Scrypt;
-					using CommonToolkit::IntegerExchangeBytes::MessagePacking;
-					using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
+					std::exception_ptr TaskException = std::exchange( Precomputation.Exception, nullptr );
+					this->CancelRekeyPrecomputation();
+					std::rethrow_exception( TaskException );
+				}
 
-					//主密钥使用完毕之后，无需更新WordKeyDataVector，直接使用这个函数
-					//After the used of the master key, no need to update the WordKeyDataVector, directly using this function
+				std::vector<std::uint8_t> GeneratedSecureKeys = std::move( Precomputation.GeneratedSecureKeys );
+				Precomputation.GeneratedSecureKeys = {};
+				this->CancelRekeyPrecomputation();
+				return GeneratedSecureKeys;
+			}
 
-					if( ConditionControlFlag || ((this->RoundSubkeysCounter % (2048ULL * 4ULL)) == 0) )
-					{
-						for(std::size_t KeyRound = 0; KeyRound < 16; ++KeyRound)
-						{
-							//Bit-level data diffusion algorithm
-							for (size_t i = 0; i < WordKeyDataVector.size(); i++)
-							{
-								std::uint64_t a = WordKeyDataVector[i] >> 32;
-								std::uint64_t b = WordKeyDataVector[i] & 0xFFFFFFFF;
-
-								//Apply bitwise operations to diffuse bits
-								a ^= b;
-								a = ~a;
-								b ^= a;
-								b = std::rotl(b, 19);
-								a ^= b;
-								a = std::rotl(a, 13);
-								b ^= a;
-								b = ~b;
-								a ^= b;
-								a = std::rotl(a, 27);
-								b ^= a;
-								b = std::rotl(b, 23);
-
-								WordKeyDataVector[i] = (a << 32) | b;
-							}
-
-							std::vector<std::uint8_t> KeyBytes(KeyBlockSize * sizeof(std::uint64_t), 0);
-
-							//Call Byte-level data confusion algorithm
-							MessageUnpacking<std::uint64_t, std::uint8_t>( WordKeyDataVector, KeyBytes.data() );
-							this->AlgorithmCorePointer->ByteSubstitution(KeyBytes, CryptionMode2MCAC4_FDW::MCA_ENCRYPTER);
-							MessagePacking<std::uint64_t, std::uint8_t>( KeyBytes, WordKeyDataVector.data() );
-						}
+			this->CancelRekeyPrecomputation();
+			return DeriveRekeyMaterial( KeySchedule.RandomWordKeyDataVector, SaltWordData );
+		}
 
-						this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys(WordKeyDataVector);
-						ConditionControlFlag = false;
+		void OPC_MainAlgorithm_Worker::StartRekeyPrecomputation()
+		{
+			auto& Precomputation = this->RekeyPrecomputation;
 
-						++(this->RoundSubkeysCounter);
-					}
+			this->CancelRekeyPrecomputation();
 
-					if((this->RoundSubkeysCounter % 2048ULL) == 0)
-					{
-						std::array<std::uint64_t, 16> SaltWordData {};
-						std::ranges::generate_n( SaltWordData.begin(), SaltWordData.size(), MersenneTwister64Bit );
+			if( RekeyThreadPoolPointer == nullptr || RekeyThreadPoolPointer->WorkerThreadCount() == 0 )
+				return;
 
-						if((this->RoundSubkeysCounter % (2048ULL * 3ULL)) == 0)
-						{
-							std::array<std::uint8_t, 16 * sizeof( std::uint64_t )> SaltData {};
-							MessageUnpacking<std::uint64_t, std::uint8_t>( SaltWordData, SaltData.data() );
-
-							std::vector<std::uint8_t> MaterialKeys = MessageUnpacking<std::uint64_t, std::uint8_t>( RandomWordKeyDataVector.data(), RandomWordKeyDataVector.size() );
-							Scrypt					  KDF_Object;
-							std::vector<std::uint8_t> GeneratedSecureKeys = KDF_Object.GenerateKeys( MaterialKeys, SaltData, RandomWordKeyDataVector.size() * sizeof( std::uint64_t ), 1024, 8, 16 );
-							MessagePacking<std::uint64_t, std::uint8_t>( GeneratedSecureKeys, RandomWordKeyDataVector.data() );
-
-							//使用通过密钥派生函数的生成的数据，而不使用主密钥数据
-							//Use the data generated by the key derivation function without using the master key data
-							this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys( RandomWordKeyDataVector );
-
-							CheckPointer = memory_set_no_optimize_function<0x00>( SaltWordData.data(), SaltWordData.size() * sizeof( std::uint64_t ) );
-							CheckPointer = nullptr;
-							CheckPointer = memory_set_no_optimize_function<0x00>( SaltData.data(), SaltData.size() );
-							CheckPointer = nullptr;
-							CheckPointer = memory_set_no_optimize_function<0x00>( MaterialKeys.data(), MaterialKeys.size() );
-							CheckPointer = nullptr;
-							CheckPointer = memory_set_no_optimize_function<0x00>( GeneratedSecureKeys.data(), GeneratedSecureKeys.size() );
-							CheckPointer = nullptr;
-							GeneratedSecureKeys.clear();
-							GeneratedSecureKeys.shrink_to_fit();
-						}
-						else if((this->RoundSubkeysCounter % (2048ULL * 2ULL)) == 0)
-						{
-							std::array<std::uint8_t, 16 * sizeof( std::uint64_t )> SaltData {};
-							MessageUnpacking<std::uint64_t, std::uint8_t>( SaltWordData, SaltData.data() );
-
-							std::vector<std::uint8_t> MaterialKeys = MessageUnpacking<std::uint64_t, std::uint8_t>( RandomWordKeyDataVector.data(), RandomWordKeyDataVector.size() );
-							Scrypt					  KDF_Object;
-							std::vector<std::uint8_t> GeneratedSecureKeys = KDF_Object.GenerateKeys( MaterialKeys, SaltData, RandomWordKeyDataVector.size() * sizeof( std::uint64_t ), 1024, 8, 16 );
-							MessagePacking<std::uint64_t, std::uint8_t>( GeneratedSecureKeys, RandomWordKeyDataVector.data() );
-
-							//使用通过密钥派生函数的生成的数据，而不使用主密钥数据
-							//Use the data generated by the key derivation function without using the master key data
-							this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys( RandomWordKeyDataVector );
-							std::seed_seq Seeds = std::seed_seq( RandomWordKeyDataVector.begin(), RandomWordKeyDataVector.end() );
-							MersenneTwister64Bit.seed( Seeds );
-
-							CheckPointer = memory_set_no_optimize_function<0x00>( SaltWordData.data(), SaltWordData.size() * sizeof( std::uint64_t ) );
-							CheckPointer = nullptr;
-							CheckPointer = memory_set_no_optimize_function<0x00>( SaltData.data(), SaltData.size() );
-							CheckPointer = nullptr;
-							CheckPointer = memory_set_no_optimize_function<0x00>( MaterialKeys.data(), MaterialKeys.size() );
-							CheckPointer = nullptr;
-							CheckPointer = memory_set_no_optimize_function<0x00>( GeneratedSecureKeys.data(), GeneratedSecureKeys.size() );
-							CheckPointer = nullptr;
-							GeneratedSecureKeys.clear();
-							GeneratedSecureKeys.shrink_to_fit();
-						}
+			//下一次检查到的 2048 的倍数; 8192 的倍数不会被检查到，因为那个数据块开头的扩散步骤会先把计数器加一
+			//The next multiple of 2048 that gets checked; multiples of 8192 never get checked, because the diffusion step at the start of that data block increments the counter first
+			std::uint64_t NextRoundSubkeysCounter = this->RoundSubkeysCounter + 2048ULL;
+			if( ( NextRoundSubkeysCounter % ( 2048ULL * 4ULL ) ) == 0 )
+				NextRoundSubkeysCounter += 2048ULL;
 
-						const std::vector<std::uint64_t> EmptyData {};
-						this->AlgorithmCorePointer->SecureSubkeyGeneratationModuleObject.GenerationSubkeys( EmptyData );
-					}
+			if( ( NextRoundSubkeysCounter % ( 2048ULL * 3ULL ) ) != 0 && ( NextRoundSubkeysCounter % ( 2048ULL * 2ULL ) ) != 0 )
+				return;
 
-					++(this->RoundSubkeysCounter);
+			//两次"盐渍"之间没有别的地方使用 MersenneTwister64Bit，所以它的副本接下来生成的就是下一次的盐
+			//Nothing else uses MersenneTwister64Bit between two "saltings", so what a copy of it generates next is the next salt
+			std::mt19937_64 PredictedMersenneTwister64Bit = KeySchedule.MersenneTwister64Bit;
+			std::ranges::generate_n( Precomputation.SaltWordData.begin(), Precomputation.SaltWordData.size(), PredictedMersenneTwister64Bit );
+			PredictedMersenneTwister64Bit.seed();
+
+			Precomputation.RoundSubkeysCounter = NextRoundSubkeysCounter;
+			Precomputation.MaterialWords.assign( KeySchedule.RandomWordKeyDataVector.begin(), KeySchedule.RandomWordKeyDataVector.end() );
+			Precomputation.Cancelled.store( false, std::memory_order_release );
+			Precomputation.Pending = true;
+
+			RekeyThreadPoolPointer->Submit
+			(
+				Precomputation.Group,
+				[ &Precomputation ]()
+				{
+					if( Precomputation.Cancelled.load( std::memory_order_acquire ) )
+						return;
+
+					try
+					{
+						Precomputation.GeneratedSecureKeys = DeriveRekeyMaterial( Precomputation.MaterialWords, Precomputation.SaltWordData );
+					}
+					catch(...)
+					{
+						Precomputation.Exception = std::current_exception();
+					}
 				}
+			);
+		}
+
+		void OPC_MainAlgorithm_Worker::CancelRekeyPrecomputation() noexcept
+		{
+			auto& Precomputation = this->RekeyPrecomputation;
+
+			volatile void* CheckPointer = nullptr;
+
+			if( Precomputation.Pending )
+			{
+				Precomputation.Cancelled.store( true, std::memory_order_release );
+				RekeyThreadPoolPointer->Wait( Precomputation.Group );
+				Precomputation.Pending = false;
+			}
+			Precomputation.Exception = nullptr;
+
+			CheckPointer = memory_set_no_optimize_function<0x00>( Precomputation.MaterialWords.data(), Precomputation.MaterialWords.size() * sizeof( std::uint64_t ) );
+			CheckPointer = nullptr;
+			CheckPointer = memory_set_no_optimize_function<0x00>( Precomputation.SaltWordData.data(), Precomputation.SaltWordData.size() * sizeof( std::uint64_t ) );
+			CheckPointer = nullptr;
+			CheckPointer = memory_set_no_optimize_function<0x00>( Precomputation.GeneratedSecureKeys.data(), Precomputation.GeneratedSecureKeys.size() );
+			CheckPointer = nullptr;
+			Precomputation.GeneratedSecureKeys.clear();
+			Precomputation.RoundSubkeysCounter = 0;
+		}
+
+		void OPC_MainAlgorithm_Worker::SplitDataBlockToEncrypt(std::span<std::uint64_t> PlainText, std::span<const std::uint64_t> Keys)
+		{
+			using TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW;
+			auto& DataBlockSize = AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_DataBlockSize;
+			auto& KeyBlockSize = AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_KeyBlockSize;
+
+			/*
+				Tips 提示
+				对于二进制计算机来说，一个数字a是modulo b，这相当于用b减1然后和a做比特AND运算 (b 应该是2的幂)。
+				For a binary computer, a number a is modulo b, which is equivalent to subtracting 1 from b and then doing a bitwise AND operation with a (b should be a power of 2)
+			*/
+
+			if( ( PlainText.size() & (DataBlockSize - 1) ) != 0)
+				my_cpp2020_assert(false, "StateData_Worker: The size of PlainText is not a multiple of OPC_QuadWord_DataBlockSize!", std::source_location::current());
+			if( ( Keys.size() & (KeyBlockSize - 1) ) != 0)
+				my_cpp2020_assert(false, "StateData_Worker: The size of (Encryption)Keys is not a multiple of OPC_QuadWord_KeyBlockSize!", std::source_location::current());
+
+			this->BeginKeySchedule(Keys);
+
+			const std::size_t PlainTextSize = PlainText.size();
+			for ( std::size_t DataBlockOffset = 0; DataBlockOffset < PlainTextSize; DataBlockOffset += DataBlockSize )
+			{
+				this->AdvanceKeySchedule();
+
+				std::span<std::uint64_t> DataByteSpan { PlainText.begin() + DataBlockOffset, PlainText.begin() + DataBlockOffset + DataBlockSize };
+
+				this->AlgorithmCorePointer->RoundFunction(DataByteSpan, CryptionMode2MCAC4_FDW::MCA_ENCRYPTER);
+			}
+
+			this->EndKeySchedule();
+		}
+
+		void OPC_MainAlgorithm_Worker::SplitDataBlockToDecrypt( std::span<std::uint64_t> CipherText, std::span<const std::uint64_t> Keys )
+		{
+			using TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW;
+			auto& DataBlockSize = AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_DataBlockSize;
+			auto& KeyBlockSize = AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_KeyBlockSize;
+
+			/*
+				Tips 提示
+				对于二进制计算机来说，一个数字a是modulo b，这相当于用b减1然后和a做比特AND运算 (b 应该是2的幂)。
+				For a binary computer, a number a is modulo b, which is equivalent to subtracting 1 from b and then doing a bitwise AND operation with a (b should be a power of 2)
+			*/
+
+			if( ( CipherText.size() & (DataBlockSize - 1) ) != 0)
+				my_cpp2020_assert(false, "StateData_Worker: The size of CipherText is not a multiple of OPC_QuadWord_DataBlockSize!", std::source_location::current());
+			if( ( Keys.size() & (KeyBlockSize - 1) ) != 0)
+				my_cpp2020_assert(false, "StateData_Worker: The size of (Decryption)Keys is not a multiple of OPC_QuadWord_KeyBlockSize!", std::source_location::current());
+
+			this->BeginKeySchedule(Keys);
+
+			const std::size_t CipherTextSize = CipherText.size();
+			for ( std::size_t DataBlockOffset = 0; DataBlockOffset < CipherTextSize; DataBlockOffset += DataBlockSize )
+			{
+				this->AdvanceKeySchedule();
 
 				std::span<std::uint64_t> DataByteSpan { CipherText.begin() + DataBlockOffset, CipherText.begin() + DataBlockOffset + DataBlockSize };
 
 				this->AlgorithmCorePointer->RoundFunction(DataByteSpan, CryptionMode2MCAC4_FDW::MCA_DECRYPTER);
 			}
 
-			this->RoundSubkeysCounter = 0;
-			CheckPointer = memory_set_no_optimize_function<0x00>(RandomWordKeyDataVector.data(), RandomWordKeyDataVector.size() * sizeof(std::uint64_t));
-			CheckPointer = nullptr;
+			this->EndKeySchedule();
 		}
 
-		std::vector<std::uint8_t> OPC_MainAlgorithm_Worker::EncrypterMain(const std::vector<std::uint8_t>& PlainText, const std::vector<std::uint8_t>& Keys)
+		std::vector<std::uint8_t> OPC_MainAlgorithm_Worker::EncrypterMain(const std::vector<std::uint8_t>& PlainText, std::span<const std::uint8_t> Keys)
 		{
 			using CommonToolkit::IntegerExchangeBytes::MessagePacking;
 			using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
@@ -395,7 +415,7 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			volatile void* CheckPointer = nullptr;
 
 			std::vector<std::uint8_t> CipherText(PlainText);
-			this->PaddingData(CipherText);
+			this->PaddingData(CipherText, AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_DataBlockSize);
 
 			auto Word64Bit_MasterKey = MessagePacking<std::uint64_t, std::uint8_t>(Keys.data(), Keys.size());
 			auto Word64Bit_Data = MessagePacking<std::uint64_t, std::uint8_t>(CipherText.data(), CipherText.size());
@@ -422,7 +442,7 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			return CipherText;
 		}
 
-		std::vector<std::uint8_t> OPC_MainAlgorithm_Worker::DecrypterMain(const std::vector<std::uint8_t>& CipherText, const std::vector<std::uint8_t>& Keys)
+		std::vector<std::uint8_t> OPC_MainAlgorithm_Worker::DecrypterMain(const std::vector<std::uint8_t>& CipherText, std::span<const std::uint8_t> Keys)
 		{
 			using CommonToolkit::IntegerExchangeBytes::MessagePacking;
 			using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
@@ -458,7 +478,7 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			return PlainText;
 		}
 
-		std::vector<std::uint8_t> OPC_MainAlgorithm_Worker::EncrypterMainWithoutPadding(const std::vector<std::uint8_t>& PlainText, const std::vector<std::uint8_t>& Keys)
+		std::vector<std::uint8_t> OPC_MainAlgorithm_Worker::EncrypterMainWithoutPadding(const std::vector<std::uint8_t>& PlainText, std::span<const std::uint8_t> Keys)
 		{
 			using CommonToolkit::IntegerExchangeBytes::MessagePacking;
 			using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
@@ -492,7 +512,7 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			return CipherText;
 		}
 
-		std::vector<std::uint8_t> OPC_MainAlgorithm_Worker::DecrypterMainWithoutUnpadding(const std::vector<std::uint8_t>& CipherText, const std::vector<std::uint8_t>& Keys)
+		std::vector<std::uint8_t> OPC_MainAlgorithm_Worker::DecrypterMainWithoutUnpadding(const std::vector<std::uint8_t>& CipherText, std::span<const std::uint8_t> Keys)
 		{
 			using CommonToolkit::IntegerExchangeBytes::MessagePacking;
 			using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
@@ -525,5 +545,231 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 			return PlainText;
 		}
+		void OPC_MainAlgorithm_Worker::EncrypterMainInPlace(std::span<std::uint8_t> Data, std::span<const std::uint8_t> Keys)
+		{
+			this->ProcessInPlace(Data, Keys, CryptionMode2MCAC4_FDW::MCA_ENCRYPTER);
+		}
+
+		void OPC_MainAlgorithm_Worker::DecrypterMainInPlace(std::span<std::uint8_t> Data, std::span<const std::uint8_t> Keys)
+		{
+			this->ProcessInPlace(Data, Keys, CryptionMode2MCAC4_FDW::MCA_DECRYPTER);
+		}
+
+		void OPC_MainAlgorithm_Worker::ProcessInPlace(std::span<std::uint8_t> Data, std::span<const std::uint8_t> Keys, CryptionMode2MCAC4_FDW Mode)
+		{
+			const std::size_t KeyBlockByteSize = AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_KeyBlockSize * sizeof(std::uint64_t);
+
+			if( Data.size() % this->StreamBlockByteSize() != 0 )
+				my_cpp2020_assert(false, "OPC_MainAlgorithm_Worker: The size of (InPlace)Data is not a multiple of OPC_QuadWord_DataBlockSize!", std::source_location::current());
+			if( reinterpret_cast<std::uintptr_t>(Data.data()) % alignof(std::uint64_t) != 0 )
+				my_cpp2020_assert(false, "OPC_MainAlgorithm_Worker: The (InPlace)Data is not aligned to a QuadWord!", std::source_location::current());
+			if( Keys.empty() || Keys.size() % KeyBlockByteSize != 0 )
+				my_cpp2020_assert(false, "OPC_MainAlgorithm_Worker: The size of (InPlace)Keys is not a multiple of OPC_QuadWord_KeyBlockSize!", std::source_location::current());
+
+			std::span<std::uint64_t> QuadWords = UseQuadWordView(Data);
+			std::span<const std::uint64_t> MasterKeyWords = this->UseMasterKeyWords(Keys);
+
+			if(Mode == CryptionMode2MCAC4_FDW::MCA_ENCRYPTER)
+				this->SplitDataBlockToEncrypt(QuadWords, MasterKeyWords);
+			else
+				this->SplitDataBlockToDecrypt(QuadWords, MasterKeyWords);
+
+			this->ReleaseMasterKeyWords();
+			ReleaseQuadWordView(QuadWords);
+		}
+
+		std::span<std::uint64_t> OPC_MainAlgorithm_Worker::UseQuadWordView(std::span<std::uint8_t> Bytes)
+		{
+			std::span<std::uint64_t> QuadWords(reinterpret_cast<std::uint64_t*>(Bytes.data()), Bytes.size() / sizeof(std::uint64_t));
+
+			if constexpr(std::endian::native == std::endian::big)
+			{
+				for(std::uint64_t& QuadWord : QuadWords)
+					QuadWord = CommonToolkit::IntegerExchangeBytes::ByteSwap::byteswap(QuadWord);
+			}
+
+			return QuadWords;
+		}
+
+		void OPC_MainAlgorithm_Worker::ReleaseQuadWordView(std::span<std::uint64_t> QuadWords)
+		{
+			if constexpr(std::endian::native == std::endian::big)
+			{
+				for(std::uint64_t& QuadWord : QuadWords)
+					QuadWord = CommonToolkit::IntegerExchangeBytes::ByteSwap::byteswap(QuadWord);
+			}
+			else
+			{
+				(void)QuadWords;
+			}
+		}
+
+		std::span<const std::uint64_t> OPC_MainAlgorithm_Worker::UseMasterKeyWords(std::span<const std::uint8_t> Keys)
+		{
+			if constexpr(std::endian::native == std::endian::little)
+			{
+				if(reinterpret_cast<std::uintptr_t>(Keys.data()) % alignof(std::uint64_t) == 0)
+					return std::span<const std::uint64_t>(reinterpret_cast<const std::uint64_t*>(Keys.data()), Keys.size() / sizeof(std::uint64_t));
+			}
+
+			PackedMasterKeyWords.resize(Keys.size() / sizeof(std::uint64_t));
+			CommonToolkit::IntegerExchangeBytes::MessagePacking<std::uint64_t, std::uint8_t>(Keys, PackedMasterKeyWords.data());
+			return PackedMasterKeyWords;
+		}
+
+		void OPC_MainAlgorithm_Worker::ReleaseMasterKeyWords()
+		{
+			volatile void* CheckPointer = memory_set_no_optimize_function<0x00>(PackedMasterKeyWords.data(), PackedMasterKeyWords.size() * sizeof(std::uint64_t));
+			CheckPointer = nullptr;
+		}
+
+		void OPC_MainAlgorithm_Worker::Begin(CryptionMode2MCAC4_FDW Mode, std::span<const std::uint8_t> Keys)
+		{
+			my_cpp2020_assert(Mode == CryptionMode2MCAC4_FDW::MCA_ENCRYPTER || Mode == CryptionMode2MCAC4_FDW::MCA_DECRYPTER, "OPC_MainAlgorithm_Worker: The stream mode must be encryption or decryption!", std::source_location::current());
+
+			const std::size_t KeyBlockByteSize = AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_KeyBlockSize * sizeof(std::uint64_t);
+			if(Keys.empty() || Keys.size() % KeyBlockByteSize != 0)
+				my_cpp2020_assert(false, "OPC_MainAlgorithm_Worker: The size of (Stream)Keys is not a multiple of OPC_QuadWord_KeyBlockSize!", std::source_location::current());
+
+			//重新开始时先擦除上一次没有 Finish 的流
+			//Wipe a previous stream that was not finished before starting again
+			if(StreamActive)
+				this->WipeStreamState();
+
+			const std::size_t BlockByteSize = this->StreamBlockByteSize();
+			StreamMasterKeyWords.resize(Keys.size() / sizeof(std::uint64_t));
+			CommonToolkit::IntegerExchangeBytes::MessagePacking<std::uint64_t, std::uint8_t>(Keys, StreamMasterKeyWords.data());
+			StreamPendingBytes.resize(BlockByteSize);
+			StreamPendingByteCount = 0;
+			StreamBlockWords.resize(BlockByteSize / sizeof(std::uint64_t));
+
+			StreamMode = Mode;
+			StreamActive = true;
+
+			this->BeginKeySchedule(StreamMasterKeyWords);
+		}
+
+		std::size_t OPC_MainAlgorithm_Worker::Update(std::span<const std::uint8_t> Input, std::span<std::uint8_t> Output)
+		{
+			my_cpp2020_assert(StreamActive, "OPC_MainAlgorithm_Worker: Update was called without Begin!", std::source_location::current());
+
+			const std::size_t BlockByteSize = this->StreamBlockByteSize();
+
+			//解密时如果数据刚好结束在数据块边界，最后一个完整数据块留给 Finish
+			//When decrypting and the data ends exactly on a data block boundary, the last full data block is left for Finish
+			const std::size_t TotalByteCount = StreamPendingByteCount + Input.size();
+			std::size_t OutputBlockCount = TotalByteCount / BlockByteSize;
+			if(StreamMode == CryptionMode2MCAC4_FDW::MCA_DECRYPTER && OutputBlockCount > 0 && TotalByteCount % BlockByteSize == 0)
+				--OutputBlockCount;
+
+			my_cpp2020_assert(Output.size() >= OutputBlockCount * BlockByteSize, "OPC_MainAlgorithm_Worker: The stream output buffer is too small!", std::source_location::current());
+
+			std::size_t OutputByteCount = 0;
+			for(std::size_t BlockIndex = 0; BlockIndex < OutputBlockCount; ++BlockIndex)
+			{
+				std::span<std::uint8_t> OutputBlock = Output.subspan(OutputByteCount, BlockByteSize);
+
+				if(StreamPendingByteCount == 0)
+				{
+					//缓冲区为空时直接处理输入，不复制到缓冲区
+					//Process the input directly when the buffer is empty, without copying it into the buffer
+					this->ProcessStreamBlock(Input.first(BlockByteSize), OutputBlock);
+					Input = Input.subspan(BlockByteSize);
+				}
+				else
+				{
+					const std::size_t FillByteCount = BlockByteSize - StreamPendingByteCount;
+					std::memcpy(StreamPendingBytes.data() + StreamPendingByteCount, Input.data(), FillByteCount);
+					Input = Input.subspan(FillByteCount);
+					StreamPendingByteCount = 0;
+
+					this->ProcessStreamBlock(StreamPendingBytes, OutputBlock);
+				}
+
+				OutputByteCount += BlockByteSize;
+			}
+
+			if(!Input.empty())
+			{
+				std::memcpy(StreamPendingBytes.data() + StreamPendingByteCount, Input.data(), Input.size());
+				StreamPendingByteCount += Input.size();
+			}
+
+			return OutputByteCount;
+		}
+
+		std::size_t OPC_MainAlgorithm_Worker::Finish(std::span<std::uint8_t> Output)
+		{
+			my_cpp2020_assert(StreamActive, "OPC_MainAlgorithm_Worker: Finish was called without Begin!", std::source_location::current());
+
+			const std::size_t BlockByteSize = this->StreamBlockByteSize();
+			std::size_t OutputByteCount = 0;
+
+			if(StreamMode == CryptionMode2MCAC4_FDW::MCA_ENCRYPTER)
+			{
+				my_cpp2020_assert(Output.size() >= BlockByteSize, "OPC_MainAlgorithm_Worker: The stream output buffer is too small!", std::source_location::current());
+
+				//剩余的字节不足一个数据块，填充之后刚好是一个数据块 (没有剩余字节时填充一整个数据块)
+				//The remaining bytes are less than one data block, after padding they are exactly one data block (a whole data block of padding when nothing remains)
+				std::vector<std::uint8_t> LastBlock(StreamPendingBytes.begin(), StreamPendingBytes.begin() + StreamPendingByteCount);
+				this->PaddingData(LastBlock, AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_DataBlockSize);
+
+				this->ProcessStreamBlock(LastBlock, Output.first(BlockByteSize));
+				OutputByteCount = BlockByteSize;
+
+				volatile void* CheckPointer = memory_set_no_optimize_function<0x00>(LastBlock.data(), LastBlock.size());
+				CheckPointer = nullptr;
+			}
+			else
+			{
+				if(StreamPendingByteCount != BlockByteSize)
+				{
+					this->WipeStreamState();
+					my_cpp2020_assert(false, "OPC_MainAlgorithm_Worker: The size of (Stream)CipherText is not a multiple of OPC_QuadWord_DataBlockSize!", std::source_location::current());
+				}
+
+				this->ProcessStreamBlock(StreamPendingBytes, StreamPendingBytes);
+
+				const std::size_t PaddingByteCount = StreamPendingBytes.back();
+				if(PaddingByteCount == 0 || PaddingByteCount > BlockByteSize || Output.size() < BlockByteSize - PaddingByteCount)
+				{
+					this->WipeStreamState();
+					my_cpp2020_assert(false, "OPC_MainAlgorithm_Worker: The stream padding is invalid or the output buffer is too small!", std::source_location::current());
+				}
+
+				OutputByteCount = BlockByteSize - PaddingByteCount;
+				std::memcpy(Output.data(), StreamPendingBytes.data(), OutputByteCount);
+			}
+
+			this->WipeStreamState();
+			return OutputByteCount;
+		}
+
+		void OPC_MainAlgorithm_Worker::ProcessStreamBlock(std::span<const std::uint8_t> Input, std::span<std::uint8_t> Output)
+		{
+			CommonToolkit::IntegerExchangeBytes::MessagePacking<std::uint64_t, std::uint8_t>(Input, StreamBlockWords.data());
+
+			this->AdvanceKeySchedule();
+			this->AlgorithmCorePointer->RoundFunction(StreamBlockWords, StreamMode);
+
+			CommonToolkit::IntegerExchangeBytes::MessageUnpacking<std::uint64_t, std::uint8_t>(StreamBlockWords, Output.data());
+		}
+
+		void OPC_MainAlgorithm_Worker::WipeStreamState()
+		{
+			volatile void* CheckPointer = nullptr;
+
+			this->EndKeySchedule();
+
+			CheckPointer = memory_set_no_optimize_function<0x00>(StreamMasterKeyWords.data(), StreamMasterKeyWords.size() * sizeof(std::uint64_t));
+			CheckPointer = nullptr;
+			CheckPointer = memory_set_no_optimize_function<0x00>(StreamPendingBytes.data(), StreamPendingBytes.size());
+			CheckPointer = nullptr;
+			CheckPointer = memory_set_no_optimize_function<0x00>(StreamBlockWords.data(), StreamBlockWords.size() * sizeof(std::uint64_t));
+			CheckPointer = nullptr;
+
+			StreamPendingByteCount = 0;
+			StreamActive = false;
+		}
 	}  // namespace SED::BlockCipher
 }  // namespace TwilightDreamOfMagical::CustomSecurity
\ No newline at end of file
@@ -24,30 +24,111 @@
 #define ALGORITHM_OALDRESPUZZLECRYPTIC_OPC_MAINALGORITHM_WORKER_HPP
 
 #include "OaldresPuzzle_Cryptic.hpp"
+#include "../WorkStealingThreadPool.hpp"
 
 namespace TwilightDreamOfMagical::CustomSecurity
 {
 	//SymmetricEncryptionDecryption
 	namespace SED::BlockCipher
 	{
+		class OPC_SegmentedWorker;
+		class OPC_KeySetupCache;
+		class OPC_PreparedContext;
+
 		class OPC_MainAlgorithm_Worker
 		{
+			friend class OPC_SegmentedWorker;
+			friend class OPC_KeySetupCache;
+			friend class OPC_PreparedContext;
+
 		public:
-			explicit OPC_MainAlgorithm_Worker(OaldresPuzzle_Cryptic& AlgorithmCoreObject)
+			explicit OPC_MainAlgorithm_Worker(OaldresPuzzle_Cryptic& AlgorithmCoreObject, bool PrintSpecialNotice = true)
 				:
-				AlgorithmCorePointer(std::addressof(AlgorithmCoreObject))
+				AlgorithmCorePointer(std::addressof(AlgorithmCoreObject)),
+				RekeyThreadPoolPointer(std::addressof(CommonToolkit::WorkStealingThreadPool::Shared()))
 			{
+				if(!PrintSpecialNotice)
+					return;
+
 				std::cout << "\nSpecial Notice\n";
 				std::cout << "The symmetric encryption and decryption algorithm (Type 2 BlockCipher) of the OaldresPuzzle_Cryptic (OPC) designed by Twilight-Dream.\n";
 				std::cout << "After calling the encryption function or decryption function, the key state inside the algorithm will change; This design is to deal with any possible brute force guess (including use quantum computer attack).\n";
 				std::cout << "If you have called the encryption function or decryption function, but want to restore your 'forward' operation.\n";
-				std::cout << "Please destroy the current instance and rebuild, then you can call the 'backward' operation function.\n";
+				std::cout << "Please destroy the current instance and rebuild (or restore a snapshot taken by OaldresPuzzle_Cryptic::TakeSnapshot before the 'forward' operation), then you can call the 'backward' operation function.\n";
+			}
+
+			~OPC_MainAlgorithm_Worker()
+			{
+				if(StreamActive)
+					this->WipeStreamState();
+				this->CancelRekeyPrecomputation();
 			}
 
-			std::vector<std::uint8_t> EncrypterMain(const std::vector<std::uint8_t>& PlainText, const std::vector<std::uint8_t>& Keys);
-			std::vector<std::uint8_t> DecrypterMain(const std::vector<std::uint8_t>& CipherText, const std::vector<std::uint8_t>& Keys);
-			std::vector<std::uint8_t> EncrypterMainWithoutPadding(const std::vector<std::uint8_t>& PlainText, const std::vector<std::uint8_t>& Keys);
-			std::vector<std::uint8_t> DecrypterMainWithoutUnpadding(const std::vector<std::uint8_t>& CipherText, const std::vector<std::uint8_t>& Keys);
+			std::vector<std::uint8_t> EncrypterMain(const std::vector<std::uint8_t>& PlainText, std::span<const std::uint8_t> Keys);
+			std::vector<std::uint8_t> DecrypterMain(const std::vector<std::uint8_t>& CipherText, std::span<const std::uint8_t> Keys);
+			std::vector<std::uint8_t> EncrypterMainWithoutPadding(const std::vector<std::uint8_t>& PlainText, std::span<const std::uint8_t> Keys);
+			std::vector<std::uint8_t> DecrypterMainWithoutUnpadding(const std::vector<std::uint8_t>& CipherText, std::span<const std::uint8_t> Keys);
+
+			/*
+				原地加密和解密调用者持有的字节区间，不填充也不去掉填充
+				Data 必须按 8 字节对齐，大小必须是数据块字节大小的整数倍；处理过程中没有中间的 vector
+				小端机器上直接把这些字节当作 QuadWord 读写，大端机器上先原地交换字节序，处理完再交换回来
+
+				Encrypt and decrypt a caller-owned byte range in place, without padding or unpadding
+				Data must be 8-byte aligned and its size must be a multiple of the data block byte size; there are no intermediate vectors
+				On little-endian machines the bytes are read and written directly as QuadWords, on big-endian machines the byte order is swapped in place first and swapped back afterwards
+			*/
+			void EncrypterMainInPlace(std::span<std::uint8_t> Data, std::span<const std::uint8_t> Keys);
+			void DecrypterMainInPlace(std::span<std::uint8_t> Data, std::span<const std::uint8_t> Keys);
+
+			/*
+				流式接口: Begin(模式, 密钥) 之后任意次 Update(输入, 输出)，最后 Finish(输出)
+				密钥编排的状态在调用之间保持，内部只缓存一个数据块，所以内存占用和数据总长度无关
+				输出和 EncrypterMain / DecrypterMain 一次处理整段数据的结果相同 (加密时的随机填充字节除外)
+
+				Streaming interface: Begin(mode, keys), then any number of Update(input, output), then Finish(output)
+				The key schedule state is kept across calls and only one data block is buffered inside, so the memory use does not depend on the total data length
+				The output is the same as EncrypterMain / DecrypterMain processing the whole data at once (except for the random padding bytes when encrypting)
+			*/
+			void Begin(CryptionMode2MCAC4_FDW Mode, std::span<const std::uint8_t> Keys);
+
+			//返回写入 Output 的字节数，总是数据块字节大小的整数倍，最多是 Input.size() 加上一个数据块
+			//Returns the number of bytes written to Output, always a multiple of the data block byte size and at most Input.size() plus one data block
+			std::size_t Update(std::span<const std::uint8_t> Input, std::span<std::uint8_t> Output);
+
+			//加密时写入带填充的最后一个数据块，解密时写入去掉填充的最后一个数据块，Output 至少要有一个数据块的大小
+			//Writes the padded last data block when encrypting, or the unpadded last data block when decrypting, Output needs room for one data block
+			std::size_t Finish(std::span<std::uint8_t> Output);
+
+			std::size_t StreamBlockByteSize() const
+			{
+				return AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_DataBlockSize * sizeof(std::uint64_t);
+			}
+
+			/*
+				各阶段性能计数器的快照 (需要定义 TDOM_OPC_STAGE_PROFILING，否则全是 0 并且 Enabled 为 false)
+				计数器一直累加到调用 ResetStageProfile 为止；想要一条消息的耗时分布，就在处理前清零、处理后读取快照
+
+				Snapshot of the per-stage performance counters (requires TDOM_OPC_STAGE_PROFILING, otherwise everything is 0 and Enabled is false)
+				The counters keep accumulating until ResetStageProfile is called; for the time split of one message, reset before processing and take the snapshot afterwards
+			*/
+			OPC_StageProfile StageProfile() const
+			{
+				return AlgorithmCorePointer->StateDataPointer->StageProfiler.Snapshot();
+			}
+
+			void ResetStageProfile()
+			{
+				AlgorithmCorePointer->StateDataPointer->StageProfiler.Reset();
+			}
+
+			//更换预先计算重新派生密钥所用的线程池 (默认是 WorkStealingThreadPool::Shared())；空指针表示总是在交接处当场计算，两种方式的输出逐位相同
+			//Replace the thread pool used to precompute the rekey (WorkStealingThreadPool::Shared() by default); a null pointer means always computing on the spot at the handover, and both ways give bit-identical output
+			void UseRekeyThreadPool(CommonToolkit::WorkStealingThreadPool* ThreadPoolPointer)
+			{
+				this->CancelRekeyPrecomputation();
+				RekeyThreadPoolPointer = ThreadPoolPointer;
+			}
 
 		private:
 
@@ -57,6 +138,102 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			//Counter to check the number of times the current round of subkeys has been generated
 			volatile std::uint64_t RoundSubkeysCounter = 0;
 
+			//分块加密和解密在数据块之间保持的密钥编排状态，整段处理和流式处理共用
+			//Key schedule state kept between data blocks by split block encryption and decryption, shared by whole-data and streaming processing
+			struct KeyScheduleState
+			{
+				std::span<const std::uint64_t> MasterKeyWords;
+				volatile std::size_t Word64Bit_Key_OffsetIndex = 0;
+				std::vector<std::uint64_t> RandomWordKeyDataVector;
+				volatile bool ConditionControlFlag = true;
+
+				//生成代表"盐渍"的伪随机数
+				//Generate a pseudo-random number representing "salted"
+				std::mt19937_64 MersenneTwister64Bit;
+
+				//第一个数据块的密钥编排已经由预先准备的状态完成，下一次推进直接跳过
+				//The key schedule of the first data block was already done by a prepared state, so the next advance is skipped
+				bool FirstAdvancePrepared = false;
+			};
+
+			KeyScheduleState KeySchedule;
+
+			/*
+				第一个数据块推进之后的密钥编排状态，只取决于主密钥和算法的初始状态，所以可以被 OPC_KeySetupCache 缓存
+				配合同一时刻的 OaldresPuzzle_Cryptic 快照使用，可以跳过 BeginKeySchedule 和第一次 AdvanceKeySchedule
+
+				The key schedule state after advancing for the first data block, it only depends on the master key and the initial state of the algorithm, so it can be cached by OPC_KeySetupCache
+				Used together with an OaldresPuzzle_Cryptic snapshot taken at the same moment, it skips BeginKeySchedule and the first AdvanceKeySchedule
+			*/
+			struct PreparedKeySchedule
+			{
+				//存储来自调用者的安全内存区 (OPC_KeySetupCache 用的是条目自己的那一块)
+				//The storage comes from a secure arena of the caller (OPC_KeySetupCache uses the one owned by the entry)
+				explicit PreparedKeySchedule(CommonToolkit::SecureArena& Arena)
+					:
+					RandomWordKeyDataVector(CommonToolkit::SecureArenaAllocator<std::uint64_t>(Arena))
+				{
+
+				}
+
+				std::size_t Word64Bit_Key_OffsetIndex = 0;
+				CommonToolkit::SecureArenaVector<std::uint64_t> RandomWordKeyDataVector;
+				bool ConditionControlFlag = true;
+				std::mt19937_64 MersenneTwister64Bit;
+				std::uint64_t RoundSubkeysCounter = 0;
+
+				~PreparedKeySchedule()
+				{
+					volatile void* CheckPointer = memory_set_no_optimize_function<0x00>(RandomWordKeyDataVector.data(), RandomWordKeyDataVector.size() * sizeof(std::uint64_t));
+					CheckPointer = nullptr;
+				}
+			};
+
+			//下一次 BeginKeySchedule 使用的预先准备的状态 (用过一次就清空)
+			//Prepared state used by the next BeginKeySchedule (cleared after one use)
+			const PreparedKeySchedule* NextPreparedKeySchedule = nullptr;
+
+			/*
+				重新派生密钥 (Scrypt) 的输入只来自 RandomWordKeyDataVector 和确定性的 MersenneTwister64Bit，和数据无关。
+				所以在上一次"盐渍"之后，就可以在后台线程预先计算下一次的结果；交接时计数器、材料和盐都一致才会使用，否则当场重新计算。
+
+				The inputs of the rekey (Scrypt) only come from RandomWordKeyDataVector and the deterministic MersenneTwister64Bit, independent of the data.
+				So right after the previous "salting", the next result can be precomputed on a background thread; it is only used at the handover when the counter, the material and the salt all match, otherwise it is recomputed on the spot.
+			*/
+			struct RekeyPrecomputationState
+			{
+				std::uint64_t RoundSubkeysCounter = 0;
+				std::vector<std::uint64_t> MaterialWords;
+				std::array<std::uint64_t, 16> SaltWordData {};
+				std::vector<std::uint8_t> GeneratedSecureKeys;
+				//后台任务抛出的异常只在交接时 (TakeRekeyMaterial) 重新抛出，放弃时直接丢掉，所以析构函数里的等待不会抛出异常
+				//An exception thrown by the background task is only rethrown at the handover (TakeRekeyMaterial) and dropped when abandoned, so the wait in the destructor never throws
+				std::exception_ptr Exception = nullptr;
+
+				bool Pending = false;
+				std::atomic<bool> Cancelled { false };
+				CommonToolkit::WorkStealingThreadPool::TaskGroup Group;
+			};
+
+			RekeyPrecomputationState RekeyPrecomputation;
+
+			//预先计算重新派生密钥所用的线程池，空指针或者没有工作线程时，在交接处当场计算
+			//Thread pool used to precompute the rekey, when it is null or has no worker threads the rekey is computed on the spot at the handover
+			CommonToolkit::WorkStealingThreadPool* RekeyThreadPoolPointer = nullptr;
+
+			//流式接口的状态: 打包好的主密钥，一个数据块的输入缓冲 (解密时保留最后一个完整数据块，留给 Finish 去掉填充) 和一个数据块的字缓冲
+			//Streaming interface state: the packed master key, one data block of input buffer (decryption holds back the last full data block for Finish to unpad) and one data block of word buffer
+			bool StreamActive = false;
+			CryptionMode2MCAC4_FDW StreamMode = CryptionMode2MCAC4_FDW::MCA_ENCRYPTER;
+			std::vector<std::uint64_t> StreamMasterKeyWords;
+			std::vector<std::uint8_t> StreamPendingBytes;
+			std::size_t StreamPendingByteCount = 0;
+			std::vector<std::uint64_t> StreamBlockWords;
+
+			//原地处理时，主密钥没有按 8 字节对齐 (或者是大端机器) 才打包到这里，容量会被重复使用
+			//For in-place processing, the master key is packed here only when it is not 8-byte aligned (or on big-endian machines), the capacity is reused
+			std::vector<std::uint64_t> PackedMasterKeyWords;
+
 
 			/*
 				https://en.wikipedia.org/wiki/Padding_(cryptography)
@@ -65,12 +242,10 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 				Example: In the following example the block size is 8 bytes and padding is required for 4 bytes
 			*/
-			void PaddingData( std::vector<std::uint8_t>& Data ) const
+			static void PaddingData( std::vector<std::uint8_t>& Data, const std::size_t DataBlockSize )
 			{
 				using TwilightDreamOfMagical::CommonSecurity::GenerateSecureRandomNumberSeed;
 
-				auto& DataBlockSize = AlgorithmCorePointer->StateDataPointer->OPC_QuadWord_DataBlockSize;
-
 				std::size_t NumberRemainder = Data.size() & ( DataBlockSize * sizeof( std::uint64_t ) ) - 1;
 
 				std::size_t NeedPaddingCount = ( DataBlockSize * sizeof( std::uint64_t ) ) - NumberRemainder;
@@ -97,7 +272,7 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 				Example: In the following example the block size is 8 bytes and padding is required for 4 bytes
 			*/
-			void UnpaddingData( std::vector<std::uint8_t>& Data ) const
+			static void UnpaddingData( std::vector<std::uint8_t>& Data )
 			{
 				std::size_t count = static_cast<std::size_t>( Data.back() );
 				while ( count-- )
@@ -106,6 +281,50 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				}
 			}
 
+			/*
+				开始和结束一次密钥编排，以及在处理每个数据块之前推进密钥编排 (加密和解密的密钥编排相同)
+				Begin and end one key schedule, and advance the key schedule before processing each data block (encryption and decryption share the same key schedule)
+			*/
+			void BeginKeySchedule(std::span<const std::uint64_t> Keys);
+			void AdvanceKeySchedule();
+			void EndKeySchedule();
+
+			//执行 BeginKeySchedule 和第一次 AdvanceKeySchedule，并记录下这时的密钥编排状态 (算法的状态由调用者另外保存快照)
+			//Run BeginKeySchedule and the first AdvanceKeySchedule and record the key schedule state at that point (the caller snapshots the algorithm state separately)
+			void PrepareKeySchedule(std::span<const std::uint64_t> Keys, PreparedKeySchedule& Prepared);
+
+			//用 Scrypt 从材料和盐派生新的 RandomWordKeyDataVector 字节 (当场计算和后台预先计算共用)
+			//Derive the new RandomWordKeyDataVector bytes from the material and the salt with Scrypt (shared by the on-the-spot and the background computation)
+			static std::vector<std::uint8_t> DeriveRekeyMaterial(std::span<const std::uint64_t> MaterialWords, std::span<const std::uint64_t> SaltWordData);
+
+			//取出这次"盐渍"的重新派生结果，预先计算的结果和输入一致就直接使用
+			//Take the rekey result of this "salting", the precomputed result is used directly when its inputs match
+			std::vector<std::uint8_t> TakeRekeyMaterial(std::span<const std::uint64_t> SaltWordData);
+
+			//在一次"盐渍"之后，如果下一次"盐渍"需要重新派生密钥，就提交到线程池预先计算
+			//After a "salting", if the next "salting" needs a rekey, submit it to the thread pool to be precomputed
+			void StartRekeyPrecomputation();
+
+			//放弃还没有交接的预先计算 (已经开始的会等它结束，它的异常被丢掉)，并擦除它的缓冲
+			//Abandon a precomputation that has not been handed over (waiting for it if it has already started, its exception is dropped), and wipe its buffers
+			void CancelRekeyPrecomputation() noexcept;
+
+			//流式接口处理一个完整的数据块 (Input 和 Output 可以是同一段内存)
+			//The streaming interface processes one full data block (Input and Output may be the same memory)
+			void ProcessStreamBlock(std::span<const std::uint8_t> Input, std::span<std::uint8_t> Output);
+
+			void WipeStreamState();
+
+			//把 8 字节对齐的字节区间当作小端序的 QuadWord 区间使用 (大端机器上原地交换字节序)，处理完之后用 ReleaseQuadWordView 换回来
+			//Use an 8-byte aligned byte range as a little-endian QuadWord range (swapping the byte order in place on big-endian machines), ReleaseQuadWordView swaps it back after processing
+			static std::span<std::uint64_t> UseQuadWordView(std::span<std::uint8_t> Bytes);
+			static void ReleaseQuadWordView(std::span<std::uint64_t> QuadWords);
+
+			std::span<const std::uint64_t> UseMasterKeyWords(std::span<const std::uint8_t> Keys);
+			void ReleaseMasterKeyWords();
+
+			void ProcessInPlace(std::span<std::uint8_t> Data, std::span<const std::uint8_t> Keys, CryptionMode2MCAC4_FDW Mode);
+
 			/*
 				分块加密数据函数
 				Split block encryption data function
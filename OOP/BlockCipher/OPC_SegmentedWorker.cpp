@@ -0,0 +1,340 @@
+#include "OPC_SegmentedWorker.hpp"
+#include "./Includes/SecureHashProvider/HMAC_Worker.hpp"
+#include "../DataFormating.hpp"
+
+namespace TwilightDreamOfMagical::CustomSecurity
+{
+	namespace SED::BlockCipher
+	{
+		OPC_SegmentedWorker::OPC_SegmentedWorker
+		(
+			std::size_t OPC_QuadWord_DataBlockSize,
+			std::size_t OPC_QuadWord_KeyBlockSize,
+			std::span<const std::uint8_t> InitialBytes_MemorySpan,
+			std::uint64_t LFSR_SeedNumber,
+			std::uint64_t NLFSR_SeedNumber,
+			std::uint64_t SDP_SeedNumber,
+			std::size_t SegmentByteSize
+		)
+			:
+			OPC_QuadWord_DataBlockSize( OPC_QuadWord_DataBlockSize ), OPC_QuadWord_KeyBlockSize( OPC_QuadWord_KeyBlockSize ), SegmentByteSize( SegmentByteSize ),
+			InitialBytes( InitialBytes_MemorySpan.begin(), InitialBytes_MemorySpan.end() ),
+			LFSR_SeedNumber( LFSR_SeedNumber ), NLFSR_SeedNumber( NLFSR_SeedNumber ), SDP_SeedNumber( SDP_SeedNumber )
+		{
+			const std::size_t DataBlockByteSize = OPC_QuadWord_DataBlockSize * sizeof( std::uint64_t );
+
+			my_cpp2020_assert
+			(
+				SegmentByteSize > 0 && DataBlockByteSize > 0 && ( SegmentByteSize % DataBlockByteSize ) == 0,
+				"OPC_SegmentedWorker: SegmentByteSize must be a non-zero multiple of (OPC_DataBlockSize * sizeof(std::uint64_t)) byte!",
+				std::source_location::current()
+			);
+
+			my_cpp2020_assert
+			(
+				!InitialBytes.empty() && ( InitialBytes.size() % DataBlockByteSize ) == 0,
+				"OPC_SegmentedWorker: The InitialBytes_MemorySpan must not be empty and its size must be a multiple of (OPC_DataBlockSize * sizeof(std::uint64_t)) byte!",
+				std::source_location::current()
+			);
+		}
+
+		OPC_SegmentedWorker::~OPC_SegmentedWorker()
+		{
+			volatile void* CheckPointer = nullptr;
+
+			CheckPointer = memory_set_no_optimize_function<0x00>( InitialBytes.data(), InitialBytes.size() );
+			CheckPointer = nullptr;
+
+			LFSR_SeedNumber = 0;
+			NLFSR_SeedNumber = 0;
+			SDP_SeedNumber = 0;
+		}
+
+		OPC_SegmentedWorker::SegmentHeader OPC_SegmentedWorker::ReadSegmentHeader( std::span<const std::uint8_t> CipherText ) const
+		{
+			using CommonToolkit::IntegerExchangeBytes::MessagePacking;
+
+			my_cpp2020_assert( CipherText.size() >= HeaderByteSize, "OPC_SegmentedWorker: The CipherText is too short to contain the segment header!", std::source_location::current() );
+
+			std::array<std::uint64_t, 3> HeaderWords {};
+			MessagePacking<std::uint64_t, std::uint8_t>( CipherText.first( HeaderByteSize ), HeaderWords.data() );
+
+			my_cpp2020_assert( HeaderWords[ 0 ] == HeaderMagicNumber, "OPC_SegmentedWorker: The segment header magic number or version does not match!", std::source_location::current() );
+
+			SegmentHeader Header { HeaderWords[ 1 ], HeaderWords[ 2 ] };
+
+			//检查头部描述的段是否和密文长度一致，防止后面的偏移量越界
+			//Check the segments described by the header agree with the ciphertext length, so later offsets cannot go out of bounds
+			const std::size_t DataBlockByteSize = OPC_QuadWord_DataBlockSize * sizeof( std::uint64_t );
+			const std::size_t BodyByteSize = CipherText.size() - HeaderByteSize;
+
+			my_cpp2020_assert
+			(
+				Header.SegmentByteSize > 0 && ( Header.SegmentByteSize % DataBlockByteSize ) == 0 && Header.SegmentCount > 0,
+				"OPC_SegmentedWorker: The segment header has an invalid segment size or segment count!",
+				std::source_location::current()
+			);
+
+			my_cpp2020_assert
+			(
+				Header.SegmentCount - 1 <= BodyByteSize / Header.SegmentByteSize,
+				"OPC_SegmentedWorker: The segment count in the header does not match the size of the CipherText!",
+				std::source_location::current()
+			);
+
+			const std::size_t LastSegmentByteSize = BodyByteSize - static_cast<std::size_t>( Header.SegmentCount - 1 ) * Header.SegmentByteSize;
+
+			my_cpp2020_assert
+			(
+				LastSegmentByteSize >= DataBlockByteSize && LastSegmentByteSize <= Header.SegmentByteSize + DataBlockByteSize && ( LastSegmentByteSize % DataBlockByteSize ) == 0,
+				"OPC_SegmentedWorker: The size of the last segment of the CipherText is invalid!",
+				std::source_location::current()
+			);
+
+			return Header;
+		}
+
+		std::pair<std::size_t, std::size_t> OPC_SegmentedWorker::SegmentByteRange( const SegmentHeader& Header, std::size_t BodyByteSize, std::uint64_t SegmentIndex ) const
+		{
+			const std::size_t SegmentByteOffset = static_cast<std::size_t>( SegmentIndex ) * Header.SegmentByteSize;
+
+			//最后一段包含填充，所以一直延伸到密文的末尾
+			//The last segment holds the padding, so it extends to the end of the ciphertext
+			if ( SegmentIndex + 1 == Header.SegmentCount )
+				return { SegmentByteOffset, BodyByteSize - SegmentByteOffset };
+
+			return { SegmentByteOffset, Header.SegmentByteSize };
+		}
+
+		void OPC_SegmentedWorker::ProcessSegment( std::span<std::uint64_t> SegmentWordData, std::span<const std::uint64_t> Word64Bit_MasterKey, std::span<const std::uint8_t> MasterKeyBytes, std::uint64_t SegmentIndex, CryptionMode2MCAC4_FDW Mode ) const
+		{
+			using CommonSecurity::SHA::SHA2_512;
+			using CommonSecurity::DataHashingWrapper::HMAC_Worker;
+			using CommonToolkit::IntegerExchangeBytes::MessagePacking;
+			using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
+			using UtilTools::DataFormating::ASCII_Hexadecmial::hexadecimalString2ByteArray;
+			using ImplementationDetails::CommonStateData;
+
+			volatile void* CheckPointer = nullptr;
+
+			/*
+				段盐 = SHA2-512(初始向量 || LFSR种子 || NLFSR种子 || SDP种子 || 段序号)
+				段材料 = HMAC-SHA2-512(主密钥, 段盐 || 0) || HMAC-SHA2-512(主密钥, 段盐 || 1) || ... 截取到 初始向量长度 + 3 * 8 字节
+				段材料依次作为这一段的初始向量和三个伪随机数生成器的种子
+
+				SegmentSalt = SHA2-512(InitialVector || LFSR seed || NLFSR seed || SDP seed || SegmentIndex)
+				SegmentMaterial = HMAC-SHA2-512(MasterKey, SegmentSalt || 0) || HMAC-SHA2-512(MasterKey, SegmentSalt || 1) || ... truncated to InitialVector length + 3 * 8 bytes
+				The segment material becomes, in order, the initial vector of this segment and the seeds of the three pseudo-random number generators
+			*/
+			const std::array<std::uint64_t, 4> SaltParameterWords { LFSR_SeedNumber, NLFSR_SeedNumber, SDP_SeedNumber, SegmentIndex };
+			std::vector<std::uint8_t> SaltMaterial( InitialBytes.size() + SaltParameterWords.size() * sizeof( std::uint64_t ), 0 );
+			std::ranges::copy( InitialBytes, SaltMaterial.begin() );
+			MessageUnpacking<std::uint64_t, std::uint8_t>( SaltParameterWords, SaltMaterial.data() + InitialBytes.size() );
+
+			std::array<std::uint8_t, 64> SegmentSalt {};
+			SHA2_512 HashFunctionObject;
+			HashFunctionObject.Hash( SaltMaterial, SegmentSalt );
+
+			HMAC_Worker HMAC_FunctionObject( HashFunctionObject );
+			HMAC_FunctionObject.GivenKeyWith_SHA2_512( MasterKeyBytes );
+
+			const std::size_t SegmentMaterialSize = InitialBytes.size() + 3 * sizeof( std::uint64_t );
+			std::vector<std::uint8_t> SegmentMaterial;
+			SegmentMaterial.reserve( SegmentMaterialSize );
+
+			std::string BlockMessage( SegmentSalt.size() + sizeof( std::uint64_t ), 0x00 );
+			std::ranges::copy( SegmentSalt, BlockMessage.begin() );
+			std::string BlockDigest;
+
+			for ( std::uint64_t BlockCounter = 0; SegmentMaterial.size() < SegmentMaterialSize; ++BlockCounter )
+			{
+				const std::array<std::uint64_t, 1> BlockCounterWord { BlockCounter };
+				MessageUnpacking<std::uint64_t, std::uint8_t>( BlockCounterWord, reinterpret_cast<std::uint8_t*>( BlockMessage.data() ) + SegmentSalt.size() );
+
+				//摘要是十六进制字符串
+				//The digest is a hexadecimal string
+				HMAC_FunctionObject.With_SHA2_512( BlockMessage, BlockDigest );
+				std::vector<std::uint8_t> BlockDigestBytes = hexadecimalString2ByteArray( BlockDigest );
+
+				const std::size_t CopyByteCount = std::min( BlockDigestBytes.size(), SegmentMaterialSize - SegmentMaterial.size() );
+				SegmentMaterial.insert( SegmentMaterial.end(), BlockDigestBytes.begin(), BlockDigestBytes.begin() + CopyByteCount );
+
+				CheckPointer = memory_set_no_optimize_function<0x00>( BlockDigestBytes.data(), BlockDigestBytes.size() );
+				CheckPointer = nullptr;
+			}
+
+			std::array<std::uint64_t, 3> SegmentSeeds {};
+			MessagePacking<std::uint64_t, std::uint8_t>( std::span<const std::uint8_t>( SegmentMaterial ).subspan( InitialBytes.size() ), SegmentSeeds.data() );
+
+			//LFSR和NLFSR的种子不能是0，SDP的种子必须足够大
+			//The LFSR and NLFSR seeds must not be 0, the SDP seed must be large enough
+			SegmentSeeds[ 0 ] = SegmentSeeds[ 0 ] != 0 ? SegmentSeeds[ 0 ] : 1;
+			SegmentSeeds[ 1 ] = SegmentSeeds[ 1 ] != 0 ? SegmentSeeds[ 1 ] : 1;
+			SegmentSeeds[ 2 ] |= 0x8000000000000000ULL;
+
+			{
+				CommonStateData		  SegmentStateData( OPC_QuadWord_DataBlockSize, OPC_QuadWord_KeyBlockSize, std::span<const std::uint8_t>( SegmentMaterial ).first( InitialBytes.size() ), SegmentSeeds[ 0 ], SegmentSeeds[ 1 ], SegmentSeeds[ 2 ] );
+				OaldresPuzzle_Cryptic	  SegmentAlgorithmCore( SegmentStateData );
+				OPC_MainAlgorithm_Worker SegmentWorker( SegmentAlgorithmCore, false );
+
+				//各个分段已经占满了线程池，分段内的重新派生密钥就当场计算
+				//The segments already occupy the thread pool, so the rekey inside a segment is computed on the spot
+				SegmentWorker.RekeyThreadPoolPointer = nullptr;
+
+				if ( Mode == CryptionMode2MCAC4_FDW::MCA_ENCRYPTER )
+					SegmentWorker.SplitDataBlockToEncrypt( SegmentWordData, Word64Bit_MasterKey );
+				else
+					SegmentWorker.SplitDataBlockToDecrypt( SegmentWordData, Word64Bit_MasterKey );
+			}
+
+			CheckPointer = memory_set_no_optimize_function<0x00>( BlockMessage.data(), BlockMessage.size() );
+			CheckPointer = nullptr;
+			CheckPointer = memory_set_no_optimize_function<0x00>( BlockDigest.data(), BlockDigest.size() );
+			CheckPointer = nullptr;
+			CheckPointer = memory_set_no_optimize_function<0x00>( SaltMaterial.data(), SaltMaterial.size() );
+			CheckPointer = nullptr;
+			CheckPointer = memory_set_no_optimize_function<0x00>( SegmentSalt.data(), SegmentSalt.size() );
+			CheckPointer = nullptr;
+			CheckPointer = memory_set_no_optimize_function<0x00>( SegmentMaterial.data(), SegmentMaterial.size() );
+			CheckPointer = nullptr;
+			CheckPointer = memory_set_no_optimize_function<0x00>( SegmentSeeds.data(), SegmentSeeds.size() * sizeof( std::uint64_t ) );
+			CheckPointer = nullptr;
+		}
+
+		void OPC_SegmentedWorker::ProcessSegments( std::span<std::uint64_t> WordData, std::span<const std::uint64_t> Word64Bit_MasterKey, std::span<const std::uint8_t> MasterKeyBytes, std::size_t SegmentWordSize, std::uint64_t SegmentCount, CryptionMode2MCAC4_FDW Mode ) const
+		{
+			using CommonToolkit::WorkStealingThreadPool;
+
+			WorkStealingThreadPool&				 ThreadPool = WorkStealingThreadPool::Shared();
+			WorkStealingThreadPool::TaskGroup SegmentTasks;
+
+			for ( std::uint64_t SegmentIndex = 0; SegmentIndex < SegmentCount; ++SegmentIndex )
+			{
+				const std::size_t SegmentWordOffset = static_cast<std::size_t>( SegmentIndex ) * SegmentWordSize;
+				std::span<std::uint64_t> SegmentWordData = ( SegmentIndex + 1 == SegmentCount )
+					? WordData.subspan( SegmentWordOffset )
+					: WordData.subspan( SegmentWordOffset, SegmentWordSize );
+
+				ThreadPool.Submit
+				(
+					SegmentTasks,
+					[ this, SegmentWordData, Word64Bit_MasterKey, MasterKeyBytes, SegmentIndex, Mode ]()
+					{
+						this->ProcessSegment( SegmentWordData, Word64Bit_MasterKey, MasterKeyBytes, SegmentIndex, Mode );
+					}
+				);
+			}
+
+			ThreadPool.Wait( SegmentTasks );
+		}
+
+		std::vector<std::uint8_t> OPC_SegmentedWorker::EncrypterMain( const std::vector<std::uint8_t>& PlainText, const std::vector<std::uint8_t>& Keys )
+		{
+			using CommonToolkit::IntegerExchangeBytes::MessagePacking;
+			using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
+
+			volatile void* CheckPointer = nullptr;
+
+			//段数量按填充之前的长度计算，填充总是落在最后一段
+			//The segment count is computed from the length before padding, the padding always falls into the last segment
+			const std::uint64_t SegmentCount = PlainText.empty() ? 1 : ( PlainText.size() + SegmentByteSize - 1 ) / SegmentByteSize;
+
+			std::vector<std::uint8_t> CipherText( PlainText );
+			OPC_MainAlgorithm_Worker::PaddingData( CipherText, OPC_QuadWord_DataBlockSize );
+
+			auto Word64Bit_MasterKey = MessagePacking<std::uint64_t, std::uint8_t>( Keys.data(), Keys.size() );
+			auto Word64Bit_Data = MessagePacking<std::uint64_t, std::uint8_t>( CipherText.data(), CipherText.size() );
+
+			CheckPointer = memory_set_no_optimize_function<0x00>( CipherText.data(), CipherText.size() );
+			CheckPointer = nullptr;
+
+			this->ProcessSegments( Word64Bit_Data, Word64Bit_MasterKey, Keys, SegmentByteSize / sizeof( std::uint64_t ), SegmentCount, CryptionMode2MCAC4_FDW::MCA_ENCRYPTER );
+
+			CheckPointer = memory_set_no_optimize_function<0x00>( Word64Bit_MasterKey.data(), Word64Bit_MasterKey.size() * sizeof( std::uint64_t ) );
+			CheckPointer = nullptr;
+
+			const std::array<std::uint64_t, 3> HeaderWords { HeaderMagicNumber, SegmentByteSize, SegmentCount };
+			CipherText.resize( HeaderByteSize + Word64Bit_Data.size() * sizeof( std::uint64_t ) );
+			MessageUnpacking<std::uint64_t, std::uint8_t>( HeaderWords, CipherText.data() );
+			MessageUnpacking<std::uint64_t, std::uint8_t>( Word64Bit_Data, CipherText.data() + HeaderByteSize );
+
+			CheckPointer = memory_set_no_optimize_function<0x00>( Word64Bit_Data.data(), Word64Bit_Data.size() * sizeof( std::uint64_t ) );
+			CheckPointer = nullptr;
+
+			return CipherText;
+		}
+
+		std::vector<std::uint8_t> OPC_SegmentedWorker::DecrypterMain( const std::vector<std::uint8_t>& CipherText, const std::vector<std::uint8_t>& Keys )
+		{
+			using CommonToolkit::IntegerExchangeBytes::MessagePacking;
+			using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
+
+			volatile void* CheckPointer = nullptr;
+
+			const SegmentHeader Header = this->ReadSegmentHeader( CipherText );
+
+			auto Word64Bit_MasterKey = MessagePacking<std::uint64_t, std::uint8_t>( Keys.data(), Keys.size() );
+			auto Word64Bit_Data = MessagePacking<std::uint64_t, std::uint8_t>( CipherText.data() + HeaderByteSize, CipherText.size() - HeaderByteSize );
+
+			this->ProcessSegments( Word64Bit_Data, Word64Bit_MasterKey, Keys, Header.SegmentByteSize / sizeof( std::uint64_t ), Header.SegmentCount, CryptionMode2MCAC4_FDW::MCA_DECRYPTER );
+
+			CheckPointer = memory_set_no_optimize_function<0x00>( Word64Bit_MasterKey.data(), Word64Bit_MasterKey.size() * sizeof( std::uint64_t ) );
+			CheckPointer = nullptr;
+
+			std::vector<std::uint8_t> PlainText = MessageUnpacking<std::uint64_t, std::uint8_t>( Word64Bit_Data.data(), Word64Bit_Data.size() );
+
+			CheckPointer = memory_set_no_optimize_function<0x00>( Word64Bit_Data.data(), Word64Bit_Data.size() * sizeof( std::uint64_t ) );
+			CheckPointer = nullptr;
+
+			my_cpp2020_assert
+			(
+				PlainText.back() != 0 && PlainText.back() <= OPC_QuadWord_DataBlockSize * sizeof( std::uint64_t ),
+				"OPC_SegmentedWorker: The padding of the decrypted data is invalid, the key or the CipherText is wrong!",
+				std::source_location::current()
+			);
+			OPC_MainAlgorithm_Worker::UnpaddingData( PlainText );
+
+			return PlainText;
+		}
+
+		std::vector<std::uint8_t> OPC_SegmentedWorker::DecryptSegment( const std::vector<std::uint8_t>& CipherText, const std::vector<std::uint8_t>& Keys, std::uint64_t SegmentIndex )
+		{
+			using CommonToolkit::IntegerExchangeBytes::MessagePacking;
+			using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
+
+			volatile void* CheckPointer = nullptr;
+
+			const SegmentHeader Header = this->ReadSegmentHeader( CipherText );
+
+			my_cpp2020_assert( SegmentIndex < Header.SegmentCount, "OPC_SegmentedWorker: The SegmentIndex is out of range!", std::source_location::current() );
+
+			const auto [ SegmentByteOffset, SegmentByteLength ] = this->SegmentByteRange( Header, CipherText.size() - HeaderByteSize, SegmentIndex );
+
+			auto Word64Bit_MasterKey = MessagePacking<std::uint64_t, std::uint8_t>( Keys.data(), Keys.size() );
+			auto Word64Bit_Data = MessagePacking<std::uint64_t, std::uint8_t>( CipherText.data() + HeaderByteSize + SegmentByteOffset, SegmentByteLength );
+
+			this->ProcessSegment( Word64Bit_Data, Word64Bit_MasterKey, Keys, SegmentIndex, CryptionMode2MCAC4_FDW::MCA_DECRYPTER );
+
+			CheckPointer = memory_set_no_optimize_function<0x00>( Word64Bit_MasterKey.data(), Word64Bit_MasterKey.size() * sizeof( std::uint64_t ) );
+			CheckPointer = nullptr;
+
+			std::vector<std::uint8_t> PlainText = MessageUnpacking<std::uint64_t, std::uint8_t>( Word64Bit_Data.data(), Word64Bit_Data.size() );
+
+			CheckPointer = memory_set_no_optimize_function<0x00>( Word64Bit_Data.data(), Word64Bit_Data.size() * sizeof( std::uint64_t ) );
+			CheckPointer = nullptr;
+
+			if ( SegmentIndex + 1 == Header.SegmentCount )
+			{
+				my_cpp2020_assert
+				(
+					PlainText.back() != 0 && PlainText.back() <= OPC_QuadWord_DataBlockSize * sizeof( std::uint64_t ),
+					"OPC_SegmentedWorker: The padding of the decrypted data is invalid, the key or the CipherText is wrong!",
+					std::source_location::current()
+				);
+				OPC_MainAlgorithm_Worker::UnpaddingData( PlainText );
+			}
+
+			return PlainText;
+		}
+	}  // namespace SED::BlockCipher
+}  // namespace TwilightDreamOfMagical::CustomSecurity
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * 本文件是 Algorithm_OaldresPuzzleCryptic 的一部分。
+ *
+ * Algorithm_OaldresPuzzleCryptic 是自由软件：你可以再分发之和/或依照由自由软件基金会发布的 GNU 通用公共许可证修改之，无论是版本 3 许可证，还是（按你的决定）任何以后版都可以。
+ *
+ * 发布 Algorithm_OaldresPuzzleCryptic 是希望它能有用，但是并无保障;甚至连可销售和符合某个特定的目的都不保证。请参看 GNU 通用公共许可证，了解详情。
+ * 你应该随程序获得一份 GNU 通用公共许可证的复本。如果没有，请看 <https://www.gnu.org/licenses/>。
+ */
+
+ /*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * This file is part of Algorithm_OaldresPuzzleCryptic.
+ *
+ * Algorithm_OaldresPuzzleCryptic is free software: you may redistribute it and/or modify it under the GNU General Public License as published by the Free Software Foundation, either under the Version 3 license, or (at your discretion) any later version.
+ *
+ * TDOM-EncryptOrDecryptFile-Reborn is released in the hope that it will be useful, but there are no guarantees; not even that it will be marketable and fit a particular purpose. Please see the GNU General Public License for details.
+ * You should get a copy of the GNU General Public License with your program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALGORITHM_OALDRESPUZZLECRYPTIC_OPC_STAGEPROFILER_HPP
+#define ALGORITHM_OALDRESPUZZLECRYPTIC_OPC_STAGEPROFILER_HPP
+
+#include "../SupportBaseFunctions.hpp"
+#include "../ProcessorFeatureDetection.hpp"
+
+/*
+	OaldresPuzzle-Cryptic 各阶段的性能计数器 (可选)
+	每个阶段累计: 时钟周期、调用次数、处理的字节数。
+	定义 TDOM_OPC_STAGE_PROFILING 才会开启；没有定义时计时点全部展开为空，快照读出来全是 0 并且 Enabled 为 false。
+	计数器属于每个 CommonStateData (也就是每个上下文)，不是线程安全的，和上下文本身一样只能在一个线程里使用。
+
+	Performance counters for each stage of OaldresPuzzle-Cryptic (optional)
+	Every stage accumulates: clock cycles, call count and bytes processed.
+	Only enabled when TDOM_OPC_STAGE_PROFILING is defined; otherwise every timing point expands to nothing, and the snapshot reads all zeros with Enabled set to false.
+	The counters belong to each CommonStateData (that is, each context) and are not thread safe; like the context itself they may only be used from one thread.
+*/
+
+// 开关：需要统计各阶段耗时就开；不想要就注释掉 (也可以在编译选项里定义)。
+// #define TDOM_OPC_STAGE_PROFILING 1
+
+#if defined( TDOM_OPC_STAGE_PROFILING ) && !defined( TDOM_PROCESSOR_X86 )
+#include <chrono>
+#endif
+
+namespace TwilightDreamOfMagical::CustomSecurity
+{
+	//SymmetricEncryptionDecryption
+	namespace SED::BlockCipher
+	{
+		//被统计的阶段，互相之间不重叠
+		//The profiled stages, which never overlap each other
+		enum class OPC_ProfileStage : std::uint8_t
+		{
+			//Module_SecureSubkeyGeneratation::GenerationSubkeys
+			GenerationSubkeys,
+			//Module_SecureRoundSubkeyGeneratation::GenerationRoundSubkeys (包括 OPC_MatrixTransformation 和扩散层)
+			//Module_SecureRoundSubkeyGeneratation::GenerationRoundSubkeys (including OPC_MatrixTransformation and the diffusion layer)
+			GenerationRoundSubkeys,
+			//轮函数里的 Lai-Massey 结构，每一遍处理整个数据块一次
+			//The Lai-Massey structure inside the round function, every pass processes the whole data block once
+			LaiMasseyFramework,
+			//轮函数里的字节置换
+			//The byte substitution inside the round function
+			ByteSubstitution,
+			//密钥调度里 16 轮的比特扩散和字节混淆 (每一轮算一次调用)
+			//The 16 rounds of bit diffusion and byte confusion inside the key schedule (every round counts as one call)
+			KeyWhitening,
+			//周期性的 Scrypt 重新派生密钥 (包括等待后台预先计算的时间)
+			//The periodic Scrypt rekey (including the time spent waiting for the background precomputation)
+			ScryptRekey,
+			Count
+		};
+
+		inline constexpr std::size_t OPC_ProfileStageCount = static_cast<std::size_t>( OPC_ProfileStage::Count );
+
+		struct OPC_StageCounters
+		{
+			//x86 上是时间戳计数器的周期数，其他平台是 steady_clock 的纳秒数
+			//Timestamp counter cycles on x86, steady_clock nanoseconds on other platforms
+			std::uint64_t Cycles = 0;
+			std::uint64_t Calls = 0;
+			std::uint64_t Bytes = 0;
+		};
+
+		//某一时刻的计数器快照，按 OPC_ProfileStage 的顺序排列
+		//A snapshot of the counters at one moment, ordered by OPC_ProfileStage
+		struct OPC_StageProfile
+		{
+			bool Enabled = false;
+			std::array<OPC_StageCounters, OPC_ProfileStageCount> Stages {};
+
+			const OPC_StageCounters& operator[]( OPC_ProfileStage Stage ) const
+			{
+				return Stages[ static_cast<std::size_t>( Stage ) ];
+			}
+		};
+
+		class OPC_StageProfiler
+		{
+
+		public:
+			static constexpr bool IsEnabled()
+			{
+				#if defined( TDOM_OPC_STAGE_PROFILING )
+				return true;
+				#else
+				return false;
+				#endif
+			}
+
+			static std::uint64_t ReadTimestamp()
+			{
+				#if defined( TDOM_PROCESSOR_X86 )
+				return static_cast<std::uint64_t>( __rdtsc() );
+				#elif defined( TDOM_OPC_STAGE_PROFILING )
+				return static_cast<std::uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+				#else
+				return 0;
+				#endif
+			}
+
+			void Record( OPC_ProfileStage Stage, std::uint64_t Cycles, std::uint64_t Calls, std::uint64_t Bytes )
+			{
+				OPC_StageCounters& Counters = Profile.Stages[ static_cast<std::size_t>( Stage ) ];
+				Counters.Cycles += Cycles;
+				Counters.Calls += Calls;
+				Counters.Bytes += Bytes;
+			}
+
+			OPC_StageProfile Snapshot() const
+			{
+				OPC_StageProfile Result = Profile;
+				Result.Enabled = IsEnabled();
+				return Result;
+			}
+
+			void Reset()
+			{
+				Profile = OPC_StageProfile {};
+			}
+
+		private:
+			OPC_StageProfile Profile {};
+		};
+
+		//作用域计时: 构造时读时间戳，析构时把经过的周期累加到对应阶段
+		//Scoped timing: reads the timestamp on construction and adds the elapsed cycles to the stage on destruction
+		class OPC_StageScope
+		{
+
+		public:
+			OPC_StageScope( OPC_StageProfiler& Profiler, OPC_ProfileStage Stage, std::uint64_t Bytes, std::uint64_t Calls = 1 )
+				:
+				ProfilerPointer( std::addressof( Profiler ) ), Stage( Stage ), Bytes( Bytes ), Calls( Calls ), StartTimestamp( OPC_StageProfiler::ReadTimestamp() )
+			{
+
+			}
+
+			OPC_StageScope( const OPC_StageScope& ) = delete;
+			OPC_StageScope& operator=( const OPC_StageScope& ) = delete;
+
+			~OPC_StageScope()
+			{
+				ProfilerPointer->Record( Stage, OPC_StageProfiler::ReadTimestamp() - StartTimestamp, Calls, Bytes );
+			}
+
+		private:
+			OPC_StageProfiler* ProfilerPointer = nullptr;
+			OPC_ProfileStage   Stage;
+			std::uint64_t	   Bytes = 0;
+			std::uint64_t	   Calls = 0;
+			std::uint64_t	   StartTimestamp = 0;
+		};
+	}  // namespace SED::BlockCipher
+}  // namespace TwilightDreamOfMagical::CustomSecurity
+
+#define TDOM_OPC_PROFILE_CONCATENATE_IMPLEMENTATION( Left, Right ) Left##Right
+#define TDOM_OPC_PROFILE_CONCATENATE( Left, Right ) TDOM_OPC_PROFILE_CONCATENATE_IMPLEMENTATION( Left, Right )
+
+/*
+	在当前作用域结束前统计一个阶段: TDOM_OPC_PROFILE_STAGE( Profiler, Stage, Bytes [, Calls] )
+	关闭时展开为空语句，参数不会被求值
+	Profile one stage until the end of the current scope: TDOM_OPC_PROFILE_STAGE( Profiler, Stage, Bytes [, Calls] )
+	Expands to an empty statement when disabled, and the arguments are not evaluated
+*/
+#if defined( TDOM_OPC_STAGE_PROFILING )
+#define TDOM_OPC_PROFILE_STAGE( Profiler, Stage, ... ) \
+	::TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_StageScope TDOM_OPC_PROFILE_CONCATENATE( OPC_StageScope_, __LINE__ )( Profiler, ::TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_ProfileStage::Stage, __VA_ARGS__ )
+#else
+#define TDOM_OPC_PROFILE_STAGE( Profiler, Stage, ... ) static_cast<void>( 0 )
+#endif
+
+#endif	//ALGORITHM_OALDRESPUZZLECRYPTIC_OPC_STAGEPROFILER_HPP
@@ -98,6 +98,23 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			return WordData;
 		}
 
+		void OaldresPuzzle_Cryptic::LaiMasseyFrameworkBatch
+		(
+			std::span<std::uint64_t> WordDatas,
+			std::span<const std::uint64_t> WordKeyMaterials,
+			TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode,
+			ImplementationDetails::LaiMasseyBatchKernel::KernelKind Kernel
+		)
+		{
+			const std::size_t BatchedWordCount = ImplementationDetails::LaiMasseyBatchKernel::ApplyLaiMasseyFramework
+			(
+				WordDatas, WordKeyMaterials, SecureRoundSubkeyGeneratationModuleObject.UseAssociatedWordTables(), ThisExecuteMode, Kernel
+			);
+
+			for ( std::size_t Index = BatchedWordCount; Index < WordDatas.size(); ++Index )
+				WordDatas[ Index ] = this->LaiMasseyFramework( WordDatas[ Index ], WordKeyMaterials[ Index ], ThisExecuteMode );
+		}
+
 		void OaldresPuzzle_Cryptic::ByteSubstitution( std::span<std::uint8_t> EachRoundDatas, TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode )
 		{
 			using TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW;
@@ -105,43 +122,45 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			if ( ( EachRoundDatas.size() & 7 ) != 0 )
 				return;
 
+			using ImplementationDetails::ByteSubstitutionKernel::SubstitutionLayer;
+
 			/*
 				字节数据置换层
 				Byte Data Substitution Layer
+
+				每 8 个字节使用固定的置换盒排列 (加密与解密互逆)
+				Every 8 bytes use a fixed arrangement of substitution boxes (encryption and decryption are inverses of each other)
+
+				Encrypter: FSB1, FSB0, BSB1, BSB0, FSB0, BSB1, FSB0, BSB1
+				Decrypter: BSB1, BSB0, FSB1, FSB0, BSB0, FSB1, BSB0, FSB1
 			*/
 			switch ( ThisExecuteMode )
 			{
 				case CryptionMode2MCAC4_FDW::MCA_ENCRYPTER:
 				{
-					for ( std::uint64_t Index = 0; Index < EachRoundDatas.size(); Index += 8 )
-					{
-						EachRoundDatas[ Index ] = ForwardSubstitutionBox1[ EachRoundDatas[ Index ] ];
-						EachRoundDatas[ Index + 1 ] = ForwardSubstitutionBox0[ EachRoundDatas[ Index + 1 ] ];
-						EachRoundDatas[ Index + 2 ] = BackwardSubstitutionBox1[ EachRoundDatas[ Index + 2 ] ];
-						EachRoundDatas[ Index + 3 ] = BackwardSubstitutionBox0[ EachRoundDatas[ Index + 3 ] ];
-
-						EachRoundDatas[ Index + 4 ] = ForwardSubstitutionBox0[ EachRoundDatas[ Index + 4 ] ];
-						EachRoundDatas[ Index + 5 ] = BackwardSubstitutionBox1[ EachRoundDatas[ Index + 5 ] ];
-						EachRoundDatas[ Index + 6 ] = ForwardSubstitutionBox0[ EachRoundDatas[ Index + 6 ] ];
-						EachRoundDatas[ Index + 7 ] = BackwardSubstitutionBox1[ EachRoundDatas[ Index + 7 ] ];
-					}
+					static const SubstitutionLayer EncryptionLayer
+					(
+						{
+							&ForwardSubstitutionBox1, &ForwardSubstitutionBox0, &BackwardSubstitutionBox1, &BackwardSubstitutionBox0,
+							&ForwardSubstitutionBox0, &BackwardSubstitutionBox1, &ForwardSubstitutionBox0, &BackwardSubstitutionBox1
+						}
+					);
+
+					EncryptionLayer.Substitute( EachRoundDatas );
 
 					break;
 				}
 				case CryptionMode2MCAC4_FDW::MCA_DECRYPTER:
 				{
-					for ( std::uint64_t Index = 0; Index < EachRoundDatas.size(); Index += 8 )
-					{
-						EachRoundDatas[ Index ] = BackwardSubstitutionBox1[ EachRoundDatas[ Index ] ];
-						EachRoundDatas[ Index + 1 ] = BackwardSubstitutionBox0[ EachRoundDatas[ Index + 1 ] ];
-						EachRoundDatas[ Index + 2 ] = ForwardSubstitutionBox1[ EachRoundDatas[ Index + 2 ] ];
-						EachRoundDatas[ Index + 3 ] = ForwardSubstitutionBox0[ EachRoundDatas[ Index + 3 ] ];
-
-						EachRoundDatas[ Index + 4 ] = BackwardSubstitutionBox0[ EachRoundDatas[ Index + 4 ] ];
-						EachRoundDatas[ Index + 5 ] = ForwardSubstitutionBox1[ EachRoundDatas[ Index + 5 ] ];
-						EachRoundDatas[ Index + 6 ] = BackwardSubstitutionBox0[ EachRoundDatas[ Index + 6 ] ];
-						EachRoundDatas[ Index + 7 ] = ForwardSubstitutionBox1[ EachRoundDatas[ Index + 7 ] ];
-					}
+					static const SubstitutionLayer DecryptionLayer
+					(
+						{
+							&BackwardSubstitutionBox1, &BackwardSubstitutionBox0, &ForwardSubstitutionBox1, &ForwardSubstitutionBox0,
+							&BackwardSubstitutionBox0, &ForwardSubstitutionBox1, &BackwardSubstitutionBox0, &ForwardSubstitutionBox1
+						}
+					);
+
+					DecryptionLayer.Substitute( EachRoundDatas );
 
 					break;
 				}
@@ -151,15 +170,48 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			}
 		}
 
-		void OaldresPuzzle_Cryptic::RoundFunction( std::span<std::uint64_t> EachRoundDatas, TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode )
+		void OaldresPuzzle_Cryptic::QuadWordByteSubstitution( std::span<std::uint64_t> EachRoundDatas, TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode )
 		{
 			using CommonToolkit::IntegerExchangeBytes::MessagePacking;
 			using CommonToolkit::IntegerExchangeBytes::MessageUnpacking;
+
+			if constexpr ( std::endian::native == std::endian::little )
+			{
+				//小端机器上 QuadWord 的内存布局就是 MessageUnpacking 的字节顺序，所以直接通过字节视图原地置换
+				//On little-endian machines the QuadWord memory layout is exactly the MessageUnpacking byte order, so substitute in place through a byte view
+				std::span<std::uint8_t> BytesView( reinterpret_cast<std::uint8_t*>( EachRoundDatas.data() ), EachRoundDatas.size_bytes() );
+
+				this->ByteSubstitution( BytesView, ThisExecuteMode );
+			}
+			else
+			{
+				std::span<std::uint8_t> BytesData = StateDataPointer->UseScratchBytes( EachRoundDatas.size_bytes() );
+
+				MessageUnpacking<std::uint64_t, std::uint8_t>( EachRoundDatas, BytesData.data() );
+
+				this->ByteSubstitution( BytesData, ThisExecuteMode );
+
+				MessagePacking<std::uint64_t, std::uint8_t>( BytesData, EachRoundDatas.data() );
+			}
+		}
+
+		void OaldresPuzzle_Cryptic::RoundFunction( std::span<std::uint64_t> EachRoundDatas, TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode )
+		{
 			using TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW;
 
 			if ( EachRoundDatas.size() != StateDataPointer->OPC_QuadWord_DataBlockSize )
 				return;
 
+			using ImplementationDetails::CommonStateData;
+
+			if ( StateDataPointer->IsFixedConfiguration() )
+			{
+				constexpr std::size_t FixedDataBlockSize = CommonStateData::FixedConfiguration_DataBlockSize;
+
+				this->RoundFunctionFixed<FixedDataBlockSize, CommonStateData::FixedConfiguration_KeyBlockSize>( std::span<std::uint64_t, FixedDataBlockSize>( EachRoundDatas.data(), FixedDataBlockSize ), ThisExecuteMode );
+				return;
+			}
+
 			/*
 				每轮数据的数据变换函数
 				Data transformation function for each round data
@@ -170,8 +222,6 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				{
 					auto& GeneratedRoundSubkeyVector = this->SecureRoundSubkeyGeneratationModuleObject.UseRoundSubkeyVectorReference();
 
-					std::vector<std::uint8_t> BytesData( EachRoundDatas.size() * sizeof( std::uint64_t ), 0 );
-
 					std::size_t KeyIndex = 0;
 
 					//生成用于轮函数的子密钥(不是原来子密钥！)
@@ -187,13 +237,13 @@ namespace TwilightDreamOfMagical::CustomSecurity
 						//K[0] --> K[N]
 						//正向应用RoundIndex (Index, KeyIndex) 和加密函数
 						//Forward apply RoundIndex (Index, KeyIndex) and the encryption function
-						for ( std::uint64_t Index = 0; Index < EachRoundDatas.size(); Index++ )
+						//同一遍里的字互相独立，第 Index 个字使用 K[KeyIndex + Index]，所以整块交给批量内核
+						//Words within one pass are independent and word Index uses K[KeyIndex + Index], so the whole block goes to the batched kernel
 						{
-							EachRoundDatas[ Index ] = this->LaiMasseyFramework( EachRoundDatas[ Index ], GeneratedRoundSubkeyVector[ KeyIndex ], ThisExecuteMode );
-
-							if ( KeyIndex < GeneratedRoundSubkeyVector.size() )
-								++KeyIndex;
+							TDOM_OPC_PROFILE_STAGE( StateDataPointer->StageProfiler, LaiMasseyFramework, EachRoundDatas.size_bytes() );
+							this->LaiMasseyFrameworkBatch( EachRoundDatas, std::span<const std::uint64_t>( GeneratedRoundSubkeyVector.data() + KeyIndex, EachRoundDatas.size() ), ThisExecuteMode );
 						}
+						KeyIndex += EachRoundDatas.size();
 
 						if ( KeyIndex < GeneratedRoundSubkeyVector.size() )
 						{
@@ -207,11 +257,10 @@ namespace TwilightDreamOfMagical::CustomSecurity
 						//非线性字节数据代换(编码函数)
 						//Nonlinear byte data substitution (encoding function)
 
-						MessageUnpacking<std::uint64_t, std::uint8_t>( EachRoundDatas, BytesData.data() );
-
-						this->ByteSubstitution( BytesData, ThisExecuteMode );
-
-						MessagePacking<std::uint64_t, std::uint8_t>( BytesData, EachRoundDatas.data() );
+						{
+							TDOM_OPC_PROFILE_STAGE( StateDataPointer->StageProfiler, ByteSubstitution, EachRoundDatas.size_bytes() );
+							this->QuadWordByteSubstitution( EachRoundDatas, ThisExecuteMode );
+						}
 
 						//向右循环移动元素
 						//Circularly move elements to the right
@@ -220,24 +269,12 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 					KeyIndex = 0;
 
-					volatile void* CheckPointer = nullptr;
-
-					CheckPointer = memory_set_no_optimize_function<0x00>( BytesData.data(), BytesData.size() );
-					if ( CheckPointer != BytesData.data() )
-					{
-						std::cout << "Force Memory Fill Has Been \"Optimization\" !" << std::endl;
-						throw std::runtime_error( "" );
-					}
-					CheckPointer = nullptr;
-
 					break;
 				}
 				case CryptionMode2MCAC4_FDW::MCA_DECRYPTER:
 				{
 					auto& GeneratedRoundSubkeyVector = this->SecureRoundSubkeyGeneratationModuleObject.UseRoundSubkeyVectorReference();
 
-					std::vector<std::uint8_t> BytesData( EachRoundDatas.size() * sizeof( std::uint64_t ), 0 );
-
 					std::size_t KeyIndex = GeneratedRoundSubkeyVector.size();
 
 					//生成用于轮函数的子密钥(不是原来子密钥！)
@@ -254,11 +291,10 @@ namespace TwilightDreamOfMagical::CustomSecurity
 						//非线性字节数据代换(解码函数)
 						//Nonlinear byte data substitution (decoding function)
 
-						MessageUnpacking<std::uint64_t, std::uint8_t>( EachRoundDatas, BytesData.data() );
-
-						this->ByteSubstitution( BytesData, ThisExecuteMode );
-
-						MessagePacking<std::uint64_t, std::uint8_t>( BytesData, EachRoundDatas.data() );
+						{
+							TDOM_OPC_PROFILE_STAGE( StateDataPointer->StageProfiler, ByteSubstitution, EachRoundDatas.size_bytes() );
+							this->QuadWordByteSubstitution( EachRoundDatas, ThisExecuteMode );
+						}
 
 					DoDecryptionDataBlock:
 
@@ -266,15 +302,15 @@ namespace TwilightDreamOfMagical::CustomSecurity
 						//K[N] --> K[0]
 						//反向应用RoundIndex (Index, KeyIndex) 和解密函数
 						//Backward apply RoundIndex (Index, KeyIndex) and the decryption function
-						for ( std::uint64_t Index = EachRoundDatas.size(); Index > 0; Index-- )
+						//同一遍里的字互相独立，第 Index 个字使用 K[KeyIndex - Size + Index]，所以整块交给批量内核
+						//Words within one pass are independent and word Index uses K[KeyIndex - Size + Index], so the whole block goes to the batched kernel
+						KeyIndex -= EachRoundDatas.size();
 						{
-							EachRoundDatas[ Index - 1 ] = this->LaiMasseyFramework( EachRoundDatas[ Index - 1 ], GeneratedRoundSubkeyVector[ KeyIndex - 1 ], ThisExecuteMode );
-
-							if ( KeyIndex - 1 > 0 )
-								--KeyIndex;
+							TDOM_OPC_PROFILE_STAGE( StateDataPointer->StageProfiler, LaiMasseyFramework, EachRoundDatas.size_bytes() );
+							this->LaiMasseyFrameworkBatch( EachRoundDatas, std::span<const std::uint64_t>( GeneratedRoundSubkeyVector.data() + KeyIndex, EachRoundDatas.size() ), ThisExecuteMode );
 						}
 
-						if ( KeyIndex - 1 > 0 )
+						if ( KeyIndex > 0 )
 						{
 							goto DoDecryptionDataBlock;
 						}
@@ -286,16 +322,69 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 					KeyIndex = 0;
 
-					volatile void* CheckPointer = nullptr;
+					break;
+				}
+
+				default:
+					my_cpp2020_assert( false, "Invalid cipher base work mode !", std::source_location::current() );
+			}
+		}
+
+		template <std::size_t DataBlockSize, std::size_t KeyBlockSize>
+		void OaldresPuzzle_Cryptic::RoundFunctionFixed( std::span<std::uint64_t, DataBlockSize> EachRoundDatas, TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode )
+		{
+			using TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW;
+
+			//轮子密钥向量来自 (KeyBlockSize * 2) x (KeyBlockSize * 2) 的轮子密钥矩阵
+			//The round subkey vector comes from the (KeyBlockSize * 2) x (KeyBlockSize * 2) round subkey matrix
+			constexpr std::size_t RoundSubkeyCount = ( KeyBlockSize * 2 ) * ( KeyBlockSize * 2 );
+			constexpr std::size_t PassCount = RoundSubkeyCount / DataBlockSize;
+
+			SecureRoundSubkeyGeneratationModuleObject.GenerationRoundSubkeys();
+
+			const std::span<const std::uint64_t, RoundSubkeyCount> RoundSubkeys( this->SecureRoundSubkeyGeneratationModuleObject.UseRoundSubkeyVectorReference().data(), RoundSubkeyCount );
+			const auto Tables = this->SecureRoundSubkeyGeneratationModuleObject.UseAssociatedWordTables();
+
+			//一整轮: 按顺序 (解密时倒序) 用每一段子密钥处理整个数据块，没有 SIMD 内核时逐段交给批量函数
+			//One whole round: process the whole block with every subkey segment in order (reverse order for decryption); without a SIMD kernel each segment goes to the batch function
+			auto ApplyRoundPasses = [ this, &EachRoundDatas, &RoundSubkeys, &Tables, ThisExecuteMode ]()
+			{
+				TDOM_OPC_PROFILE_STAGE( StateDataPointer->StageProfiler, LaiMasseyFramework, EachRoundDatas.size_bytes() * PassCount, PassCount );
+
+				if ( ImplementationDetails::LaiMasseyBatchKernel::ApplyLaiMasseyFrameworkPasses<DataBlockSize, RoundSubkeyCount>( EachRoundDatas, RoundSubkeys, Tables, ThisExecuteMode ) )
+					return;
+
+				for ( std::size_t Pass = 0; Pass < PassCount; ++Pass )
+				{
+					const std::size_t Segment = ThisExecuteMode == CryptionMode2MCAC4_FDW::MCA_ENCRYPTER ? Pass : PassCount - 1 - Pass;
+					this->LaiMasseyFrameworkBatch( EachRoundDatas, RoundSubkeys.subspan( Segment * DataBlockSize, DataBlockSize ), ThisExecuteMode );
+				}
+			};
 
-					CheckPointer = memory_set_no_optimize_function<0x00>( BytesData.data(), BytesData.size() );
-					if ( CheckPointer != BytesData.data() )
+			switch ( ThisExecuteMode )
+			{
+				case CryptionMode2MCAC4_FDW::MCA_ENCRYPTER:
+				{
+					for ( std::size_t RoundCounter = 0; RoundCounter < 16; ++RoundCounter )
+					{
+						ApplyRoundPasses();
+						{
+							TDOM_OPC_PROFILE_STAGE( StateDataPointer->StageProfiler, ByteSubstitution, EachRoundDatas.size_bytes() );
+							this->QuadWordByteSubstitution( EachRoundDatas, ThisExecuteMode );
+						}
+					}
+					break;
+				}
+				case CryptionMode2MCAC4_FDW::MCA_DECRYPTER:
+				{
+					for ( std::size_t RoundCounter = 0; RoundCounter < 16; ++RoundCounter )
 					{
-						std::cout << "Force Memory Fill Has Been \"Optimization\" !" << std::endl;
-						throw std::runtime_error( "" );
+						{
+							TDOM_OPC_PROFILE_STAGE( StateDataPointer->StageProfiler, ByteSubstitution, EachRoundDatas.size_bytes() );
+							this->QuadWordByteSubstitution( EachRoundDatas, ThisExecuteMode );
+						}
+						ApplyRoundPasses();
 					}
-					CheckPointer = nullptr;
-
 					break;
 				}
 
@@ -25,6 +25,7 @@
 
 #include "Module_SecureSubkeyGeneratation.hpp"
 #include "Module_SecureRoundSubkeyGeneratation.hpp"
+#include "ByteSubstitutionKernel.hpp"
 
 namespace TwilightDreamOfMagical::CustomSecurity
 {
@@ -35,6 +36,7 @@ namespace TwilightDreamOfMagical::CustomSecurity
 		{
 
 			friend class OPC_MainAlgorithm_Worker;
+			friend class OPC_BenchmarkProbe;
 
 		public:
 
@@ -82,9 +84,108 @@ namespace TwilightDreamOfMagical::CustomSecurity
 					std::cout << "Self sanity check error: Data does not match (F-functions), LaiMasseyFramework function is incorrect!" << std::endl;
 				}
 
+				//批量内核必须与逐字参考实现逐位相同
+				//The batched kernel must be bit-identical to the word-by-word reference implementation
+				std::array<std::uint64_t, 19> ReferenceWords {};
+				std::array<std::uint64_t, 19> ReferenceKeys {};
+				std::ranges::generate(ReferenceWords, PRNG);
+				std::ranges::generate(ReferenceKeys, PRNG);
+				for(auto ExecuteMode : { CryptionMode2MCAC4_FDW::MCA_ENCRYPTER, CryptionMode2MCAC4_FDW::MCA_DECRYPTER })
+				{
+					std::array<std::uint64_t, 19> BatchedWords = ReferenceWords;
+					this->LaiMasseyFrameworkBatch(BatchedWords, ReferenceKeys, ExecuteMode);
+
+					for(std::size_t Index = 0; Index < ReferenceWords.size(); ++Index)
+						ReferenceWords[Index] = this->LaiMasseyFramework(ReferenceWords[Index], ReferenceKeys[Index], ExecuteMode);
+
+					if(BatchedWords != ReferenceWords)
+					{
+						std::cout << "Self sanity check error: Data does not match (batched kernel), LaiMasseyFrameworkBatch function is incorrect!" << std::endl;
+					}
+				}
+
 				std::cout << "Self sanity check passed !" << std::endl;
 			}
 
+			/*
+				算法状态快照 (CommonStateData 加上子密钥模块和轮子密钥模块的状态)，保存在一段扁平的字节里
+				用来在加密之后恢复到加密之前的状态，代替销毁并重建 CommonStateData、OaldresPuzzle_Cryptic 和 OPC_MainAlgorithm_Worker
+
+				Algorithm state snapshot (CommonStateData plus the state of the subkey module and the round subkey module), held in one flat byte buffer
+				Used to return to the state before encryption after encrypting, instead of destroying and rebuilding CommonStateData, OaldresPuzzle_Cryptic and OPC_MainAlgorithm_Worker
+			*/
+			class StateSnapshot
+			{
+				friend class OaldresPuzzle_Cryptic;
+
+			public:
+				StateSnapshot() = default;
+				StateSnapshot(const StateSnapshot&) = default;
+				StateSnapshot(StateSnapshot&&) = default;
+				StateSnapshot& operator=(const StateSnapshot&) = default;
+				StateSnapshot& operator=(StateSnapshot&&) = default;
+
+				~StateSnapshot()
+				{
+					volatile void* CheckPointer = memory_set_no_optimize_function<0x00>(SnapshotBytes.data(), SnapshotBytes.size());
+					CheckPointer = nullptr;
+				}
+
+			private:
+				std::vector<std::uint8_t> SnapshotBytes;
+			};
+
+			StateSnapshot TakeSnapshot() const
+			{
+				StateSnapshot Snapshot;
+				this->SaveSnapshot(Snapshot);
+				return Snapshot;
+			}
+
+			//快照的总字节数 (CommonStateData、子密钥模块、轮子密钥模块)
+			//Total byte size of a snapshot (CommonStateData, the subkey module and the round subkey module)
+			std::size_t SnapshotByteSize() const
+			{
+				return StateDataPointer->SnapshotByteSize() + SecureSubkeyGeneratationModuleObject.SnapshotByteSize() + SecureRoundSubkeyGeneratationModuleObject.SnapshotByteSize();
+			}
+
+			//保存到调用者提供的存储里 (例如 OPC_KeySetupCache 条目的安全内存区)
+			//Saves into storage provided by the caller (for example the secure arena of an OPC_KeySetupCache entry)
+			void SaveSnapshot(std::span<std::uint8_t> SnapshotBytes) const
+			{
+				const std::size_t StateDataByteSize = StateDataPointer->SnapshotByteSize();
+				const std::size_t SubkeyModuleByteSize = SecureSubkeyGeneratationModuleObject.SnapshotByteSize();
+				my_cpp2020_assert(SnapshotBytes.size() == this->SnapshotByteSize(), "OaldresPuzzle_Cryptic: The snapshot storage does not match the block sizes of this algorithm!", std::source_location::current());
+
+				StateDataPointer->SaveSnapshot(SnapshotBytes.first(StateDataByteSize));
+				SecureSubkeyGeneratationModuleObject.SaveSnapshot(SnapshotBytes.subspan(StateDataByteSize, SubkeyModuleByteSize));
+				SecureRoundSubkeyGeneratationModuleObject.SaveSnapshot(SnapshotBytes.subspan(StateDataByteSize + SubkeyModuleByteSize));
+			}
+
+			void RestoreSnapshot(std::span<const std::uint8_t> SnapshotBytes)
+			{
+				const std::size_t StateDataByteSize = StateDataPointer->SnapshotByteSize();
+				const std::size_t SubkeyModuleByteSize = SecureSubkeyGeneratationModuleObject.SnapshotByteSize();
+				my_cpp2020_assert(SnapshotBytes.size() == this->SnapshotByteSize(), "OaldresPuzzle_Cryptic: The snapshot was not taken from an algorithm with the same block sizes!", std::source_location::current());
+
+				StateDataPointer->RestoreSnapshot(SnapshotBytes.first(StateDataByteSize));
+				SecureSubkeyGeneratationModuleObject.RestoreSnapshot(SnapshotBytes.subspan(StateDataByteSize, SubkeyModuleByteSize));
+				SecureRoundSubkeyGeneratationModuleObject.RestoreSnapshot(SnapshotBytes.subspan(StateDataByteSize + SubkeyModuleByteSize));
+			}
+
+			//第一次调用时分配快照的存储，之后重复使用
+			//The snapshot storage is allocated on the first call and reused afterwards
+			void SaveSnapshot(StateSnapshot& Snapshot) const
+			{
+				Snapshot.SnapshotBytes.resize(this->SnapshotByteSize());
+				this->SaveSnapshot(std::span<std::uint8_t>(Snapshot.SnapshotBytes));
+			}
+
+			void RestoreSnapshot(const StateSnapshot& Snapshot)
+			{
+				this->RestoreSnapshot(std::span<const std::uint8_t>(Snapshot.SnapshotBytes));
+			}
+
 		private:
 
 			ImplementationDetails::CommonStateData* StateDataPointer = nullptr;
@@ -273,12 +374,36 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode
 			);
 
+			/*
+				对一组互相独立的字应用 LaiMasseyFramework，WordDatas[ Index ] 使用 WordKeyMaterials[ Index ]。
+				能凑满 SIMD 宽度的部分走批量内核 (一次 4 或 8 个字)，剩下的字逐个调用 LaiMasseyFramework (参考实现)。
+				Apply LaiMasseyFramework to a group of independent words, WordDatas[ Index ] uses WordKeyMaterials[ Index ].
+				The part that fills whole SIMD vectors goes through the batched kernel (4 or 8 words at a time), and the remaining words call LaiMasseyFramework (the reference implementation) one by one.
+			*/
+			void LaiMasseyFrameworkBatch
+			(
+				std::span<std::uint64_t> WordDatas,
+				std::span<const std::uint64_t> WordKeyMaterials,
+				TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode,
+				ImplementationDetails::LaiMasseyBatchKernel::KernelKind Kernel = ImplementationDetails::LaiMasseyBatchKernel::SelectKernel()
+			);
+
 			void ByteSubstitution
 			(
 				std::span<std::uint8_t> EachRoundDatas,
 				TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode
 			);
 
+			/*
+				对 QuadWord 的小端字节序列做字节置换，不分配内存
+				Byte substitution on the little-endian byte sequence of the QuadWords, without allocating memory
+			*/
+			void QuadWordByteSubstitution
+			(
+				std::span<std::uint64_t> EachRoundDatas,
+				TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode
+			);
+
 			//每一轮过程的函数
 			//The function of each round process
 			void RoundFunction
@@ -286,6 +411,19 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				std::span<std::uint64_t> EachRoundDatas,
 				TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode
 			);
+
+			/*
+				常用配置的轮函数: 数据块和轮子密钥的大小在编译期固定，没有运行时的大小检查，数据块在一整轮的所有子密钥段之间一直留在寄存器里。
+				RoundFunction 在运行时的大小与固定配置相同时分派到这里，结果逐位相同。
+				Round function of the common configuration: the sizes of the data block and the round subkeys are fixed at compile time, there are no runtime size checks, and the data block stays in registers across all subkey segments of a round.
+				RoundFunction dispatches here when the runtime sizes match the fixed configuration, and the result is bit-identical.
+			*/
+			template <std::size_t DataBlockSize, std::size_t KeyBlockSize>
+			void RoundFunctionFixed
+			(
+				std::span<std::uint64_t, DataBlockSize> EachRoundDatas,
+				TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW ThisExecuteMode
+			);
 		};
 	}
 }
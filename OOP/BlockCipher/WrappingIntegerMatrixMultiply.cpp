@@ -0,0 +1,358 @@
+#include "WrappingIntegerMatrixMultiply.hpp"
+
+namespace TwilightDreamOfMagical::CustomSecurity
+{
+	//SymmetricEncryptionDecryption
+	namespace SED::BlockCipher
+	{
+		namespace ImplementationDetails::WrappingIntegerMatrixMultiply
+		{
+			namespace
+			{
+				/*
+					缓存分块大小 (以元素计)
+					一个 64x128 的 A 面板 + 128x64 的 B 面板 = 128 KiB，可以留在 L2 里，而每个微内核使用的 A 列和 B 元素都在 L1 里。
+					Cache blocking sizes (in elements)
+					A 64x128 panel of A + a 128x64 panel of B = 128 KiB, which stays in L2, while the A columns and B elements each micro kernel uses stay in L1.
+				*/
+				constexpr std::size_t BlockRows = 64;
+				constexpr std::size_t BlockDepth = 128;
+				constexpr std::size_t BlockColumns = 64;
+
+				//寄存器分块的列数 (所有内核相同)
+				//Number of columns in a register tile (same for every kernel)
+				constexpr std::size_t TileColumns = 4;
+
+				//处理不足一个寄存器分块的边角部分
+				//Handle the edge parts that do not fill a register tile
+				void MultiplyEdge
+				(
+					std::size_t Rows, std::size_t Columns, std::size_t Depth,
+					const std::uint64_t* A, std::size_t LeadingA,
+					const std::uint64_t* B, std::size_t LeadingB,
+					std::uint64_t* C, std::size_t LeadingC
+				)
+				{
+					for ( std::size_t Column = 0; Column < Columns; ++Column )
+					{
+						for ( std::size_t Inner = 0; Inner < Depth; ++Inner )
+						{
+							const std::uint64_t Value = B[ Inner + Column * LeadingB ];
+							const std::uint64_t* ColumnA = A + Inner * LeadingA;
+							std::uint64_t* ColumnC = C + Column * LeadingC;
+
+							for ( std::size_t Row = 0; Row < Rows; ++Row )
+								ColumnC[ Row ] += ColumnA[ Row ] * Value;
+						}
+					}
+				}
+
+				void MicroKernelScalar
+				(
+					std::size_t Depth,
+					const std::uint64_t* A, std::size_t LeadingA,
+					const std::uint64_t* B, std::size_t LeadingB,
+					std::uint64_t* C, std::size_t LeadingC
+				)
+				{
+					std::uint64_t Accumulator[ 4 ][ 4 ] {};
+
+					for ( std::size_t Inner = 0; Inner < Depth; ++Inner )
+					{
+						const std::uint64_t* ColumnA = A + Inner * LeadingA;
+						const std::uint64_t A0 = ColumnA[ 0 ], A1 = ColumnA[ 1 ], A2 = ColumnA[ 2 ], A3 = ColumnA[ 3 ];
+
+						for ( std::size_t Column = 0; Column < 4; ++Column )
+						{
+							const std::uint64_t Value = B[ Inner + Column * LeadingB ];
+							Accumulator[ Column ][ 0 ] += A0 * Value;
+							Accumulator[ Column ][ 1 ] += A1 * Value;
+							Accumulator[ Column ][ 2 ] += A2 * Value;
+							Accumulator[ Column ][ 3 ] += A3 * Value;
+						}
+					}
+
+					for ( std::size_t Column = 0; Column < 4; ++Column )
+						for ( std::size_t Row = 0; Row < 4; ++Row )
+							C[ Row + Column * LeadingC ] += Accumulator[ Column ][ Row ];
+				}
+
+				#if defined( TDOM_PROCESSOR_X86 )
+
+				/*
+					AVX2 没有 64 位低位乘法，这里用三个 32x32->64 的乘积拼出来:
+					AVX2 has no 64-bit low multiply, so it is assembled from three 32x32->64 products:
+					(AH*2^32 + AL) * (BH*2^32 + BL) mod 2^64 = AL*BL + ((AH*BL + AL*BH) << 32)
+				*/
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				inline __m256i MultiplyLow64_AVX2( __m256i LeftLow, __m256i LeftHigh, __m256i RightLow, __m256i RightHigh )
+				{
+					const __m256i LowProduct = _mm256_mul_epu32( LeftLow, RightLow );
+					const __m256i CrossProduct = _mm256_add_epi64( _mm256_mul_epu32( LeftHigh, RightLow ), _mm256_mul_epu32( LeftLow, RightHigh ) );
+					return _mm256_add_epi64( LowProduct, _mm256_slli_epi64( CrossProduct, 32 ) );
+				}
+
+				TDOM_TARGET_ATTRIBUTE( "avx2" )
+				void MicroKernelAVX2
+				(
+					std::size_t Depth,
+					const std::uint64_t* A, std::size_t LeadingA,
+					const std::uint64_t* B, std::size_t LeadingB,
+					std::uint64_t* C, std::size_t LeadingC
+				)
+				{
+					//8 行 x 4 列，每列两个 YMM 累加器 (手工展开，保证累加器都留在寄存器里)
+					//8 rows x 4 columns, two YMM accumulators per column (unrolled by hand so every accumulator stays in a register)
+					__m256i C00 = _mm256_setzero_si256(), C01 = _mm256_setzero_si256();
+					__m256i C10 = _mm256_setzero_si256(), C11 = _mm256_setzero_si256();
+					__m256i C20 = _mm256_setzero_si256(), C21 = _mm256_setzero_si256();
+					__m256i C30 = _mm256_setzero_si256(), C31 = _mm256_setzero_si256();
+
+					const std::uint64_t* B0 = B;
+					const std::uint64_t* B1 = B + LeadingB;
+					const std::uint64_t* B2 = B + LeadingB * 2;
+					const std::uint64_t* B3 = B + LeadingB * 3;
+
+					for ( std::size_t Inner = 0; Inner < Depth; ++Inner )
+					{
+						const std::uint64_t* ColumnA = A + Inner * LeadingA;
+						const __m256i A0 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( ColumnA ) );
+						const __m256i A1 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( ColumnA + 4 ) );
+						const __m256i A0_High = _mm256_srli_epi64( A0, 32 );
+						const __m256i A1_High = _mm256_srli_epi64( A1, 32 );
+
+						__m256i Value = _mm256_set1_epi64x( static_cast<long long>( B0[ Inner ] ) );
+						__m256i Value_High = _mm256_srli_epi64( Value, 32 );
+						C00 = _mm256_add_epi64( C00, MultiplyLow64_AVX2( A0, A0_High, Value, Value_High ) );
+						C01 = _mm256_add_epi64( C01, MultiplyLow64_AVX2( A1, A1_High, Value, Value_High ) );
+
+						Value = _mm256_set1_epi64x( static_cast<long long>( B1[ Inner ] ) );
+						Value_High = _mm256_srli_epi64( Value, 32 );
+						C10 = _mm256_add_epi64( C10, MultiplyLow64_AVX2( A0, A0_High, Value, Value_High ) );
+						C11 = _mm256_add_epi64( C11, MultiplyLow64_AVX2( A1, A1_High, Value, Value_High ) );
+
+						Value = _mm256_set1_epi64x( static_cast<long long>( B2[ Inner ] ) );
+						Value_High = _mm256_srli_epi64( Value, 32 );
+						C20 = _mm256_add_epi64( C20, MultiplyLow64_AVX2( A0, A0_High, Value, Value_High ) );
+						C21 = _mm256_add_epi64( C21, MultiplyLow64_AVX2( A1, A1_High, Value, Value_High ) );
+
+						Value = _mm256_set1_epi64x( static_cast<long long>( B3[ Inner ] ) );
+						Value_High = _mm256_srli_epi64( Value, 32 );
+						C30 = _mm256_add_epi64( C30, MultiplyLow64_AVX2( A0, A0_High, Value, Value_High ) );
+						C31 = _mm256_add_epi64( C31, MultiplyLow64_AVX2( A1, A1_High, Value, Value_High ) );
+					}
+
+					auto StoreColumn = [ C, LeadingC ]( std::size_t Column, __m256i Low, __m256i High ) TDOM_TARGET_ATTRIBUTE( "avx2" )
+					{
+						__m256i* ColumnC = reinterpret_cast<__m256i*>( C + Column * LeadingC );
+						_mm256_storeu_si256( ColumnC, _mm256_add_epi64( _mm256_loadu_si256( ColumnC ), Low ) );
+						_mm256_storeu_si256( ColumnC + 1, _mm256_add_epi64( _mm256_loadu_si256( ColumnC + 1 ), High ) );
+					};
+					StoreColumn( 0, C00, C01 );
+					StoreColumn( 1, C10, C11 );
+					StoreColumn( 2, C20, C21 );
+					StoreColumn( 3, C30, C31 );
+				}
+
+				TDOM_TARGET_ATTRIBUTE( "avx512f,avx512dq" )
+				void MicroKernelAVX512
+				(
+					std::size_t Depth,
+					const std::uint64_t* A, std::size_t LeadingA,
+					const std::uint64_t* B, std::size_t LeadingB,
+					std::uint64_t* C, std::size_t LeadingC
+				)
+				{
+					//16 行 x 4 列，每列两个 ZMM 累加器 (手工展开，保证累加器都留在寄存器里)
+					//16 rows x 4 columns, two ZMM accumulators per column (unrolled by hand so every accumulator stays in a register)
+					__m512i C00 = _mm512_setzero_si512(), C01 = _mm512_setzero_si512();
+					__m512i C10 = _mm512_setzero_si512(), C11 = _mm512_setzero_si512();
+					__m512i C20 = _mm512_setzero_si512(), C21 = _mm512_setzero_si512();
+					__m512i C30 = _mm512_setzero_si512(), C31 = _mm512_setzero_si512();
+
+					const std::uint64_t* B0 = B;
+					const std::uint64_t* B1 = B + LeadingB;
+					const std::uint64_t* B2 = B + LeadingB * 2;
+					const std::uint64_t* B3 = B + LeadingB * 3;
+
+					for ( std::size_t Inner = 0; Inner < Depth; ++Inner )
+					{
+						const std::uint64_t* ColumnA = A + Inner * LeadingA;
+						const __m512i A0 = _mm512_loadu_si512( ColumnA );
+						const __m512i A1 = _mm512_loadu_si512( ColumnA + 8 );
+
+						__m512i Value = _mm512_set1_epi64( static_cast<long long>( B0[ Inner ] ) );
+						C00 = _mm512_add_epi64( C00, _mm512_mullo_epi64( A0, Value ) );
+						C01 = _mm512_add_epi64( C01, _mm512_mullo_epi64( A1, Value ) );
+
+						Value = _mm512_set1_epi64( static_cast<long long>( B1[ Inner ] ) );
+						C10 = _mm512_add_epi64( C10, _mm512_mullo_epi64( A0, Value ) );
+						C11 = _mm512_add_epi64( C11, _mm512_mullo_epi64( A1, Value ) );
+
+						Value = _mm512_set1_epi64( static_cast<long long>( B2[ Inner ] ) );
+						C20 = _mm512_add_epi64( C20, _mm512_mullo_epi64( A0, Value ) );
+						C21 = _mm512_add_epi64( C21, _mm512_mullo_epi64( A1, Value ) );
+
+						Value = _mm512_set1_epi64( static_cast<long long>( B3[ Inner ] ) );
+						C30 = _mm512_add_epi64( C30, _mm512_mullo_epi64( A0, Value ) );
+						C31 = _mm512_add_epi64( C31, _mm512_mullo_epi64( A1, Value ) );
+					}
+
+					auto StoreColumn = [ C, LeadingC ]( std::size_t Column, __m512i Low, __m512i High ) TDOM_TARGET_ATTRIBUTE( "avx512f" )
+					{
+						std::uint64_t* ColumnC = C + Column * LeadingC;
+						_mm512_storeu_si512( ColumnC, _mm512_add_epi64( _mm512_loadu_si512( ColumnC ), Low ) );
+						_mm512_storeu_si512( ColumnC + 8, _mm512_add_epi64( _mm512_loadu_si512( ColumnC + 8 ), High ) );
+					};
+					StoreColumn( 0, C00, C01 );
+					StoreColumn( 1, C10, C11 );
+					StoreColumn( 2, C20, C21 );
+					StoreColumn( 3, C30, C31 );
+				}
+
+				#endif
+
+				using MicroKernelFunction = void ( * )( std::size_t, const std::uint64_t*, std::size_t, const std::uint64_t*, std::size_t, std::uint64_t*, std::size_t );
+			}  // namespace
+
+			KernelKind SelectKernel()
+			{
+				static const KernelKind Selected = []()
+				{
+					const auto& Features = BaseOperation::CurrentProcessorFeatures();
+
+					if ( Features.AVX512F && Features.AVX512DQ )
+						return KernelKind::AVX512;
+					if ( Features.AVX2 )
+						return KernelKind::AVX2;
+					return KernelKind::Scalar;
+				}();
+
+				return Selected;
+			}
+
+			void MultiplyMatrix
+			(
+				std::size_t M, std::size_t N, std::size_t K,
+				const std::uint64_t* A, std::size_t LeadingA,
+				const std::uint64_t* B, std::size_t LeadingB,
+				std::uint64_t* C, std::size_t LeadingC,
+				bool Accumulate,
+				KernelKind Kernel
+			)
+			{
+				my_cpp2020_assert
+				(
+					LeadingA >= M && LeadingB >= K && LeadingC >= M,
+					"WrappingIntegerMatrixMultiply: The leading dimension is smaller than the number of rows!",
+					std::source_location::current()
+				);
+
+				if ( !Accumulate )
+				{
+					for ( std::size_t Column = 0; Column < N; ++Column )
+						std::fill_n( C + Column * LeadingC, M, std::uint64_t { 0 } );
+				}
+
+				MicroKernelFunction MicroKernel = MicroKernelScalar;
+				std::size_t			TileRows = 4;
+
+				#if defined( TDOM_PROCESSOR_X86 )
+				//调用方可以请求一个当前处理器不支持的内核，此时退回到可用的最佳内核
+				//The caller may request a kernel the current processor does not support; fall back to the best available one
+				if ( Kernel == KernelKind::AVX512 && SelectKernel() != KernelKind::AVX512 )
+					Kernel = SelectKernel();
+				if ( Kernel == KernelKind::AVX2 && SelectKernel() == KernelKind::Scalar )
+					Kernel = KernelKind::Scalar;
+
+				if ( Kernel == KernelKind::AVX512 )
+				{
+					MicroKernel = MicroKernelAVX512;
+					TileRows = 16;
+				}
+				else if ( Kernel == KernelKind::AVX2 )
+				{
+					MicroKernel = MicroKernelAVX2;
+					TileRows = 8;
+				}
+				#else
+				static_cast<void>( Kernel );
+				#endif
+
+				for ( std::size_t ColumnBlock = 0; ColumnBlock < N; ColumnBlock += BlockColumns )
+				{
+					const std::size_t Columns = std::min( BlockColumns, N - ColumnBlock );
+					const std::size_t FullColumns = Columns - Columns % TileColumns;
+
+					for ( std::size_t DepthBlock = 0; DepthBlock < K; DepthBlock += BlockDepth )
+					{
+						const std::size_t Depth = std::min( BlockDepth, K - DepthBlock );
+
+						for ( std::size_t RowBlock = 0; RowBlock < M; RowBlock += BlockRows )
+						{
+							const std::size_t Rows = std::min( BlockRows, M - RowBlock );
+							const std::size_t FullRows = Rows - Rows % TileRows;
+
+							const std::uint64_t* PanelA = A + RowBlock + DepthBlock * LeadingA;
+							const std::uint64_t* PanelB = B + DepthBlock + ColumnBlock * LeadingB;
+							std::uint64_t*		 PanelC = C + RowBlock + ColumnBlock * LeadingC;
+
+							for ( std::size_t Column = 0; Column < FullColumns; Column += TileColumns )
+							{
+								for ( std::size_t Row = 0; Row < FullRows; Row += TileRows )
+									MicroKernel( Depth, PanelA + Row, LeadingA, PanelB + Column * LeadingB, LeadingB, PanelC + Row + Column * LeadingC, LeadingC );
+
+								if ( FullRows != Rows )
+									MultiplyEdge( Rows - FullRows, TileColumns, Depth, PanelA + FullRows, LeadingA, PanelB + Column * LeadingB, LeadingB, PanelC + FullRows + Column * LeadingC, LeadingC );
+							}
+
+							if ( FullColumns != Columns )
+								MultiplyEdge( Rows, Columns - FullColumns, Depth, PanelA, LeadingA, PanelB + FullColumns * LeadingB, LeadingB, PanelC + FullColumns * LeadingC, LeadingC );
+						}
+					}
+				}
+			}
+
+			void MultiplyMatrixByRankOne
+			(
+				std::size_t M, std::size_t N, std::size_t K,
+				const std::uint64_t* A, std::size_t LeadingA,
+				const std::uint64_t* ColumnVector,
+				const std::uint64_t* RowVector,
+				std::uint64_t Scale,
+				std::uint64_t* ProductWorkspace,
+				std::uint64_t* C, std::size_t LeadingC
+			)
+			{
+				my_cpp2020_assert
+				(
+					LeadingA >= M && LeadingC >= M,
+					"WrappingIntegerMatrixMultiply: The leading dimension is smaller than the number of rows!",
+					std::source_location::current()
+				);
+
+				//ProductWorkspace = A * ColumnVector (按列累加，访问是连续的)
+				//ProductWorkspace = A * ColumnVector (accumulated column by column, so the access is contiguous)
+				std::fill_n( ProductWorkspace, M, std::uint64_t { 0 } );
+				for ( std::size_t Inner = 0; Inner < K; ++Inner )
+				{
+					const std::uint64_t	 Value = ColumnVector[ Inner ];
+					const std::uint64_t* ColumnA = A + Inner * LeadingA;
+
+					for ( std::size_t Row = 0; Row < M; ++Row )
+						ProductWorkspace[ Row ] += ColumnA[ Row ] * Value;
+				}
+
+				//C(:, Column) = ProductWorkspace * (RowVector[Column] * Scale)
+				for ( std::size_t Column = 0; Column < N; ++Column )
+				{
+					const std::uint64_t ScaledValue = RowVector[ Column ] * Scale;
+					std::uint64_t*		ColumnC = C + Column * LeadingC;
+
+					for ( std::size_t Row = 0; Row < M; ++Row )
+						ColumnC[ Row ] = ProductWorkspace[ Row ] * ScaledValue;
+				}
+			}
+		}  // namespace ImplementationDetails::WrappingIntegerMatrixMultiply
+	}	   // namespace SED::BlockCipher
+}  // namespace TwilightDreamOfMagical::CustomSecurity
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * 本文件是 Algorithm_OaldresPuzzleCryptic 的一部分。
+ *
+ * Algorithm_OaldresPuzzleCryptic 是自由软件：你可以再分发之和/或依照由自由软件基金会发布的 GNU 通用公共许可证修改之，无论是版本 3 许可证，还是（按你的决定）任何以后版都可以。
+ *
+ * 发布 Algorithm_OaldresPuzzleCryptic 是希望它能有用，但是并无保障;甚至连可销售和符合某个特定的目的都不保证。请参看 GNU 通用公共许可证，了解详情。
+ * 你应该随程序获得一份 GNU 通用公共许可证的复本。如果没有，请看 <https://www.gnu.org/licenses/>。
+ */
+
+ /*
+ * Copyright (C) 2023-2050 Twilight-Dream
+ *
+ * This file is part of Algorithm_OaldresPuzzleCryptic.
+ *
+ * Algorithm_OaldresPuzzleCryptic is free software: you may redistribute it and/or modify it under the GNU General Public License as published by the Free Software Foundation, either under the Version 3 license, or (at your discretion) any later version.
+ *
+ * TDOM-EncryptOrDecryptFile-Reborn is released in the hope that it will be useful, but there are no guarantees; not even that it will be marketable and fit a particular purpose. Please see the GNU General Public License for details.
+ * You should get a copy of the GNU General Public License with your program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALGORITHM_OALDRESPUZZLECRYPTIC_WRAPPINGINTEGERMATRIXMULTIPLY_HPP
+#define ALGORITHM_OALDRESPUZZLECRYPTIC_WRAPPINGINTEGERMATRIXMULTIPLY_HPP
+
+#include "../SupportBaseFunctions.hpp"
+#include "../ProcessorFeatureDetection.hpp"
+
+namespace TwilightDreamOfMagical::CustomSecurity
+{
+	//SymmetricEncryptionDecryption
+	namespace SED::BlockCipher
+	{
+		namespace ImplementationDetails::WrappingIntegerMatrixMultiply
+		{
+			/*
+				模 2^64 的 QuadWord 矩阵乘法引擎 (所有加法和乘法都自然回绕)
+				Modulo 2^64 QuadWord matrix multiplication engine (every addition and multiplication wraps naturally)
+
+				因为模 2^64 的加法满足结合律和交换律，所以无论分块和累加顺序如何，结果都与 Eigen 的 GEMM 逐位相同。
+				Because addition modulo 2^64 is associative and commutative, the result is bit-identical to Eigen's GEMM regardless of blocking and accumulation order.
+			*/
+			enum class KernelKind : std::uint8_t
+			{
+				//4x4 寄存器分块的可移植内核
+				//Portable kernel with 4x4 register tiling
+				Scalar,
+				//8x4 分块，用 32x32 位乘积模拟 64 位低位乘法
+				//8x4 tiling, emulating the 64-bit low multiply from 32x32-bit products
+				AVX2,
+				//16x4 分块，使用 AVX-512DQ 的原生 64 位低位乘法
+				//16x4 tiling, using the native AVX-512DQ 64-bit low multiply
+				AVX512
+			};
+
+			//当前处理器可用的最快内核
+			//The fastest kernel available on the current processor
+			KernelKind SelectKernel();
+
+			/*
+				C[M x N] = (Accumulate ? C : 0) + A[M x K] * B[K x N]
+				所有矩阵都是列主序 (与 Eigen 默认存储一致)，Leading 参数是列之间的元素跨度。
+				All matrices are column-major (same as Eigen's default storage); the Leading parameters are the element stride between columns.
+			*/
+			void MultiplyMatrix
+			(
+				std::size_t M, std::size_t N, std::size_t K,
+				const std::uint64_t* A, std::size_t LeadingA,
+				const std::uint64_t* B, std::size_t LeadingB,
+				std::uint64_t* C, std::size_t LeadingC,
+				bool Accumulate,
+				KernelKind Kernel
+			);
+
+			inline void MultiplyMatrix
+			(
+				std::size_t M, std::size_t N, std::size_t K,
+				const std::uint64_t* A, std::size_t LeadingA,
+				const std::uint64_t* B, std::size_t LeadingB,
+				std::uint64_t* C, std::size_t LeadingC,
+				bool Accumulate
+			)
+			{
+				MultiplyMatrix( M, N, K, A, LeadingA, B, LeadingB, C, LeadingC, Accumulate, SelectKernel() );
+			}
+
+			/*
+				C[M x N] = A[M x K] * ( ColumnVector[K] * RowVector[N]^T * Scale )
+				右侧是一个秩为 1 的外积矩阵，所以按 (A * ColumnVector) * (RowVector * Scale)^T 计算，只需要 O(M*K + M*N)，并且不需要实体化 K x N 的临时矩阵。
+				模 2^64 的整数环满足结合律，所以结果与先构造外积再做完整 GEMM 逐位相同。
+				The right-hand side is a rank-1 outer product, so it is computed as (A * ColumnVector) * (RowVector * Scale)^T in O(M*K + M*N) without materializing the K x N temporary.
+				The integer ring modulo 2^64 is associative, so the result is bit-identical to building the outer product and running a full GEMM.
+
+				ProductWorkspace 至少需要 M 个元素，调用方负责擦除
+				ProductWorkspace needs at least M elements; the caller is responsible for wiping it
+			*/
+			void MultiplyMatrixByRankOne
+			(
+				std::size_t M, std::size_t N, std::size_t K,
+				const std::uint64_t* A, std::size_t LeadingA,
+				const std::uint64_t* ColumnVector,
+				const std::uint64_t* RowVector,
+				std::uint64_t Scale,
+				std::uint64_t* ProductWorkspace,
+				std::uint64_t* C, std::size_t LeadingC
+			);
+		}  // namespace ImplementationDetails::WrappingIntegerMatrixMultiply
+	}	   // namespace SED::BlockCipher
+}  // namespace TwilightDreamOfMagical::CustomSecurity
+
+#endif	//ALGORITHM_OALDRESPUZZLECRYPTIC_WRAPPINGINTEGERMATRIXMULTIPLY_HPP
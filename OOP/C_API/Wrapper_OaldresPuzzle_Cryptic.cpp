@@ -4,6 +4,8 @@
 using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OaldresPuzzle_Cryptic;
 using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_MainAlgorithm_Worker;
 using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::ImplementationDetails::CommonStateData;
+using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_ProfileStage;
+using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_StageProfile;
 
 struct OaldresPuzzle_CrypticContext
 {
@@ -12,6 +14,7 @@ struct OaldresPuzzle_CrypticContext
 	std::unique_ptr<CommonStateData>		  CommonStateDataPointer = nullptr;
 	std::unique_ptr<OaldresPuzzle_Cryptic>	  AlgorithmCorePointer = nullptr;
 	std::unique_ptr<OPC_MainAlgorithm_Worker> AlgorithmWorkerPointer = nullptr;
+	OaldresPuzzle_Cryptic::StateSnapshot	  InitialStateSnapshot;
 	std::vector<std::uint8_t>				  InitialVector;
 	uint64_t								  LFSR_Seed;
 	uint64_t								  NLFSR_Seed;
@@ -70,19 +73,67 @@ OaldresPuzzle_CrypticContext* New_OPC( uint64_t data_block_size, uint64_t key_bl
 	context->CommonStateDataPointer = std::make_unique<CommonStateData>( data_block_size, key_block_size, context->InitialVector, LFSR_Seed, NLFSR_Seed, SDP_Seed );
 	context->AlgorithmCorePointer = std::make_unique<OaldresPuzzle_Cryptic>( *context->CommonStateDataPointer );
 	context->AlgorithmWorkerPointer = std::make_unique<OPC_MainAlgorithm_Worker>( *context->AlgorithmCorePointer );
+	context->AlgorithmCorePointer->SaveSnapshot( context->InitialStateSnapshot );
 
 	return context;
 }
 
+//恢复到刚构建时的状态快照，和重新构建的结果相同，但是不需要重新分配
+//Restore the state snapshot taken right after construction, same result as rebuilding but without reallocating
 void Reset_OPC( OaldresPuzzle_CrypticContext* context )
 {
-	context->CommonStateDataPointer.reset();
-	context->AlgorithmCorePointer.reset();
-	context->AlgorithmWorkerPointer.reset();
+	context->AlgorithmCorePointer->RestoreSnapshot( context->InitialStateSnapshot );
+}
 
-	context->CommonStateDataPointer = std::make_unique<CommonStateData>( context->data_block_size, context->key_block_size, context->InitialVector, context->LFSR_Seed, context->NLFSR_Seed, context->SDP_Seed );
-	context->AlgorithmCorePointer = std::make_unique<OaldresPuzzle_Cryptic>( *context->CommonStateDataPointer );
-	context->AlgorithmWorkerPointer = std::make_unique<OPC_MainAlgorithm_Worker>( *context->AlgorithmCorePointer );
+static int OPC_ProcessInPlace( OaldresPuzzle_CrypticContext* context, const uint8_t* keys, uint64_t keys_size, uint8_t* data, size_t data_size, bool is_encryption )
+{
+	if ( context == nullptr || keys == nullptr || ( data == nullptr && data_size != 0 ) )
+	{
+		std::cerr << "My C API Error: context, keys and data must not be null pointers!" << std::endl;
+		return -1;
+	}
+
+	if ( ( data_size % ( context->data_block_size * sizeof( uint64_t ) ) ) != 0 || ( reinterpret_cast<std::uintptr_t>( data ) % alignof( uint64_t ) ) != 0 )
+	{
+		std::cerr << "My C API Error: The in-place data must be aligned to 8 bytes and its size must be a multiple of (data_block_size * sizeof(uint64_t)) byte!" << std::endl;
+		return -1;
+	}
+
+	if ( keys_size == 0 || ( keys_size % ( context->key_block_size * sizeof( uint64_t ) ) ) != 0 )
+	{
+		std::cerr << "My C API Error: The keys size must be a multiple of (key_block_size * sizeof(uint64_t)) byte!" << std::endl;
+		return -1;
+	}
+
+	std::span<std::uint8_t> DataSpan( data, data_size );
+	std::span<const std::uint8_t> KeySpan( keys, keys_size );
+
+	try
+	{
+		if ( is_encryption )
+			context->AlgorithmWorkerPointer->EncrypterMainInPlace( DataSpan, KeySpan );
+		else
+			context->AlgorithmWorkerPointer->DecrypterMainInPlace( DataSpan, KeySpan );
+	}
+	catch ( const std::exception& except )
+	{
+		std::cerr << "My C API Error: " << except.what() << std::endl;
+		Reset_OPC( context );
+		return -1;
+	}
+
+	Reset_OPC( context );
+	return 0;
+}
+
+int OPC_EncryptInPlace( OaldresPuzzle_CrypticContext* context, const uint8_t* keys, uint64_t keys_size, uint8_t* data, size_t data_size )
+{
+	return OPC_ProcessInPlace( context, keys, keys_size, data, data_size, true );
+}
+
+int OPC_DecryptInPlace( OaldresPuzzle_CrypticContext* context, const uint8_t* keys, uint64_t keys_size, uint8_t* data, size_t data_size )
+{
+	return OPC_ProcessInPlace( context, keys, keys_size, data, data_size, false );
 }
 
 void OPC_Encryption( OaldresPuzzle_CrypticContext* context, const uint8_t* keys, uint64_t keys_size, const uint8_t* input, size_t input_size, uint8_t* output )
@@ -121,6 +172,42 @@ void OPC_Decryption( OaldresPuzzle_CrypticContext* context, const uint8_t* keys,
 	Reset_OPC( context );
 }
 
+int OPC_GetStageProfile( const OaldresPuzzle_CrypticContext* context, OPC_ProfileSnapshot* snapshot )
+{
+	if ( context == nullptr || snapshot == nullptr )
+	{
+		std::cerr << "My C API Error: context and snapshot must not be null pointers!" << std::endl;
+		return -1;
+	}
+
+	const OPC_StageProfile Profile = context->AlgorithmWorkerPointer->StageProfile();
+
+	auto CopyCounters = [ &Profile ]( OPC_ProfileStage Stage, OPC_ProfileCounters& Counters )
+	{
+		Counters.cycles = Profile[ Stage ].Cycles;
+		Counters.calls = Profile[ Stage ].Calls;
+		Counters.bytes = Profile[ Stage ].Bytes;
+	};
+
+	snapshot->enabled = Profile.Enabled ? 1 : 0;
+	CopyCounters( OPC_ProfileStage::GenerationSubkeys, snapshot->generation_subkeys );
+	CopyCounters( OPC_ProfileStage::GenerationRoundSubkeys, snapshot->generation_round_subkeys );
+	CopyCounters( OPC_ProfileStage::LaiMasseyFramework, snapshot->lai_massey_framework );
+	CopyCounters( OPC_ProfileStage::ByteSubstitution, snapshot->byte_substitution );
+	CopyCounters( OPC_ProfileStage::KeyWhitening, snapshot->key_whitening );
+	CopyCounters( OPC_ProfileStage::ScryptRekey, snapshot->scrypt_rekey );
+
+	return 0;
+}
+
+void OPC_ResetStageProfile( OaldresPuzzle_CrypticContext* context )
+{
+	if ( context == nullptr )
+		return;
+
+	context->AlgorithmWorkerPointer->ResetStageProfile();
+}
+
 void Delete_OPC( OaldresPuzzle_CrypticContext* context )
 {
 	delete context;
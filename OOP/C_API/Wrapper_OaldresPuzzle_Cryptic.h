@@ -23,6 +23,7 @@
 #ifndef ALGORITHM_OALDRESPUZZLECRYPTIC_WRAPPER_OALDRESPUZZLE_CRYPTIC_H
 #define ALGORITHM_OALDRESPUZZLECRYPTIC_WRAPPER_OALDRESPUZZLE_CRYPTIC_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -38,6 +39,52 @@ extern "C"
 
 	void OPC_Decryption( OaldresPuzzle_CrypticContext* context, const uint8_t* keys, uint64_t keys_size, const uint8_t* input, size_t input_size, uint8_t* output );
 
+	/*
+		原地加密和解密调用者的缓冲区，不填充也不去掉填充
+		data 必须按 8 字节对齐，data_size 必须是 data_block_size * 8 字节的整数倍，keys_size 必须是 key_block_size * 8 字节的整数倍
+		成功返回 0，参数不符合要求时返回 -1 并且不修改 data
+
+		Encrypt and decrypt the caller's buffer in place, without padding or unpadding
+		data must be 8-byte aligned, data_size must be a multiple of data_block_size * 8 bytes, keys_size must be a multiple of key_block_size * 8 bytes
+		Returns 0 on success, returns -1 and leaves data untouched when the arguments do not meet the requirements
+	*/
+	int OPC_EncryptInPlace( OaldresPuzzle_CrypticContext* context, const uint8_t* keys, uint64_t keys_size, uint8_t* data, size_t data_size );
+
+	int OPC_DecryptInPlace( OaldresPuzzle_CrypticContext* context, const uint8_t* keys, uint64_t keys_size, uint8_t* data, size_t data_size );
+
+	/*
+		各阶段的性能计数器，在 context 上一直累加，直到调用 OPC_ResetStageProfile
+		库需要在定义了 TDOM_OPC_STAGE_PROFILING 的情况下编译，否则 enabled 为 0 并且所有计数都是 0
+		cycles 在 x86 上是时间戳计数器的周期数，在其他平台上是纳秒
+
+		Per-stage performance counters, accumulated on the context until OPC_ResetStageProfile is called
+		The library must be compiled with TDOM_OPC_STAGE_PROFILING defined, otherwise enabled is 0 and every count is 0
+		cycles are timestamp counter cycles on x86 and nanoseconds on other platforms
+	*/
+	typedef struct OPC_ProfileCounters
+	{
+		uint64_t cycles;
+		uint64_t calls;
+		uint64_t bytes;
+	} OPC_ProfileCounters;
+
+	typedef struct OPC_ProfileSnapshot
+	{
+		int					enabled;
+		OPC_ProfileCounters generation_subkeys;
+		OPC_ProfileCounters generation_round_subkeys;
+		OPC_ProfileCounters lai_massey_framework;
+		OPC_ProfileCounters byte_substitution;
+		OPC_ProfileCounters key_whitening;
+		OPC_ProfileCounters scrypt_rekey;
+	} OPC_ProfileSnapshot;
+
+	//成功返回 0，context 或 snapshot 是空指针时返回 -1
+	//Returns 0 on success, returns -1 when context or snapshot is a null pointer
+	int OPC_GetStageProfile( const OaldresPuzzle_CrypticContext* context, OPC_ProfileSnapshot* snapshot );
+
+	void OPC_ResetStageProfile( OaldresPuzzle_CrypticContext* context );
+
 	void Delete_OPC( OaldresPuzzle_CrypticContext* context );
 
 #ifdef __cplusplus
@@ -0,0 +1,116 @@
+#ifndef ALGORITHM_OALDRESPUZZLECRYPTIC_PROCESSORFEATUREDETECTION_HPP
+#define ALGORITHM_OALDRESPUZZLECRYPTIC_PROCESSORFEATUREDETECTION_HPP
+
+/*
+	运行时处理器指令集检测，给需要SIMD内核的模块做自动分派用
+	Runtime processor instruction-set detection, used by modules with SIMD kernels to dispatch automatically
+
+	定义 TDOM_DISABLE_SIMD 可以强制所有模块只走标量路径
+	Define TDOM_DISABLE_SIMD to force every module onto the scalar path
+*/
+
+#if !defined(TDOM_DISABLE_SIMD) && ( defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86) )
+#define TDOM_PROCESSOR_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(TDOM_PROCESSOR_X86) && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+//MSVC 不需要按函数开启指令集
+//MSVC does not need per-function instruction set enabling
+#define TDOM_TARGET_ATTRIBUTE(TargetString)
+#elif defined(TDOM_PROCESSOR_X86)
+#define TDOM_TARGET_ATTRIBUTE(TargetString) __attribute__((target(TargetString)))
+#else
+#define TDOM_TARGET_ATTRIBUTE(TargetString)
+#endif
+
+//强制内联，用于在指定了指令集的函数里展开通用模板代码
+//Force inlining, used to expand generic template code inside functions that have an instruction set target
+#if defined(_MSC_VER) && !defined(__clang__)
+#define TDOM_ALWAYS_INLINE __forceinline
+#else
+#define TDOM_ALWAYS_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace TwilightDreamOfMagical::BaseOperation
+{
+	struct ProcessorFeatures
+	{
+		bool SSE2 = false;
+		bool SSSE3 = false;
+		bool AVX2 = false;
+		bool BMI2 = false;
+		bool AVX512F = false;
+		bool AVX512BW = false;
+		bool AVX512DQ = false;
+		bool AVX512VL = false;
+		bool AVX512VBMI = false;
+	};
+
+	namespace ProcessorFeatureDetectionImplementation
+	{
+		inline ProcessorFeatures Detect()
+		{
+			ProcessorFeatures Features {};
+
+			#if defined(TDOM_PROCESSOR_X86) && defined(_MSC_VER) && !defined(__clang__)
+
+			int Registers[4] { 0, 0, 0, 0 };
+			__cpuid(Registers, 0);
+			const int MaximumLeaf = Registers[0];
+
+			__cpuid(Registers, 1);
+			const bool HasOSXSAVE = (Registers[2] & (1 << 27)) != 0;
+			Features.SSE2 = (Registers[3] & (1 << 26)) != 0;
+			Features.SSSE3 = (Registers[2] & (1 << 9)) != 0;
+
+			//操作系统必须保存YMM/ZMM寄存器状态，否则不能使用AVX
+			//The operating system must save the YMM/ZMM register state, otherwise AVX cannot be used
+			const unsigned long long XCR0 = HasOSXSAVE ? _xgetbv(0) : 0;
+			const bool OS_SavesYMM = (XCR0 & 0x06) == 0x06;
+			const bool OS_SavesZMM = (XCR0 & 0xE6) == 0xE6;
+
+			if(MaximumLeaf >= 7)
+			{
+				__cpuidex(Registers, 7, 0);
+				Features.AVX2 = OS_SavesYMM && (Registers[1] & (1 << 5)) != 0;
+				Features.BMI2 = (Registers[1] & (1 << 8)) != 0;
+				Features.AVX512F = OS_SavesZMM && (Registers[1] & (1 << 16)) != 0;
+				Features.AVX512DQ = Features.AVX512F && (Registers[1] & (1 << 17)) != 0;
+				Features.AVX512BW = Features.AVX512F && (Registers[1] & (1 << 30)) != 0;
+				Features.AVX512VL = Features.AVX512F && (Registers[1] & (1 << 31)) != 0;
+				Features.AVX512VBMI = Features.AVX512F && (Registers[2] & (1 << 1)) != 0;
+			}
+
+			#elif defined(TDOM_PROCESSOR_X86)
+
+			//GCC/Clang 的内建函数已经检查了操作系统是否保存了扩展寄存器状态
+			//The GCC/Clang builtins already check whether the operating system saves the extended register state
+			__builtin_cpu_init();
+			Features.SSE2 = __builtin_cpu_supports("sse2");
+			Features.SSSE3 = __builtin_cpu_supports("ssse3");
+			Features.AVX2 = __builtin_cpu_supports("avx2");
+			Features.BMI2 = __builtin_cpu_supports("bmi2");
+			Features.AVX512F = __builtin_cpu_supports("avx512f");
+			Features.AVX512BW = __builtin_cpu_supports("avx512bw");
+			Features.AVX512DQ = __builtin_cpu_supports("avx512dq");
+			Features.AVX512VL = __builtin_cpu_supports("avx512vl");
+			Features.AVX512VBMI = __builtin_cpu_supports("avx512vbmi");
+
+			#endif
+
+			return Features;
+		}
+	}
+
+	//只检测一次，之后返回缓存的结果
+	//Detect only once, then return the cached result
+	inline const ProcessorFeatures& CurrentProcessorFeatures()
+	{
+		static const ProcessorFeatures Features = ProcessorFeatureDetectionImplementation::Detect();
+		return Features;
+	}
+}
+
+#endif //ALGORITHM_OALDRESPUZZLECRYPTIC_PROCESSORFEATUREDETECTION_HPP
@@ -0,0 +1,269 @@
+#ifndef ALGORITHM_OALDRESPUZZLECRYPTIC_SECUREARENA_HPP
+#define ALGORITHM_OALDRESPUZZLECRYPTIC_SECUREARENA_HPP
+
+#include "SupportBaseFunctions.hpp"
+
+/*
+	安全内存区
+	一块预先分配、按页对齐的内存，尽量锁定在物理内存里 (不会被换出到交换区)，并且尽量排除在核心转储之外。
+	在这块内存上做指针递增式分配，释放只在最后一次分配上回退；在明确的时间点 (例如一次子密钥生成结束) 一次性擦除整块已用区域并重置。
+	容量不够时退回到堆上分配，这部分在释放时立即擦除，所以正确性从不依赖容量。
+	不是线程安全的：每个上下文拥有自己的安全内存区。
+
+	Secure arena
+	A preallocated, page-aligned region that is locked into physical memory where possible (never swapped out) and excluded from core dumps where possible.
+	Allocation is a pointer bump inside this region, and freeing only rewinds the most recent allocation; at well-defined points (such as the end of one subkey generation) the whole used region is wiped once in bulk and reset.
+	When the capacity runs out it falls back to the heap, and those blocks are wiped immediately on free, so correctness never depends on the capacity.
+	It is not thread safe: every context owns its own secure arena.
+*/
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#define TDOM_SECURE_ARENA_WINDOWS 1
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define TDOM_SECURE_ARENA_POSIX 1
+#endif
+
+namespace CommonToolkit
+{
+	class SecureArena
+	{
+
+	public:
+		//所有分配的最大对齐 (也是堆上后备分配使用的对齐)
+		//Largest alignment of any allocation (also the alignment used by the heap fallback)
+		static constexpr std::size_t MaximumAlignment = 64;
+
+		explicit SecureArena(std::size_t CapacityBytes)
+		{
+			std::size_t PageSize = QueryPageSize();
+			CapacityBytes = std::max<std::size_t>(CapacityBytes, 1);
+			this->RegionCapacity = (CapacityBytes + PageSize - 1) / PageSize * PageSize;
+
+			#if defined(TDOM_SECURE_ARENA_WINDOWS)
+
+			this->RegionPointer = static_cast<std::uint8_t*>(::VirtualAlloc(nullptr, this->RegionCapacity, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+			if(this->RegionPointer != nullptr)
+			{
+				this->RegionMapped = true;
+				this->RegionLocked = ::VirtualLock(this->RegionPointer, this->RegionCapacity) != 0;
+			}
+
+			#elif defined(TDOM_SECURE_ARENA_POSIX)
+
+			void* MappedPointer = ::mmap(nullptr, this->RegionCapacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if(MappedPointer != MAP_FAILED)
+			{
+				this->RegionPointer = static_cast<std::uint8_t*>(MappedPointer);
+				this->RegionMapped = true;
+
+				#if defined(MADV_DONTDUMP)
+				::madvise(MappedPointer, this->RegionCapacity, MADV_DONTDUMP);
+				#endif
+
+				//锁定失败 (例如超过了 RLIMIT_MEMLOCK) 不是错误，只是失去了不被换出的保证
+				//A failed lock (for example over RLIMIT_MEMLOCK) is not an error, only the no-swap guarantee is lost
+				this->RegionLocked = ::mlock(MappedPointer, this->RegionCapacity) == 0;
+			}
+
+			#endif
+
+			if(this->RegionPointer == nullptr)
+			{
+				this->RegionPointer = static_cast<std::uint8_t*>(::operator new(this->RegionCapacity, std::align_val_t(MaximumAlignment)));
+			}
+		}
+
+		SecureArena(const SecureArena&) = delete;
+		SecureArena& operator=(const SecureArena&) = delete;
+
+		~SecureArena()
+		{
+			volatile void* CheckPointer = memory_set_no_optimize_function<0x00>(this->RegionPointer, this->HighWaterMark);
+			CheckPointer = nullptr;
+
+			if(this->RegionMapped)
+			{
+				#if defined(TDOM_SECURE_ARENA_WINDOWS)
+
+				if(this->RegionLocked)
+					::VirtualUnlock(this->RegionPointer, this->RegionCapacity);
+				::VirtualFree(this->RegionPointer, 0, MEM_RELEASE);
+
+				#elif defined(TDOM_SECURE_ARENA_POSIX)
+
+				if(this->RegionLocked)
+					::munlock(this->RegionPointer, this->RegionCapacity);
+				::munmap(this->RegionPointer, this->RegionCapacity);
+
+				#endif
+			}
+			else
+			{
+				::operator delete(this->RegionPointer, std::align_val_t(MaximumAlignment));
+			}
+		}
+
+		void* Allocate(std::size_t ByteCount, std::size_t Alignment)
+		{
+			my_cpp2020_assert(Alignment != 0 && Alignment <= MaximumAlignment && std::has_single_bit(Alignment), "SecureArena: The requested alignment is not supported!", std::source_location::current());
+
+			std::size_t AlignedOffset = (this->CurrentOffset + Alignment - 1) & ~(Alignment - 1);
+			if(AlignedOffset <= this->RegionCapacity && ByteCount <= this->RegionCapacity - AlignedOffset)
+			{
+				this->CurrentOffset = AlignedOffset + ByteCount;
+				this->HighWaterMark = std::max(this->HighWaterMark, this->CurrentOffset);
+				++(this->LiveAllocationCount);
+				return this->RegionPointer + AlignedOffset;
+			}
+
+			//容量不够: 退回到堆上
+			//Out of capacity: fall back to the heap
+			return ::operator new(ByteCount, std::align_val_t(MaximumAlignment));
+		}
+
+		void Deallocate(void* Pointer, std::size_t ByteCount) noexcept
+		{
+			if(Pointer == nullptr)
+				return;
+
+			std::uint8_t* BytePointer = static_cast<std::uint8_t*>(Pointer);
+			if(!this->Owns(BytePointer))
+			{
+				volatile void* CheckPointer = memory_set_no_optimize_function<0x00>(Pointer, ByteCount);
+				CheckPointer = nullptr;
+				::operator delete(Pointer, std::align_val_t(MaximumAlignment));
+				return;
+			}
+
+			--(this->LiveAllocationCount);
+
+			//最后一次分配可以直接回退，其余的内存留到 Reset 时一起擦除
+			//The most recent allocation can be rewound directly, the rest of the memory waits for Reset to be wiped together
+			if(BytePointer + ByteCount == this->RegionPointer + this->CurrentOffset)
+				this->CurrentOffset = static_cast<std::size_t>(BytePointer - this->RegionPointer);
+		}
+
+		//一次性擦除所有用过的内存并回到起点，调用时不能还有存活的分配
+		//Wipe all memory that was used in one pass and rewind to the start, no allocation may still be alive when this is called
+		void Reset()
+		{
+			my_cpp2020_assert(this->LiveAllocationCount == 0, "SecureArena: Reset was called while allocations are still alive!", std::source_location::current());
+
+			volatile void* CheckPointer = memory_set_no_optimize_function<0x00>(this->RegionPointer, this->HighWaterMark);
+			CheckPointer = nullptr;
+
+			this->CurrentOffset = 0;
+			this->HighWaterMark = 0;
+		}
+
+		bool Owns(const void* Pointer) const noexcept
+		{
+			const std::uint8_t* BytePointer = static_cast<const std::uint8_t*>(Pointer);
+			return std::less_equal<const std::uint8_t*>()(this->RegionPointer, BytePointer) && std::less<const std::uint8_t*>()(BytePointer, this->RegionPointer + this->RegionCapacity);
+		}
+
+		std::size_t Capacity() const noexcept
+		{
+			return this->RegionCapacity;
+		}
+
+		bool IsLocked() const noexcept
+		{
+			return this->RegionLocked;
+		}
+
+	private:
+		std::uint8_t* RegionPointer = nullptr;
+		std::size_t RegionCapacity = 0;
+		std::size_t CurrentOffset = 0;
+		//自上次 Reset 以来用过的最高位置，Reset 只擦除到这里
+		//Highest offset used since the last Reset, Reset only wipes up to here
+		std::size_t HighWaterMark = 0;
+		std::size_t LiveAllocationCount = 0;
+		bool RegionMapped = false;
+		bool RegionLocked = false;
+
+		static std::size_t QueryPageSize()
+		{
+			#if defined(TDOM_SECURE_ARENA_WINDOWS)
+
+			SYSTEM_INFO SystemInformation;
+			::GetSystemInfo(&SystemInformation);
+			return static_cast<std::size_t>(SystemInformation.dwPageSize);
+
+			#elif defined(TDOM_SECURE_ARENA_POSIX)
+
+			long PageSize = ::sysconf(_SC_PAGESIZE);
+			return PageSize > 0 ? static_cast<std::size_t>(PageSize) : 4096;
+
+			#else
+
+			return 4096;
+
+			#endif
+		}
+	};
+
+	//把 SecureArena 包装成标准库容器可用的分配器
+	//Wraps SecureArena as an allocator usable by standard library containers
+	template<typename Type>
+	class SecureArenaAllocator
+	{
+
+	public:
+		using value_type = Type;
+
+		explicit SecureArenaAllocator(SecureArena& Arena) noexcept
+			:
+			ArenaPointer(std::addressof(Arena))
+		{
+
+		}
+
+		template<typename OtherType>
+		SecureArenaAllocator(const SecureArenaAllocator<OtherType>& Other) noexcept
+			:
+			ArenaPointer(Other.GetArena())
+		{
+
+		}
+
+		Type* allocate(std::size_t Count)
+		{
+			if(Count > std::numeric_limits<std::size_t>::max() / sizeof(Type))
+				throw std::bad_array_new_length();
+
+			return static_cast<Type*>(ArenaPointer->Allocate(Count * sizeof(Type), alignof(Type)));
+		}
+
+		void deallocate(Type* Pointer, std::size_t Count) noexcept
+		{
+			ArenaPointer->Deallocate(Pointer, Count * sizeof(Type));
+		}
+
+		SecureArena* GetArena() const noexcept
+		{
+			return ArenaPointer;
+		}
+
+	private:
+		SecureArena* ArenaPointer = nullptr;
+	};
+
+	template<typename LeftType, typename RightType>
+	bool operator==(const SecureArenaAllocator<LeftType>& Left, const SecureArenaAllocator<RightType>& Right) noexcept
+	{
+		return Left.GetArena() == Right.GetArena();
+	}
+
+	template<typename Type>
+	using SecureArenaVector = std::vector<Type, SecureArenaAllocator<Type>>;
+}
+
+#endif //ALGORITHM_OALDRESPUZZLECRYPTIC_SECUREARENA_HPP
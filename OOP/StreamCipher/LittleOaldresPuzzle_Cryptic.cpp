@@ -1,4 +1,8 @@
 #include "LittleOaldresPuzzle_Cryptic.h"
+#include "../ProcessorFeatureDetection.hpp"
+
+#include <algorithm>
+#include <stdexcept>
 
 /*
 
@@ -329,6 +333,187 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				b = B;
 			}
 
+		#if defined( TDOM_PROCESSOR_X86 )
+
+			// ========================================================================
+			// Multi-block forward/backward
+			// 多分组版本的 forward/backward
+			//
+			// Every 32-bit SIMD lane runs one independent copy of the ARX-box, step by step
+			// identical to forward/backward above: `a` holds the a-words and `b` the b-words.
+			// AVX2 runs 8 copies (4 blocks), AVX-512 runs 16 copies (8 blocks).
+			// ========================================================================
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE void forward_avx2( __m256i& a, __m256i& b ) const noexcept
+			{
+				const auto& RC = ROUND_CONSTANTS;
+
+				__m256i A = a;
+				__m256i B = b;
+
+				// Subround 0
+				B = _mm256_sub_epi32( B, broadcast_avx2( RC[ 1 ] ) );
+
+				__m256i C0, D0;
+				cd_injection_from_B_avx2( B, C0, D0 );
+
+				const __m256i CD0 = _mm256_xor_si256( _mm256_slli_epi32( C0, 2 ), _mm256_srli_epi32( D0, 2 ) );
+				const __m256i CD1 = _mm256_xor_si256( _mm256_srli_epi32( C0, 5 ), _mm256_slli_epi32( D0, 5 ) );
+
+				A = _mm256_xor_si256( A, xor3_avx2( rotl_avx2<24>( B ), rotl_avx2<16>( C0 ), rotl_avx2<8>( B ) ) );
+				A = _mm256_add_epi32( A, xor3_avx2( rotl_avx2<31>( CD0 ), rotl_avx2<17>( CD1 ), broadcast_avx2( RC[ 0 ] ) ) );
+
+				B = xor3_avx2( B, rotl_avx2<CROSS_XOR_ROT_R0>( A ), broadcast_avx2( RC[ 4 ] ) );
+				A = _mm256_xor_si256( A, rotl_avx2<CROSS_XOR_ROT_R1>( B ) );
+
+				// Subround 1
+				A = _mm256_sub_epi32( A, broadcast_avx2( RC[ 6 ] ) );
+
+				__m256i C1, D1;
+				cd_injection_from_A_avx2( A, C1, D1 );
+
+				const __m256i CD2 = _mm256_xor_si256( _mm256_srli_epi32( C1, 3 ), _mm256_slli_epi32( D1, 3 ) );
+				const __m256i CD3 = _mm256_xor_si256( _mm256_slli_epi32( C1, 1 ), _mm256_srli_epi32( D1, 1 ) );
+
+				B = _mm256_xor_si256( B, xor3_avx2( rotr_avx2<24>( A ), rotr_avx2<16>( D1 ), rotr_avx2<8>( A ) ) );
+				B = _mm256_add_epi32( B, xor3_avx2( CD2, CD3, broadcast_avx2( RC[ 5 ] ) ) );
+
+				A = xor3_avx2( A, rotl_avx2<5>( B ), broadcast_avx2( RC[ 9 ] ) );
+				B = _mm256_xor_si256( B, rotl_avx2<25>( A ) );
+
+				// Final light whitening
+				a = _mm256_xor_si256( A, broadcast_avx2( RC[ 10 ] ) );
+				b = _mm256_xor_si256( B, broadcast_avx2( RC[ 11 ] ) );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE void backward_avx2( __m256i& a, __m256i& b ) const noexcept
+			{
+				const auto& RC = ROUND_CONSTANTS;
+
+				// Undo final whitening
+				__m256i B = _mm256_xor_si256( b, broadcast_avx2( RC[ 11 ] ) );
+				__m256i A = _mm256_xor_si256( a, broadcast_avx2( RC[ 10 ] ) );
+
+				// Undo Subround 1
+				B = _mm256_xor_si256( B, rotl_avx2<25>( A ) );
+				A = xor3_avx2( A, rotl_avx2<5>( B ), broadcast_avx2( RC[ 9 ] ) );
+
+				__m256i C1, D1;
+				cd_injection_from_A_avx2( A, C1, D1 );
+
+				const __m256i CD2 = _mm256_xor_si256( _mm256_srli_epi32( C1, 3 ), _mm256_slli_epi32( D1, 3 ) );
+				const __m256i CD3 = _mm256_xor_si256( _mm256_slli_epi32( C1, 1 ), _mm256_srli_epi32( D1, 1 ) );
+
+				B = _mm256_sub_epi32( B, xor3_avx2( CD2, CD3, broadcast_avx2( RC[ 5 ] ) ) );
+				B = _mm256_xor_si256( B, xor3_avx2( rotr_avx2<24>( A ), rotr_avx2<16>( D1 ), rotr_avx2<8>( A ) ) );
+
+				A = _mm256_add_epi32( A, broadcast_avx2( RC[ 6 ] ) );
+
+				// Undo Subround 0
+				A = _mm256_xor_si256( A, rotl_avx2<CROSS_XOR_ROT_R1>( B ) );
+				B = xor3_avx2( B, rotl_avx2<CROSS_XOR_ROT_R0>( A ), broadcast_avx2( RC[ 4 ] ) );
+
+				__m256i C0, D0;
+				cd_injection_from_B_avx2( B, C0, D0 );
+
+				const __m256i CD0 = _mm256_xor_si256( _mm256_slli_epi32( C0, 2 ), _mm256_srli_epi32( D0, 2 ) );
+				const __m256i CD1 = _mm256_xor_si256( _mm256_srli_epi32( C0, 5 ), _mm256_slli_epi32( D0, 5 ) );
+
+				A = _mm256_sub_epi32( A, xor3_avx2( rotl_avx2<31>( CD0 ), rotl_avx2<17>( CD1 ), broadcast_avx2( RC[ 0 ] ) ) );
+				A = _mm256_xor_si256( A, xor3_avx2( rotl_avx2<24>( B ), rotl_avx2<16>( C0 ), rotl_avx2<8>( B ) ) );
+
+				b = _mm256_add_epi32( B, broadcast_avx2( RC[ 1 ] ) );
+				a = A;
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx512f" )
+			TDOM_ALWAYS_INLINE void forward_avx512( __m512i& a, __m512i& b ) const noexcept
+			{
+				const auto& RC = ROUND_CONSTANTS;
+
+				__m512i A = a;
+				__m512i B = b;
+
+				// Subround 0
+				B = _mm512_sub_epi32( B, broadcast_avx512( RC[ 1 ] ) );
+
+				__m512i C0, D0;
+				cd_injection_from_B_avx512( B, C0, D0 );
+
+				const __m512i CD0 = _mm512_xor_si512( _mm512_slli_epi32( C0, 2 ), _mm512_srli_epi32( D0, 2 ) );
+				const __m512i CD1 = _mm512_xor_si512( _mm512_srli_epi32( C0, 5 ), _mm512_slli_epi32( D0, 5 ) );
+
+				A = _mm512_xor_si512( A, xor3_avx512( _mm512_rol_epi32( B, 24 ), _mm512_rol_epi32( C0, 16 ), _mm512_rol_epi32( B, 8 ) ) );
+				A = _mm512_add_epi32( A, xor3_avx512( _mm512_rol_epi32( CD0, 31 ), _mm512_rol_epi32( CD1, 17 ), broadcast_avx512( RC[ 0 ] ) ) );
+
+				B = xor3_avx512( B, _mm512_rol_epi32( A, CROSS_XOR_ROT_R0 ), broadcast_avx512( RC[ 4 ] ) );
+				A = _mm512_xor_si512( A, _mm512_rol_epi32( B, CROSS_XOR_ROT_R1 ) );
+
+				// Subround 1
+				A = _mm512_sub_epi32( A, broadcast_avx512( RC[ 6 ] ) );
+
+				__m512i C1, D1;
+				cd_injection_from_A_avx512( A, C1, D1 );
+
+				const __m512i CD2 = _mm512_xor_si512( _mm512_srli_epi32( C1, 3 ), _mm512_slli_epi32( D1, 3 ) );
+				const __m512i CD3 = _mm512_xor_si512( _mm512_slli_epi32( C1, 1 ), _mm512_srli_epi32( D1, 1 ) );
+
+				B = _mm512_xor_si512( B, xor3_avx512( _mm512_ror_epi32( A, 24 ), _mm512_ror_epi32( D1, 16 ), _mm512_ror_epi32( A, 8 ) ) );
+				B = _mm512_add_epi32( B, xor3_avx512( CD2, CD3, broadcast_avx512( RC[ 5 ] ) ) );
+
+				A = xor3_avx512( A, _mm512_rol_epi32( B, 5 ), broadcast_avx512( RC[ 9 ] ) );
+				B = _mm512_xor_si512( B, _mm512_rol_epi32( A, 25 ) );
+
+				// Final light whitening
+				a = _mm512_xor_si512( A, broadcast_avx512( RC[ 10 ] ) );
+				b = _mm512_xor_si512( B, broadcast_avx512( RC[ 11 ] ) );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx512f" )
+			TDOM_ALWAYS_INLINE void backward_avx512( __m512i& a, __m512i& b ) const noexcept
+			{
+				const auto& RC = ROUND_CONSTANTS;
+
+				// Undo final whitening
+				__m512i B = _mm512_xor_si512( b, broadcast_avx512( RC[ 11 ] ) );
+				__m512i A = _mm512_xor_si512( a, broadcast_avx512( RC[ 10 ] ) );
+
+				// Undo Subround 1
+				B = _mm512_xor_si512( B, _mm512_rol_epi32( A, 25 ) );
+				A = xor3_avx512( A, _mm512_rol_epi32( B, 5 ), broadcast_avx512( RC[ 9 ] ) );
+
+				__m512i C1, D1;
+				cd_injection_from_A_avx512( A, C1, D1 );
+
+				const __m512i CD2 = _mm512_xor_si512( _mm512_srli_epi32( C1, 3 ), _mm512_slli_epi32( D1, 3 ) );
+				const __m512i CD3 = _mm512_xor_si512( _mm512_slli_epi32( C1, 1 ), _mm512_srli_epi32( D1, 1 ) );
+
+				B = _mm512_sub_epi32( B, xor3_avx512( CD2, CD3, broadcast_avx512( RC[ 5 ] ) ) );
+				B = _mm512_xor_si512( B, xor3_avx512( _mm512_ror_epi32( A, 24 ), _mm512_ror_epi32( D1, 16 ), _mm512_ror_epi32( A, 8 ) ) );
+
+				A = _mm512_add_epi32( A, broadcast_avx512( RC[ 6 ] ) );
+
+				// Undo Subround 0
+				A = _mm512_xor_si512( A, _mm512_rol_epi32( B, CROSS_XOR_ROT_R1 ) );
+				B = xor3_avx512( B, _mm512_rol_epi32( A, CROSS_XOR_ROT_R0 ), broadcast_avx512( RC[ 4 ] ) );
+
+				__m512i C0, D0;
+				cd_injection_from_B_avx512( B, C0, D0 );
+
+				const __m512i CD0 = _mm512_xor_si512( _mm512_slli_epi32( C0, 2 ), _mm512_srli_epi32( D0, 2 ) );
+				const __m512i CD1 = _mm512_xor_si512( _mm512_srli_epi32( C0, 5 ), _mm512_slli_epi32( D0, 5 ) );
+
+				A = _mm512_sub_epi32( A, xor3_avx512( _mm512_rol_epi32( CD0, 31 ), _mm512_rol_epi32( CD1, 17 ), broadcast_avx512( RC[ 0 ] ) ) );
+				A = _mm512_xor_si512( A, xor3_avx512( _mm512_rol_epi32( B, 24 ), _mm512_rol_epi32( C0, 16 ), _mm512_rol_epi32( B, 8 ) ) );
+
+				b = _mm512_add_epi32( B, broadcast_avx512( RC[ 1 ] ) );
+				a = A;
+			}
+
+		#endif
+
 		private:
 			// ==== NeoAlzette ARX-box constants / NeoAlzette ARX-box 常量 ====
 			static inline constexpr auto ROUND_CONSTANTS = std::to_array<std::uint32_t>
@@ -502,6 +687,206 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				const std::uint32_t d = q_shared ^ std::rotl( q_state_no, 5 ) ^ std::rotl( q_bridge, 13 ) ^ cross_q ^ anti_q;
 				return { c, d };
 			}
+
+		#if defined( TDOM_PROCESSOR_X86 )
+
+			// ========================================================================
+			// SIMD helpers and lane-wise injection layer, the same expressions as
+			// generate_dynamic_diffusion_mask0/1 and cd_injection_from_B/A above.
+			// ========================================================================
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE static __m256i broadcast_avx2( std::uint32_t value ) noexcept
+			{
+				return _mm256_set1_epi32( static_cast<int>( value ) );
+			}
+
+			template <int Count>
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE static __m256i rotl_avx2( __m256i x ) noexcept
+			{
+				return _mm256_or_si256( _mm256_slli_epi32( x, Count ), _mm256_srli_epi32( x, 32 - Count ) );
+			}
+
+			template <int Count>
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE static __m256i rotr_avx2( __m256i x ) noexcept
+			{
+				return _mm256_or_si256( _mm256_srli_epi32( x, Count ), _mm256_slli_epi32( x, 32 - Count ) );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE static __m256i xor3_avx2( __m256i x, __m256i y, __m256i z ) noexcept
+			{
+				return _mm256_xor_si256( _mm256_xor_si256( x, y ), z );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE static __m256i generate_dynamic_diffusion_mask0_avx2( __m256i x ) noexcept
+			{
+				const __m256i v0 = x;
+				const __m256i v1 = _mm256_xor_si256( v0, rotl_avx2<2>( v0 ) );
+				const __m256i v2 = _mm256_xor_si256( v0, rotl_avx2<17>( v1 ) );
+				const __m256i v3 = _mm256_xor_si256( v0, rotl_avx2<4>( v2 ) );
+				const __m256i v4 = _mm256_xor_si256( v3, rotl_avx2<24>( v3 ) );
+				return _mm256_xor_si256( v2, rotl_avx2<7>( v4 ) );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE static __m256i generate_dynamic_diffusion_mask1_avx2( __m256i x ) noexcept
+			{
+				const __m256i v0 = x;
+				const __m256i v1 = _mm256_xor_si256( v0, rotr_avx2<2>( v0 ) );
+				const __m256i v2 = _mm256_xor_si256( v0, rotr_avx2<17>( v1 ) );
+				const __m256i v3 = _mm256_xor_si256( v0, rotr_avx2<4>( v2 ) );
+				const __m256i v4 = _mm256_xor_si256( v3, rotr_avx2<24>( v3 ) );
+				return _mm256_xor_si256( v2, rotr_avx2<7>( v4 ) );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE static void cd_injection_from_B_avx2( __m256i B, __m256i& c, __m256i& d ) noexcept
+			{
+				const __m256i all_ones = _mm256_set1_epi32( -1 );
+				const __m256i companion0 = rotr_avx2<24>( B );
+
+				const __m256i mask = generate_dynamic_diffusion_mask0_avx2( B );
+				const __m256i companion_mask = _mm256_xor_si256( rotr_avx2<24>( mask ), broadcast_avx2( MASK0_RC7 ) );
+				const __m256i mask_r1 = rotr_avx2<5>( mask );
+
+				const __m256i x0 = _mm256_xor_si256( companion0, mask );
+				const __m256i x1 = _mm256_xor_si256( B, mask );
+				const __m256i view = _mm256_xor_si256( companion0, companion_mask );
+				const __m256i bridge_state = _mm256_xor_si256( rotr_avx2<19>( B ), _mm256_slli_epi32( B, 9 ) );
+
+				const __m256i q_state_na = xor3_avx2( broadcast_avx2( RC7_R24 ), _mm256_and_si256( B, mask ), all_ones );
+				const __m256i q_comp_no  = _mm256_xor_si256( xor3_avx2( companion0, B, broadcast_avx2( RC8_R24 ) ), _mm256_xor_si256( _mm256_or_si256( companion0, mask_r1 ), all_ones ) );
+				const __m256i q_bridge   = _mm256_xor_si256( xor3_avx2( bridge_state, B, broadcast_avx2( RC13_R24 ) ), _mm256_xor_si256( _mm256_and_si256( bridge_state, companion_mask ), all_ones ) );
+				const __m256i q_shared   = _mm256_xor_si256( q_state_na, q_comp_no );
+
+				const __m256i cross_q = _mm256_and_si256( _mm256_xor_si256( B, mask_r1 ), rotr_avx2<7>( _mm256_xor_si256( mask, companion_mask ) ) );
+				const __m256i anti_q  = _mm256_and_si256( xor3_avx2( _mm256_srli_epi32( x1, 3 ), _mm256_srli_epi32( view, 5 ), mask_r1 ), _mm256_xor_si256( B, rotr_avx2<11>( x0 ) ) );
+
+				c = _mm256_xor_si256( xor3_avx2( q_shared, rotr_avx2<5>( q_comp_no ), rotr_avx2<11>( q_comp_no ) ), anti_q );
+				d = xor3_avx2( xor3_avx2( q_shared, rotr_avx2<5>( q_state_na ), rotr_avx2<13>( q_bridge ) ), cross_q, anti_q );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE static void cd_injection_from_A_avx2( __m256i A, __m256i& c, __m256i& d ) noexcept
+			{
+				const __m256i all_ones = _mm256_set1_epi32( -1 );
+				const __m256i companion0 = rotl_avx2<8>( A );
+
+				const __m256i mask = generate_dynamic_diffusion_mask1_avx2( A );
+				const __m256i companion_mask = _mm256_xor_si256( rotl_avx2<8>( mask ), broadcast_avx2( MASK1_RC2 ) );
+				const __m256i mask_r1 = rotr_avx2<5>( mask );
+
+				const __m256i x0 = _mm256_xor_si256( companion0, mask );
+				const __m256i x1 = _mm256_xor_si256( A, mask );
+				const __m256i view = _mm256_xor_si256( companion0, companion_mask );
+				const __m256i bridge_state = _mm256_xor_si256( rotl_avx2<19>( A ), _mm256_srli_epi32( A, 9 ) );
+
+				const __m256i q_state_no = xor3_avx2( broadcast_avx2( RC2_L8 ), _mm256_or_si256( A, mask ), all_ones );
+				const __m256i q_comp_na  = _mm256_xor_si256( xor3_avx2( companion0, A, broadcast_avx2( RC3_L8 ) ), _mm256_xor_si256( _mm256_and_si256( companion0, mask_r1 ), all_ones ) );
+				const __m256i q_bridge   = _mm256_xor_si256( xor3_avx2( bridge_state, A, broadcast_avx2( RC12_L8 ) ), _mm256_xor_si256( _mm256_or_si256( bridge_state, companion_mask ), all_ones ) );
+				const __m256i q_shared   = _mm256_xor_si256( q_state_no, q_comp_na );
+
+				const __m256i cross_q = _mm256_and_si256( _mm256_xor_si256( A, mask_r1 ), rotl_avx2<13>( _mm256_xor_si256( mask, companion_mask ) ) );
+				const __m256i anti_q  = _mm256_or_si256( xor3_avx2( _mm256_slli_epi32( x1, 3 ), _mm256_slli_epi32( view, 5 ), mask_r1 ), _mm256_xor_si256( A, rotl_avx2<11>( x0 ) ) );
+
+				c = _mm256_xor_si256( xor3_avx2( q_shared, rotl_avx2<5>( q_comp_na ), rotl_avx2<11>( q_comp_na ) ), anti_q );
+				d = xor3_avx2( xor3_avx2( q_shared, rotl_avx2<5>( q_state_no ), rotl_avx2<13>( q_bridge ) ), cross_q, anti_q );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx512f" )
+			TDOM_ALWAYS_INLINE static __m512i broadcast_avx512( std::uint32_t value ) noexcept
+			{
+				return _mm512_set1_epi32( static_cast<int>( value ) );
+			}
+
+			// x ^ y ^ z in one ternary-logic instruction
+			TDOM_TARGET_ATTRIBUTE( "avx512f" )
+			TDOM_ALWAYS_INLINE static __m512i xor3_avx512( __m512i x, __m512i y, __m512i z ) noexcept
+			{
+				return _mm512_ternarylogic_epi32( x, y, z, 0x96 );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx512f" )
+			TDOM_ALWAYS_INLINE static __m512i generate_dynamic_diffusion_mask0_avx512( __m512i x ) noexcept
+			{
+				const __m512i v0 = x;
+				const __m512i v1 = _mm512_xor_si512( v0, _mm512_rol_epi32( v0, 2 ) );
+				const __m512i v2 = _mm512_xor_si512( v0, _mm512_rol_epi32( v1, 17 ) );
+				const __m512i v3 = _mm512_xor_si512( v0, _mm512_rol_epi32( v2, 4 ) );
+				const __m512i v4 = _mm512_xor_si512( v3, _mm512_rol_epi32( v3, 24 ) );
+				return _mm512_xor_si512( v2, _mm512_rol_epi32( v4, 7 ) );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx512f" )
+			TDOM_ALWAYS_INLINE static __m512i generate_dynamic_diffusion_mask1_avx512( __m512i x ) noexcept
+			{
+				const __m512i v0 = x;
+				const __m512i v1 = _mm512_xor_si512( v0, _mm512_ror_epi32( v0, 2 ) );
+				const __m512i v2 = _mm512_xor_si512( v0, _mm512_ror_epi32( v1, 17 ) );
+				const __m512i v3 = _mm512_xor_si512( v0, _mm512_ror_epi32( v2, 4 ) );
+				const __m512i v4 = _mm512_xor_si512( v3, _mm512_ror_epi32( v3, 24 ) );
+				return _mm512_xor_si512( v2, _mm512_ror_epi32( v4, 7 ) );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx512f" )
+			TDOM_ALWAYS_INLINE static void cd_injection_from_B_avx512( __m512i B, __m512i& c, __m512i& d ) noexcept
+			{
+				const __m512i all_ones = _mm512_set1_epi32( -1 );
+				const __m512i companion0 = _mm512_ror_epi32( B, 24 );
+
+				const __m512i mask = generate_dynamic_diffusion_mask0_avx512( B );
+				const __m512i companion_mask = _mm512_xor_si512( _mm512_ror_epi32( mask, 24 ), broadcast_avx512( MASK0_RC7 ) );
+				const __m512i mask_r1 = _mm512_ror_epi32( mask, 5 );
+
+				const __m512i x0 = _mm512_xor_si512( companion0, mask );
+				const __m512i x1 = _mm512_xor_si512( B, mask );
+				const __m512i view = _mm512_xor_si512( companion0, companion_mask );
+				const __m512i bridge_state = _mm512_xor_si512( _mm512_ror_epi32( B, 19 ), _mm512_slli_epi32( B, 9 ) );
+
+				const __m512i q_state_na = xor3_avx512( broadcast_avx512( RC7_R24 ), _mm512_and_si512( B, mask ), all_ones );
+				const __m512i q_comp_no  = _mm512_xor_si512( xor3_avx512( companion0, B, broadcast_avx512( RC8_R24 ) ), _mm512_xor_si512( _mm512_or_si512( companion0, mask_r1 ), all_ones ) );
+				const __m512i q_bridge   = _mm512_xor_si512( xor3_avx512( bridge_state, B, broadcast_avx512( RC13_R24 ) ), _mm512_xor_si512( _mm512_and_si512( bridge_state, companion_mask ), all_ones ) );
+				const __m512i q_shared   = _mm512_xor_si512( q_state_na, q_comp_no );
+
+				const __m512i cross_q = _mm512_and_si512( _mm512_xor_si512( B, mask_r1 ), _mm512_ror_epi32( _mm512_xor_si512( mask, companion_mask ), 7 ) );
+				const __m512i anti_q  = _mm512_and_si512( xor3_avx512( _mm512_srli_epi32( x1, 3 ), _mm512_srli_epi32( view, 5 ), mask_r1 ), _mm512_xor_si512( B, _mm512_ror_epi32( x0, 11 ) ) );
+
+				c = _mm512_xor_si512( xor3_avx512( q_shared, _mm512_ror_epi32( q_comp_no, 5 ), _mm512_ror_epi32( q_comp_no, 11 ) ), anti_q );
+				d = xor3_avx512( xor3_avx512( q_shared, _mm512_ror_epi32( q_state_na, 5 ), _mm512_ror_epi32( q_bridge, 13 ) ), cross_q, anti_q );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx512f" )
+			TDOM_ALWAYS_INLINE static void cd_injection_from_A_avx512( __m512i A, __m512i& c, __m512i& d ) noexcept
+			{
+				const __m512i all_ones = _mm512_set1_epi32( -1 );
+				const __m512i companion0 = _mm512_rol_epi32( A, 8 );
+
+				const __m512i mask = generate_dynamic_diffusion_mask1_avx512( A );
+				const __m512i companion_mask = _mm512_xor_si512( _mm512_rol_epi32( mask, 8 ), broadcast_avx512( MASK1_RC2 ) );
+				const __m512i mask_r1 = _mm512_ror_epi32( mask, 5 );
+
+				const __m512i x0 = _mm512_xor_si512( companion0, mask );
+				const __m512i x1 = _mm512_xor_si512( A, mask );
+				const __m512i view = _mm512_xor_si512( companion0, companion_mask );
+				const __m512i bridge_state = _mm512_xor_si512( _mm512_rol_epi32( A, 19 ), _mm512_srli_epi32( A, 9 ) );
+
+				const __m512i q_state_no = xor3_avx512( broadcast_avx512( RC2_L8 ), _mm512_or_si512( A, mask ), all_ones );
+				const __m512i q_comp_na  = _mm512_xor_si512( xor3_avx512( companion0, A, broadcast_avx512( RC3_L8 ) ), _mm512_xor_si512( _mm512_and_si512( companion0, mask_r1 ), all_ones ) );
+				const __m512i q_bridge   = _mm512_xor_si512( xor3_avx512( bridge_state, A, broadcast_avx512( RC12_L8 ) ), _mm512_xor_si512( _mm512_or_si512( bridge_state, companion_mask ), all_ones ) );
+				const __m512i q_shared   = _mm512_xor_si512( q_state_no, q_comp_na );
+
+				const __m512i cross_q = _mm512_and_si512( _mm512_xor_si512( A, mask_r1 ), _mm512_rol_epi32( _mm512_xor_si512( mask, companion_mask ), 13 ) );
+				const __m512i anti_q  = _mm512_or_si512( xor3_avx512( _mm512_slli_epi32( x1, 3 ), _mm512_slli_epi32( view, 5 ), mask_r1 ), _mm512_xor_si512( A, _mm512_rol_epi32( x0, 11 ) ) );
+
+				c = _mm512_xor_si512( xor3_avx512( q_shared, _mm512_rol_epi32( q_comp_na, 5 ), _mm512_rol_epi32( q_comp_na, 11 ) ), anti_q );
+				d = xor3_avx512( xor3_avx512( q_shared, _mm512_rol_epi32( q_state_no, 5 ), _mm512_rol_epi32( q_bridge, 13 ) ), cross_q, anti_q );
+			}
+
+		#endif
 		};
 		
 		// ---------------------------------------------------------------------
@@ -537,13 +922,14 @@ namespace TwilightDreamOfMagical::CustomSecurity
 		//
 		// No extra ad-hoc round constants are injected here;
 		// round only affects position / routing.
-		void LittleOaldresPuzzle_Cryptic::GenerateAndStoreKeyStates(const Key128 key_128bit, const std::uint64_t number_once)
+		//
+		// The `rounds` key states are written to `key_states` (KeyStates for one block,
+		// or one block's slice of BatchKeyStates for the multi-block path).
+		void LittleOaldresPuzzle_Cryptic::GenerateAndStoreKeyStates(const Key128 key_128bit, const std::uint64_t number_once, KeyState* key_states)
 		{
 			// 注意：这里不构造任何 XorConstantRotation 实例，只使用成员 prng / prng_second
 			for (std::uint64_t round = 0; round < rounds; ++round)
 			{
-				KeyState& key_state = KeyStates[round];
-
 				const std::uint64_t input_left  = number_once ^ round;
 				const std::uint64_t input_right = (number_once ^ (round << 1)) ^ (round >> 1);
 
@@ -551,49 +937,107 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				const auto out_left  = prng.GenerateSubKey128(input_left);
 				const auto out_right = prng_second.GenerateSubKey128(input_right);
 
-				const std::uint64_t a = out_left.a;
-				const std::uint64_t b = out_left.b;
-				const std::uint64_t c = out_right.a;
-				const std::uint64_t d = out_right.b;
+				key_states[round] = FoldKeyState(key_128bit, out_left, out_right, round);
+			}
+		}
 
-				// ---------------------------------------------------------------------
-				// ARX-shaped subkey folding
-				//
-				// IMPORTANT:
-				// We intentionally use the form
-				//   (key +/- xcr_word) ^ rotated_xcr_word
-				// and NOT
-				//   key +/- (xcr_word ^ rotated_xcr_word).
-				//
-				// Reason:
-				// - The chosen form keeps the modular add/sub core isolated first,
-				//   then applies a rotated-XOR outer perturbation.
-				// - This preserves a cleaner modeling boundary for differential / linear /
-				//   dependency-bit / state-machine style analysis.
-				// - The rejected alternative would push the mixed XCR value directly into the
-				//   carry/borrow chain, entangling XCR-side structure with the modular core
-				//   and forcing a broader rework of the subkey model.
-				//
-				// In short:
-				//   chosen   : ARX core first, XOR shell later
-				//   rejected : XCR mixture first, carry entanglement later
-				// ---------------------------------------------------------------------
-				// round 参与“位置”，不引入额外常量
-				// 生成 128-bit subkey（Key128 的 first/second）
-				key_state.subkey.first  = (key_128bit.first  + a) ^ std::rotr(c, static_cast<int>(round & 63ULL));
-				key_state.subkey.second = (key_128bit.second - b) ^ std::rotr(d, static_cast<int>((round + 1) & 63ULL));
-
-				// choice：只要 2-bit
-				key_state.choice_function = (a ^ b ^ c ^ d) & 3ULL;
-
-				// rotation amounts：从同一轮输出切片（6+6）
-				const std::uint64_t rot_pool =
-					(a ^ b) ^ (c ^ d) ^
-					std::rotl(key_state.subkey.first, 1) ^
-					std::rotl(key_state.subkey.second, 3);
-
-				key_state.bit_rotation_amount_a = ( rot_pool        ) & 63ULL;  // bits 0..5
-				key_state.bit_rotation_amount_b = ((rot_pool >> 6 ) ) & 63ULL;  // bits 6..11
+		LittleOaldresPuzzle_Cryptic::KeyState LittleOaldresPuzzle_Cryptic::FoldKeyState
+		(
+			const Key128 key_128bit, const XorConstantRotation::GeneratedSubKey128 out_left, const XorConstantRotation::GeneratedSubKey128 out_right, const std::uint64_t round
+		)
+		{
+			KeyState key_state;
+
+			const std::uint64_t a = out_left.a;
+			const std::uint64_t b = out_left.b;
+			const std::uint64_t c = out_right.a;
+			const std::uint64_t d = out_right.b;
+
+			// ---------------------------------------------------------------------
+			// ARX-shaped subkey folding
+			//
+			// IMPORTANT:
+			// We intentionally use the form
+			//   (key +/- xcr_word) ^ rotated_xcr_word
+			// and NOT
+			//   key +/- (xcr_word ^ rotated_xcr_word).
+			//
+			// Reason:
+			// - The chosen form keeps the modular add/sub core isolated first,
+			//   then applies a rotated-XOR outer perturbation.
+			// - This preserves a cleaner modeling boundary for differential / linear /
+			//   dependency-bit / state-machine style analysis.
+			// - The rejected alternative would push the mixed XCR value directly into the
+			//   carry/borrow chain, entangling XCR-side structure with the modular core
+			//   and forcing a broader rework of the subkey model.
+			//
+			// In short:
+			//   chosen   : ARX core first, XOR shell later
+			//   rejected : XCR mixture first, carry entanglement later
+			// ---------------------------------------------------------------------
+			// round 参与“位置”，不引入额外常量
+			// 生成 128-bit subkey（Key128 的 first/second）
+			key_state.subkey.first  = (key_128bit.first  + a) ^ std::rotr(c, static_cast<int>(round & 63ULL));
+			key_state.subkey.second = (key_128bit.second - b) ^ std::rotr(d, static_cast<int>((round + 1) & 63ULL));
+
+			// choice：只要 2-bit
+			key_state.choice_function = (a ^ b ^ c ^ d) & 3ULL;
+
+			// rotation amounts：从同一轮输出切片（6+6）
+			const std::uint64_t rot_pool =
+				(a ^ b) ^ (c ^ d) ^
+				std::rotl(key_state.subkey.first, 1) ^
+				std::rotl(key_state.subkey.second, 3);
+
+			key_state.bit_rotation_amount_a = ( rot_pool        ) & 63ULL;  // bits 0..5
+			key_state.bit_rotation_amount_b = ((rot_pool >> 6 ) ) & 63ULL;  // bits 6..11
+
+			return key_state;
+		}
+
+		// ---------------------------------------------------------------------
+		// Key schedule of consecutive blocks (structure-of-arrays)
+		// ---------------------------------------------------------------------
+		// Produces exactly the key states that GenerateAndStoreKeyStates would produce
+		// for blocks first_block .. first_block + block_count - 1, one call per block.
+		//
+		// The first pass only calls the generators, in the same order as the one-block
+		// path (block after block, round after round).  `prng` and `prng_second` are
+		// independent objects whose inputs depend only on number_once and round, so
+		// their two dependency chains stay in flight side by side with nothing else
+		// in between.  The second pass folds the raw outputs into the round-major
+		// tables without touching any generator state.
+		void LittleOaldresPuzzle_Cryptic::GenerateKeySchedule
+		(
+			std::span<const Key128> keys, const std::uint64_t first_number_once, const std::size_t first_block, const std::size_t block_count
+		)
+		{
+			KeySchedule& schedule = BatchKeySchedule;
+
+			for (std::size_t block = 0; block < block_count; ++block)
+			{
+				const std::uint64_t number_once = first_number_once + first_block + block;
+				for (std::uint64_t round = 0; round < rounds; ++round)
+				{
+					schedule.left_outputs[block * rounds + round] = prng.GenerateSubKey128(number_once ^ round);
+					schedule.right_outputs[block * rounds + round] = prng_second.GenerateSubKey128((number_once ^ (round << 1)) ^ (round >> 1));
+				}
+			}
+
+			for (std::uint64_t round = 0; round < rounds; ++round)
+			{
+				for (std::size_t block = 0; block < block_count; ++block)
+				{
+					const Key128&  key = keys[(first_block + block) % keys.size()];
+					const KeyState key_state = FoldKeyState(key, schedule.left_outputs[block * rounds + round], schedule.right_outputs[block * rounds + round], round);
+
+					const std::size_t index = round * KeySchedule::capacity + block;
+					schedule.subkey_first[index] = key_state.subkey.first;
+					schedule.subkey_second[index] = key_state.subkey.second;
+					schedule.choice_function[index] = key_state.choice_function;
+					schedule.bit_rotation_amount_a[index] = key_state.bit_rotation_amount_a;
+					schedule.bit_rotation_amount_b[index] = key_state.bit_rotation_amount_b;
+				}
 			}
 		}
 
@@ -723,11 +1167,312 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			lane1 = (lane1_case0 & m0) | (lane1_case1 & m1) | (lane1_case2 & m2) | (lane1_case3 & m3);
 		}
 
+		// ---------------------------------------------------------------------
+		// Multi-block data path
+		// ---------------------------------------------------------------------
+		// The key states of a block depend on the two stateful member XCR instances,
+		// so they are generated in order, a chunk at a time, into a KeySchedule
+		// (see GenerateKeySchedule).  Everything after that is independent per block: one 64-bit SIMD lane holds one 64-bit lane of a block
+		// (lane0 in one register, lane1 in another), and the NeoAlzette ARX-box runs on
+		// the same registers as 32-bit lanes.  With x86 lane order the low half of lane0
+		// is w1 and the high half is w0 (w3 / w2 for lane1), so the 32-bit lanes pair up
+		// as (w1, w3) and (w0, w2), exactly the diagonal pairing of the scalar round.
+		//
+		// MixLinearTransform keeps its constant-time form: all four cases are computed
+		// and the result is selected with per-lane equality masks.
+		namespace
+		{
+			enum class BlockKernelKind : std::uint8_t
+			{
+				Scalar,
+				// 4 blocks at a time
+				AVX2,
+				// 8 blocks at a time
+				AVX512
+			};
+
+			BlockKernelKind SelectBlockKernel()
+			{
+				static const BlockKernelKind Selected = []()
+				{
+					const auto& Features = TwilightDreamOfMagical::BaseOperation::CurrentProcessorFeatures();
+
+					if ( Features.AVX512F )
+						return BlockKernelKind::AVX512;
+					if ( Features.AVX2 )
+						return BlockKernelKind::AVX2;
+					return BlockKernelKind::Scalar;
+				}();
+
+				return Selected;
+			}
+
+			std::size_t BlockKernelWidth( const BlockKernelKind kernel )
+			{
+				switch ( kernel )
+				{
+				case BlockKernelKind::AVX512:
+					return 8;
+				case BlockKernelKind::AVX2:
+					return 4;
+				default:
+					return 1;
+				}
+			}
+
+		#if defined( TDOM_PROCESSOR_X86 )
+
+			// One round of key material for neighbouring blocks, pointing into a KeySchedule (fields are round-major)
+			struct KeyScheduleRound
+			{
+				const std::uint64_t* subkey_first;
+				const std::uint64_t* subkey_second;
+				const std::uint64_t* choice_function;
+				const std::uint64_t* bit_rotation_amount_a;
+				const std::uint64_t* bit_rotation_amount_b;
+			};
+
+			template <typename KeyScheduleType>
+			KeyScheduleRound MakeKeyScheduleRound( const KeyScheduleType& schedule, const std::size_t round, const std::size_t first_block )
+			{
+				const std::size_t index = round * KeyScheduleType::capacity + first_block;
+
+				return KeyScheduleRound
+				{
+					schedule.subkey_first.data() + index,
+					schedule.subkey_second.data() + index,
+					schedule.choice_function.data() + index,
+					schedule.bit_rotation_amount_a.data() + index,
+					schedule.bit_rotation_amount_b.data() + index
+				};
+			}
+
+			// AVX2 has no 64-bit rotate; a right shift by 64 yields 0, so a count of 0 is correct
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE __m256i RotateLeftVariable64_AVX2( __m256i value, __m256i count )
+			{
+				return _mm256_or_si256( _mm256_sllv_epi64( value, count ), _mm256_srlv_epi64( value, _mm256_sub_epi64( _mm256_set1_epi64x( 64 ), count ) ) );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE __m256i RotateRightVariable64_AVX2( __m256i value, __m256i count )
+			{
+				return _mm256_or_si256( _mm256_srlv_epi64( value, count ), _mm256_sllv_epi64( value, _mm256_sub_epi64( _mm256_set1_epi64x( 64 ), count ) ) );
+			}
+
+			// Lane-wise MixLinearTransform_Forward (IsForward) / MixLinearTransform_Backward
+			template <bool IsForward>
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE void MixLinearTransform_AVX2( __m256i& lane0, __m256i& lane1, const KeyScheduleRound& key_round )
+			{
+				const __m256i all_ones = _mm256_set1_epi64x( -1 );
+				const __m256i subkey_first = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( key_round.subkey_first ) );
+				const __m256i subkey_second = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( key_round.subkey_second ) );
+				const __m256i choice_function = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( key_round.choice_function ) );
+				const __m256i rotation_amount = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( key_round.bit_rotation_amount_b ) );
+
+				const __m256i lane0_case0 = _mm256_xor_si256( lane0, subkey_first );
+				const __m256i lane1_case0 = _mm256_xor_si256( lane1, subkey_second );
+
+				const __m256i lane0_case1 = _mm256_xor_si256( lane0_case0, all_ones );
+				const __m256i lane1_case1 = _mm256_xor_si256( lane1_case0, all_ones );
+
+				const __m256i lane0_case2 = IsForward ? RotateLeftVariable64_AVX2( lane0, rotation_amount ) : RotateRightVariable64_AVX2( lane0, rotation_amount );
+				const __m256i lane1_case2 = IsForward ? RotateLeftVariable64_AVX2( lane1, rotation_amount ) : RotateRightVariable64_AVX2( lane1, rotation_amount );
+
+				const __m256i lane0_case3 = IsForward ? RotateRightVariable64_AVX2( lane0, rotation_amount ) : RotateLeftVariable64_AVX2( lane0, rotation_amount );
+				const __m256i lane1_case3 = IsForward ? RotateRightVariable64_AVX2( lane1, rotation_amount ) : RotateLeftVariable64_AVX2( lane1, rotation_amount );
+
+				const __m256i m0 = _mm256_cmpeq_epi64( choice_function, _mm256_setzero_si256() );
+				const __m256i m1 = _mm256_cmpeq_epi64( choice_function, _mm256_set1_epi64x( 1 ) );
+				const __m256i m2 = _mm256_cmpeq_epi64( choice_function, _mm256_set1_epi64x( 2 ) );
+				const __m256i m3 = _mm256_cmpeq_epi64( choice_function, _mm256_set1_epi64x( 3 ) );
+
+				lane0 = _mm256_or_si256( _mm256_or_si256( _mm256_and_si256( lane0_case0, m0 ), _mm256_and_si256( lane0_case1, m1 ) ), _mm256_or_si256( _mm256_and_si256( lane0_case2, m2 ), _mm256_and_si256( lane0_case3, m3 ) ) );
+				lane1 = _mm256_or_si256( _mm256_or_si256( _mm256_and_si256( lane1_case0, m0 ), _mm256_and_si256( lane1_case1, m1 ) ), _mm256_or_si256( _mm256_and_si256( lane1_case2, m2 ), _mm256_and_si256( lane1_case3, m3 ) ) );
+			}
+
+			// Random Bit Tweak, its own inverse
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE void RandomBitTweak_AVX2( __m256i& lane0, __m256i& lane1, const KeyScheduleRound& key_round )
+			{
+				const __m256i one = _mm256_set1_epi64x( 1 );
+				const __m256i rotation_amount = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( key_round.bit_rotation_amount_a ) );
+
+				lane0 = _mm256_xor_si256( lane0, _mm256_sllv_epi64( one, rotation_amount ) );
+				lane1 = _mm256_xor_si256( lane1, _mm256_sllv_epi64( one, _mm256_sub_epi64( _mm256_set1_epi64x( 63 ), rotation_amount ) ) );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			TDOM_ALWAYS_INLINE void AddRoundKey_AVX2( __m256i& lane0, __m256i& lane1, const KeyScheduleRound& key_round )
+			{
+				lane0 = _mm256_xor_si256( lane0, _mm256_loadu_si256( reinterpret_cast<const __m256i*>( key_round.subkey_first ) ) );
+				lane1 = _mm256_xor_si256( lane1, _mm256_loadu_si256( reinterpret_cast<const __m256i*>( key_round.subkey_second ) ) );
+			}
+
+			// Same rounds as EncryptionRoundsFunction (IsEncryption) / DecryptionRoundsFunction for 4 blocks,
+			// with the key states of schedule blocks first_block .. first_block + 3
+			template <bool IsEncryption, typename KeyScheduleType>
+			TDOM_TARGET_ATTRIBUTE( "avx2" )
+			void RoundsFunction_AVX2( const Block128* data, Block128* result, const KeyScheduleType& schedule, const std::size_t first_block, const std::size_t rounds )
+			{
+				const NeoAlzetteSubstitutionBox SubstitutionBox;
+
+				alignas( 32 ) std::uint64_t lanes[ 2 ][ 4 ];
+				for ( std::size_t block = 0; block < 4; ++block )
+				{
+					lanes[ 0 ][ block ] = data[ block ].first;
+					lanes[ 1 ][ block ] = data[ block ].second;
+				}
+
+				__m256i lane0 = _mm256_load_si256( reinterpret_cast<const __m256i*>( lanes[ 0 ] ) );
+				__m256i lane1 = _mm256_load_si256( reinterpret_cast<const __m256i*>( lanes[ 1 ] ) );
+
+				for ( std::size_t index = 0; index < rounds; ++index )
+				{
+					const std::size_t round = IsEncryption ? index : rounds - 1 - index;
+					const KeyScheduleRound key_round = MakeKeyScheduleRound( schedule, round, first_block );
+
+					if constexpr ( IsEncryption )
+					{
+						AddRoundKey_AVX2( lane0, lane1, key_round );
+						SubstitutionBox.forward_avx2( lane0, lane1 );
+						MixLinearTransform_AVX2<true>( lane0, lane1, key_round );
+						RandomBitTweak_AVX2( lane0, lane1, key_round );
+					}
+					else
+					{
+						RandomBitTweak_AVX2( lane0, lane1, key_round );
+						MixLinearTransform_AVX2<false>( lane0, lane1, key_round );
+						SubstitutionBox.backward_avx2( lane0, lane1 );
+						AddRoundKey_AVX2( lane0, lane1, key_round );
+					}
+				}
+
+				_mm256_store_si256( reinterpret_cast<__m256i*>( lanes[ 0 ] ), lane0 );
+				_mm256_store_si256( reinterpret_cast<__m256i*>( lanes[ 1 ] ), lane1 );
+
+				for ( std::size_t block = 0; block < 4; ++block )
+					result[ block ] = Block128 { lanes[ 0 ][ block ], lanes[ 1 ][ block ] };
+			}
+
+			// Lane-wise MixLinearTransform_Forward (IsForward) / MixLinearTransform_Backward
+			template <bool IsForward>
+			TDOM_TARGET_ATTRIBUTE( "avx512f" )
+			TDOM_ALWAYS_INLINE void MixLinearTransform_AVX512( __m512i& lane0, __m512i& lane1, const KeyScheduleRound& key_round )
+			{
+				const __m512i all_ones = _mm512_set1_epi64( -1 );
+				const __m512i subkey_first = _mm512_loadu_si512( key_round.subkey_first );
+				const __m512i subkey_second = _mm512_loadu_si512( key_round.subkey_second );
+				const __m512i choice_function = _mm512_loadu_si512( key_round.choice_function );
+				const __m512i rotation_amount = _mm512_loadu_si512( key_round.bit_rotation_amount_b );
+
+				const __m512i lane0_case0 = _mm512_xor_si512( lane0, subkey_first );
+				const __m512i lane1_case0 = _mm512_xor_si512( lane1, subkey_second );
+
+				const __m512i lane0_case1 = _mm512_xor_si512( lane0_case0, all_ones );
+				const __m512i lane1_case1 = _mm512_xor_si512( lane1_case0, all_ones );
+
+				const __m512i lane0_case2 = IsForward ? _mm512_rolv_epi64( lane0, rotation_amount ) : _mm512_rorv_epi64( lane0, rotation_amount );
+				const __m512i lane1_case2 = IsForward ? _mm512_rolv_epi64( lane1, rotation_amount ) : _mm512_rorv_epi64( lane1, rotation_amount );
+
+				const __m512i lane0_case3 = IsForward ? _mm512_rorv_epi64( lane0, rotation_amount ) : _mm512_rolv_epi64( lane0, rotation_amount );
+				const __m512i lane1_case3 = IsForward ? _mm512_rorv_epi64( lane1, rotation_amount ) : _mm512_rolv_epi64( lane1, rotation_amount );
+
+				const __mmask8 m1 = _mm512_cmpeq_epi64_mask( choice_function, _mm512_set1_epi64( 1 ) );
+				const __mmask8 m2 = _mm512_cmpeq_epi64_mask( choice_function, _mm512_set1_epi64( 2 ) );
+				const __mmask8 m3 = _mm512_cmpeq_epi64_mask( choice_function, _mm512_set1_epi64( 3 ) );
+
+				// Exactly one case applies to every lane, case 0 is the lanes left over
+				lane0 = _mm512_mask_blend_epi64( m3, _mm512_mask_blend_epi64( m2, _mm512_mask_blend_epi64( m1, lane0_case0, lane0_case1 ), lane0_case2 ), lane0_case3 );
+				lane1 = _mm512_mask_blend_epi64( m3, _mm512_mask_blend_epi64( m2, _mm512_mask_blend_epi64( m1, lane1_case0, lane1_case1 ), lane1_case2 ), lane1_case3 );
+			}
+
+			// Random Bit Tweak, its own inverse
+			TDOM_TARGET_ATTRIBUTE( "avx512f" )
+			TDOM_ALWAYS_INLINE void RandomBitTweak_AVX512( __m512i& lane0, __m512i& lane1, const KeyScheduleRound& key_round )
+			{
+				const __m512i one = _mm512_set1_epi64( 1 );
+				const __m512i rotation_amount = _mm512_loadu_si512( key_round.bit_rotation_amount_a );
+
+				lane0 = _mm512_xor_si512( lane0, _mm512_sllv_epi64( one, rotation_amount ) );
+				lane1 = _mm512_xor_si512( lane1, _mm512_sllv_epi64( one, _mm512_sub_epi64( _mm512_set1_epi64( 63 ), rotation_amount ) ) );
+			}
+
+			TDOM_TARGET_ATTRIBUTE( "avx512f" )
+			TDOM_ALWAYS_INLINE void AddRoundKey_AVX512( __m512i& lane0, __m512i& lane1, const KeyScheduleRound& key_round )
+			{
+				lane0 = _mm512_xor_si512( lane0, _mm512_loadu_si512( key_round.subkey_first ) );
+				lane1 = _mm512_xor_si512( lane1, _mm512_loadu_si512( key_round.subkey_second ) );
+			}
+
+			// Same rounds as EncryptionRoundsFunction (IsEncryption) / DecryptionRoundsFunction for 8 blocks,
+			// with the key states of schedule blocks first_block .. first_block + 7
+			template <bool IsEncryption, typename KeyScheduleType>
+			TDOM_TARGET_ATTRIBUTE( "avx512f" )
+			void RoundsFunction_AVX512( const Block128* data, Block128* result, const KeyScheduleType& schedule, const std::size_t first_block, const std::size_t rounds )
+			{
+				const NeoAlzetteSubstitutionBox SubstitutionBox;
+
+				alignas( 64 ) std::uint64_t lanes[ 2 ][ 8 ];
+				for ( std::size_t block = 0; block < 8; ++block )
+				{
+					lanes[ 0 ][ block ] = data[ block ].first;
+					lanes[ 1 ][ block ] = data[ block ].second;
+				}
+
+				__m512i lane0 = _mm512_load_si512( lanes[ 0 ] );
+				__m512i lane1 = _mm512_load_si512( lanes[ 1 ] );
+
+				for ( std::size_t index = 0; index < rounds; ++index )
+				{
+					const std::size_t round = IsEncryption ? index : rounds - 1 - index;
+					const KeyScheduleRound key_round = MakeKeyScheduleRound( schedule, round, first_block );
+
+					if constexpr ( IsEncryption )
+					{
+						AddRoundKey_AVX512( lane0, lane1, key_round );
+						SubstitutionBox.forward_avx512( lane0, lane1 );
+						MixLinearTransform_AVX512<true>( lane0, lane1, key_round );
+						RandomBitTweak_AVX512( lane0, lane1, key_round );
+					}
+					else
+					{
+						RandomBitTweak_AVX512( lane0, lane1, key_round );
+						MixLinearTransform_AVX512<false>( lane0, lane1, key_round );
+						SubstitutionBox.backward_avx512( lane0, lane1 );
+						AddRoundKey_AVX512( lane0, lane1, key_round );
+					}
+				}
+
+				_mm512_store_si512( lanes[ 0 ], lane0 );
+				_mm512_store_si512( lanes[ 1 ], lane1 );
+
+				for ( std::size_t block = 0; block < 8; ++block )
+					result[ block ] = Block128 { lanes[ 0 ][ block ], lanes[ 1 ][ block ] };
+			}
+
+		#endif
+		}  // namespace
+
 		Block128 LittleOaldresPuzzle_Cryptic::EncryptionCoreFunction( const Block128 data, const Key128 key, const std::uint64_t number_once )
 		{
 			// 生成并缓存密钥状态（保持实现不变）
-			GenerateAndStoreKeyStates( key, number_once );
+			GenerateAndStoreKeyStates( key, number_once, KeyStates.data() );
+
+			return EncryptionRoundsFunction( data, KeyStates.data() );
+		}
+
+		Block128 LittleOaldresPuzzle_Cryptic::DecryptionCoreFunction( const Block128 data, const Key128 key, const std::uint64_t number_once )
+		{
+			// 生成并缓存密钥状态（保持实现不变）
+			GenerateAndStoreKeyStates( key, number_once, KeyStates.data() );
 
+			return DecryptionRoundsFunction( data, KeyStates.data() );
+		}
+
+		Block128 LittleOaldresPuzzle_Cryptic::EncryptionRoundsFunction( const Block128 data, const KeyState* key_states )
+		{
 			NeoAlzetteSubstitutionBox SubstitutionBox;
 
 			// 128-bit 状态按两条 64-bit 车道存放
@@ -739,7 +1484,7 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 			for ( size_t round = 0; round < rounds; ++round )
 			{
-				const KeyState& current_key_state = KeyStates[ round ];
+				const KeyState& current_key_state = key_states[ round ];
 
 				// Add Round Key
 				lane0 ^= current_key_state.subkey.first;
@@ -770,11 +1515,8 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			return Block128 { lane0, lane1 };
 		}
 
-		Block128 LittleOaldresPuzzle_Cryptic::DecryptionCoreFunction( const Block128 data, const Key128 key, const std::uint64_t number_once )
+		Block128 LittleOaldresPuzzle_Cryptic::DecryptionRoundsFunction( const Block128 data, const KeyState* key_states )
 		{
-			// 生成并缓存密钥状态（保持实现不变）
-			GenerateAndStoreKeyStates( key, number_once );
-
 			NeoAlzetteSubstitutionBox SubstitutionBox;
 
 			uint64_t lane0 = data.first;
@@ -785,7 +1527,7 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 			for ( size_t round = rounds; round > 0; --round )
 			{
-				const KeyState& current_key_state = KeyStates[ round - 1 ];
+				const KeyState& current_key_state = key_states[ round - 1 ];
 
 				/* Keyed Switching Layer^{-1} - Random Bit Tweak (Nonlinear)(Backward) */
 				lane0 ^= ( uint64_t( 1 ) << current_key_state.bit_rotation_amount_a );
@@ -810,6 +1552,73 @@ namespace TwilightDreamOfMagical::CustomSecurity
 
 			return Block128 { lane0, lane1 };
 		}
+
+		void LittleOaldresPuzzle_Cryptic::BlocksCoreFunction
+		(
+			std::span<const Block128> data_blocks, std::span<const Key128> keys, std::span<Block128> result_blocks,
+			const std::uint64_t first_number_once, const bool is_encryption
+		)
+		{
+			if ( data_blocks.empty() )
+				return;
+			if ( keys.empty() )
+				throw std::invalid_argument( "LittleOaldresPuzzle_Cryptic: at least one key is required!" );
+			if ( result_blocks.size() < data_blocks.size() )
+				throw std::invalid_argument( "LittleOaldresPuzzle_Cryptic: the result span is smaller than the data span!" );
+
+			[[maybe_unused]] const BlockKernelKind kernel = SelectBlockKernel();
+			[[maybe_unused]] const std::size_t	  batch_blocks = BlockKernelWidth( kernel );
+
+			// Chunk by chunk: precompute the key schedule of up to KeySchedule::capacity blocks in one pass,
+			// then run the rounds of the whole chunk from the schedule, so generation and the ARX core interleave
+			// on tables that stay in cache.
+			for ( std::size_t chunk_begin = 0; chunk_begin < data_blocks.size(); chunk_begin += KeySchedule::capacity )
+			{
+				const std::size_t chunk_blocks = std::min( KeySchedule::capacity, data_blocks.size() - chunk_begin );
+				GenerateKeySchedule( keys, first_number_once, chunk_begin, chunk_blocks );
+
+				std::size_t block = 0;
+
+				#if defined( TDOM_PROCESSOR_X86 )
+
+				// Whole SIMD batches. Every block is loaded before any result is stored,
+				// so data_blocks and result_blocks may be the same span.
+				for ( ; batch_blocks > 1 && chunk_blocks - block >= batch_blocks; block += batch_blocks )
+				{
+					const Block128* data = data_blocks.data() + chunk_begin + block;
+					Block128*		result = result_blocks.data() + chunk_begin + block;
+
+					if ( kernel == BlockKernelKind::AVX512 )
+					{
+						if ( is_encryption )
+							RoundsFunction_AVX512<true>( data, result, BatchKeySchedule, block, rounds );
+						else
+							RoundsFunction_AVX512<false>( data, result, BatchKeySchedule, block, rounds );
+					}
+					else
+					{
+						if ( is_encryption )
+							RoundsFunction_AVX2<true>( data, result, BatchKeySchedule, block, rounds );
+						else
+							RoundsFunction_AVX2<false>( data, result, BatchKeySchedule, block, rounds );
+					}
+				}
+
+				#endif
+
+				// Remaining blocks of the chunk (or no SIMD support): one block at a time
+				for ( ; block < chunk_blocks; ++block )
+				{
+					for ( std::size_t round = 0; round < rounds; ++round )
+						KeyStates[ round ] = BatchKeySchedule.Load( block, round );
+
+					const std::size_t index = chunk_begin + block;
+					result_blocks[ index ] = is_encryption
+						? EncryptionRoundsFunction( data_blocks[ index ], KeyStates.data() )
+						: DecryptionRoundsFunction( data_blocks[ index ], KeyStates.data() );
+				}
+			}
+		}
 	}  // TwilightDreamOfMagical
 	
 }
\ No newline at end of file
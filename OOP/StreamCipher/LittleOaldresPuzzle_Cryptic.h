@@ -26,6 +26,7 @@
 #include <vector>
 #include <utility>
 #include <random>
+#include <span>
 #include "XorConstantRotation.h"
 
 #if _DEBUG
@@ -52,7 +53,8 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				prng(seed),
 				prng_second(~seed ^ std::rotl(seed, 32)),
 				rounds(rounds),
-				KeyStates(std::vector<KeyState>(rounds, KeyState()))
+				KeyStates(std::vector<KeyState>(rounds, KeyState())),
+				BatchKeySchedule(rounds)
 			{
 			}
 
@@ -62,7 +64,8 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				prng(seed),
 				prng_second(~seed ^ std::rotl(seed, 32)),
 				rounds(4),
-				KeyStates(std::vector<KeyState>(rounds, KeyState()))
+				KeyStates(std::vector<KeyState>(rounds, KeyState())),
+				BatchKeySchedule(rounds)
 			{
 			}
 
@@ -72,7 +75,8 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				prng(seed),
 				prng_second(~seed ^ std::rotl(seed, 32)),
 				rounds(4),
-				KeyStates(std::vector<KeyState>(rounds, KeyState()))
+				KeyStates(std::vector<KeyState>(rounds, KeyState())),
+				BatchKeySchedule(rounds)
 			{
 			}
 
@@ -104,11 +108,8 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				
 				#endif
 				
-				// Encryption
-				for (size_t i = 0; i < data_array.size(); ++i)
-				{
-					result_data_array[i] = EncryptionCoreFunction(data_array[i], keys[i % keys.size()], i);
-				}
+				// Encryption (block i uses keys[i % keys.size()] and number_once i)
+				BlocksCoreFunction(data_array, keys, result_data_array, 0, true);
 				
 				#if _DEBUG
 			
@@ -135,11 +136,8 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				
 				#endif
 				
-				// Decryption
-				for (size_t i = 0; i < data_array.size(); ++i)
-				{
-					result_data_array[i] = DecryptionCoreFunction(data_array[i], keys[i % keys.size()], i);
-				}
+				// Decryption (block i uses keys[i % keys.size()] and number_once i)
+				BlocksCoreFunction(data_array, keys, result_data_array, 0, false);
 				
 				#if _DEBUG
 			
@@ -152,22 +150,55 @@ namespace TwilightDreamOfMagical::CustomSecurity
 				ResetPRNG();
 			}
 
+			// Encrypt independent blocks in one session.
+			//
+			// Block i is encrypted with keys[i % keys.size()] and number_once (first_number_once + i),
+			// exactly as if EncryptionCoreFunction had been called on the blocks one after another,
+			// so MultipleRoundsEncryption(data, keys, result) equals EncryptBlocks(data, keys, result, 0).
+			//
+			// The key states are still generated block by block (both XCR instances are stateful),
+			// but the data path runs several blocks at once: 8 with AVX-512, 4 with AVX2,
+			// chosen at runtime, and one block at a time for the remainder or without SIMD support.
+			//
+			// result_blocks must hold at least data_blocks.size() blocks; keys must not be empty.
+			// The PRNG state is reset afterwards, like every other top-level call.
+			void EncryptBlocks(std::span<const Block128> data_blocks, std::span<const Key128> keys, std::span<Block128> result_blocks, const std::uint64_t first_number_once = 0)
+			{
+				BlocksCoreFunction(data_blocks, keys, result_blocks, first_number_once, true);
+
+				// Reset the PRNG state for the next encryption or decryption (Must be call this function)
+				ResetPRNG();
+			}
+
+			// Inverse of EncryptBlocks, with the same key / number_once assignment and the same requirements.
+			void DecryptBlocks(std::span<const Block128> data_blocks, std::span<const Key128> keys, std::span<Block128> result_blocks, const std::uint64_t first_number_once = 0)
+			{
+				BlocksCoreFunction(data_blocks, keys, result_blocks, first_number_once, false);
+
+				// Reset the PRNG state for the next encryption or decryption (Must be call this function)
+				ResetPRNG();
+			}
+
 			std::vector<Block128> GenerateSubkey_WithUseEncryption(const Key128 key, std::uint64_t loop_count)
 			{
 				Key128 subkey {0,0};
-				Key128 buffer {0,0};
 				std::vector<Key128> subkeys(loop_count, {0,0});
 
 				std::mt19937_64 cpp_prng(key.first ^ key.second ^ loop_count);
-				Block128 number_once {0,0};
+				std::vector<Block128> number_onces(loop_count, {0,0});
+				std::vector<Block128> buffers(loop_count, {0,0});
 
 				//NumberOnce/CounterMode
+				//The counter blocks do not depend on the cipher output, so they are all processed as one batch
+				for(std::uint64_t counter = 0; counter < loop_count; ++counter)
+					number_onces[counter] = {cpp_prng(), cpp_prng()};
+
+				BlocksCoreFunction(number_onces, std::span<const Key128>(&key, 1), buffers, 0, true);
+
 				for(std::uint64_t counter = 0; counter < loop_count; ++counter)
 				{
-					number_once = {cpp_prng(), cpp_prng()};
-					buffer = EncryptionCoreFunction(number_once, key, counter);
-					subkey.first  ^= buffer.first;
-					subkey.second ^= buffer.second;
+					subkey.first  ^= buffers[counter].first;
+					subkey.second ^= buffers[counter].second;
 					subkeys[counter] = subkey;
 				}
 				
@@ -180,19 +211,23 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			std::vector<Block128> GenerateSubkey_WithUseDecryption(const Key128 key, std::uint64_t loop_count)
 			{
 				Key128 subkey {0,0};
-				Key128 buffer {0,0};
 				std::vector<Key128> subkeys(loop_count, {0,0});
 
 				std::mt19937_64 cpp_prng(key.first ^ key.second ^ loop_count);
-				Block128 number_once {0,0};
+				std::vector<Block128> number_onces(loop_count, {0,0});
+				std::vector<Block128> buffers(loop_count, {0,0});
 
 				//NumberOnce/CounterMode
+				//The counter blocks do not depend on the cipher output, so they are all processed as one batch
+				for(std::uint64_t counter = 0; counter < loop_count; ++counter)
+					number_onces[counter] = {cpp_prng(), cpp_prng()};
+
+				BlocksCoreFunction(number_onces, std::span<const Key128>(&key, 1), buffers, 0, false);
+
 				for(std::uint64_t counter = 0; counter < loop_count; ++counter)
 				{
-					number_once = {cpp_prng(), cpp_prng()};
-					buffer = DecryptionCoreFunction(number_once, key, counter);
-					subkey.first  ^= buffer.first;
-					subkey.second ^= buffer.second;
+					subkey.first  ^= buffers[counter].first;
+					subkey.second ^= buffers[counter].second;
 					subkeys[counter] = subkey;
 				}
 				
@@ -211,8 +246,11 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			//   mutated internal XCR states.
 			//
 			// Reset policy:
-			// - `prng`        is reset with the original constructor seed.
-			// - `prng_second` is reset with the paired derived seed: ~seed ^ std::rotl(seed, 32)
+			// - `prng`        is reset to the original constructor seed.
+			// - `prng_second` is reset to the paired derived seed: ~seed ^ std::rotl(seed, 32)
+			// - Both were seeded exactly once, in the constructor, and `seed` never changes,
+			//   so restoring their cached seeded states is identical to calling Seed() again
+			//   while skipping the XCR warm-up (which costs far more than one block).
 			//
 			// Result:
 			// - Each top-level encryption / decryption session starts from the same
@@ -221,8 +259,8 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			//   continuously evolving member states.
 			void ResetPRNG()
 			{
-				prng.Seed(seed);
-				prng_second.Seed(~seed ^ std::rotl(seed, 32));
+				prng.RestoreSeededState();
+				prng_second.RestoreSeededState();
 			}
 			
 			#if _DEBUG
@@ -249,14 +287,68 @@ namespace TwilightDreamOfMagical::CustomSecurity
 			};
 
 			std::vector<KeyState> KeyStates;
+
+			// Structure-of-arrays key schedule of up to `capacity` consecutive blocks.
+			// Every field is stored round-major: field[round * capacity + block],
+			// so the key material of one round for neighbouring blocks is contiguous
+			// and the SIMD data path loads it directly.
+			struct KeySchedule
+			{
+				// Blocks per schedule (a multiple of every SIMD batch width)
+				static constexpr std::size_t capacity = 64;
+
+				std::vector<std::uint64_t> subkey_first;
+				std::vector<std::uint64_t> subkey_second;
+				std::vector<std::uint64_t> choice_function;
+				std::vector<std::uint64_t> bit_rotation_amount_a;
+				std::vector<std::uint64_t> bit_rotation_amount_b;
+
+				// Raw outputs of prng / prng_second, block-major: [block * rounds + round]
+				std::vector<XorConstantRotation::GeneratedSubKey128> left_outputs;
+				std::vector<XorConstantRotation::GeneratedSubKey128> right_outputs;
+
+				explicit KeySchedule(const std::uint64_t rounds)
+					:
+					subkey_first(rounds * capacity, 0),
+					subkey_second(rounds * capacity, 0),
+					choice_function(rounds * capacity, 0),
+					bit_rotation_amount_a(rounds * capacity, 0),
+					bit_rotation_amount_b(rounds * capacity, 0),
+					left_outputs(rounds * capacity, {0, 0}),
+					right_outputs(rounds * capacity, {0, 0})
+				{
+				}
+
+				// Gather one block's key state of one round (used by the one-block-at-a-time path)
+				KeyState Load(const std::size_t block, const std::size_t round) const
+				{
+					const std::size_t index = round * capacity + block;
+					return KeyState { {subkey_first[index], subkey_second[index]}, choice_function[index], bit_rotation_amount_a[index], bit_rotation_amount_b[index] };
+				}
+			};
+
+			KeySchedule BatchKeySchedule;
+
+			// Derive one round's key state from the two 128-bit XCR outputs of that round
+			static KeyState FoldKeyState(const Key128 key_128bit, const XorConstantRotation::GeneratedSubKey128 out_left, const XorConstantRotation::GeneratedSubKey128 out_right, const std::uint64_t round);
 			
-			void GenerateAndStoreKeyStates(const Key128 key_128bit, const std::uint64_t number_once);
+			void GenerateAndStoreKeyStates(const Key128 key_128bit, const std::uint64_t number_once, KeyState* key_states);
+
+			// Fill BatchKeySchedule for blocks [first_block, first_block + block_count) of a BlocksCoreFunction call
+			void GenerateKeySchedule(std::span<const Key128> keys, const std::uint64_t first_number_once, const std::size_t first_block, const std::size_t block_count);
 
 			void MixLinearTransform_Forward(uint64_t& lane0, uint64_t& lane1, const KeyState& current_key_state);
 			void MixLinearTransform_Backward(uint64_t& lane0, uint64_t& lane1, const KeyState& current_key_state);
 
+			// The round function of one block, with already generated key states
+			Block128 EncryptionRoundsFunction(const Block128 data, const KeyState* key_states);
+			Block128 DecryptionRoundsFunction(const Block128 data, const KeyState* key_states);
+
 			Block128 EncryptionCoreFunction(const Block128 data, const Key128 key_128bit, const std::uint64_t round);
 			Block128 DecryptionCoreFunction(const Block128 data, const Key128 key_128bit, const std::uint64_t round);
+
+			// Shared body of EncryptBlocks / DecryptBlocks / MultipleRounds*, without the PRNG reset
+			void BlocksCoreFunction(std::span<const Block128> data_blocks, std::span<const Key128> keys, std::span<Block128> result_blocks, const std::uint64_t first_number_once, const bool is_encryption);
 		};
 	}
 
@@ -1093,6 +1093,8 @@ namespace TwilightDreamOfMagical::CustomSecurity::CSPRNG
 	//   state ready for public GenerateSubKey128()/operator() calls.
 	// - Subsequent public production calls mutate the internal state AND
 	//   explicitly advance `counter` in the current implementation.
+	// - That state is also kept in `seeded_state`, so RestoreSeededState() can
+	//   return to it without re-running the warm-up.
 	// ---------------------------------------------------------------------
 	void XorConstantRotation::StateInitialize()
 	{
@@ -1173,5 +1175,8 @@ namespace TwilightDreamOfMagical::CustomSecurity::CSPRNG
 
 		// Minimal fold-back (key whitening)
 		w = backup_seed ^ random;
+
+		// Cache the seeded state, so resetting to this seed later does not need to repeat the warm-up
+		seeded_state = SaveState();
 	}
 }  // namespace TwilightDreamOfMagical::CustomSecurity::CSPRNG
\ No newline at end of file
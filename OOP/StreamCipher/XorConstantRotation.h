@@ -151,6 +151,39 @@ namespace TwilightDreamOfMagical::CustomSecurity::CSPRNG
 		GeneratedSubKey128 operator()( std::uint64_t number_once );
 		GeneratedSubKey128 GenerateSubKey128( std::uint64_t number_once );
 
+		// Restorable copy of the full generator state: (w, x, y, z, counter).
+		struct StateSnapshot
+		{
+			std::uint64_t w = 0;
+			std::uint64_t x = 0;
+			std::uint64_t y = 0;
+			std::uint64_t z = 0;
+			std::uint64_t counter = 0;
+		};
+
+		StateSnapshot SaveState() const
+		{
+			return { w, x, y, z, counter };
+		}
+
+		void RestoreState( const StateSnapshot& snapshot )
+		{
+			w = snapshot.w;
+			x = snapshot.x;
+			y = snapshot.y;
+			z = snapshot.z;
+			counter = snapshot.counter;
+		}
+
+		// Return to the state right after the last ctor / Seed() call.
+		// - Produces exactly the same output stream as calling Seed() again with that seed,
+		//   but is a five-word copy instead of the whole GGM warm-up
+		//   (hundreds of StateIteration() calls that extract one bit each).
+		void RestoreSeededState()
+		{
+			RestoreState( seeded_state );
+		}
+
 		// 256-bit state
 		std::uint64_t w = 0;
 		std::uint64_t x = 0;
@@ -160,6 +193,12 @@ namespace TwilightDreamOfMagical::CustomSecurity::CSPRNG
 		// public counter
 		std::uint64_t counter = 0;
 
+	private:
+		// Captured at the end of StateInitialize(), used by RestoreSeededState().
+		StateSnapshot seeded_state {};
+
+	public:
+
 		// NOTE:
 		// - First 4 constants are "manually mixed anchors"
 		// - The rest are generated by your high-order continuous function discretization.
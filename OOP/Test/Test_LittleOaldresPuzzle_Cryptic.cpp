@@ -23,6 +23,8 @@
 #include "../StreamCipher/LittleOaldresPuzzle_Cryptic.h"
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <span>
 #include <random>
 #include <chrono>
 
@@ -187,5 +189,108 @@ namespace TwilightDreamOfMagical
 			PrintBlock("A", A); PrintBlock("B", B); PrintBlock("C", C); PrintBlock("D", D);
 			std::cout << "--------------------------------------------------\n";
 		}
+
+		void ResetPRNG_SeededStateTest()
+		{
+			using XorConstantRotation = LittleOaldresPuzzle_Cryptic::XorConstantRotation;
+
+			// RestoreSeededState() must give exactly the same stream as Seed() with the same seed
+			bool same_stream = true;
+			for (std::uint64_t seed : {0ULL, 1ULL, 0x0123456789ABCDEFULL})
+			{
+				XorConstantRotation reseeded(seed);
+				XorConstantRotation restored(seed);
+				for (std::uint64_t session = 0; session < 3; ++session)
+				{
+					reseeded.Seed(seed);
+					restored.RestoreSeededState();
+					for (std::uint64_t number_once = 0; number_once < 64; ++number_once)
+						same_stream = same_stream && reseeded(number_once + session) == restored(number_once + session) && reseeded.counter == restored.counter;
+				}
+			}
+
+			// Every top-level call starts from the same seeded state, so repeating one gives the same block
+			Block128 P{1475ULL, 3695ULL};
+			Key128  K{7532ULL, 9512ULL};
+
+			LittleOaldresPuzzle_Cryptic opc(1);
+			Block128 C1 = opc.SingleRoundEncryption(P, K, /*number_once*/ 1);
+			Block128 C2 = opc.SingleRoundEncryption(P, K, /*number_once*/ 1);
+			Block128 D  = opc.SingleRoundDecryption(C1, K, /*number_once*/ 1);
+
+			std::cout << "--------------------------------------------------\n";
+			if (same_stream && C1 == C2 && P == D) std::cout << "Resetting to the cached seeded state was successful.\n";
+			else                                   std::cout << "Resetting to the cached seeded state failed.\n";
+			std::cout << "--------------------------------------------------\n";
+		}
+
+		void EncryptBlocks_BatchTest()
+		{
+			// 150 blocks: three key schedule chunks of up to 64 blocks, each with whole SIMD batches
+			// (when available) plus a one-block-at-a-time remainder in the last one
+			std::vector<Block128> data(150);
+			for (size_t i = 0; i < data.size(); ++i) data[i] = {i * 0x9E3779B97F4A7C15ULL, ~i};
+			std::vector<Key128> keys{{1, 2}, {3, 4}, {5, 6}};
+
+			LittleOaldresPuzzle_Cryptic opc(1);
+
+			// Known answers from the one-block-at-a-time implementation (EncryptionCoreFunction called on
+			// block i with keys[i % keys.size()] and number_once = i, before the multi-block data path existed).
+			// The pinned blocks sit on the 64-block chunk boundaries, and the digest (FNV-1a over all words) covers the rest
+			const std::vector<std::pair<size_t, Block128>> known_blocks
+			{
+				{0, {0xeac490b17e951fa1ULL, 0xffd6868430295898ULL}},
+				{1, {0xf2dd5df4774d49e3ULL, 0x2ba43d455893f017ULL}},
+				{63, {0x40e6fe81cf31e453ULL, 0x1c0fefa4aab504bdULL}},
+				{64, {0x865e57fbbe20cc58ULL, 0xc0f7fe0f1012a1a5ULL}},
+				{127, {0x2112260051052bafULL, 0x5cbba8a838eb1a47ULL}},
+				{128, {0x80587c0d2c3aa995ULL, 0x5ad983dab4d305d2ULL}},
+				{149, {0x1079718815782140ULL, 0x443eeeb361134a9bULL}}
+			};
+			const std::uint64_t known_digest = 0x58587ccc2231a04fULL;
+
+			std::vector<Block128> enc(data.size());
+			opc.EncryptBlocks(data, keys, enc);
+
+			std::uint64_t digest = 0xcbf29ce484222325ULL;
+			for (const Block128& block : enc)
+			{
+				for (std::uint64_t word : {block.first, block.second})
+				{
+					digest ^= word;
+					digest *= 0x100000001b3ULL;
+				}
+			}
+
+			bool same_as_known = digest == known_digest;
+			for (const auto& [index, block] : known_blocks)
+				same_as_known = same_as_known && enc[index] == block;
+
+			// MultipleRoundsEncryption is the same session as EncryptBlocks with first_number_once = 0
+			std::vector<Block128> multiple;
+			opc.MultipleRoundsEncryption(data, keys, multiple);
+			same_as_known = same_as_known && multiple == enc;
+
+			// A prefix puts its blocks on a different path (SIMD batch or single block) than the full run,
+			// but the key states are generated in the same order, so the results must be the same
+			bool same_prefix = true;
+			for (size_t count : {1, 2, 3, 5, 8, 9, 17, 63, 64, 65, 129})
+			{
+				std::vector<Block128> prefix(count);
+				opc.EncryptBlocks(std::span<const Block128>(data.data(), count), keys, prefix);
+				same_prefix = same_prefix && std::equal(prefix.begin(), prefix.end(), enc.begin());
+			}
+
+			// Round trip with a nonzero first number_once, decrypting in place
+			std::vector<Block128> work(data.size());
+			opc.EncryptBlocks(data, keys, work, /*first_number_once*/ 1000);
+			opc.DecryptBlocks(work, keys, work, /*first_number_once*/ 1000);
+			bool round_trip = work == data;
+
+			std::cout << "--------------------------------------------------\n";
+			if (same_as_known && same_prefix && round_trip) std::cout << "Multi-block encryption and decryption were successful.\n";
+			else                                                std::cout << "Multi-block encryption and decryption failed.\n";
+			std::cout << "--------------------------------------------------\n";
+		}
 	} // namespace Test_LittleOaldresPuzzle_Cryptic
 } // namespace TwilightDreamOfMagical
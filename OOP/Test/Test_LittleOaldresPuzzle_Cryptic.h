@@ -37,6 +37,8 @@ namespace TwilightDreamOfMagical
 		void MultipleRoundsTest();
 		void MultipleRoundsWithMoreDataTest();
 		void NumberOnce_CounterMode_Test();
+		void ResetPRNG_SeededStateTest();
+		void EncryptBlocks_BatchTest();
 	}
 }
 
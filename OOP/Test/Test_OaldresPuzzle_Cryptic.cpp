@@ -1,4 +1,5 @@
 #include "Test_OaldresPuzzle_Cryptic.h"
+#include "../BlockCipher/Includes/KeyDerivationFunction/Scrypt.hpp"
 
 namespace TwilightDreamOfMagical
 {
@@ -142,6 +143,10 @@ namespace TwilightDreamOfMagical
 			std::unique_ptr<OaldresPuzzle_Cryptic>	  AlgorithmCorePointer = std::make_unique<OaldresPuzzle_Cryptic>( *CommonStateDataUniquePointer );
 			std::unique_ptr<OPC_MainAlgorithm_Worker> OPC_Worker_Pointer = std::make_unique<OPC_MainAlgorithm_Worker>( *AlgorithmCorePointer );
 
+			//保存加密之前的状态，解密之前恢复它，而不是重建所有对象
+			//Save the state before encryption and restore it before decryption, instead of rebuilding every object
+			const OaldresPuzzle_Cryptic::StateSnapshot InitialStateSnapshot = AlgorithmCorePointer->TakeSnapshot();
+
 			//10485760 10MB
 			//209715200 200MB
 
@@ -162,13 +167,7 @@ namespace TwilightDreamOfMagical
 			/*
 				Reset cipher state
 			*/
-			OPC_Worker_Pointer.reset();
-			AlgorithmCorePointer.reset();
-			CommonStateDataUniquePointer.reset();
-
-			CommonStateDataUniquePointer = std::make_unique<CommonStateData>( 16, 32, InitialVector, LFSR_Seed, NLFSR_Seed, SDP_Seed );
-			AlgorithmCorePointer = std::make_unique<OaldresPuzzle_Cryptic>( *CommonStateDataUniquePointer );
-			OPC_Worker_Pointer = std::make_unique<OPC_MainAlgorithm_Worker>( *AlgorithmCorePointer );
+			AlgorithmCorePointer->RestoreSnapshot( InitialStateSnapshot );
 
 			std::chrono::time_point<std::chrono::system_clock> generateDecryptionStartTime = std::chrono::system_clock::now();
 
@@ -225,5 +224,847 @@ namespace TwilightDreamOfMagical
 			CipherData.shrink_to_fit();
 			ProcessData.shrink_to_fit();
 		}
+
+		void RunSegmentedUnit( const std::vector<std::uint8_t>& PlainData, const std::vector<std::uint8_t>& Keys, const std::vector<std::uint8_t>& InitialVector, std::size_t SegmentByteSize, std::uint64_t LFSR_Seed, std::uint64_t NLFSR_Seed, std::uint64_t SDP_Seed )
+		{
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_SegmentedWorker;
+
+			std::chrono::duration<double> TimeSpent;
+
+			OPC_SegmentedWorker OPC_SegmentedWorkerObject( 16, 32, InitialVector, LFSR_Seed, NLFSR_Seed, SDP_Seed, SegmentByteSize );
+
+			std::chrono::time_point<std::chrono::system_clock> generateEncryptionStartTime = std::chrono::system_clock::now();
+
+			std::vector<std::uint8_t> CipherData = OPC_SegmentedWorkerObject.EncrypterMain( PlainData, Keys );
+
+			std::chrono::time_point<std::chrono::system_clock> generateEncryptionEndTime = std::chrono::system_clock::now();
+			TimeSpent = generateEncryptionEndTime - generateEncryptionStartTime;
+			std::cout << "The time spent encrypting the data (segmented): " << TimeSpent.count() << "s" << std::endl;
+
+			std::chrono::time_point<std::chrono::system_clock> generateDecryptionStartTime = std::chrono::system_clock::now();
+
+			std::vector<std::uint8_t> ProcessData = OPC_SegmentedWorkerObject.DecrypterMain( CipherData, Keys );
+
+			std::chrono::time_point<std::chrono::system_clock> generateDecryptionEndTime = std::chrono::system_clock::now();
+			TimeSpent = generateDecryptionEndTime - generateDecryptionStartTime;
+			std::cout << "The time spent decrypting the data (segmented): " << TimeSpent.count() << "s" << std::endl;
+
+			const OPC_SegmentedWorker::SegmentHeader Header = OPC_SegmentedWorkerObject.ReadSegmentHeader( CipherData );
+			std::cout << "Segment size: " << Header.SegmentByteSize << " byte, segment count: " << Header.SegmentCount << std::endl;
+
+			bool IsSameData = ( ProcessData == PlainData );
+
+			//单独解密中间的一段，检查是否能直接定位
+			//Decrypt the middle segment on its own, to check that it can be seeked to directly
+			const std::uint64_t MiddleSegmentIndex = Header.SegmentCount / 2;
+			if ( MiddleSegmentIndex + 1 < Header.SegmentCount )
+			{
+				std::vector<std::uint8_t> SegmentData = OPC_SegmentedWorkerObject.DecryptSegment( CipherData, Keys, MiddleSegmentIndex );
+				IsSameData = IsSameData && std::equal( SegmentData.begin(), SegmentData.end(), PlainData.begin() + MiddleSegmentIndex * Header.SegmentByteSize );
+			}
+
+			if ( IsSameData )
+			{
+				std::cout << "The data after this operation is correct!" << std::endl;
+				std::cout << "Yeah! \nThe segmented mode is normal work!" << std::endl;
+			}
+			else
+			{
+				std::cout << "The data after this operation is incorrect!" << std::endl;
+				std::cout << "Oh, no!\nThe segmented mode is not processing the correct data." << std::endl;
+			}
+		}
+
+		void RunStreamingUnit( const std::vector<std::uint8_t>& PlainData, const std::vector<std::uint8_t>& Keys, const std::vector<std::uint8_t>& InitialVector, std::size_t ChunkByteSize, std::uint64_t LFSR_Seed, std::uint64_t NLFSR_Seed, std::uint64_t SDP_Seed )
+		{
+			using TwilightDreamOfMagical::CustomSecurity::CryptionMode2MCAC4_FDW;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OaldresPuzzle_Cryptic;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_MainAlgorithm_Worker;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::ImplementationDetails::CommonStateData;
+
+			std::chrono::duration<double> TimeSpent;
+
+			CommonStateData CommonStateDataObject( 16, 32, InitialVector, LFSR_Seed, NLFSR_Seed, SDP_Seed );
+			OaldresPuzzle_Cryptic AlgorithmCoreObject( CommonStateDataObject );
+			OPC_MainAlgorithm_Worker OPC_WorkerObject( AlgorithmCoreObject, false );
+
+			const OaldresPuzzle_Cryptic::StateSnapshot InitialStateSnapshot = AlgorithmCoreObject.TakeSnapshot();
+			const std::size_t BlockByteSize = OPC_WorkerObject.StreamBlockByteSize();
+
+			//每次 Update 最多输出输入大小加一个数据块，Finish 最多输出一个数据块
+			//Each Update outputs at most the input size plus one data block, Finish outputs at most one data block
+			std::vector<std::uint8_t> OutputChunk( ChunkByteSize + BlockByteSize, 0x00 );
+
+			std::chrono::time_point<std::chrono::system_clock> generateEncryptionStartTime = std::chrono::system_clock::now();
+
+			std::vector<std::uint8_t> CipherData;
+			OPC_WorkerObject.Begin( CryptionMode2MCAC4_FDW::MCA_ENCRYPTER, Keys );
+			for ( std::size_t Offset = 0; Offset < PlainData.size(); Offset += ChunkByteSize )
+			{
+				std::span<const std::uint8_t> InputChunk( PlainData.begin() + Offset, std::min( ChunkByteSize, PlainData.size() - Offset ) );
+				const std::size_t OutputByteCount = OPC_WorkerObject.Update( InputChunk, OutputChunk );
+				CipherData.insert( CipherData.end(), OutputChunk.begin(), OutputChunk.begin() + OutputByteCount );
+			}
+			std::size_t FinishByteCount = OPC_WorkerObject.Finish( OutputChunk );
+			CipherData.insert( CipherData.end(), OutputChunk.begin(), OutputChunk.begin() + FinishByteCount );
+
+			std::chrono::time_point<std::chrono::system_clock> generateEncryptionEndTime = std::chrono::system_clock::now();
+			TimeSpent = generateEncryptionEndTime - generateEncryptionStartTime;
+			std::cout << "The time spent encrypting the data (streaming): " << TimeSpent.count() << "s" << std::endl;
+
+			//流式加密的密文可以一次整段解密
+			//The streaming ciphertext can be decrypted as a whole at once
+			AlgorithmCoreObject.RestoreSnapshot( InitialStateSnapshot );
+			bool IsSameData = ( OPC_WorkerObject.DecrypterMain( CipherData, Keys ) == PlainData );
+
+			std::chrono::time_point<std::chrono::system_clock> generateDecryptionStartTime = std::chrono::system_clock::now();
+
+			AlgorithmCoreObject.RestoreSnapshot( InitialStateSnapshot );
+			std::vector<std::uint8_t> ProcessData;
+			OPC_WorkerObject.Begin( CryptionMode2MCAC4_FDW::MCA_DECRYPTER, Keys );
+			for ( std::size_t Offset = 0; Offset < CipherData.size(); Offset += ChunkByteSize )
+			{
+				std::span<const std::uint8_t> InputChunk( CipherData.begin() + Offset, std::min( ChunkByteSize, CipherData.size() - Offset ) );
+				const std::size_t OutputByteCount = OPC_WorkerObject.Update( InputChunk, OutputChunk );
+				ProcessData.insert( ProcessData.end(), OutputChunk.begin(), OutputChunk.begin() + OutputByteCount );
+			}
+			FinishByteCount = OPC_WorkerObject.Finish( OutputChunk );
+			ProcessData.insert( ProcessData.end(), OutputChunk.begin(), OutputChunk.begin() + FinishByteCount );
+
+			std::chrono::time_point<std::chrono::system_clock> generateDecryptionEndTime = std::chrono::system_clock::now();
+			TimeSpent = generateDecryptionEndTime - generateDecryptionStartTime;
+			std::cout << "The time spent decrypting the data (streaming): " << TimeSpent.count() << "s" << std::endl;
+
+			IsSameData = IsSameData && ( ProcessData == PlainData );
+
+			if ( IsSameData )
+			{
+				std::cout << "The data after this operation is correct!" << std::endl;
+				std::cout << "Yeah! \nThe streaming interface is normal work!" << std::endl;
+			}
+			else
+			{
+				std::cout << "The data after this operation is incorrect!" << std::endl;
+				std::cout << "Oh, no!\nThe streaming interface is not processing the correct data." << std::endl;
+			}
+		}
+
+		void RunInPlaceUnit( const std::vector<std::uint8_t>& PlainData, const std::vector<std::uint8_t>& Keys, const std::vector<std::uint8_t>& InitialVector, std::uint64_t LFSR_Seed, std::uint64_t NLFSR_Seed, std::uint64_t SDP_Seed )
+		{
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OaldresPuzzle_Cryptic;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_MainAlgorithm_Worker;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::ImplementationDetails::CommonStateData;
+
+			CommonStateData CommonStateDataObject( 16, 32, InitialVector, LFSR_Seed, NLFSR_Seed, SDP_Seed );
+			OaldresPuzzle_Cryptic AlgorithmCoreObject( CommonStateDataObject );
+			OPC_MainAlgorithm_Worker OPC_WorkerObject( AlgorithmCoreObject, false );
+
+			const OaldresPuzzle_Cryptic::StateSnapshot InitialStateSnapshot = AlgorithmCoreObject.TakeSnapshot();
+			const std::size_t BlockByteSize = OPC_WorkerObject.StreamBlockByteSize();
+
+			//原地接口不填充，所以只用数据块对齐的部分；用 QuadWord 的 vector 保证 8 字节对齐
+			//The in-place interface does not pad, so only the block-aligned part is used; a QuadWord vector guarantees 8-byte alignment
+			const std::size_t DataByteSize = PlainData.size() - PlainData.size() % BlockByteSize;
+			const std::vector<std::uint8_t> AlignedPlainData( PlainData.begin(), PlainData.begin() + DataByteSize );
+			std::vector<std::uint64_t> DataWords( DataByteSize / sizeof( std::uint64_t ), 0 );
+			std::span<std::uint8_t> DataBytes( reinterpret_cast<std::uint8_t*>( DataWords.data() ), DataByteSize );
+			std::memcpy( DataBytes.data(), AlignedPlainData.data(), DataByteSize );
+
+			std::chrono::time_point<std::chrono::system_clock> generateEncryptionStartTime = std::chrono::system_clock::now();
+
+			OPC_WorkerObject.EncrypterMainInPlace( DataBytes, Keys );
+
+			std::chrono::time_point<std::chrono::system_clock> generateEncryptionEndTime = std::chrono::system_clock::now();
+			std::chrono::duration<double> TimeSpent = generateEncryptionEndTime - generateEncryptionStartTime;
+			std::cout << "The time spent encrypting the data (in-place): " << TimeSpent.count() << "s" << std::endl;
+
+			AlgorithmCoreObject.RestoreSnapshot( InitialStateSnapshot );
+			const std::vector<std::uint8_t> CipherData = OPC_WorkerObject.EncrypterMainWithoutPadding( AlignedPlainData, Keys );
+			bool IsSameData = std::equal( CipherData.begin(), CipherData.end(), DataBytes.begin() );
+
+			AlgorithmCoreObject.RestoreSnapshot( InitialStateSnapshot );
+			OPC_WorkerObject.DecrypterMainInPlace( DataBytes, Keys );
+			IsSameData = IsSameData && std::equal( AlignedPlainData.begin(), AlignedPlainData.end(), DataBytes.begin() );
+
+			if ( IsSameData )
+			{
+				std::cout << "The data after this operation is correct!" << std::endl;
+				std::cout << "Yeah! \nThe in-place interface is normal work!" << std::endl;
+			}
+			else
+			{
+				std::cout << "The data after this operation is incorrect!" << std::endl;
+				std::cout << "Oh, no!\nThe in-place interface is not processing the correct data." << std::endl;
+			}
+		}
+
+		void RunKeySetupCacheUnit( const std::vector<std::uint8_t>& PlainData, const std::vector<std::uint8_t>& Keys, const std::vector<std::uint8_t>& InitialVector, std::uint64_t LFSR_Seed, std::uint64_t NLFSR_Seed, std::uint64_t SDP_Seed )
+		{
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OaldresPuzzle_Cryptic;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_MainAlgorithm_Worker;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_KeySetupCache;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::ImplementationDetails::CommonStateData;
+
+			//不填充，所以只用数据块对齐的部分
+			//No padding, so only the block-aligned part is used
+			const std::size_t DataByteSize = PlainData.size() - PlainData.size() % ( 16 * sizeof( std::uint64_t ) );
+			const std::vector<std::uint8_t> AlignedPlainData( PlainData.begin(), PlainData.begin() + DataByteSize );
+
+			std::chrono::time_point<std::chrono::system_clock> generateSetupStartTime = std::chrono::system_clock::now();
+
+			CommonStateData CommonStateDataObject( 16, 32, InitialVector, LFSR_Seed, NLFSR_Seed, SDP_Seed );
+			OaldresPuzzle_Cryptic AlgorithmCoreObject( CommonStateDataObject );
+			OPC_MainAlgorithm_Worker OPC_WorkerObject( AlgorithmCoreObject, false );
+			const std::vector<std::uint8_t> ReferenceCipherData = OPC_WorkerObject.EncrypterMainWithoutPadding( AlignedPlainData, Keys );
+
+			std::chrono::duration<double> TimeSpent = std::chrono::system_clock::now() - generateSetupStartTime;
+			std::cout << "The time spent encrypting the data (full setup): " << TimeSpent.count() << "s" << std::endl;
+
+			OPC_KeySetupCache KeySetupCache( 2 );
+
+			auto FirstContext = KeySetupCache.Acquire( 16, 32, InitialVector, Keys, LFSR_Seed, NLFSR_Seed, SDP_Seed );
+			bool IsSameData = FirstContext->EncrypterMainWithoutPadding( AlignedPlainData ) == ReferenceCipherData;
+
+			generateSetupStartTime = std::chrono::system_clock::now();
+
+			auto SecondContext = KeySetupCache.Acquire( 16, 32, InitialVector, Keys, LFSR_Seed, NLFSR_Seed, SDP_Seed );
+			IsSameData = IsSameData && SecondContext->EncrypterMainWithoutPadding( AlignedPlainData ) == ReferenceCipherData;
+
+			TimeSpent = std::chrono::system_clock::now() - generateSetupStartTime;
+			std::cout << "The time spent encrypting the data (cached setup): " << TimeSpent.count() << "s" << std::endl;
+
+			//同一个上下文可以处理下一条消息
+			//The same context can process the next message
+			IsSameData = IsSameData && FirstContext->DecrypterMainWithoutUnpadding( ReferenceCipherData ) == AlignedPlainData;
+
+			OPC_KeySetupCache::Statistics CacheStatistics = KeySetupCache.GetStatistics();
+			IsSameData = IsSameData && CacheStatistics.Hits == 1 && CacheStatistics.Misses == 1 && CacheStatistics.EntryCount == 1;
+
+			//另外两组种子把最早的条目挤出去，再取它时重新准备，结果不变
+			//Two other seeds push the oldest entry out, acquiring it again sets it up anew with the same result
+			KeySetupCache.Acquire( 16, 32, InitialVector, Keys, LFSR_Seed + 1, NLFSR_Seed, SDP_Seed );
+			KeySetupCache.Acquire( 16, 32, InitialVector, Keys, LFSR_Seed + 2, NLFSR_Seed, SDP_Seed );
+			auto ThirdContext = KeySetupCache.Acquire( 16, 32, InitialVector, Keys, LFSR_Seed, NLFSR_Seed, SDP_Seed );
+			IsSameData = IsSameData && ThirdContext->EncrypterMainWithoutPadding( AlignedPlainData ) == ReferenceCipherData;
+
+			CacheStatistics = KeySetupCache.GetStatistics();
+			IsSameData = IsSameData && CacheStatistics.Misses == 4 && CacheStatistics.Evictions == 2 && CacheStatistics.EntryCount == 2;
+
+			KeySetupCache.Purge();
+			CacheStatistics = KeySetupCache.GetStatistics();
+			IsSameData = IsSameData && CacheStatistics.EntryCount == 0;
+
+			//清除之后已经取得的上下文仍然可以使用
+			//Contexts acquired before the purge can still be used
+			IsSameData = IsSameData && SecondContext->DecrypterMainWithoutUnpadding( ReferenceCipherData ) == AlignedPlainData;
+
+			if ( IsSameData )
+			{
+				std::cout << "The data after this operation is correct!" << std::endl;
+				std::cout << "Yeah! \nThe key setup cache is normal work!" << std::endl;
+			}
+			else
+			{
+				std::cout << "The data after this operation is incorrect!" << std::endl;
+				std::cout << "Oh, no!\nThe key setup cache is not processing the correct data." << std::endl;
+			}
+		}
+
+		void RunStageProfileUnit( const std::vector<std::uint8_t>& PlainData, const std::vector<std::uint8_t>& Keys, const std::vector<std::uint8_t>& InitialVector, std::uint64_t LFSR_Seed, std::uint64_t NLFSR_Seed, std::uint64_t SDP_Seed )
+		{
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OaldresPuzzle_Cryptic;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_MainAlgorithm_Worker;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_ProfileStage;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_StageProfile;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_StageProfiler;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::ImplementationDetails::CommonStateData;
+
+			CommonStateData CommonStateDataObject( 16, 32, InitialVector, LFSR_Seed, NLFSR_Seed, SDP_Seed );
+			OaldresPuzzle_Cryptic AlgorithmCoreObject( CommonStateDataObject );
+			OPC_MainAlgorithm_Worker OPC_WorkerObject( AlgorithmCoreObject, false );
+
+			OPC_WorkerObject.ResetStageProfile();
+			const std::vector<std::uint8_t> CipherData = OPC_WorkerObject.EncrypterMain( PlainData, Keys );
+			const OPC_StageProfile Profile = OPC_WorkerObject.StageProfile();
+
+			constexpr std::array<std::pair<OPC_ProfileStage, const char*>, 6> StageNames
+			{
+				std::pair { OPC_ProfileStage::GenerationSubkeys, "GenerationSubkeys" },
+				std::pair { OPC_ProfileStage::GenerationRoundSubkeys, "GenerationRoundSubkeys" },
+				std::pair { OPC_ProfileStage::LaiMasseyFramework, "LaiMasseyFramework" },
+				std::pair { OPC_ProfileStage::ByteSubstitution, "ByteSubstitution" },
+				std::pair { OPC_ProfileStage::KeyWhitening, "KeyWhitening" },
+				std::pair { OPC_ProfileStage::ScryptRekey, "ScryptRekey" }
+			};
+
+			bool IsCorrectProfile = Profile.Enabled == OPC_StageProfiler::IsEnabled();
+
+			std::cout << "Stage profile of one message (" << PlainData.size() << " bytes, profiling " << ( Profile.Enabled ? "enabled" : "disabled" ) << "):" << std::endl;
+			for ( const auto& [ Stage, StageName ] : StageNames )
+			{
+				std::cout << "  " << StageName << ": cycles " << Profile[ Stage ].Cycles << ", calls " << Profile[ Stage ].Calls << ", bytes " << Profile[ Stage ].Bytes << std::endl;
+
+				//一条短消息不会触发周期性的 Scrypt 重新派生密钥
+				//A short message never triggers the periodic Scrypt rekey
+				if ( Profile.Enabled && Stage != OPC_ProfileStage::ScryptRekey )
+					IsCorrectProfile = IsCorrectProfile && Profile[ Stage ].Calls != 0 && Profile[ Stage ].Bytes != 0;
+				else if ( !Profile.Enabled )
+					IsCorrectProfile = IsCorrectProfile && Profile[ Stage ].Cycles == 0 && Profile[ Stage ].Calls == 0 && Profile[ Stage ].Bytes == 0;
+			}
+
+			OPC_WorkerObject.ResetStageProfile();
+			const OPC_StageProfile ClearedProfile = OPC_WorkerObject.StageProfile();
+			for ( const auto& [ Stage, StageName ] : StageNames )
+				IsCorrectProfile = IsCorrectProfile && ClearedProfile[ Stage ].Cycles == 0 && ClearedProfile[ Stage ].Calls == 0 && ClearedProfile[ Stage ].Bytes == 0;
+
+			if ( !CipherData.empty() && IsCorrectProfile )
+			{
+				std::cout << "The data after this operation is correct!" << std::endl;
+				std::cout << "Yeah! \nThe stage profile is normal work!" << std::endl;
+			}
+			else
+			{
+				std::cout << "The data after this operation is incorrect!" << std::endl;
+				std::cout << "Oh, no!\nThe stage profile is not counting the correct data." << std::endl;
+			}
+		}
+
+		void RunScryptKernelUnit()
+		{
+			using TwilightDreamOfMagical::CommonSecurity::KeyDerivationFunction::Scrypt;
+			using CommonToolkit::WorkStealingThreadPool;
+
+			std::vector<std::uint8_t> PasswordBytes( 64, 0x00 );
+			std::vector<std::uint8_t> SaltBytes( 32, 0x00 );
+			for ( std::size_t index = 0; index < PasswordBytes.size(); ++index )
+				PasswordBytes[ index ] = static_cast<std::uint8_t>( index * 7 + 1 );
+			for ( std::size_t index = 0; index < SaltBytes.size(); ++index )
+				SaltBytes[ index ] = static_cast<std::uint8_t>( index * 13 + 5 );
+
+			constexpr std::array<Scrypt::SalsaKernelKind, 2> SimdKernels { Scrypt::SalsaKernelKind::SSE2, Scrypt::SalsaKernelKind::AVX2 };
+
+			bool IsSameData = true;
+
+			/*
+				奇数个通道时 SSE2 内核的临时空间只有一个通道大，AVX2 内核最后一个通道单独交给 SSE2；
+				用 _GLIBCXX_ASSERTIONS (或者 MSVC 的迭代器调试) 构建时，任何越过临时空间的 span 都会在这里中止
+
+				With an odd lane count the scratch space of the SSE2 kernel is one lane large, and the AVX2 kernel leaves its last lane to SSE2 on its own;
+				When built with _GLIBCXX_ASSERTIONS (or the iterator debugging of MSVC), any span past the scratch space aborts here
+			*/
+			for ( std::uint64_t ParallelizationCount : { 1ULL, 2ULL, 3ULL, 5ULL } )
+			{
+				Scrypt ReferenceScrypt( Scrypt::SalsaKernelKind::Scalar, nullptr );
+				const std::vector<std::uint8_t> ReferenceKeys = ReferenceScrypt.GenerateKeys( PasswordBytes, SaltBytes, 64, 16, 2, ParallelizationCount );
+
+				for ( Scrypt::SalsaKernelKind Kernel : SimdKernels )
+				{
+					Scrypt SerialScrypt( Kernel, nullptr );
+					Scrypt PooledScrypt( Kernel, std::addressof( WorkStealingThreadPool::Shared() ) );
+
+					IsSameData = IsSameData && SerialScrypt.GenerateKeys( PasswordBytes, SaltBytes, 64, 16, 2, ParallelizationCount ) == ReferenceKeys;
+					IsSameData = IsSameData && PooledScrypt.GenerateKeys( PasswordBytes, SaltBytes, 64, 16, 2, ParallelizationCount ) == ReferenceKeys;
+				}
+			}
+
+			if ( IsSameData )
+			{
+				std::cout << "The data after this operation is correct!" << std::endl;
+				std::cout << "Yeah! \nThe Scrypt kernels are normal work!" << std::endl;
+			}
+			else
+			{
+				std::cout << "The data after this operation is incorrect!" << std::endl;
+				std::cout << "Oh, no!\nThe Scrypt kernels are not processing the correct data." << std::endl;
+			}
+		}
+
+		void RunWrappingMatrixMultiplyKernelUnit()
+		{
+			using namespace TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::ImplementationDetails::WrappingIntegerMatrixMultiply;
+			using QuadWordMatrix = Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+			std::mt19937_64 RandomGenerator( 0x5EEDC0DE12345678ULL );
+			auto RandomMatrix = [ &RandomGenerator ]( std::size_t Rows, std::size_t Columns )
+			{
+				QuadWordMatrix Matrix( Rows, Columns );
+				for ( Eigen::Index index = 0; index < Matrix.size(); ++index )
+					Matrix.data()[ index ] = RandomGenerator();
+				return Matrix;
+			};
+
+			//不支持的内核在 MultiplyMatrix 里会退回到可用的内核，所以只检查这台处理器真正支持的
+			//An unsupported kernel falls back to an available one inside MultiplyMatrix, so only the kernels this processor really supports are checked
+			std::vector<KernelKind> SupportedKernels { KernelKind::Scalar };
+			if ( SelectKernel() != KernelKind::Scalar )
+				SupportedKernels.push_back( KernelKind::AVX2 );
+			if ( SelectKernel() == KernelKind::AVX512 )
+				SupportedKernels.push_back( KernelKind::AVX512 );
+
+			constexpr std::array<std::array<std::size_t, 3>, 9> MatrixSizes
+			{ {
+				{ 1, 1, 1 }, { 3, 5, 7 }, { 4, 4, 4 }, { 8, 4, 9 }, { 15, 3, 17 },
+				{ 16, 8, 16 }, { 33, 31, 65 }, { 64, 64, 64 }, { 129, 7, 100 }
+			} };
+
+			bool IsSameData = true;
+
+			for ( KernelKind Kernel : SupportedKernels )
+			{
+				for ( const auto& [ M, N, K ] : MatrixSizes )
+				{
+					//A 和 C 多出三行，检查列跨度 (Leading) 大于行数的情况
+					//A and C have three extra rows, to check a column stride (Leading) larger than the row count
+					const QuadWordMatrix A = RandomMatrix( M + 3, K );
+					const QuadWordMatrix B = RandomMatrix( K, N );
+					const QuadWordMatrix InitialC = RandomMatrix( M + 3, N );
+
+					const QuadWordMatrix Product = A.topRows( M ) * B;
+
+					QuadWordMatrix C = InitialC;
+					MultiplyMatrix( M, N, K, A.data(), A.rows(), B.data(), B.rows(), C.data(), C.rows(), false, Kernel );
+					IsSameData = IsSameData && C.topRows( M ) == Product && C.bottomRows( 3 ) == InitialC.bottomRows( 3 );
+
+					C = InitialC;
+					MultiplyMatrix( M, N, K, A.data(), A.rows(), B.data(), B.rows(), C.data(), C.rows(), true, Kernel );
+					IsSameData = IsSameData && C.topRows( M ) == QuadWordMatrix( InitialC.topRows( M ) + Product ) && C.bottomRows( 3 ) == InitialC.bottomRows( 3 );
+				}
+			}
+
+			std::cout << "Checked wrapping GEMM kernels: " << SupportedKernels.size() << std::endl;
+
+			if ( IsSameData )
+			{
+				std::cout << "The data after this operation is correct!" << std::endl;
+				std::cout << "Yeah! \nThe wrapping GEMM kernels are normal work!" << std::endl;
+			}
+			else
+			{
+				std::cout << "The data after this operation is incorrect!" << std::endl;
+				std::cout << "Oh, no!\nThe wrapping GEMM kernels are not processing the correct data." << std::endl;
+			}
+		}
+
+		void RunSubkeyMatrixRankOneUpdateUnit()
+		{
+			using namespace TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::ImplementationDetails;
+			using QuadWordMatrix = Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+			std::mt19937_64 RandomGenerator( 0x0123456789ABCDEFULL );
+
+			bool IsSameData = true;
+
+			//64 是常用配置 (密钥块 32 个 QuadWord) 的密钥矩阵大小，其余大小覆盖不是通道宽度整数倍的情况
+			//64 is the key matrix size of the common configuration (32 QuadWords of key block); the other sizes cover sizes that are not a multiple of the lane width
+			for ( std::size_t MatrixSize : { 1, 3, 7, 16, 33, 64, 65 } )
+			{
+				const Eigen::Index Size = static_cast<Eigen::Index>( MatrixSize );
+
+				QuadWordMatrix RandomQuadWordMatrix( Size, Size );
+				Eigen::Matrix<std::uint64_t, 1, Eigen::Dynamic> RandomWordVector( 1, Size );
+				Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1> RandomWordVector2( Size, 1 );
+
+				for ( Eigen::Index index = 0; index < RandomQuadWordMatrix.size(); ++index )
+					RandomQuadWordMatrix.data()[ index ] = RandomGenerator();
+				for ( Eigen::Index index = 0; index < Size; ++index )
+				{
+					RandomWordVector( 0, index ) = RandomGenerator();
+					RandomWordVector2( index, 0 ) = RandomGenerator();
+				}
+
+				const std::uint64_t DotProduct = RandomWordVector2.dot( RandomWordVector );
+
+				//UpdateState 原来的计算方式
+				//The original computation of UpdateState
+				const QuadWordMatrix KroneckerProductMatrix = Eigen::kroneckerProduct( RandomWordVector, RandomWordVector2 ).eval();
+				const QuadWordMatrix ExpectedSubkeyMatrix = RandomQuadWordMatrix * ( KroneckerProductMatrix * DotProduct );
+
+				//UpdateState 现在的计算方式 (参数与 Module_SubkeyMatrixOperation::UpdateState 里的调用相同)
+				//The current computation of UpdateState (same arguments as the call in Module_SubkeyMatrixOperation::UpdateState)
+				QuadWordMatrix TransformedSubkeyMatrix = QuadWordMatrix::Zero( Size, Size );
+				Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1> MatrixVectorProduct = Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1>::Zero( Size, 1 );
+
+				WrappingIntegerMatrixMultiply::MultiplyMatrixByRankOne
+				(
+					RandomQuadWordMatrix.rows(), RandomWordVector.cols(), RandomQuadWordMatrix.cols(),
+					RandomQuadWordMatrix.data(), RandomQuadWordMatrix.rows(),
+					RandomWordVector2.data(),
+					RandomWordVector.data(),
+					DotProduct,
+					MatrixVectorProduct.data(),
+					TransformedSubkeyMatrix.data(), TransformedSubkeyMatrix.rows()
+				);
+
+				IsSameData = IsSameData && TransformedSubkeyMatrix == ExpectedSubkeyMatrix;
+			}
+
+			if ( IsSameData )
+			{
+				std::cout << "The data after this operation is correct!" << std::endl;
+				std::cout << "Yeah! \nThe rank-1 subkey matrix update is normal work!" << std::endl;
+			}
+			else
+			{
+				std::cout << "The data after this operation is incorrect!" << std::endl;
+				std::cout << "Oh, no!\nThe rank-1 subkey matrix update is not processing the correct data." << std::endl;
+			}
+		}
+
+		void RunDiffusionLayerKernelUnit()
+		{
+			using namespace TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::ImplementationDetails;
+
+			constexpr std::size_t SliceWords = 32;
+
+			std::mt19937_64 RandomGenerator( 0xD1FF05102024ULL );
+
+			//ApplyDiffusionLayer 对 8 片以上使用 AVX-512，4 到 7 片使用 AVX2，剩下的片使用标量路径，所以 1 到 19 片覆盖了处理器支持的每个路径和它们的尾部
+			//ApplyDiffusionLayer uses AVX-512 for 8 slices and more, AVX2 for 4 to 7 slices and the scalar path for the remaining slices, so 1 to 19 slices cover every path the processor supports and their tails
+			const auto& Features = TwilightDreamOfMagical::BaseOperation::CurrentProcessorFeatures();
+			std::cout << "Diffusion layer kernels: scalar" << ( Features.AVX2 ? ", AVX2" : "" ) << ( Features.AVX512F ? ", AVX-512" : "" ) << std::endl;
+
+			bool IsSameData = true;
+
+			for ( std::size_t SliceCount = 1; SliceCount <= 19; ++SliceCount )
+			{
+				for ( std::size_t Round = 0; Round < 4; ++Round )
+				{
+					std::vector<std::uint64_t> KeyState( SliceCount * SliceWords );
+					for ( auto& Word : KeyState )
+						Word = RandomGenerator();
+
+					std::vector<std::uint64_t> ExpectedKeyState = KeyState;
+
+					DiffusionLayerNetwork::ApplyDiffusionLayer( KeyState );
+					DiffusionLayerNetwork::ApplyDiffusionLayerScalar( ExpectedKeyState );
+
+					IsSameData = IsSameData && KeyState == ExpectedKeyState;
+				}
+			}
+
+			if ( IsSameData )
+			{
+				std::cout << "The data after this operation is correct!" << std::endl;
+				std::cout << "Yeah! \nThe diffusion layer kernels are normal work!" << std::endl;
+			}
+			else
+			{
+				std::cout << "The data after this operation is incorrect!" << std::endl;
+				std::cout << "Oh, no!\nThe diffusion layer kernels are not processing the correct data." << std::endl;
+			}
+		}
+
+		void RunByteSubstitutionKernelUnit()
+		{
+			using namespace TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::ImplementationDetails::ByteSubstitutionKernel;
+
+			std::mt19937_64 RandomGenerator( 0x5B0C5B0C5B0C5B0CULL );
+
+			//两个随机置换盒和它们的逆，按 OaldresPuzzle_Cryptic::ByteSubstitution 加密和解密时的通道排列组合
+			//Two random substitution boxes and their inverses, arranged by lane the same way as encryption and decryption in OaldresPuzzle_Cryptic::ByteSubstitution
+			SubstitutionBox ForwardBox0 {}, ForwardBox1 {}, BackwardBox0 {}, BackwardBox1 {};
+			std::iota( ForwardBox0.begin(), ForwardBox0.end(), std::uint8_t { 0 } );
+			std::iota( ForwardBox1.begin(), ForwardBox1.end(), std::uint8_t { 0 } );
+			std::shuffle( ForwardBox0.begin(), ForwardBox0.end(), RandomGenerator );
+			std::shuffle( ForwardBox1.begin(), ForwardBox1.end(), RandomGenerator );
+			for ( std::size_t ByteValue = 0; ByteValue < 256; ++ByteValue )
+			{
+				BackwardBox0[ ForwardBox0[ ByteValue ] ] = static_cast<std::uint8_t>( ByteValue );
+				BackwardBox1[ ForwardBox1[ ByteValue ] ] = static_cast<std::uint8_t>( ByteValue );
+			}
+
+			const SubstitutionLayer EncryptionLayer
+			(
+				{
+					&ForwardBox1, &ForwardBox0, &BackwardBox1, &BackwardBox0,
+					&ForwardBox0, &BackwardBox1, &ForwardBox0, &BackwardBox1
+				}
+			);
+			const SubstitutionLayer DecryptionLayer
+			(
+				{
+					&BackwardBox1, &BackwardBox0, &ForwardBox1, &ForwardBox0,
+					&BackwardBox0, &ForwardBox1, &BackwardBox0, &ForwardBox1
+				}
+			);
+
+			//不支持的内核在 Substitute 里会退回到可用的内核，所以只检查这台处理器真正支持的
+			//An unsupported kernel falls back to an available one inside Substitute, so only the kernels this processor really supports are checked
+			std::vector<KernelKind> SupportedKernels { KernelKind::Scalar };
+			if ( SelectKernel() != KernelKind::Scalar )
+				SupportedKernels.push_back( KernelKind::AVX2 );
+			if ( SelectKernel() == KernelKind::AVX512VBMI )
+				SupportedKernels.push_back( KernelKind::AVX512VBMI );
+
+			//每个通道都遇到全部 256 个字节值
+			//Every lane meets all 256 byte values
+			std::vector<std::uint8_t> AllByteValues( 256 * 8 );
+			for ( std::size_t index = 0; index < AllByteValues.size(); ++index )
+				AllByteValues[ index ] = static_cast<std::uint8_t>( index / 8 + index % 8 * 37 );
+
+			bool IsSameData = true;
+
+			for ( const SubstitutionLayer* Layer : { &EncryptionLayer, &DecryptionLayer } )
+			{
+				for ( KernelKind Kernel : SupportedKernels )
+				{
+					std::vector<std::uint8_t> Datas = AllByteValues;
+					std::vector<std::uint8_t> ExpectedDatas = AllByteValues;
+					Layer->Substitute( Datas, Kernel );
+					Layer->Substitute( ExpectedDatas, KernelKind::Scalar );
+					IsSameData = IsSameData && Datas == ExpectedDatas;
+
+					//AVX2 一次 32 字节，AVX-512VBMI 一次 64 字节，这些长度留下各种不是整块的尾部
+					//AVX2 takes 32 bytes at a time and AVX-512VBMI 64 bytes at a time, so these lengths leave all kinds of tails that are not whole blocks
+					for ( std::size_t ByteCount : { 8, 16, 24, 40, 56, 72, 88, 120, 136, 200, 264, 1016 } )
+					{
+						Datas.resize( ByteCount );
+						for ( auto& Byte : Datas )
+							Byte = static_cast<std::uint8_t>( RandomGenerator() );
+						ExpectedDatas = Datas;
+
+						Layer->Substitute( Datas, Kernel );
+						Layer->Substitute( ExpectedDatas, KernelKind::Scalar );
+						IsSameData = IsSameData && Datas == ExpectedDatas;
+					}
+				}
+			}
+
+			//两个方向互逆
+			//The two directions are inverses of each other
+			std::vector<std::uint8_t> RoundTripDatas = AllByteValues;
+			EncryptionLayer.Substitute( RoundTripDatas );
+			DecryptionLayer.Substitute( RoundTripDatas );
+			IsSameData = IsSameData && RoundTripDatas == AllByteValues;
+
+			std::cout << "Checked byte substitution kernels: " << SupportedKernels.size() << std::endl;
+
+			if ( IsSameData )
+			{
+				std::cout << "The data after this operation is correct!" << std::endl;
+				std::cout << "Yeah! \nThe byte substitution kernels are normal work!" << std::endl;
+			}
+			else
+			{
+				std::cout << "The data after this operation is incorrect!" << std::endl;
+				std::cout << "Oh, no!\nThe byte substitution kernels are not processing the correct data." << std::endl;
+			}
+		}
+
+		void RunRekeyPrecomputationUnit()
+		{
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OaldresPuzzle_Cryptic;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::OPC_MainAlgorithm_Worker;
+			using TwilightDreamOfMagical::CustomSecurity::SED::BlockCipher::ImplementationDetails::CommonStateData;
+			using CommonToolkit::WorkStealingThreadPool;
+
+			//小的数据块 (4 个 QuadWord) 和密钥块 (8 个 QuadWord)，让测试很快越过计数器 4096、6144 和 12288 处的重新派生密钥
+			//A small data block (4 QuadWords) and key block (8 QuadWords), so the test quickly passes the rekeys at counters 4096, 6144 and 12288
+			constexpr std::size_t DataBlockSize = 4;
+			constexpr std::size_t KeyBlockSize = 8;
+			constexpr std::size_t DataBlockCount = 13 * 1024;
+
+			std::mt19937_64 RandomGenerator( 0x4E6B65795265ULL );
+			std::vector<std::uint8_t> InitialVector( 1024 );
+			std::vector<std::uint8_t> Keys( KeyBlockSize * sizeof( std::uint64_t ) * 2 );
+			std::vector<std::uint8_t> PlainData( DataBlockCount * DataBlockSize * sizeof( std::uint64_t ) );
+			for ( auto* ByteData : { &InitialVector, &Keys, &PlainData } )
+				for ( auto& Byte : *ByteData )
+					Byte = static_cast<std::uint8_t>( RandomGenerator() );
+
+			//单核机器上 WorkStealingThreadPool::Shared() 没有工作线程，所以这里强制使用一个有 3 个工作线程的线程池
+			//WorkStealingThreadPool::Shared() has no worker threads on a single-core machine, so a pool with 3 worker threads is forced here
+			WorkStealingThreadPool ForcedThreadPool( 3 );
+
+			auto Encrypt = [ & ]( WorkStealingThreadPool* ThreadPoolPointer )
+			{
+				CommonStateData CommonStateDataObject( DataBlockSize, KeyBlockSize, InitialVector, 123456, 456789, 0xB7E151628AED2A6AULL );
+				OaldresPuzzle_Cryptic AlgorithmCoreObject( CommonStateDataObject );
+				OPC_MainAlgorithm_Worker OPC_WorkerObject( AlgorithmCoreObject, false );
+				OPC_WorkerObject.UseRekeyThreadPool( ThreadPoolPointer );
+				return OPC_WorkerObject.EncrypterMainWithoutPadding( PlainData, Keys );
+			};
+
+			const std::vector<std::uint8_t> SerialCipherData = Encrypt( nullptr );
+			const std::vector<std::uint8_t> PooledCipherData = Encrypt( std::addressof( ForcedThreadPool ) );
+
+			CommonStateData CommonStateDataObject( DataBlockSize, KeyBlockSize, InitialVector, 123456, 456789, 0xB7E151628AED2A6AULL );
+			OaldresPuzzle_Cryptic AlgorithmCoreObject( CommonStateDataObject );
+			OPC_MainAlgorithm_Worker OPC_WorkerObject( AlgorithmCoreObject, false );
+			OPC_WorkerObject.UseRekeyThreadPool( std::addressof( ForcedThreadPool ) );
+			const std::vector<std::uint8_t> DecryptedData = OPC_WorkerObject.DecrypterMainWithoutUnpadding( PooledCipherData, Keys );
+
+			if ( SerialCipherData == PooledCipherData && DecryptedData == PlainData )
+			{
+				std::cout << "The data after this operation is correct!" << std::endl;
+				std::cout << "Yeah! \nThe rekey precomputation is normal work!" << std::endl;
+			}
+			else
+			{
+				std::cout << "The data after this operation is incorrect!" << std::endl;
+				std::cout << "Oh, no!\nThe rekey precomputation is not processing the correct data." << std::endl;
+			}
+		}
+
+		template <bool MatrixInField>
+		bool CheckMontgomeryMatrixVector( const TwilightDreamOfMagical::PrimeField::MontgomeryPrimeFieldContext& Context, std::mt19937_64& RandomGenerator )
+		{
+			using namespace TwilightDreamOfMagical::PrimeField;
+			using QuadWordMatrix = Eigen::Matrix<std::uint64_t, Eigen::Dynamic, Eigen::Dynamic>;
+			using QuadWordVector = Eigen::Matrix<std::uint64_t, Eigen::Dynamic, 1>;
+
+			bool IsSameData = true;
+
+			for ( std::size_t Round = 0; Round < 64; ++Round )
+			{
+				//64 x 64 是 SecureHash 使用的大小，其余是随机大小
+				//64 x 64 is the size used by SecureHash, the others are random sizes
+				const Eigen::Index Rows = ( Round == 0 ) ? 64 : static_cast<Eigen::Index>( 1 + RandomGenerator() % 70 );
+				const Eigen::Index Columns = ( Round == 0 ) ? 64 : static_cast<Eigen::Index>( 1 + RandomGenerator() % 70 );
+
+				//一半的轮次让元素集中在模数附近和 2^64 附近，保证出现大于等于模数的元素
+				//Half of the rounds concentrate the elements near the modulus and near 2^64, so elements greater than or equal to the modulus do occur
+				QuadWordMatrix Matrix( Rows, Columns );
+				QuadWordVector Vector( Columns );
+				for ( Eigen::Index index = 0; index < Matrix.size(); ++index )
+				{
+					const std::uint64_t RandomNumber = RandomGenerator();
+					Matrix.data()[ index ] = ( Round % 2 == 0 ) ? RandomNumber : ( ( index % 2 == 0 ) ? Context.modulus - 4 + RandomNumber % 8 : ~std::uint64_t { 0 } - RandomNumber % 64 );
+				}
+				for ( Eigen::Index index = 0; index < Vector.size(); ++index )
+				{
+					const std::uint64_t RandomNumber = RandomGenerator();
+					Vector( index ) = ( Round % 4 == 1 ) ? ~std::uint64_t { 0 } - RandomNumber % 128 : RandomNumber;
+				}
+
+				//原来的路径：逐元素入域 (MatrixInField 时直接当作域内表示)，Eigen GEMV，再逐元素出域
+				//The original path: enter the field element by element (taken directly as the field representation when MatrixInField), Eigen GEMV, then leave the field element by element
+				QuadWordVector ExpectedOutput( Rows );
+				{
+					MontgomeryComputationScope Scope( Context );
+
+					Eigen::Matrix<Montgomery64, Eigen::Dynamic, Eigen::Dynamic> MatrixInMontgomery( Rows, Columns );
+					Eigen::Matrix<Montgomery64, Eigen::Dynamic, 1> VectorInMontgomery( Columns );
+					for ( Eigen::Index index = 0; index < Matrix.size(); ++index )
+						MatrixInMontgomery.data()[ index ] = MatrixInField ? Montgomery64( Matrix.data()[ index ], true ) : Montgomery64::FromStandard( Matrix.data()[ index ] );
+					for ( Eigen::Index index = 0; index < Vector.size(); ++index )
+						VectorInMontgomery( index ) = Montgomery64::FromStandard( Vector( index ) );
+
+					const Eigen::Matrix<Montgomery64, Eigen::Dynamic, 1> OutputInMontgomery = ( MatrixInMontgomery * VectorInMontgomery ).eval();
+					for ( Eigen::Index index = 0; index < Rows; ++index )
+						ExpectedOutput( index ) = OutputInMontgomery( index ).ToStandard();
+				}
+
+				QuadWordVector Output( Rows );
+				std::vector<std::uint64_t> VectorInField( Columns );
+				std::vector<std::uint64_t> AccumulatorWords( 2 * Rows );
+				MultiplyMatrixVectorInField<MatrixInField>( Context, Matrix.data(), Rows, Columns, Vector.data(), Output.data(), VectorInField.data(), AccumulatorWords.data() );
+
+				IsSameData = IsSameData && Output == ExpectedOutput;
+			}
+
+			return IsSameData;
+		}
+
+		void RunMontgomeryMatrixVectorUnit()
+		{
+			using TwilightDreamOfMagical::PrimeField::MontgomeryPrimeFieldContext;
+
+			std::mt19937_64 RandomGenerator( 0x4D6F6E74676F6DULL );
+
+			bool IsSameData = true;
+
+			//SecureHash 使用的 2^64 - 59 (大于 2^63，ReduceFrom128 会丢掉进位)，以及两个小于 2^63 的素数
+			//2^64 - 59 used by SecureHash (greater than 2^63, ReduceFrom128 drops the carry), and two primes below 2^63
+			for ( std::uint64_t Modulus : { 18446744073709551557ULL, 4611686018427387847ULL, 1000000007ULL } )
+			{
+				const MontgomeryPrimeFieldContext Context( Modulus );
+
+				IsSameData = IsSameData && CheckMontgomeryMatrixVector<false>( Context, RandomGenerator );
+				IsSameData = IsSameData && CheckMontgomeryMatrixVector<true>( Context, RandomGenerator );
+			}
+
+			if ( IsSameData )
+			{
+				std::cout << "The data after this operation is correct!" << std::endl;
+				std::cout << "Yeah! \nThe fused Montgomery matrix-vector multiplication is normal work!" << std::endl;
+			}
+			else
+			{
+				std::cout << "The data after this operation is incorrect!" << std::endl;
+				std::cout << "Oh, no!\nThe fused Montgomery matrix-vector multiplication is not processing the correct data." << std::endl;
+			}
+		}
+
+		void RunSimulateDoublePendulumUnit()
+		{
+			using TwilightDreamOfMagical::CustomSecurity::CSPRNG::ChaoticTheory::SimulateDoublePendulum;
+			using EvaluationMode = SimulateDoublePendulum::evaluation_mode;
+
+			const std::uint64_t SeedNumber = 0xB7E151628AED2A6AULL;
+
+			//fast_double_v1 的前 16 个输出只取决于种子；如果这里改变了，说明 v1 的比特流被改动了
+			//The first 16 outputs of fast_double_v1 only depend on the seed; if they change here, the v1 bit stream has been modified
+			constexpr std::array<std::uint64_t, 16> FastModeKnownAnswers
+			{
+				0x557577d5a5a565a9ULL, 0x557557d5aa65996aULL, 0x555ff7d756a65599ULL, 0x555fd7d765666a6aULL,
+				0xabeeaabe95a5a696ULL, 0xabeebabe9559696aULL, 0xabeeeabe6a6aaaa9ULL, 0xabeefabe69a69955ULL,
+				0xafafbbbb5a65a556ULL, 0xafafebbeaa6a9556ULL, 0xafaffbbe9a996599ULL, 0xafbaabbe6aa656a9ULL,
+				0xbabfebaa69955a55ULL, 0xbabffbabaa9556a9ULL, 0xbaeaabab95955669ULL, 0xbaeabbab56955696ULL
+			};
+
+			bool IsSameData = true;
+
+			//切换到快速模式之前先生成几个兼容模式的输出：快速模式从种子开始，与 long double 状态无关
+			//Generate a few compatibility-mode outputs before switching to fast mode: the fast mode starts from the seed, independent of the long double state
+			SimulateDoublePendulum KnownAnswerGenerator( SeedNumber );
+			for ( std::size_t index = 0; index < 5; ++index )
+				KnownAnswerGenerator( SimulateDoublePendulum::min(), SimulateDoublePendulum::max() );
+			KnownAnswerGenerator.set_evaluation_mode( EvaluationMode::fast_double_v1 );
+			for ( std::uint64_t KnownAnswer : FastModeKnownAnswers )
+				IsSameData = IsSameData && KnownAnswerGenerator( SimulateDoublePendulum::min(), SimulateDoublePendulum::max() ) == KnownAnswer;
+
+			//reset 之后快速模式也从种子重新开始
+			//After reset the fast mode also restarts from the seed
+			KnownAnswerGenerator.reset();
+			IsSameData = IsSameData && KnownAnswerGenerator( SimulateDoublePendulum::min(), SimulateDoublePendulum::max() ) == FastModeKnownAnswers[ 0 ];
+
+			//快速模式一次积分 4 个摆锤，不是 4 的倍数的批量大小会让输出留在待取缓冲区里，下一次调用要先用完它们
+			//The fast mode integrates 4 pendulums at a time, so batch sizes that are not a multiple of 4 leave outputs in the pending buffer, which the next call must use up first
+			constexpr std::array<std::size_t, 10> BatchSizes { 1, 3, 5, 7, 2, 4, 9, 6, 11, 1 };
+
+			for ( EvaluationMode Mode : { EvaluationMode::compatible_long_double, EvaluationMode::fast_double_v1 } )
+			{
+				SimulateDoublePendulum BulkGenerator( SeedNumber );
+				SimulateDoublePendulum SingleGenerator( SeedNumber );
+				BulkGenerator.set_evaluation_mode( Mode );
+				SingleGenerator.set_evaluation_mode( Mode );
+
+				std::vector<std::uint64_t> RandomNumbers;
+				for ( std::size_t BatchSize : BatchSizes )
+				{
+					RandomNumbers.assign( BatchSize, 0 );
+					BulkGenerator.generate( RandomNumbers );
+
+					for ( std::uint64_t RandomNumber : RandomNumbers )
+						IsSameData = IsSameData && SingleGenerator( SimulateDoublePendulum::min(), SimulateDoublePendulum::max() ) == RandomNumber;
+
+					//批量之间穿插一次单个调用
+					//Interleave one single call between batches
+					IsSameData = IsSameData && BulkGenerator( SimulateDoublePendulum::min(), SimulateDoublePendulum::max() ) == SingleGenerator( SimulateDoublePendulum::min(), SimulateDoublePendulum::max() );
+				}
+			}
+
+			if ( IsSameData )
+			{
+				std::cout << "The data after this operation is correct!" << std::endl;
+				std::cout << "Yeah! \nThe double pendulum generator is normal work!" << std::endl;
+			}
+			else
+			{
+				std::cout << "The data after this operation is incorrect!" << std::endl;
+				std::cout << "Oh, no!\nThe double pendulum generator is not processing the correct data." << std::endl;
+			}
+		}
 	}  // namespace Test_OaldresPuzzle_Cryptic
 }
\ No newline at end of file
@@ -27,6 +27,12 @@
 #include <chrono>
 
 #include "../BlockCipher/OPC_MainAlgorithm_Worker.hpp"
+#include "../BlockCipher/OPC_SegmentedWorker.hpp"
+#include "../BlockCipher/OPC_KeySetupCache.hpp"
+#include "../BlockCipher/WrappingIntegerMatrixMultiply.hpp"
+#include "../BlockCipher/DiffusionLayerNetwork.hpp"
+#include "../BlockCipher/ByteSubstitutionKernel.hpp"
+#include "../BlockCipher/ExtraIncludes/MontgomeryScalarEigen.hpp"
 
 namespace TwilightDreamOfMagical
 {
@@ -41,6 +47,100 @@ namespace TwilightDreamOfMagical
 			std::uint64_t NLFSR_Seed = 1,
 			std::uint64_t SDP_Seed = 0xB7E151628AED2A6AULL
 		);
+
+		//分段并行模式：整体往返，以及单独解密中间的一段
+		//Segmented parallel mode: whole round trip, and decrypting one middle segment on its own
+		void RunSegmentedUnit
+		(
+			const std::vector<std::uint8_t>& PlainData,
+			const std::vector<std::uint8_t>& Keys,
+			const std::vector<std::uint8_t>& InitialVector,
+			std::size_t SegmentByteSize,
+			std::uint64_t LFSR_Seed = 1,
+			std::uint64_t NLFSR_Seed = 1,
+			std::uint64_t SDP_Seed = 0xB7E151628AED2A6AULL
+		);
+
+		//原地接口：和不填充的整段加密结果比较，然后原地解密回明文
+		//In-place interface: compare with whole-data encryption without padding, then decrypt back to the plaintext in place
+		void RunInPlaceUnit
+		(
+			const std::vector<std::uint8_t>& PlainData,
+			const std::vector<std::uint8_t>& Keys,
+			const std::vector<std::uint8_t>& InitialVector,
+			std::uint64_t LFSR_Seed = 1,
+			std::uint64_t NLFSR_Seed = 1,
+			std::uint64_t SDP_Seed = 0xB7E151628AED2A6AULL
+		);
+
+		//流式接口：按不同大小的分块加密和解密，并和一次处理整段数据的解密结果比较
+		//Streaming interface: encrypt and decrypt in chunks of varying size, and compare with decrypting the whole data at once
+		void RunStreamingUnit
+		(
+			const std::vector<std::uint8_t>& PlainData,
+			const std::vector<std::uint8_t>& Keys,
+			const std::vector<std::uint8_t>& InitialVector,
+			std::size_t ChunkByteSize,
+			std::uint64_t LFSR_Seed = 1,
+			std::uint64_t NLFSR_Seed = 1,
+			std::uint64_t SDP_Seed = 0xB7E151628AED2A6AULL
+		);
+
+		//密钥准备缓存：未命中、命中和重复使用的上下文都要和完整准备的结果相同，并检查命中统计和清除
+		//Key setup cache: a miss, a hit and a reused context must all match the fully set up result, and the hit statistics and purge are checked
+		void RunKeySetupCacheUnit
+		(
+			const std::vector<std::uint8_t>& PlainData,
+			const std::vector<std::uint8_t>& Keys,
+			const std::vector<std::uint8_t>& InitialVector,
+			std::uint64_t LFSR_Seed = 1,
+			std::uint64_t NLFSR_Seed = 1,
+			std::uint64_t SDP_Seed = 0xB7E151628AED2A6AULL
+		);
+
+		//各阶段性能计数器：打印一条消息的耗时分布；开启时每个会被执行的阶段都要有计数，关闭时必须全是 0，清零之后也必须全是 0
+		//Per-stage performance counters: print the time split of one message; when enabled every stage that runs must have counts, when disabled everything must be 0, and everything must be 0 after a reset
+		void RunStageProfileUnit
+		(
+			const std::vector<std::uint8_t>& PlainData,
+			const std::vector<std::uint8_t>& Keys,
+			const std::vector<std::uint8_t>& InitialVector,
+			std::uint64_t LFSR_Seed = 1,
+			std::uint64_t NLFSR_Seed = 1,
+			std::uint64_t SDP_Seed = 0xB7E151628AED2A6AULL
+		);
+
+		//Scrypt 的各个 Salsa20/8 内核：奇数和偶数个并行通道，有没有线程池，都要和逐字的参考实现得到相同的密钥
+		//Salsa20/8 kernels of Scrypt: odd and even parallel lane counts, with and without the thread pool, must all derive the same keys as the word-by-word reference implementation
+		void RunScryptKernelUnit();
+
+		//模 2^64 的矩阵乘法：处理器支持的每个内核，在各种大小 (包括不是通道宽度整数倍的大小) 下都要和 Eigen 的 uint64 乘积逐位相同
+		//Wrapping matrix multiplication modulo 2^64: every kernel the processor supports must match the Eigen uint64 product bit for bit at various sizes (including sizes that are not a multiple of the lane width)
+		void RunWrappingMatrixMultiplyKernelUnit();
+
+		//子密钥矩阵更新状态：秩 1 的分解计算必须和它替代的 克罗内克积 + 完整矩阵乘法 得到相同的矩阵
+		//Subkey matrix update state: the rank-1 factored computation must give the same matrix as the Kronecker product + full matrix multiplication it replaces
+		void RunSubkeyMatrixRankOneUpdateUnit();
+
+		//比特数据扩散层：AVX2 和 AVX-512 路径必须和标量参考实现 ApplyDiffusionLayerScalar 逐位相同
+		//Bits data diffusion layer: the AVX2 and AVX-512 paths must match the scalar reference ApplyDiffusionLayerScalar bit for bit
+		void RunDiffusionLayerKernelUnit();
+
+		//字节数据置换层：处理器支持的每个 SIMD 内核在加密和解密两个方向、全部 256 个字节值和不是整块的尾部长度上，都要和标量查表路径逐字节相同
+		//Byte data substitution layer: every SIMD kernel the processor supports must match the scalar table lookup path byte for byte in both the encryption and decryption direction, for all 256 byte values and for tail lengths that are not whole blocks
+		void RunByteSubstitutionKernelUnit();
+
+		//重新派生密钥的后台预先计算：越过几个重新派生密钥的边界时，没有工作线程和强制使用多个工作线程得到的密文必须逐位相同
+		//Background precomputation of the rekey: past several rekey boundaries, the ciphertext with no worker threads and with forced multiple worker threads must be bit-identical
+		void RunRekeyPrecomputationUnit();
+
+		//融合的模矩阵-向量乘法：MultiplyMatrixVectorInField 的两种矩阵表示都要和原来的 Montgomery64 + Eigen GEMV 路径逐位相同 (包括大于等于模数的元素)
+		//Fused modular matrix-vector multiplication: both matrix representations of MultiplyMatrixVectorInField must match the original Montgomery64 + Eigen GEMV path bit for bit (including elements greater than or equal to the modulus)
+		void RunMontgomeryMatrixVectorUnit();
+
+		//双摆伪随机数生成器：fast_double_v1 的已知答案，以及两种求值模式下 generate(span) 和逐个调用 operator() 的结果相同
+		//Double pendulum pseudo-random number generator: known answers of fast_double_v1, and generate(span) giving the same results as calling operator() one by one in both evaluation modes
+		void RunSimulateDoublePendulumUnit();
 	}
 }
 
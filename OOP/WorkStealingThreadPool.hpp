@@ -0,0 +1,246 @@
+#ifndef ALGORITHM_OALDRESPUZZLECRYPTIC_WORKSTEALINGTHREADPOOL_HPP
+#define ALGORITHM_OALDRESPUZZLECRYPTIC_WORKSTEALINGTHREADPOOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+	工作窃取线程池
+	每个工作线程有自己的任务队列，从自己队列的尾部取任务，空闲时从其他队列的头部窃取任务。
+	等待任务组的线程也会帮忙执行任务，所以单核机器上(没有工作线程)也能正常完成。
+
+	Work-stealing thread pool
+	Each worker thread owns a task queue, takes tasks from the back of its own queue and steals from the front of the other queues when idle.
+	A thread waiting on a task group helps execute tasks, so it still completes on a single-core machine (with no worker threads).
+*/
+
+namespace CommonToolkit
+{
+	class WorkStealingThreadPool
+	{
+
+	public:
+		//一组一起等待的任务，第一个抛出的异常会在 Wait 中重新抛出
+		//A set of tasks that are waited on together, the first exception thrown is rethrown in Wait
+		class TaskGroup
+		{
+			friend class WorkStealingThreadPool;
+
+		public:
+			TaskGroup() = default;
+			TaskGroup( const TaskGroup& ) = delete;
+			TaskGroup& operator=( const TaskGroup& ) = delete;
+
+		private:
+			std::atomic<std::size_t> UnfinishedTaskCount { 0 };
+			std::mutex ExceptionMutex;
+			std::exception_ptr FirstException = nullptr;
+		};
+
+		explicit WorkStealingThreadPool( std::size_t WorkerThreadCount )
+			:
+			TaskQueues( WorkerThreadCount > 0 ? WorkerThreadCount : 1 )
+		{
+			for ( auto& TaskQueuePointer : TaskQueues )
+				TaskQueuePointer = std::make_unique<TaskQueue>();
+
+			WorkerThreads.reserve( WorkerThreadCount );
+			for ( std::size_t WorkerIndex = 0; WorkerIndex < WorkerThreadCount; ++WorkerIndex )
+				WorkerThreads.emplace_back( [ this, WorkerIndex ]() { this->WorkerLoop( WorkerIndex ); } );
+		}
+
+		~WorkStealingThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> StateLock( StateMutex );
+				Stopping = true;
+			}
+			WorkAvailableCondition.notify_all();
+
+			for ( auto& WorkerThread : WorkerThreads )
+			{
+				if ( WorkerThread.joinable() )
+					WorkerThread.join();
+			}
+		}
+
+		WorkStealingThreadPool( const WorkStealingThreadPool& ) = delete;
+		WorkStealingThreadPool& operator=( const WorkStealingThreadPool& ) = delete;
+
+		std::size_t WorkerThreadCount() const
+		{
+			return WorkerThreads.size();
+		}
+
+		//提交一个任务到任务组，工作线程提交到自己的队列，外部线程轮流提交到各个队列
+		//Submit a task to a task group, worker threads push to their own queue, outside threads push to the queues in turn
+		template <typename TaskFunctionType>
+		void Submit( TaskGroup& Group, TaskFunctionType&& TaskFunction )
+		{
+			Group.UnfinishedTaskCount.fetch_add( 1, std::memory_order_relaxed );
+
+			std::function<void()> WrappedTask = [ this, &Group, Task = std::forward<TaskFunctionType>( TaskFunction ) ]() mutable
+			{
+				try
+				{
+					Task();
+				}
+				catch ( ... )
+				{
+					std::lock_guard<std::mutex> ExceptionLock( Group.ExceptionMutex );
+					if ( Group.FirstException == nullptr )
+						Group.FirstException = std::current_exception();
+				}
+
+				{
+					std::lock_guard<std::mutex> StateLock( StateMutex );
+					Group.UnfinishedTaskCount.fetch_sub( 1, std::memory_order_acq_rel );
+				}
+				GroupFinishedCondition.notify_all();
+			};
+
+			const std::size_t QueueIndex = ( CurrentThreadPool == this )
+				? CurrentWorkerIndex
+				: NextQueueIndex.fetch_add( 1, std::memory_order_relaxed ) % TaskQueues.size();
+
+			{
+				std::lock_guard<std::mutex> QueueLock( TaskQueues[ QueueIndex ]->Mutex );
+				TaskQueues[ QueueIndex ]->Tasks.push_back( std::move( WrappedTask ) );
+			}
+
+			{
+				std::lock_guard<std::mutex> StateLock( StateMutex );
+				QueuedTaskCount.fetch_add( 1, std::memory_order_release );
+			}
+			WorkAvailableCondition.notify_one();
+			GroupFinishedCondition.notify_all();
+		}
+
+		//等待任务组完成，等待期间当前线程也执行队列中的任务
+		//Wait for the task group to finish, the current thread also executes queued tasks while waiting
+		void Wait( TaskGroup& Group )
+		{
+			const std::size_t StartQueueIndex = ( CurrentThreadPool == this ) ? CurrentWorkerIndex : 0;
+
+			while ( Group.UnfinishedTaskCount.load( std::memory_order_acquire ) > 0 )
+			{
+				if ( this->TryRunOneTask( StartQueueIndex ) )
+					continue;
+
+				std::unique_lock<std::mutex> StateLock( StateMutex );
+				GroupFinishedCondition.wait
+				(
+					StateLock,
+					[ this, &Group ]()
+					{
+						return Group.UnfinishedTaskCount.load( std::memory_order_acquire ) == 0 || QueuedTaskCount.load( std::memory_order_acquire ) > 0;
+					}
+				);
+			}
+
+			std::exception_ptr GroupException = nullptr;
+			{
+				std::lock_guard<std::mutex> ExceptionLock( Group.ExceptionMutex );
+				std::swap( GroupException, Group.FirstException );
+			}
+			if ( GroupException != nullptr )
+				std::rethrow_exception( GroupException );
+		}
+
+		//进程共享的线程池，调用者在 Wait 中也算一个执行者，所以工作线程数是硬件线程数减一
+		//Process-wide shared pool, the caller counts as one executor in Wait, so the worker count is the hardware thread count minus one
+		static WorkStealingThreadPool& Shared()
+		{
+			static WorkStealingThreadPool SharedPool( std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0 );
+			return SharedPool;
+		}
+
+	private:
+		struct TaskQueue
+		{
+			std::mutex Mutex;
+			std::deque<std::function<void()>> Tasks;
+		};
+
+		std::vector<std::unique_ptr<TaskQueue>> TaskQueues;
+		std::vector<std::thread> WorkerThreads;
+
+		std::mutex StateMutex;
+		std::condition_variable WorkAvailableCondition;
+		std::condition_variable GroupFinishedCondition;
+		//入队之后才增加，出队时减少，所以可能短暂为负
+		//Increased after pushing and decreased when popping, so it can be briefly negative
+		std::atomic<std::int64_t> QueuedTaskCount { 0 };
+		std::atomic<std::size_t> NextQueueIndex { 0 };
+		bool Stopping = false;
+
+		inline static thread_local WorkStealingThreadPool* CurrentThreadPool = nullptr;
+		inline static thread_local std::size_t CurrentWorkerIndex = 0;
+
+		//先取自己队列的尾部(最近提交的任务)，再依次窃取其他队列的头部(最早提交的任务)
+		//First take the back of the own queue (most recently submitted task), then steal the front of the other queues in turn (earliest submitted tasks)
+		bool TryRunOneTask( std::size_t OwnQueueIndex )
+		{
+			std::function<void()> Task;
+
+			{
+				TaskQueue& OwnQueue = *TaskQueues[ OwnQueueIndex ];
+				std::lock_guard<std::mutex> QueueLock( OwnQueue.Mutex );
+				if ( !OwnQueue.Tasks.empty() )
+				{
+					Task = std::move( OwnQueue.Tasks.back() );
+					OwnQueue.Tasks.pop_back();
+				}
+			}
+
+			for ( std::size_t Offset = 1; !Task && Offset < TaskQueues.size(); ++Offset )
+			{
+				TaskQueue& VictimQueue = *TaskQueues[ ( OwnQueueIndex + Offset ) % TaskQueues.size() ];
+				std::lock_guard<std::mutex> QueueLock( VictimQueue.Mutex );
+				if ( !VictimQueue.Tasks.empty() )
+				{
+					Task = std::move( VictimQueue.Tasks.front() );
+					VictimQueue.Tasks.pop_front();
+				}
+			}
+
+			if ( !Task )
+				return false;
+
+			QueuedTaskCount.fetch_sub( 1, std::memory_order_acq_rel );
+			Task();
+			return true;
+		}
+
+		void WorkerLoop( std::size_t WorkerIndex )
+		{
+			CurrentThreadPool = this;
+			CurrentWorkerIndex = WorkerIndex;
+
+			while ( true )
+			{
+				if ( this->TryRunOneTask( WorkerIndex ) )
+					continue;
+
+				std::unique_lock<std::mutex> StateLock( StateMutex );
+				WorkAvailableCondition.wait( StateLock, [ this ]() { return Stopping || QueuedTaskCount.load( std::memory_order_acquire ) > 0; } );
+				if ( Stopping && QueuedTaskCount.load( std::memory_order_acquire ) <= 0 )
+					break;
+			}
+
+			CurrentThreadPool = nullptr;
+		}
+	};
+}  // namespace CommonToolkit
+
+#endif	//ALGORITHM_OALDRESPUZZLECRYPTIC_WORKSTEALINGTHREADPOOL_HPP
@@ -20,6 +20,8 @@ inline void Check_LittleOPC_UnitTest()
 	TwilightDreamOfMagical::Test_LittleOaldresPuzzle_Cryptic::SingleRoundTest();
 	TwilightDreamOfMagical::Test_LittleOaldresPuzzle_Cryptic::MultipleRoundsTest();
 	TwilightDreamOfMagical::Test_LittleOaldresPuzzle_Cryptic::NumberOnce_CounterMode_Test();
+	TwilightDreamOfMagical::Test_LittleOaldresPuzzle_Cryptic::ResetPRNG_SeededStateTest();
+	TwilightDreamOfMagical::Test_LittleOaldresPuzzle_Cryptic::EncryptBlocks_BatchTest();
 }
 
 #endif //IS_BINARY_TEST_LITTLEOPC
@@ -74,6 +76,58 @@ inline void Check_OPC_UnitTest()
 
 	RunUnit(PlainData, Keys, InitialVector, (std::uint64_t)123456, (std::uint64_t)456789, 0xB7E151628AED2A6AULL);
 
+	using TwilightDreamOfMagical::Test_OaldresPuzzle_Cryptic::RunSegmentedUnit;
+
+	RunSegmentedUnit(PlainData, Keys, InitialVector, 262144, (std::uint64_t)123456, (std::uint64_t)456789, 0xB7E151628AED2A6AULL);
+
+	using TwilightDreamOfMagical::Test_OaldresPuzzle_Cryptic::RunStreamingUnit;
+
+	RunStreamingUnit(PlainData, Keys, InitialVector, 65536 + 17, (std::uint64_t)123456, (std::uint64_t)456789, 0xB7E151628AED2A6AULL);
+
+	using TwilightDreamOfMagical::Test_OaldresPuzzle_Cryptic::RunInPlaceUnit;
+
+	RunInPlaceUnit(PlainData, Keys, InitialVector, (std::uint64_t)123456, (std::uint64_t)456789, 0xB7E151628AED2A6AULL);
+
+	using TwilightDreamOfMagical::Test_OaldresPuzzle_Cryptic::RunKeySetupCacheUnit;
+
+	RunKeySetupCacheUnit(std::vector<std::uint8_t>(PlainData.begin(), PlainData.begin() + 65536), Keys, InitialVector, (std::uint64_t)123456, (std::uint64_t)456789, 0xB7E151628AED2A6AULL);
+
+	using TwilightDreamOfMagical::Test_OaldresPuzzle_Cryptic::RunStageProfileUnit;
+
+	RunStageProfileUnit(std::vector<std::uint8_t>(PlainData.begin(), PlainData.begin() + 65536), Keys, InitialVector, (std::uint64_t)123456, (std::uint64_t)456789, 0xB7E151628AED2A6AULL);
+
+	using TwilightDreamOfMagical::Test_OaldresPuzzle_Cryptic::RunScryptKernelUnit;
+
+	RunScryptKernelUnit();
+
+	using TwilightDreamOfMagical::Test_OaldresPuzzle_Cryptic::RunWrappingMatrixMultiplyKernelUnit;
+
+	RunWrappingMatrixMultiplyKernelUnit();
+
+	using TwilightDreamOfMagical::Test_OaldresPuzzle_Cryptic::RunSubkeyMatrixRankOneUpdateUnit;
+
+	RunSubkeyMatrixRankOneUpdateUnit();
+
+	using TwilightDreamOfMagical::Test_OaldresPuzzle_Cryptic::RunDiffusionLayerKernelUnit;
+
+	RunDiffusionLayerKernelUnit();
+
+	using TwilightDreamOfMagical::Test_OaldresPuzzle_Cryptic::RunByteSubstitutionKernelUnit;
+
+	RunByteSubstitutionKernelUnit();
+
+	using TwilightDreamOfMagical::Test_OaldresPuzzle_Cryptic::RunRekeyPrecomputationUnit;
+
+	RunRekeyPrecomputationUnit();
+
+	using TwilightDreamOfMagical::Test_OaldresPuzzle_Cryptic::RunMontgomeryMatrixVectorUnit;
+
+	RunMontgomeryMatrixVectorUnit();
+
+	using TwilightDreamOfMagical::Test_OaldresPuzzle_Cryptic::RunSimulateDoublePendulumUnit;
+
+	RunSimulateDoublePendulumUnit();
+
 }
 
 #endif //IS_BINARY_TEST_OPC